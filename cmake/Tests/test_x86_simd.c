@@ -0,0 +1,20 @@
+#include <immintrin.h>
+
+#if !defined(__x86_64__)
+#error "SIMD kernels are only enabled for x86_64"
+#endif
+
+__attribute__((target("avx2")))
+static void shuffle( char * data ) {
+  const __m256i mask = _mm256_set1_epi8( 1 );
+  __m256i v = _mm256_loadu_si256( (const __m256i *) data );
+  _mm256_storeu_si256( (__m256i *) data , _mm256_shuffle_epi8( v , mask ));
+}
+
+int main(int argc, char ** argv) {
+  char data[32] = {0};
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    shuffle( data );
+  return data[0];
+}
@@ -30,13 +30,15 @@ check_function_exists( GetTempPath HAVE_WINDOWS_GET_TEMP_PATH )
 check_function_exists( fork HAVE_FORK )
 check_function_exists( getpwuid HAVE_GETPWUID )
 check_function_exists( fsync HAVE_FSYNC )
+check_function_exists( mmap HAVE_MMAP )
+check_function_exists( pwritev HAVE_PWRITEV )
 check_function_exists( setenv HAVE_POSIX_SETENV )
 check_function_exists( chmod HAVE_CHMOD )
-check_function_exists( pthread_timedjoin_np HAVE_TIMEDJOIN)
 check_function_exists( pthread_yield_np HAVE_YIELD_NP)
 check_function_exists( pthread_yield HAVE_YIELD)
 check_function_exists( fseeko HAVE_FSEEKO )
 check_function_exists( timegm HAVE_TIMEGM )
+check_function_exists( sysconf HAVE_SYSCONF )
 
 check_function_exists( _mkdir HAVE_WINDOWS_MKDIR)
 if (NOT HAVE_WINDOWS_MKDIR)
@@ -65,6 +67,7 @@ try_compile( HAVE_VA_COPY ${CMAKE_BINARY_DIR} ${PROJECT_SOURCE_DIR}/cmake/Tests/
 try_compile( HAVE_SIGBUS ${CMAKE_BINARY_DIR} ${PROJECT_SOURCE_DIR}/cmake/Tests/test_have_sigbus.c )
 try_compile( HAVE_PID_T ${CMAKE_BINARY_DIR} ${PROJECT_SOURCE_DIR}/cmake/Tests/test_pid_t.c )
 try_compile( HAVE_MODE_T ${CMAKE_BINARY_DIR} ${PROJECT_SOURCE_DIR}/cmake/Tests/test_mode_t.c )
+try_compile( HAVE_X86_SIMD ${CMAKE_BINARY_DIR} ${PROJECT_SOURCE_DIR}/cmake/Tests/test_x86_simd.c )
 
 
 set( BUILD_CXX ON )
@@ -29,6 +29,7 @@
 #include <ert/util/time_t_vector.h>
 #include <ert/util/statistics.h>
 #include <ert/util/vector.h>
+#include <ert/util/stringlist.h>
 #include <ert/util/arg_pack.h>
 #include <ert/util/thread_pool.h>
 
@@ -39,6 +40,7 @@
 #include <ert/config/config_content_node.h>
 
 #include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_vector.h>
 
 #define DEFAULT_NUM_INTERP  50
 #define SUMMARY_JOIN       ":"
@@ -89,6 +91,7 @@ typedef struct {
   time_t                start_time;
   time_t                end_time;
   const ecl_sum_type  * refcase;     /* Pointer to an arbitrary ecl_sum instance in the ensemble - to have access to indexing functions. */
+  stringlist_type     * key_patterns; /* The summary keys mentioned in the OUTPUT statements; only these are loaded. */
   pthread_rwlock_t      rwlock;
 } ensemble_type;
 
@@ -121,10 +124,10 @@ static void quant_key_free__( void * qkey ) {
 
 /*****************************************************************/
 
-sum_case_type * sum_case_fread_alloc( const char * data_file , const time_t_vector_type * interp_time ) {
+sum_case_type * sum_case_fread_alloc( const char * data_file , const time_t_vector_type * interp_time , const stringlist_type * key_patterns) {
   sum_case_type * sum_case = util_malloc( sizeof * sum_case );
 
-  sum_case->ecl_sum     = ecl_sum_fread_alloc_case( data_file , SUMMARY_JOIN );
+  sum_case->ecl_sum     = ecl_sum_fread_alloc_case_selected( data_file , SUMMARY_JOIN , key_patterns );
   sum_case->interp_data = double_vector_alloc(0 , 0);
   sum_case->interp_time = interp_time;
   sum_case->start_time  = ecl_sum_get_start_time( sum_case->ecl_sum );
@@ -149,7 +152,7 @@ void sum_case_free__( void * sum_case) {
 
 
 void ensemble_add_case( ensemble_type * ensemble , const char * data_file ) {
-  sum_case_type * sum_case = sum_case_fread_alloc( data_file , ensemble->interp_time );
+  sum_case_type * sum_case = sum_case_fread_alloc( data_file , ensemble->interp_time , ensemble->key_patterns );
 
   pthread_rwlock_wrlock( &ensemble->rwlock );
   {
@@ -213,15 +216,44 @@ ensemble_type * ensemble_alloc( ) {
   ensemble->end_time    = -1;
   ensemble->data        = vector_alloc_new();
   ensemble->interp_time = time_t_vector_alloc( 0 , -1 );
+  ensemble->key_patterns = stringlist_alloc_new();
   pthread_rwlock_init( &ensemble->rwlock , NULL );
   return ensemble;
 }
 
 
+/**
+   Will collect the summary keys (possibly with wildcards) from the
+   OUTPUT statements, so that only these vectors are loaded from the
+   summary files. Malformed keys are skipped here, they are reported
+   by output_add_key().
+*/
+
+static void ensemble_init_key_patterns( ensemble_type * ensemble , const config_content_type * config) {
+  if (config_content_has_item( config , "OUTPUT")) {
+    const config_content_item_type * output_item = config_content_get_item( config , "OUTPUT");
+    int i,j;
+    for (i = 0; i < config_content_item_get_size( output_item ); i++) {
+      const config_content_node_type * output_node = config_content_item_iget_node( output_item , i );
+      for (j = 2; j < config_content_node_get_size( output_node ); j++) {
+        int tokens;
+        char ** tmp;
+
+        util_split_string( config_content_node_iget( output_node , j ) , SUMMARY_JOIN , &tokens , &tmp);
+        if (tokens > 1)
+          stringlist_append_owned_ref( ensemble->key_patterns , util_alloc_joined_string( (const char **) tmp , tokens - 1 , SUMMARY_JOIN));
+        util_free_stringlist( tmp , tokens );
+      }
+    }
+  }
+}
+
+
 void ensemble_init( ensemble_type * ensemble , config_content_type * config) {
 
   /*1 : Loading ensembles and settings from the config instance */
   /*1a: Loading the eclipse summary cases. */
+  ensemble_init_key_patterns( ensemble , config );
   {
     thread_pool_type * tp = thread_pool_alloc( LOAD_THREADS , true );
     {
@@ -266,6 +298,7 @@ const ecl_sum_type * ensemble_get_refcase( const ensemble_type * ensemble ) {
 void ensemble_free( ensemble_type * ensemble ) {
   vector_free( ensemble->data );
   time_t_vector_free( ensemble->interp_time );
+  stringlist_free( ensemble->key_patterns );
   free( ensemble );
 }
 
@@ -657,42 +690,75 @@ void output_run_line( const output_type * output , ensemble_type * ensemble) {
 
        WWCT:OP_1:0.10  WWCT:OP_1:0.50  WWCT:OP_1:0.90
 
-       the interp_data_cache construction will ensure that the
-       underlying ecl_sum object is only queried once; and also the
-       sorting will be performed once.
+       the summary key is only evaluated, and sorted, once for each
+       time. All the keys of one case are evaluated with one call to
+       ecl_sum_get_interp_vector(), i.e. with one time lookup. That
+       reads all the keys from the same one or two ministeps, which
+       are contiguous in the row oriented storage of ecl_sum; the
+       column store is therefor not enabled for the cases.
     */
 
-    hash_type * interp_data_cache = hash_alloc();
+    stringlist_type * sum_keys    = stringlist_alloc_new();
+    int             * key_index   = util_calloc( data_columns , sizeof * key_index );
+    vector_type     * keylists    = vector_alloc_new();
+    vector_type     * interp_data = vector_alloc_new();
+    double_vector_type * values   = double_vector_alloc( 0 , 0 );
+
+    for (column_nr = 0; column_nr < data_columns; column_nr++) {
+      const quant_key_type * qkey = vector_iget( output->keys , column_nr );
+      int index = stringlist_find_first( sum_keys , qkey->sum_key );
+
+      if (index < 0) {
+        index = stringlist_get_size( sum_keys );
+        stringlist_append_ref( sum_keys , qkey->sum_key );
+        vector_append_owned_ref( interp_data , double_vector_alloc( 0 , 0 ) , double_vector_free__ );
+      }
+      key_index[column_nr] = index;
+    }
+
+    for (int iens = 0; iens < vector_get_size( ensemble->data ); iens++) {
+      const sum_case_type * sum_case = vector_iget_const( ensemble->data , iens );
+      ecl_sum_vector_type * keylist = ecl_sum_vector_alloc( sum_case->ecl_sum );
+
+      for (int ikey = 0; ikey < stringlist_get_size( sum_keys ); ikey++)
+        ecl_sum_vector_add_key( keylist , stringlist_iget( sum_keys , ikey ));
+
+      vector_append_ref( keylists , keylist );
+    }
 
     for (row_nr = 0; row_nr < data_rows; row_nr++) {
       time_t interp_time = time_t_vector_iget( ensemble->interp_time , row_nr);
-      for (column_nr = 0; column_nr < vector_get_size( output->keys ); column_nr++) {
-        const quant_key_type * qkey = vector_iget( output->keys , column_nr );
-        double_vector_type * interp_data;
-
-        /* Check if we have the vector in the cache table - if not create it. */
-        if (!hash_has_key( interp_data_cache , qkey->sum_key)) {
-          interp_data = double_vector_alloc(0 , 0);
-          hash_insert_hash_owned_ref( interp_data_cache , qkey->sum_key , interp_data , double_vector_free__);
-        }
-        interp_data = hash_get( interp_data_cache , qkey->sum_key );
 
-        /* Check if the vector has data - if not initialize it. */
-        if (double_vector_size( interp_data ) == 0) {
-          for (int iens = 0; iens < vector_get_size( ensemble->data ); iens++) {
-            const sum_case_type * sum_case = vector_iget_const( ensemble->data , iens );
+      for (int ikey = 0; ikey < stringlist_get_size( sum_keys ); ikey++)
+        double_vector_reset( vector_iget( interp_data , ikey ));
 
-            if ((interp_time >= sum_case->start_time) && (interp_time <= sum_case->end_time))  /* We allow the different simulations to have differing length */
-              double_vector_append( interp_data , ecl_sum_get_general_var_from_sim_time( sum_case->ecl_sum , interp_time , qkey->sum_key)) ;
+      for (int iens = 0; iens < vector_get_size( ensemble->data ); iens++) {
+        const sum_case_type * sum_case = vector_iget_const( ensemble->data , iens );
 
-            double_vector_sort( interp_data );
-          }
+        if ((interp_time >= sum_case->start_time) && (interp_time <= sum_case->end_time)) {  /* We allow the different simulations to have differing length */
+          ecl_sum_get_interp_vector( sum_case->ecl_sum , interp_time , vector_iget_const( keylists , iens ) , values );
+          for (int ikey = 0; ikey < stringlist_get_size( sum_keys ); ikey++)
+            double_vector_append( vector_iget( interp_data , ikey ) , double_vector_iget( values , ikey ));
         }
-        data[row_nr][column_nr] = statistics_empirical_quantile__( interp_data , qkey->quantile );
       }
-      hash_apply( interp_data_cache , double_vector_reset__ );
+
+      for (int ikey = 0; ikey < stringlist_get_size( sum_keys ); ikey++)
+        double_vector_sort( vector_iget( interp_data , ikey ));
+
+      for (column_nr = 0; column_nr < data_columns; column_nr++) {
+        const quant_key_type * qkey = vector_iget( output->keys , column_nr );
+        data[row_nr][column_nr] = statistics_empirical_quantile__( vector_iget( interp_data , key_index[column_nr] ) , qkey->quantile );
+      }
     }
-    hash_free( interp_data_cache );
+
+    for (int iens = 0; iens < vector_get_size( keylists ); iens++)
+      ecl_sum_vector_free( vector_iget( keylists , iens ));
+
+    double_vector_free( values );
+    vector_free( interp_data );
+    vector_free( keylists );
+    free( key_index );
+    stringlist_free( sum_keys );
   }
 
   output_save( output , ensemble , (const double **) data);
@@ -38,19 +38,36 @@ extern "C" {
                                       mainly to save filedescriptors in cases where many ecl_file instances are open at
                                       the same time. */
     //
-    ECL_FILE_WRITABLE      =  2    /*
+    ECL_FILE_WRITABLE      =  2 ,  /*
                                       This flag opens the file in a mode where it can be updated and modified, but it
                                       must still exist and be readable. I.e. this should not compared with the normal:
                                       fopen(filename , "w") where an existing file is truncated to zero upon successfull
                                       open.
                                    */
+    //
+    ECL_FILE_MMAP          =  4 ,  /*
+                                      This flag will memory map the file; the keyword headers are scanned and the
+                                      keyword data is loaded directly from the mapping instead of through the FILE
+                                      stream. The flag is only honored for unformatted files opened read only, in all
+                                      other cases - and if the mmap() call fails - the normal stream based reading is
+                                      used.
+                                   */
+    //
+    ECL_FILE_INDEX         =  8    /*
+                                      This flag will store the keyword index of the file in the companion file
+                                      '.<filename>.index', and use that index instead of scanning the file the next time it
+                                      is opened. The index is validated against the size and modification time of the
+                                      file, and rebuilt when stale.
+                                   */
   } ecl_file_flag_type;
 
 
 #define ECL_FILE_FLAGS_ENUM_DEFS \
   {.value =   1 , .name="ECL_FILE_CLOSE_STREAM"}, \
-  {.value =   2 , .name="ECL_FILE_WRITABLE"}
-#define ECL_FILE_FLAGS_ENUM_SIZE 2
+  {.value =   2 , .name="ECL_FILE_WRITABLE"}, \
+  {.value =   4 , .name="ECL_FILE_MMAP"}, \
+  {.value =   8 , .name="ECL_FILE_INDEX"}
+#define ECL_FILE_FLAGS_ENUM_SIZE 4
 
 
 
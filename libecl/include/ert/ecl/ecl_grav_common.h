@@ -30,6 +30,8 @@ extern "C" {
 
   bool   * ecl_grav_common_alloc_aquifer_cell( const ecl_grid_cache_type * grid_cache , const ecl_file_type * init_file);
   double   ecl_grav_common_eval_biot_savart( const ecl_grid_cache_type * grid_cache , ecl_region_type * region , const bool * aquifer , const double * weight ,  double utm_x , double utm_y , double depth);
+  void     ecl_grav_common_eval_biot_savart_stations( const ecl_grid_cache_type * grid_cache , ecl_region_type * region , const bool * aquifer , const double * weight ,
+                                                      int num_stations , const double * utm_x , const double * utm_y , const double * depth , double * result);
 
 #ifdef __cplusplus
 }
@@ -54,6 +54,7 @@ extern "C" {
 
   void            ecl_grid_get_cell_corner_xyz3(const ecl_grid_type * grid , int i , int j , int k, int corner_nr , double * xpos , double * ypos , double * zpos );
   void            ecl_grid_get_cell_corner_xyz1(const ecl_grid_type * grid , int global_index , int corner_nr , double * xpos , double * ypos , double * zpos );
+  void            ecl_grid_get_cell_corners_xyz1(const ecl_grid_type * grid , int global_index , double * xpos , double * ypos , double * zpos );
   void            ecl_grid_get_corner_xyz(const ecl_grid_type * grid , int i , int j , int k, double * xpos , double * ypos , double * zpos );
 
   double          ecl_grid_get_cell_dx1A( const ecl_grid_type * grid , int active_index);
@@ -204,6 +205,8 @@ extern "C" {
 
   int              ecl_grid_zcorn_index(const ecl_grid_type * grid , int i, int j , int k , int c);
   ecl_grid_type * ecl_grid_alloc_EGRID(const char * grid_file, bool apply_mapaxes );
+  ecl_grid_type * ecl_grid_alloc_EGRID_compact(const char * grid_file, bool apply_mapaxes );
+  bool            ecl_grid_is_compact( const ecl_grid_type * grid );
   ecl_grid_type * ecl_grid_alloc_GRID(const char * grid_file, bool apply_mapaxes );
 
   float          * ecl_grid_alloc_zcorn_data( const ecl_grid_type * grid );
@@ -0,0 +1,41 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_grid_search.h' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_ECL_GRID_SEARCH_H
+#define ERT_ECL_GRID_SEARCH_H
+
+#include <ert/ecl/ecl_grid.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+  typedef struct ecl_grid_search_struct ecl_grid_search_type;
+
+
+  ecl_grid_search_type * ecl_grid_search_alloc( const ecl_grid_type * grid );
+  int                    ecl_grid_search_find( const ecl_grid_search_type * grid_search , double x , double y , double z);
+  void                   ecl_grid_search_find_points( const ecl_grid_search_type * grid_search , int num_points , const double * x , const double * y , const double * z , int * global_index);
+  void                   ecl_grid_search_free( ecl_grid_search_type * grid_search );
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -73,6 +73,10 @@ extern "C" {
   bool           ecl_kw_fread_realloc(ecl_kw_type *, fortio_type *);
   void           ecl_kw_fread(ecl_kw_type * , fortio_type * );
   ecl_kw_type *  ecl_kw_fread_alloc(fortio_type *);
+  bool           ecl_kw_mmap_read_header( ecl_kw_type * ecl_kw , const fortio_type * fortio , offset_type * offset);
+  bool           ecl_kw_mmap_skip_data( const ecl_kw_type * ecl_kw , const fortio_type * fortio , offset_type * offset);
+  bool           ecl_kw_mmap_read_data( ecl_kw_type * ecl_kw , const fortio_type * fortio , offset_type * offset);
+  ecl_kw_type *  ecl_kw_mmap_alloc( const fortio_type * fortio , offset_type offset);
   void           ecl_kw_free_data(ecl_kw_type *);
   void           ecl_kw_fread_indexed_data(fortio_type * fortio, offset_type data_offset, ecl_type_enum ecl_type, int element_count, const int_vector_type* index_map, char* buffer);
   void           ecl_kw_free(ecl_kw_type *);
@@ -189,6 +193,7 @@ extern "C" {
   ECL_KW_SHIFT_TYPED_HEADER( double );
 #undef ECL_KW_SHIFT_TYPED_HEADER
   void ecl_kw_shift_float_or_double( ecl_kw_type * ecl_kw , double shift_value );
+  void ecl_kw_scale_shift_float_or_double( ecl_kw_type * ecl_kw , double scale_factor , double shift_value );
 
 
 #define ECL_KW_IGET_TYPED_HEADER(type) type ecl_kw_iget_ ## type(const ecl_kw_type * , int)
@@ -56,6 +56,7 @@ typedef struct ecl_smspec_struct ecl_smspec_type;
   void                ecl_smspec_fwrite( const ecl_smspec_type * smspec , const char * ecl_case , bool fmt_file );
 
   ecl_smspec_type *        ecl_smspec_fread_alloc(const char *header_file, const char * key_join_string , bool include_restart);
+  ecl_smspec_type *        ecl_smspec_fread_alloc_selected(const char *header_file, const char * key_join_string , bool include_restart , const stringlist_type * key_patterns);
   void                     ecl_smspec_free( ecl_smspec_type *);
 
   int                      ecl_smspec_get_date_day_index( const ecl_smspec_type * smspec );
@@ -133,6 +134,8 @@ typedef struct ecl_smspec_struct ecl_smspec_type;
 
   const int                * ecl_smspec_get_grid_dims( const ecl_smspec_type * smspec );
   int                        ecl_smspec_get_params_size( const ecl_smspec_type * smspec );
+  const int_vector_type    * ecl_smspec_get_params_map( const ecl_smspec_type * smspec );
+  int                        ecl_smspec_get_file_params_size( const ecl_smspec_type * smspec );
   int                        ecl_smspec_num_nodes( const ecl_smspec_type * smspec);
   const   smspec_node_type * ecl_smspec_iget_node( const ecl_smspec_type * smspec , int index );
   void                       ecl_smspec_lock( ecl_smspec_type * smspec );
@@ -80,6 +80,8 @@ typedef struct ecl_sum_struct       ecl_sum_type;
   const char *     ecl_sum_iget_keyword( const ecl_sum_type * sum , int param_index );
   int              ecl_sum_get_data_length( const ecl_sum_type * ecl_sum );
   void             ecl_sum_scale_vector( ecl_sum_type * ecl_sum, int index, double scalar );
+  void             ecl_sum_set_column_store( ecl_sum_type * ecl_sum , bool column_store );
+  bool             ecl_sum_has_column_store( const ecl_sum_type * ecl_sum );
   void             ecl_sum_shift_vector( ecl_sum_type * ecl_sum, int index, double addend );
   double           ecl_sum_iget_from_sim_time( const ecl_sum_type * ecl_sum , time_t sim_time , int param_index);
   double           ecl_sum_iget_from_sim_days( const ecl_sum_type * ecl_sum , double sim_days , int param_index );
@@ -94,7 +96,10 @@ typedef struct ecl_sum_struct       ecl_sum_type;
   ecl_sum_type   * ecl_sum_fread_alloc(const char * , const stringlist_type * data_files, const char * key_join_string);
   ecl_sum_type   * ecl_sum_fread_alloc_case(const char *  , const char * key_join_string);
   ecl_sum_type   * ecl_sum_fread_alloc_case__(const char *  , const char * key_join_string , bool include_restart);
+  ecl_sum_type   * ecl_sum_fread_alloc_selected(const char * header_file , const stringlist_type * data_files , const char * key_join_string , const stringlist_type * key_patterns);
+  ecl_sum_type   * ecl_sum_fread_alloc_case_selected(const char * input_file , const char * key_join_string , const stringlist_type * key_patterns);
   bool             ecl_sum_case_exists( const char * input_file );
+  int              ecl_sum_refresh( ecl_sum_type * ecl_sum );
 
   /* Accessor functions : */
   double            ecl_sum_get_well_var(const ecl_sum_type * ecl_sum , int time_index , const char * well , const char *var);
@@ -39,6 +39,7 @@ typedef struct ecl_sum_data_struct ecl_sum_data_type ;
   void                     ecl_sum_data_fwrite_step( const ecl_sum_data_type * data , const char * ecl_case , bool fmt_case , bool unified, int report_step);
   void                     ecl_sum_data_fwrite( const ecl_sum_data_type * data , const char * ecl_case , bool fmt_case , bool unified);
   bool                     ecl_sum_data_fread( ecl_sum_data_type * data , const stringlist_type * filelist);
+  int                      ecl_sum_data_refresh( ecl_sum_data_type * data , const stringlist_type * filelist);
   void                     ecl_sum_data_fread_restart( ecl_sum_data_type * data , const stringlist_type * filelist);
   ecl_sum_data_type      * ecl_sum_data_alloc_writer( ecl_smspec_type * smspec );
   ecl_sum_data_type      * ecl_sum_data_alloc( ecl_smspec_type * smspec);
@@ -89,6 +90,9 @@ typedef struct ecl_sum_data_struct ecl_sum_data_type ;
   bool                     ecl_sum_data_report_step_equal( const ecl_sum_data_type * data1 , const ecl_sum_data_type * data2);
   bool                     ecl_sum_data_report_step_compatible( const ecl_sum_data_type * data1 , const ecl_sum_data_type * data2);
   void                     ecl_sum_data_fwrite_interp_csv_line(const ecl_sum_data_type * data , time_t sim_time, const ecl_sum_vector_type * keylist, FILE *fp);
+  void                     ecl_sum_data_get_interp_vector( const ecl_sum_data_type * data , time_t sim_time , const ecl_sum_vector_type * keylist , double_vector_type * values);
+  void                     ecl_sum_data_set_column_store( ecl_sum_data_type * data , bool column_store );
+  bool                     ecl_sum_data_has_column_store( const ecl_sum_data_type * data );
 
   double_vector_type * ecl_sum_data_alloc_seconds_solution( const ecl_sum_data_type * data , const smspec_node_type * node , double value, bool rates_clamp_lower);
 
@@ -24,6 +24,7 @@ extern "C" {
 #endif
 
 #include <ert/util/type_macros.h>
+#include <ert/util/double_vector.h>
 
 #include <ert/ecl/ecl_sum.h>
 
@@ -39,6 +40,8 @@ typedef struct ecl_sum_vector_struct ecl_sum_vector_type;
   int ecl_sum_vector_iget_param_index(const ecl_sum_vector_type * ecl_sum_vector, int index);
   int ecl_sum_vector_get_size(const ecl_sum_vector_type * ecl_sum_vector);
 
+  void ecl_sum_get_interp_vector( const ecl_sum_type * ecl_sum , time_t sim_time , const ecl_sum_vector_type * keylist , double_vector_type * values);
+
   UTIL_IS_INSTANCE_HEADER( ecl_sum_vector);
 
 
@@ -80,6 +80,11 @@ typedef struct fortio_struct fortio_type;
   bool               fortio_assert_stream_open( fortio_type * fortio );
   bool               fortio_read_at_eof( fortio_type * fortio );
 
+  bool               fortio_mmap( fortio_type * fortio );
+  const char  *      fortio_mmap_data( const fortio_type * fortio );
+  offset_type        fortio_mmap_size( const fortio_type * fortio );
+  bool               fortio_endian_flip_header( const fortio_type * fortio );
+
 UTIL_IS_INSTANCE_HEADER( fortio );
 UTIL_SAFE_CAST_HEADER( fortio );
 
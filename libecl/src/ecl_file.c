@@ -830,8 +830,203 @@ static file_map_type * ecl_file_get_blockmap( ecl_file_type * ecl_file , const c
    map.
 */
 
+/*****************************************************************/
+/*
+  The keyword index created by ecl_file_scan() can optionally be
+  stored in a small companion file, and loaded from there the next
+  time the same file is opened with the ECL_FILE_INDEX flag. For the
+  file 'path/CASE.UNRST' the index is stored in the hidden file
+  'path/.CASE.UNRST.index'.
+
+  The index file starts with a small header containing the size and
+  modification time of the data file; if these do not match the
+  current data file the index is considered stale, the file is
+  scanned and the index is rewritten. All failures to read or write
+  the index file are silently ignored, in the worst case the file is
+  scanned as if the ECL_FILE_INDEX flag was not set.
+*/
+
+#define ECL_FILE_INDEX_ID      71067
+#define ECL_FILE_INDEX_VERSION 1
+
+
+static char * ecl_file_alloc_index_filename( const char * filename ) {
+  char * path = util_split_alloc_dirname( filename );
+  char * name = util_split_alloc_filename( filename );
+  char * hidden_name = util_alloc_sprintf( ".%s" , name );
+  char * index_file = util_alloc_filename( path , hidden_name , "index" );
+
+  util_safe_free( path );
+  free( name );
+  free( hidden_name );
+  return index_file;
+}
+
+
+static bool ecl_file_fread_index( ecl_file_type * ecl_file , const char * filename , FILE * stream ) {
+  int id , version , num_kw;
+  size_t file_size;
+  time_t mtime;
+
+  if (fread( &id , sizeof id , 1 , stream ) != 1 || id != ECL_FILE_INDEX_ID)
+    return false;
+
+  if (fread( &version , sizeof version , 1 , stream ) != 1 || version != ECL_FILE_INDEX_VERSION)
+    return false;
+
+  if (fread( &file_size , sizeof file_size , 1 , stream ) != 1 || file_size != util_file_size( filename ))
+    return false;
+
+  if (fread( &mtime , sizeof mtime , 1 , stream ) != 1 || mtime != util_file_mtime( filename ))
+    return false;
+
+  if (fread( &num_kw , sizeof num_kw , 1 , stream ) != 1 || num_kw < 0)
+    return false;
+
+  {
+    vector_type * kw_list = vector_alloc_new();
+    bool index_ok = true;
+    int ikw;
+
+    for (ikw = 0; ikw < num_kw; ikw++) {
+      ecl_file_kw_type * file_kw = ecl_file_kw_fread_alloc( stream );
+      if (file_kw == NULL) {
+        index_ok = false;
+        break;
+      }
+      vector_append_ref( kw_list , file_kw );
+    }
+
+    if (index_ok && (fgetc( stream ) != EOF))
+      index_ok = false;
+
+    for (ikw = 0; ikw < vector_get_size( kw_list ); ikw++) {
+      ecl_file_kw_type * file_kw = vector_iget( kw_list , ikw );
+      if (index_ok)
+        file_map_add_kw( ecl_file->global_map , file_kw );
+      else
+        ecl_file_kw_free( file_kw );
+    }
+    vector_free( kw_list );
+
+    if (index_ok)
+      file_map_make_index( ecl_file->global_map );
+
+    return index_ok;
+  }
+}
+
+
+static bool ecl_file_load_index( ecl_file_type * ecl_file , const char * filename , const char * index_file ) {
+  bool index_ok = false;
+  if (util_file_exists( index_file )) {
+    FILE * stream = util_fopen__( index_file , "r");
+    if (stream != NULL) {
+      index_ok = ecl_file_fread_index( ecl_file , filename , stream );
+      fclose( stream );
+    }
+  }
+  return index_ok;
+}
+
+
+/*
+  The index is written to a temporary file which is renamed in place,
+  so concurrent readers of the same file will never see a partially
+  written index. If the data file has been modified during the
+  current second the index is not written, because a subsequent
+  modification in the same second would not be detected.
+*/
+
+static void ecl_file_save_index( const ecl_file_type * ecl_file , const char * filename , const char * index_file ) {
+  time_t mtime = util_file_mtime( filename );
+  if (mtime >= time( NULL ))
+    return;
+
+  {
+    char * path = util_split_alloc_dirname( index_file );
+    char * name = util_split_alloc_filename( index_file );
+    char * tmp_file = util_alloc_tmp_file( path ? path : "." , name , true );
+    FILE * stream = util_fopen__( tmp_file , "w");
+
+    if (stream != NULL) {
+      const file_map_type * global_map = ecl_file->global_map;
+      int id = ECL_FILE_INDEX_ID;
+      int version = ECL_FILE_INDEX_VERSION;
+      int num_kw = vector_get_size( global_map->kw_list );
+      size_t file_size = util_file_size( filename );
+      bool write_ok = true;
+      int ikw;
+
+      fwrite( &id , sizeof id , 1 , stream );
+      fwrite( &version , sizeof version , 1 , stream );
+      fwrite( &file_size , sizeof file_size , 1 , stream );
+      fwrite( &mtime , sizeof mtime , 1 , stream );
+      fwrite( &num_kw , sizeof num_kw , 1 , stream );
+      for (ikw = 0; (ikw < num_kw) && write_ok; ikw++)
+        write_ok = ecl_file_kw_fwrite( vector_iget_const( global_map->kw_list , ikw ) , stream );
+
+      write_ok = write_ok && (ferror( stream ) == 0);
+      write_ok = (fclose( stream ) == 0) && write_ok;
+
+      if (!write_ok || (rename( tmp_file , index_file ) != 0))
+        remove( tmp_file );
+    }
+
+    util_safe_free( path );
+    free( name );
+    free( tmp_file );
+  }
+}
+
+
+
+/*
+   Scan variant used when the file has been memory mapped; the headers
+   are parsed directly from the mapping and the data sections are
+   skipped without being touched.
+*/
+
+static bool ecl_file_mmap_scan( ecl_file_type * ecl_file ) {
+  bool scan_ok = false;
+  offset_type map_size = fortio_mmap_size( ecl_file->fortio );
+  offset_type current_offset = 0;
+  {
+    ecl_kw_type * work_kw = ecl_kw_alloc_new("WORK-KW" , 0 , ECL_INT_TYPE , NULL);
+
+    while (true) {
+      if (current_offset == map_size) {
+        scan_ok = true;
+        break;
+      }
+
+      {
+        offset_type kw_offset = current_offset;
+        if (ecl_kw_mmap_read_header( work_kw , ecl_file->fortio , &current_offset)) {
+          if (ecl_kw_mmap_skip_data( work_kw , ecl_file->fortio , &current_offset)) {
+            ecl_file_kw_type * file_kw = ecl_file_kw_alloc( work_kw , kw_offset);
+            file_map_add_kw( ecl_file->global_map , file_kw );
+          } else
+            break;
+        } else
+          break;
+      }
+    }
+
+    ecl_kw_free( work_kw );
+  }
+  if (scan_ok)
+    file_map_make_index( ecl_file->global_map );
+
+  return scan_ok;
+}
+
+
 static bool ecl_file_scan( ecl_file_type * ecl_file ) {
   bool scan_ok = false;
+  if (fortio_mmap_data( ecl_file->fortio ) != NULL)
+    return ecl_file_mmap_scan( ecl_file );
+
   fortio_fseek( ecl_file->fortio , 0 , SEEK_SET );
   {
     ecl_kw_type * work_kw = ecl_kw_alloc_new("WORK-KW" , 0 , ECL_INT_TYPE , NULL);
@@ -864,6 +1059,29 @@ static bool ecl_file_scan( ecl_file_type * ecl_file ) {
 }
 
 
+/*
+   Will build the global_map, either from the index file or by
+   scanning the file.
+*/
+
+static bool ecl_file_open_index( ecl_file_type * ecl_file , const char * filename ) {
+  if (FILE_FLAGS_SET( ecl_file->flags , ECL_FILE_INDEX)) {
+    char * index_file = ecl_file_alloc_index_filename( filename );
+    bool scan_ok = ecl_file_load_index( ecl_file , filename , index_file );
+
+    if (!scan_ok) {
+      scan_ok = ecl_file_scan( ecl_file );
+      if (scan_ok)
+        ecl_file_save_index( ecl_file , filename , index_file );
+    }
+
+    free( index_file );
+    return scan_ok;
+  } else
+    return ecl_file_scan( ecl_file );
+}
+
+
 void ecl_file_select_global( ecl_file_type * ecl_file ) {
   ecl_file->active_map = ecl_file->global_map;
 }
@@ -898,8 +1116,11 @@ ecl_file_type * ecl_file_open( const char * filename , int flags) {
     ecl_file->fortio = fortio;
     ecl_file->global_map = file_map_alloc( ecl_file->fortio , &ecl_file->flags , ecl_file->inv_map , true );
 
+    if (FILE_FLAGS_SET( flags , ECL_FILE_MMAP) && !FILE_FLAGS_SET( flags , ECL_FILE_WRITABLE))
+      fortio_mmap( ecl_file->fortio );
+
     ecl_file_add_map( ecl_file , ecl_file->global_map );
-    if (ecl_file_scan( ecl_file )) {
+    if (ecl_file_open_index( ecl_file , filename )) {
       ecl_file_select_global( ecl_file );
 
       if (FILE_FLAGS_SET( ecl_file->flags , ECL_FILE_CLOSE_STREAM))
@@ -20,6 +20,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include <ert/util/size_t_vector.h>
 #include <ert/util/util.h>
@@ -221,8 +222,12 @@ static void ecl_file_kw_load_kw( ecl_file_kw_type * file_kw , fortio_type * fort
     ecl_file_kw_drop_kw( file_kw , inv_map );
 
   {
-    fortio_fseek( fortio , file_kw->file_offset , SEEK_SET );
-    file_kw->kw = ecl_kw_fread_alloc( fortio );
+    if (fortio_mmap_data( fortio ) != NULL)
+      file_kw->kw = ecl_kw_mmap_alloc( fortio , file_kw->file_offset );
+    else {
+      fortio_fseek( fortio , file_kw->file_offset , SEEK_SET );
+      file_kw->kw = ecl_kw_fread_alloc( fortio );
+    }
     ecl_file_kw_assert_kw( file_kw );
     inv_map_add_kw( inv_map , file_kw , file_kw->kw );
   }
@@ -302,6 +307,83 @@ bool ecl_file_kw_fskip_data( const ecl_file_kw_type * file_kw , fortio_type * fo
 }
 
 
+/**
+   The ecl_file_kw_fwrite() and ecl_file_kw_fread_alloc() functions
+   store the header information of a file_kw instance as a fixed size
+   binary record; this is used by ecl_file to store the keyword index
+   of a file. The keyword itself is not written. The index is only a
+   cache, so neither of the functions will abort on an I/O error or a
+   corrupt record; the caller should discard the index instead.
+*/
+
+bool ecl_file_kw_fwrite( const ecl_file_kw_type * file_kw , FILE * stream ) {
+  char header[ECL_STRING_LENGTH + 1];
+  sprintf( header , "%-8s" , file_kw->header );
+
+  if (fwrite( header , 1 , ECL_STRING_LENGTH , stream ) != ECL_STRING_LENGTH)
+    return false;
+
+  if (fwrite( ecl_util_get_type_name( file_kw->ecl_type ) , 1 , ECL_TYPE_LENGTH , stream ) != ECL_TYPE_LENGTH)
+    return false;
+
+  if (fwrite( &file_kw->kw_size , sizeof file_kw->kw_size , 1 , stream ) != 1)
+    return false;
+
+  if (fwrite( &file_kw->file_offset , sizeof file_kw->file_offset , 1 , stream ) != 1)
+    return false;
+
+  return (ferror( stream ) == 0);
+}
+
+
+static bool ecl_file_kw_valid_type_name( const char * type_name ) {
+  const ecl_type_enum ecl_types[] = { ECL_CHAR_TYPE , ECL_FLOAT_TYPE , ECL_DOUBLE_TYPE ,
+                                       ECL_INT_TYPE  , ECL_BOOL_TYPE  , ECL_MESS_TYPE };
+  for (int i = 0; i < sizeof ecl_types / sizeof ecl_types[0]; i++) {
+    if (strncmp( type_name , ecl_util_get_type_name( ecl_types[i] ) , ECL_TYPE_LENGTH ) == 0)
+      return true;
+  }
+  return false;
+}
+
+
+/*
+   Returns NULL if a complete and valid record could not be read from
+   the stream.
+*/
+
+ecl_file_kw_type * ecl_file_kw_fread_alloc( FILE * stream ) {
+  char header[ECL_STRING_LENGTH + 1];
+  char ecl_type_str[ECL_TYPE_LENGTH + 1];
+  int kw_size;
+  offset_type file_offset;
+
+  if (fread( header , 1 , ECL_STRING_LENGTH , stream ) != ECL_STRING_LENGTH)
+    return NULL;
+
+  if (fread( ecl_type_str , 1 , ECL_TYPE_LENGTH , stream ) != ECL_TYPE_LENGTH)
+    return NULL;
+
+  if (fread( &kw_size , sizeof kw_size , 1 , stream ) != 1)
+    return NULL;
+
+  if (fread( &file_offset , sizeof file_offset , 1 , stream ) != 1)
+    return NULL;
+
+  header[ECL_STRING_LENGTH]     = '\0';
+  ecl_type_str[ECL_TYPE_LENGTH] = '\0';
+  if (!ecl_file_kw_valid_type_name( ecl_type_str ) || (kw_size < 0) || (file_offset < 0))
+    return NULL;
+
+  {
+    char * stripped_header = util_alloc_strip_copy( header );
+    ecl_file_kw_type * file_kw = ecl_file_kw_alloc__( stripped_header , ecl_util_get_type_from_name( ecl_type_str ) , kw_size , file_offset );
+    free( stripped_header );
+    return file_kw;
+  }
+}
+
+
 /**
    This function will replace the file content of the keyword pointed
    to by @file_kw, with the new content given by @ecl_kw. The new
@@ -21,7 +21,14 @@
 #include <stdbool.h>
 #include <math.h>
 
+#include "ert/util/build_config.h"
+
+#ifdef HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
 #include <ert/util/util.h>
+#include <ert/util/util_kernels.h>
 
 #include <ert/ecl/ecl_kw.h>
 #include <ert/ecl/ecl_file.h>
@@ -99,3 +106,157 @@ double ecl_grav_common_eval_biot_savart( const ecl_grid_cache_type * grid_cache
 }
 
 
+
+/*****************************************************************/
+/*
+  Evaluation of the Biot-Savart sum for many stations at once. The
+  active cells which contribute (i.e. not aquifer cells and inside
+  the region) are first gathered to contiguous position and weight
+  arrays. The stations are then evaluated in blocks of
+  BIOT_SAVART_STATION_BLOCK stations, running over the cells in
+  blocks of BIOT_SAVART_CELL_BLOCK cells so that the cell data for a
+  block stays in the cache while all stations in the station block
+  are evaluated. The station blocks are evaluated in parallel when
+  compiled with OpenMP.
+
+  For the same weights the terms are computed as in
+  ecl_grav_common_eval_biot_savart(), but the summation order is
+  different. In addition the callers may form the weights differently
+  than the single station evaluation; ecl_grav_eval_stations() sums
+  the mass differences of the phases before the Biot-Savart sum,
+  whereas ecl_grav_eval() sums the results of the phases. The results
+  are therefor only equal to the single station functions to within
+  rounding.
+*/
+
+#define BIOT_SAVART_CELL_BLOCK    2048
+#define BIOT_SAVART_STATION_BLOCK 16
+
+typedef double (biot_savart_kernel_ftype) ( const double * xpos , const double * ypos , const double * zpos , const double * weight , int size , double utm_x , double utm_y , double depth);
+
+
+static double ecl_grav_common_biot_savart_kernel_scalar( const double * xpos , const double * ypos , const double * zpos , const double * weight , int size , double utm_x , double utm_y , double depth) {
+  double sum = 0;
+  int index;
+
+  for (index = 0; index < size; index++) {
+    double dist_x  = (xpos[index] - utm_x );
+    double dist_y  = (ypos[index] - utm_y );
+    double dist_z  = (zpos[index] - depth );
+    double dist    = sqrt( dist_x*dist_x + dist_y*dist_y + dist_z*dist_z );
+
+    sum += weight[index] * dist_z/(dist * dist * dist );
+  }
+  return sum;
+}
+
+
+#ifdef HAVE_X86_SIMD
+
+/*
+  Four cells at a time with AVX2; the multiply and add operations are
+  not fused, so that the terms are identical to the scalar kernel.
+*/
+
+__attribute__((target("avx2")))
+static double ecl_grav_common_biot_savart_kernel_avx2( const double * xpos , const double * ypos , const double * zpos , const double * weight , int size , double utm_x , double utm_y , double depth) {
+  const __m256d vutm_x = _mm256_set1_pd( utm_x );
+  const __m256d vutm_y = _mm256_set1_pd( utm_y );
+  const __m256d vdepth = _mm256_set1_pd( depth );
+  __m256d vsum = _mm256_setzero_pd();
+  double partial_sum[4];
+  int index = 0;
+
+  for (; index + 4 <= size; index += 4) {
+    __m256d dist_x = _mm256_sub_pd( _mm256_loadu_pd( &xpos[index] ) , vutm_x );
+    __m256d dist_y = _mm256_sub_pd( _mm256_loadu_pd( &ypos[index] ) , vutm_y );
+    __m256d dist_z = _mm256_sub_pd( _mm256_loadu_pd( &zpos[index] ) , vdepth );
+    __m256d dist2  = _mm256_add_pd( _mm256_add_pd( _mm256_mul_pd( dist_x , dist_x ) ,
+                                                   _mm256_mul_pd( dist_y , dist_y )) ,
+                                    _mm256_mul_pd( dist_z , dist_z ));
+    __m256d dist   = _mm256_sqrt_pd( dist2 );
+    __m256d dist3  = _mm256_mul_pd( _mm256_mul_pd( dist , dist ) , dist );
+
+    vsum = _mm256_add_pd( vsum , _mm256_div_pd( _mm256_mul_pd( _mm256_loadu_pd( &weight[index] ) , dist_z ) , dist3 ));
+  }
+  _mm256_storeu_pd( partial_sum , vsum );
+
+  return (partial_sum[0] + partial_sum[1]) + (partial_sum[2] + partial_sum[3]) +
+    ecl_grav_common_biot_savart_kernel_scalar( &xpos[index] , &ypos[index] , &zpos[index] , &weight[index] , size - index , utm_x , utm_y , depth );
+}
+
+#endif
+
+
+void ecl_grav_common_eval_biot_savart_stations( const ecl_grid_cache_type * grid_cache , ecl_region_type * region , const bool * aquifer , const double * weight ,
+                                                int num_stations , const double * utm_x , const double * utm_y , const double * depth , double * result) {
+  const double * cache_xpos = ecl_grid_cache_get_xpos( grid_cache );
+  const double * cache_ypos = ecl_grid_cache_get_ypos( grid_cache );
+  const double * cache_zpos = ecl_grid_cache_get_zpos( grid_cache );
+  const int * index_list = NULL;
+  int size , num_cells;
+  double * xpos;
+  double * ypos;
+  double * zpos;
+  double * cell_weight;
+  biot_savart_kernel_ftype * kernel = ecl_grav_common_biot_savart_kernel_scalar;
+
+#ifdef HAVE_X86_SIMD
+  if (util_kernel_get_level( ) >= UTIL_KERNEL_AVX2)
+    kernel = ecl_grav_common_biot_savart_kernel_avx2;
+#endif
+
+  if (region == NULL)
+    size = ecl_grid_cache_get_size( grid_cache );
+  else {
+    const int_vector_type * index_vector = ecl_region_get_active_list( region );
+    size = int_vector_size( index_vector );
+    index_list = int_vector_get_const_ptr( index_vector );
+  }
+
+  xpos        = util_calloc( util_int_max( 1 , size ) , sizeof * xpos );
+  ypos        = util_calloc( util_int_max( 1 , size ) , sizeof * ypos );
+  zpos        = util_calloc( util_int_max( 1 , size ) , sizeof * zpos );
+  cell_weight = util_calloc( util_int_max( 1 , size ) , sizeof * cell_weight );
+  {
+    int i;
+    num_cells = 0;
+    for (i = 0; i < size; i++) {
+      int index = (index_list == NULL) ? i : index_list[i];
+      if (!aquifer[index]) {
+        xpos[num_cells]        = cache_xpos[index];
+        ypos[num_cells]        = cache_ypos[index];
+        zpos[num_cells]        = cache_zpos[index];
+        cell_weight[num_cells] = weight[index];
+        num_cells++;
+      }
+    }
+  }
+
+  {
+    const int num_station_blocks = (num_stations + BIOT_SAVART_STATION_BLOCK - 1) / BIOT_SAVART_STATION_BLOCK;
+    int station_block;
+
+#pragma omp parallel for schedule(dynamic)
+    for (station_block = 0; station_block < num_station_blocks; station_block++) {
+      const int station1 = station_block * BIOT_SAVART_STATION_BLOCK;
+      const int station2 = util_int_min( num_stations , station1 + BIOT_SAVART_STATION_BLOCK );
+      int station , cell1;
+
+      for (station = station1; station < station2; station++)
+        result[station] = 0;
+
+      for (cell1 = 0; cell1 < num_cells; cell1 += BIOT_SAVART_CELL_BLOCK) {
+        const int block_size = util_int_min( BIOT_SAVART_CELL_BLOCK , num_cells - cell1 );
+        for (station = station1; station < station2; station++)
+          result[station] += kernel( &xpos[cell1] , &ypos[cell1] , &zpos[cell1] , &cell_weight[cell1] , block_size ,
+                                     utm_x[station] , utm_y[station] , depth[station] );
+      }
+    }
+  }
+
+  free( xpos );
+  free( ypos );
+  free( zpos );
+  free( cell_weight );
+}
@@ -702,18 +702,25 @@ typedef struct ecl_cell_struct           ecl_cell_type;
 #define SET_CELL_FLAG(cell,flag) ((cell->cell_flags |= (flag)))
 #define METER_TO_FEET_SCALE_FACTOR 3.28084
 
-struct ecl_cell_struct {
-  point_type center;
-  point_type corner_list[8];
+/*
+  The cell corners are not stored in the cell struct; for normal grids
+  they are stored in the grid->corners array with eight consecutive
+  points for each cell, and for compact grids they are calculated on
+  demand from the COORD and ZCORN data, see the function
+  ecl_grid_get_cell_corners(). For normal grids the cell center is
+  calculated when first needed and cached in grid->centers, for compact
+  grids it is calculated from the corners every time.
+*/
 
+struct ecl_cell_struct {
   double                 volume;             /* Cache volume - whether it is initialized or not is handled by a cell_flags. */
+  const ecl_grid_type   *lgr;                /* if this cell is part of an lgr; this will point to a grid instance for that lgr; NULL if not part of lgr. */
+  nnc_info_type        * nnc_info;           /* Non-neighbour connection info*/
   int                    active;
   int                    active_index[2];    /* [0]: The active matrix index; [1]: the active fracture index */
-  const ecl_grid_type   *lgr;                /* if this cell is part of an lgr; this will point to a grid instance for that lgr; NULL if not part of lgr. */
   int                    host_cell;          /* the global index of the host cell for an lgr cell, set to -1 for normal cells. */
   int                    coarse_group;       /* The index of the coarse group holding this cell -1 for non-coarsened cells. */
   int                    cell_flags;
-  nnc_info_type        * nnc_info;           /* Non-neighbour connection info*/
 };
 
 
@@ -741,6 +748,10 @@ struct ecl_grid_struct {
   int                 * inv_fracture_index_map; /* For fractures: this is list of total_active elements - which point back to the index_map. */
 
   ecl_cell_type      *  cells;
+  point_type         *  corners;                /* 8 corners for each cell - NULL for compact grids. */
+  point_type         *  centers;                /* Cached cell centers, valid when CELL_FLAG_CENTER is set - NULL for compact grids. */
+  bool                  compact;                /* For compact grids the corners are calculated on demand from the coord_kw and zcorn fields. */
+  float              *  zcorn;                  /* The ZCORN data for compact grids - NULL otherwise. */
 
   char                * parent_name;   /* the name of the parent for a nested lgr - for the main grid, and also a
                                           lgr descending directly from the main grid this will be NULL. */
@@ -782,7 +793,7 @@ struct ecl_grid_struct {
   int                   eclipse_version;
 };
 
-static void ecl_cell_compare(const ecl_cell_type * c1 , const ecl_cell_type * c2,  bool include_nnc , bool * equal) {
+static void ecl_cell_compare(const ecl_cell_type * c1 , const point_type * corner_list1 , const ecl_cell_type * c2, const point_type * corner_list2 , bool include_nnc , bool * equal) {
   int i;
 
   if (c1->active != c2->active)
@@ -803,7 +814,7 @@ static void ecl_cell_compare(const ecl_cell_type * c1 , const ecl_cell_type * c2
 
   if (*equal) {
     for (i=0; i < 8; i++)
-      point_compare( &c1->corner_list[i] , &c2->corner_list[i] , equal );
+      point_compare( &corner_list1[i] , &corner_list2[i] , equal );
 
   }
 
@@ -815,28 +826,29 @@ static void ecl_cell_compare(const ecl_cell_type * c1 , const ecl_cell_type * c2
 }
 
 
-static void ecl_cell_dump( const ecl_cell_type * cell , FILE * stream) {
+static void ecl_cell_dump( const point_type * corner_list , FILE * stream) {
   int i;
   for (i=0; i < 8; i++)
-    point_dump( &cell->corner_list[i] , stream );
+    point_dump( &corner_list[i] , stream );
 }
 
 
-static void ecl_cell_assert_center( ecl_cell_type * cell);
+static void ecl_cell_get_center( const point_type * corner_list , point_type * center);
 
-static void ecl_cell_dump_ascii( ecl_cell_type * cell , int i , int j , int k , FILE * stream , const double * offset) {
+static void ecl_cell_dump_ascii( const ecl_cell_type * cell , const point_type * corner_list , int i , int j , int k , FILE * stream , const double * offset) {
+  point_type center;
   fprintf(stream , "Cell: i:%3d  j:%3d    k:%3d   host_cell:%d  CoarseGroup:%4d active_nr:%6d  active:%d \nCorners:\n",i,j,k,cell->host_cell, cell->coarse_group , cell->active_index[MATRIX_INDEX], cell->active);
 
-  ecl_cell_assert_center( cell );
+  ecl_cell_get_center( corner_list , &center );
   fprintf(stream , "Center   : ");
-  point_dump_ascii( &cell->center , stream , offset);
+  point_dump_ascii( &center , stream , offset);
   fprintf(stream , "\n");
 
   {
     int l;
     for (l=0; l < 8; l++) {
       fprintf(stream , "Corner %d : ",l);
-      point_dump_ascii( &cell->corner_list[l] , stream , offset);
+      point_dump_ascii( &corner_list[l] , stream , offset);
       fprintf(stream , "\n");
     }
   }
@@ -844,6 +856,8 @@ static void ecl_cell_dump_ascii( ecl_cell_type * cell , int i , int j , int k ,
 }
 
 
+static const point_type * ecl_grid_get_cell_corners( const ecl_grid_type * grid , int global_index , point_type * corner_buffer );
+
 static void ecl_cell_fwrite_GRID( const ecl_grid_type * grid , const ecl_cell_type * cell , bool fracture_cell , int coords_size , int i, int j , int k , int global_index , ecl_kw_type * coords_kw , ecl_kw_type * corners_kw, fortio_type * fortio) {
   ecl_kw_iset_int( coords_kw , 0 , i + 1);
   ecl_kw_iset_int( coords_kw , 1 , j + 1);
@@ -867,11 +881,13 @@ static void ecl_cell_fwrite_GRID( const ecl_grid_type * grid , const ecl_cell_ty
   ecl_kw_fwrite( coords_kw , fortio );
   {
     float * corners = ecl_kw_get_void_ptr( corners_kw );
+    point_type corner_buffer[8];
+    const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , corner_buffer );
     point_type point;
     int c;
 
     for (c = 0; c < 8; c++) {
-      point_copy_values( &point , &cell->corner_list[c] );
+      point_copy_values( &point , &corner_list[c] );
       if (grid->use_mapaxes)
         point_mapaxes_invtransform( &point , grid->origo , grid->unit_x , grid->unit_y );
 
@@ -884,7 +900,7 @@ static void ecl_cell_fwrite_GRID( const ecl_grid_type * grid , const ecl_cell_ty
 }
 
 //static const size_t cellMappingECLRi[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
-static void ecl_cell_ri_export( const ecl_cell_type * cell , double * ri_points) {
+static void ecl_cell_ri_export( const point_type * corner_list , double * ri_points) {
   int ecl_offset = 4;
   int ri_offset =  ecl_offset * 3;
   {
@@ -892,14 +908,14 @@ static void ecl_cell_ri_export( const ecl_cell_type * cell , double * ri_points)
     // Handling the points 0,1 & 4,5 which map directly between ECLIPSE and RI
     for (point_nr =0; point_nr < 2; point_nr++) {
       // Points 0 & 1
-      ri_points[ point_nr * 3     ] =  cell->corner_list[point_nr].x;
-      ri_points[ point_nr * 3 + 1 ] =  cell->corner_list[point_nr].y;
-      ri_points[ point_nr * 3 + 2 ] = -cell->corner_list[point_nr].z;
+      ri_points[ point_nr * 3     ] =  corner_list[point_nr].x;
+      ri_points[ point_nr * 3 + 1 ] =  corner_list[point_nr].y;
+      ri_points[ point_nr * 3 + 2 ] = -corner_list[point_nr].z;
 
       // Points 4 & 5
-      ri_points[ ri_offset + point_nr * 3     ] =  cell->corner_list[ecl_offset + point_nr].x;
-      ri_points[ ri_offset + point_nr * 3 + 1 ] =  cell->corner_list[ecl_offset + point_nr].y;
-      ri_points[ ri_offset + point_nr * 3 + 2 ] = -cell->corner_list[ecl_offset + point_nr].z;
+      ri_points[ ri_offset + point_nr * 3     ] =  corner_list[ecl_offset + point_nr].x;
+      ri_points[ ri_offset + point_nr * 3 + 1 ] =  corner_list[ecl_offset + point_nr].y;
+      ri_points[ ri_offset + point_nr * 3 + 2 ] = -corner_list[ecl_offset + point_nr].z;
     }
   }
 
@@ -912,15 +928,15 @@ static void ecl_cell_ri_export( const ecl_cell_type * cell , double * ri_points)
     for (ecl_point =2; ecl_point < 4; ecl_point++) {
       int ri_point = 5 - ecl_point;
       // Points 2 & 3
-      ri_points[ ri_point * 3     ] =  cell->corner_list[ecl_point].x;
-      ri_points[ ri_point * 3 + 1 ] =  cell->corner_list[ecl_point].y;
-      ri_points[ ri_point * 3 + 2 ] = -cell->corner_list[ecl_point].z;
+      ri_points[ ri_point * 3     ] =  corner_list[ecl_point].x;
+      ri_points[ ri_point * 3 + 1 ] =  corner_list[ecl_point].y;
+      ri_points[ ri_point * 3 + 2 ] = -corner_list[ecl_point].z;
 
 
       // Points 6 & 7
-      ri_points[ ri_offset + ri_point * 3     ] =  cell->corner_list[ecl_offset + ecl_point].x;
-      ri_points[ ri_offset + ri_point * 3 + 1 ] =  cell->corner_list[ecl_offset + ecl_point].y;
-      ri_points[ ri_offset + ri_point * 3 + 2 ] = -cell->corner_list[ecl_offset + ecl_point].z;
+      ri_points[ ri_offset + ri_point * 3     ] =  corner_list[ecl_offset + ecl_point].x;
+      ri_points[ ri_offset + ri_point * 3 + 1 ] =  corner_list[ecl_offset + ecl_point].y;
+      ri_points[ ri_offset + ri_point * 3 + 2 ] = -corner_list[ecl_offset + ecl_point].z;
     }
   }
 }
@@ -955,12 +971,12 @@ static  double min8( double x1 , double x2 , double x3, double x4 , double x5 ,
 
 /*****************************************************************/
 
-static double ecl_cell_min_z( const ecl_cell_type * cell) {
-  return min4( cell->corner_list[0].z , cell->corner_list[1].z , cell->corner_list[2].z , cell->corner_list[3].z);
+static double ecl_cell_min_z( const point_type * corner_list) {
+  return min4( corner_list[0].z , corner_list[1].z , corner_list[2].z , corner_list[3].z);
 }
 
-static double ecl_cell_max_z( const ecl_cell_type * cell ) {
-  return max4( cell->corner_list[4].z , cell->corner_list[5].z , cell->corner_list[6].z , cell->corner_list[7].z );
+static double ecl_cell_max_z( const point_type * corner_list ) {
+  return max4( corner_list[4].z , corner_list[5].z , corner_list[6].z , corner_list[7].z );
 }
 
 
@@ -969,26 +985,26 @@ static double ecl_cell_max_z( const ecl_cell_type * cell ) {
    plane for the x/y min/max.
 */
 
-static double ecl_cell_min_x( const ecl_cell_type * cell) {
-  return min8( cell->corner_list[0].x , cell->corner_list[1].x , cell->corner_list[2].x , cell->corner_list[3].x,
-               cell->corner_list[4].x , cell->corner_list[5].x , cell->corner_list[6].x , cell->corner_list[7].x );
+static double ecl_cell_min_x( const point_type * corner_list) {
+  return min8( corner_list[0].x , corner_list[1].x , corner_list[2].x , corner_list[3].x,
+               corner_list[4].x , corner_list[5].x , corner_list[6].x , corner_list[7].x );
 }
 
 
-static double ecl_cell_max_x( const ecl_cell_type * cell ) {
-  return max8( cell->corner_list[0].x , cell->corner_list[1].x , cell->corner_list[2].x , cell->corner_list[3].x,
-               cell->corner_list[4].x , cell->corner_list[5].x , cell->corner_list[6].x , cell->corner_list[7].x );
+static double ecl_cell_max_x( const point_type * corner_list ) {
+  return max8( corner_list[0].x , corner_list[1].x , corner_list[2].x , corner_list[3].x,
+               corner_list[4].x , corner_list[5].x , corner_list[6].x , corner_list[7].x );
 }
 
-static double ecl_cell_min_y( const ecl_cell_type * cell) {
-  return min8( cell->corner_list[0].y , cell->corner_list[1].y , cell->corner_list[2].y , cell->corner_list[3].y,
-               cell->corner_list[4].y , cell->corner_list[5].y , cell->corner_list[6].y , cell->corner_list[7].y );
+static double ecl_cell_min_y( const point_type * corner_list) {
+  return min8( corner_list[0].y , corner_list[1].y , corner_list[2].y , corner_list[3].y,
+               corner_list[4].y , corner_list[5].y , corner_list[6].y , corner_list[7].y );
 }
 
 
-static double ecl_cell_max_y( const ecl_cell_type * cell ) {
-  return max8( cell->corner_list[0].y , cell->corner_list[1].y , cell->corner_list[2].y , cell->corner_list[3].y,
-               cell->corner_list[4].y , cell->corner_list[5].y , cell->corner_list[6].y , cell->corner_list[7].y );
+static double ecl_cell_max_y( const point_type * corner_list ) {
+  return max8( corner_list[0].y , corner_list[1].y , corner_list[2].y , corner_list[3].y,
+               corner_list[4].y , corner_list[5].y , corner_list[6].y , corner_list[7].y );
 }
 
 
@@ -1028,10 +1044,10 @@ static double ecl_cell_max_y( const ecl_cell_type * cell ) {
  */
 
 
-static void ecl_cell_taint_cell( ecl_cell_type * cell ) {
+static void ecl_cell_taint_cell( ecl_cell_type * cell , const point_type * corner_list ) {
   int c;
   for (c = 0; c < 8; c++) {
-    const point_type p = cell->corner_list[c];
+    const point_type p = corner_list[c];
     if ((p.x == 0) && (p.y == 0)) {
       SET_CELL_FLAG(cell , CELL_FLAG_TAINTED);
       break;
@@ -1043,10 +1059,10 @@ static void ecl_cell_taint_cell( ecl_cell_type * cell ) {
   */
   if (cell->active == CELL_NOT_ACTIVE) {
     if (!GET_CELL_FLAG(cell , CELL_FLAG_TAINTED)) {
-      const point_type p0 = cell->corner_list[0];
+      const point_type p0 = corner_list[0];
       int cell_index = 1;
       while (true) {
-        const point_type pi = cell->corner_list[cell_index];
+        const point_type pi = corner_list[cell_index];
         if (pi.z != p0.z)
           // There is a difference - the cell is certainly valid.
           break;
@@ -1099,22 +1115,14 @@ static int ecl_cell_get_tetrahedron_method( int i , int j , int k) {
 #undef mod
 */
 
-static void ecl_cell_set_center( ecl_cell_type * cell) {
-  point_set(&cell->center , 0 , 0 , 0);
+static void ecl_cell_get_center( const point_type * corner_list , point_type * center) {
+  point_set(center , 0 , 0 , 0);
   {
     int c;
     for (c = 0; c < 8; c++)
-      point_inplace_add(&cell->center , &cell->corner_list[c]);
+      point_inplace_add(center , &corner_list[c]);
   }
-  point_inplace_scale(&cell->center , 1.0 / 8.0);
-
-  SET_CELL_FLAG( cell , CELL_FLAG_CENTER );
-}
-
-
-static void ecl_cell_assert_center( ecl_cell_type * cell) {
-  if (!GET_CELL_FLAG(cell , CELL_FLAG_CENTER))
-    ecl_cell_set_center( cell );
+  point_inplace_scale(center , 1.0 / 8.0);
 }
 
 
@@ -1156,7 +1164,7 @@ static double C(double *r,int f1,int f2,int f3){
 }
 
 
-static double ecl_cell_get_volume_tskille( ecl_cell_type * cell ) {
+static double ecl_cell_get_volume_tskille( const point_type * corner_list ) {
   double volume = 0;
   int pb,pg,qa,qg,ra,rb;
   double X[8];
@@ -1165,9 +1173,9 @@ static double ecl_cell_get_volume_tskille( ecl_cell_type * cell ) {
   {
     int c;
     for (c = 0; c < 8; c++) {
-      X[c] = cell->corner_list[c].x;
-      Y[c] = cell->corner_list[c].y;
-      Z[c] = cell->corner_list[c].z;
+      X[c] = corner_list[c].x;
+      Y[c] = corner_list[c].y;
+      Z[c] = corner_list[c].z;
     }
   }
 
@@ -1234,19 +1242,19 @@ static inline double tetrahedron_volume6( tetrahedron_type tet ) {
  * when used in opm-parser and has been optimised significantly. This means
  * inlining several operations, e.g. vector operations, and other tricks.
  */
-static double ecl_cell_get_signed_volume( ecl_cell_type * cell) {
+static double ecl_cell_get_signed_volume( ecl_cell_type * cell , const point_type * corner_list) {
   if (GET_CELL_FLAG(cell , CELL_FLAG_VOLUME))
     return cell->volume;
 
-  ecl_cell_assert_center( cell );
   {
     /*
      * We make an activation record local copy of the cell's corners for less
      * jumping in memory and better cache performance.
      */
-    point_type center = cell->center;
+    point_type center;
     point_type corners[ 8 ];
-    memcpy( corners, cell->corner_list, sizeof( point_type ) * 8 );
+    ecl_cell_get_center( corner_list , &center );
+    memcpy( corners, corner_list, sizeof( point_type ) * 8 );
 
     tetrahedron_type tet = { .p0 = center };
     double           volume = 0;
@@ -1297,8 +1305,8 @@ static double ecl_cell_get_signed_volume( ecl_cell_type * cell) {
 }
 
 
-static double ecl_cell_get_volume( ecl_cell_type * cell ) {
-  return fabs( ecl_cell_get_signed_volume(cell));
+static double ecl_cell_get_volume( ecl_cell_type * cell , const point_type * corner_list ) {
+  return fabs( ecl_cell_get_signed_volume(cell , corner_list));
 }
 
 
@@ -1353,7 +1361,7 @@ static bool triangle_contains(const point_type *p0 , const point_type * p1 , con
 */
 
 
-static bool ecl_cell_layer_contains_xy( const ecl_cell_type * cell , bool lower_layer , double x , double y) {
+static bool ecl_cell_layer_contains_xy( const ecl_cell_type * cell , const point_type * corner_list , bool lower_layer , double x , double y) {
   if (GET_CELL_FLAG(cell,CELL_FLAG_TAINTED))
     return false;
   {
@@ -1365,10 +1373,10 @@ static bool ecl_cell_layer_contains_xy( const ecl_cell_type * cell , bool lower_
       else
         corner_offset = 4;
 
-      p0 = &cell->corner_list[corner_offset + 0];
-      p1 = &cell->corner_list[corner_offset + 1];
-      p2 = &cell->corner_list[corner_offset + 2];
-      p3 = &cell->corner_list[corner_offset + 3];
+      p0 = &corner_list[corner_offset + 0];
+      p1 = &corner_list[corner_offset + 1];
+      p2 = &corner_list[corner_offset + 2];
+      p3 = &corner_list[corner_offset + 3];
     }
 
     if (triangle_contains(p0,p1,p2,x,y))
@@ -1387,23 +1395,23 @@ static bool ecl_cell_layer_contains_xy( const ecl_cell_type * cell , bool lower_
          |   |           |   |
          0---1           4---5
 */
-static void ecl_cell_init_regular( ecl_cell_type * cell , const double * offset , int i , int j , int k , int global_index , const double * ivec , const double * jvec , const double * kvec , const int * actnum ) {
-  point_set(&cell->corner_list[0] , offset[0] , offset[1] , offset[2] ); // Point 0
+static void ecl_cell_init_regular( ecl_cell_type * cell , point_type * corner_list , const double * offset , int i , int j , int k , int global_index , const double * ivec , const double * jvec , const double * kvec , const int * actnum ) {
+  point_set(&corner_list[0] , offset[0] , offset[1] , offset[2] ); // Point 0
 
-  cell->corner_list[1] = cell->corner_list[0];                       // Point 1
-  point_shift(&cell->corner_list[1] , ivec[0] , ivec[1] , ivec[2]);
+  corner_list[1] = corner_list[0];                       // Point 1
+  point_shift(&corner_list[1] , ivec[0] , ivec[1] , ivec[2]);
 
-  cell->corner_list[2] = cell->corner_list[0];                       // Point 2
-  point_shift(&cell->corner_list[2] , jvec[0] , jvec[1] , jvec[2]);
+  corner_list[2] = corner_list[0];                       // Point 2
+  point_shift(&corner_list[2] , jvec[0] , jvec[1] , jvec[2]);
 
-  cell->corner_list[3] = cell->corner_list[1];                       // Point 3
-  point_shift(&cell->corner_list[3] , jvec[0] , jvec[1] , jvec[2]);
+  corner_list[3] = corner_list[1];                       // Point 3
+  point_shift(&corner_list[3] , jvec[0] , jvec[1] , jvec[2]);
 
   {
     int i;
     for (i=0; i < 4; i++) {
-      cell->corner_list[i+4] = cell->corner_list[i];                      // Point 4-7
-      point_shift(&cell->corner_list[i+4] , kvec[0] , kvec[1] , kvec[2]);
+      corner_list[i+4] = corner_list[i];                      // Point 4-7
+      point_shift(&corner_list[i+4] , kvec[0] , kvec[1] , kvec[2]);
     }
   }
 
@@ -1431,6 +1439,143 @@ static ecl_cell_type * ecl_grid_get_cell(const ecl_grid_type * grid , int global
 }
 
 
+/*
+  Writable access to the stored corners of a cell; can only be used
+  while constructing a grid which is not compact.
+*/
+
+static point_type * ecl_grid_get_cell_corners_ref(const ecl_grid_type * grid , int global_index) {
+  return &grid->corners[8 * (size_t) global_index];
+}
+
+
+static void ecl_grid_pillar_cross_planes(const point_type * p0,
+                                         double e_x , double e_y , double e_z ,
+                                         const double *z , double *x , double *y) {
+  int k;
+  if (e_z != 0) {
+    for (k=0; k < 2; k++) {
+      double t = (z[k] -  p0->z) / e_z;
+      x[k] = p0->x + t * e_x;
+      y[k] = p0->y + t * e_y;
+    }
+  } else {
+    for (k=0; k < 2; k++) {
+      x[k] = p0->x;
+      y[k] = p0->y;
+    }
+  }
+}
+
+
+/*
+  Calculates the eight corners of cell (i,j,k) from the COORD and
+  ZCORN data; the mapaxes transformation of the grid is applied. This
+  is used both when loading a normal grid and when the corners of a
+  compact grid are calculated on demand, so the two give exactly the
+  same corner coordinates.
+*/
+
+static void ecl_grid_calc_cell_corners( const ecl_grid_type * ecl_grid , const float * zcorn , const float * coord , int i , int j , int k , point_type * corner_list) {
+  const int nx = ecl_grid->nx;
+  const int ny = ecl_grid->ny;
+  point_type pillars[4][2];
+  double x[4][2];
+  double y[4][2];
+  double z[4][2];
+
+  {
+    int pillar_index[4];
+    int ip;
+    pillar_index[0] = 6 * ( j      * (nx + 1) + i    );
+    pillar_index[1] = 6 * ( j      * (nx + 1) + i + 1);
+    pillar_index[2] = 6 * ((j + 1) * (nx + 1) + i    );
+    pillar_index[3] = 6 * ((j + 1) * (nx + 1) + i + 1);
+
+    for (ip = 0; ip < 4; ip++) {
+      size_t index = pillar_index[ip];
+      point_set(&pillars[ip][0] , coord[index] , coord[index + 1] , coord[index + 2]);
+
+      index += 3;
+      point_set(&pillars[ip][1] , coord[index] , coord[index + 1] , coord[index + 2]);
+    }
+  }
+
+  {
+    size_t zcorn_offset = (size_t) k*8*nx*ny + j*4*nx + 2*i;
+    size_t layer_size   = (size_t) 4*nx*ny;
+    int c;
+    for (c = 0; c < 2; c++) {
+      z[0][c] = zcorn[zcorn_offset                + c*layer_size];
+      z[1][c] = zcorn[zcorn_offset +  1           + c*layer_size];
+      z[2][c] = zcorn[zcorn_offset + 2*nx         + c*layer_size];
+      z[3][c] = zcorn[zcorn_offset + 2*nx + 1     + c*layer_size];
+    }
+  }
+
+  {
+    int ip;
+    for (ip = 0; ip <  4; ip++) {
+      double ex = pillars[ip][1].x - pillars[ip][0].x;
+      double ey = pillars[ip][1].y - pillars[ip][0].y;
+      double ez = pillars[ip][1].z - pillars[ip][0].z;
+      ecl_grid_pillar_cross_planes(&pillars[ip][0] , ex, ey , ez , z[ip] , x[ip] , y[ip]);
+    }
+  }
+
+  {
+    int ip , iz;
+    for (iz = 0; iz < 2; iz++) {
+      for (ip = 0; ip < 4; ip++) {
+        int c = ip + iz * 4;
+        point_set(&corner_list[c] , x[ip][iz] , y[ip][iz] , z[ip][iz]);
+
+        if (ecl_grid->use_mapaxes)
+          point_mapaxes_transform( &corner_list[c] , ecl_grid->origo , ecl_grid->unit_x , ecl_grid->unit_y );
+      }
+    }
+  }
+}
+
+
+/*
+  Returns a pointer to the eight corners of the cell. For normal grids
+  this is a pointer into the stored corners, for compact grids the
+  corners are calculated into the caller supplied corner_buffer, which
+  must have room for eight points. The returned pointer is only valid
+  as long as the corner_buffer is in scope.
+*/
+
+static const point_type * ecl_grid_get_cell_corners( const ecl_grid_type * grid , int global_index , point_type * corner_buffer ) {
+  if (grid->compact) {
+    int i = global_index % grid->nx;
+    int j = (global_index / grid->nx) % grid->ny;
+    int k = global_index / (grid->nx * grid->ny);
+    ecl_grid_calc_cell_corners( grid , grid->zcorn , ecl_kw_get_float_ptr( grid->coord_kw ) , i , j , k , corner_buffer );
+    return corner_buffer;
+  } else
+    return &grid->corners[8 * (size_t) global_index];
+}
+
+
+static void ecl_grid_get_cell_center( const ecl_grid_type * grid , int global_index , point_type * center ) {
+  if (grid->compact) {
+    point_type corner_buffer[8];
+    ecl_cell_get_center( ecl_grid_get_cell_corners( grid , global_index , corner_buffer ) , center );
+  } else {
+    ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
+    point_type * cached_center = &grid->centers[ global_index ];
+
+    if (!GET_CELL_FLAG( cell , CELL_FLAG_CENTER )) {
+      ecl_cell_get_center( &grid->corners[8 * (size_t) global_index] , cached_center );
+      SET_CELL_FLAG( cell , CELL_FLAG_CENTER );
+    }
+    *center = *cached_center;
+  }
+}
+
+
+
 /**
    this function uses heuristics (ahhh - i hate it) in an attempt to
    mark cells with fucked geometry - see further comments in the
@@ -1441,7 +1586,8 @@ static void ecl_grid_taint_cells( ecl_grid_type * ecl_grid ) {
   int index;
   for (index = 0; index < ecl_grid->size; index++) {
     ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , index );
-    ecl_cell_taint_cell( cell );
+    point_type corner_buffer[8];
+    ecl_cell_taint_cell( cell , ecl_grid_get_cell_corners( ecl_grid , index , corner_buffer ));
   }
 }
 
@@ -1456,9 +1602,17 @@ static void ecl_grid_free_cells( ecl_grid_type * grid ) {
       nnc_info_free(cell->nnc_info);
   }
   free( grid->cells );
-
+  free( grid->corners );
+  free( grid->centers );
+  free( grid->zcorn );
 }
 
+
+/*
+  For compact grids only the cell structs are allocated here, the
+  ZCORN data is installed when the grid geometry is initialized.
+*/
+
 static bool ecl_grid_alloc_cells( ecl_grid_type * grid , bool init_valid) {
   grid->cells = malloc(grid->size * sizeof * grid->cells );
   if (!grid->cells)
@@ -1474,8 +1628,15 @@ static bool ecl_grid_alloc_cells( ecl_grid_type * grid , bool init_valid) {
         ecl_cell_memcpy( target_cell , cell0 );
       }
     }
-    return true;
   }
+
+  if (!grid->compact) {
+    grid->corners = calloc( 8 * (size_t) grid->size , sizeof * grid->corners );
+    grid->centers = malloc( (size_t) grid->size * sizeof * grid->centers );
+    if (!grid->corners || !grid->centers)
+      return false;
+  }
+  return true;
 }
 
 /**
@@ -1486,7 +1647,7 @@ static bool ecl_grid_alloc_cells( ecl_grid_type * grid , bool init_valid) {
    is performed.
 */
 
-static ecl_grid_type * ecl_grid_alloc_empty(ecl_grid_type * global_grid , int dualp_flag , int nx , int ny , int nz, int lgr_nr, bool init_valid) {
+static ecl_grid_type * ecl_grid_alloc_empty(ecl_grid_type * global_grid , int dualp_flag , int nx , int ny , int nz, int lgr_nr, bool init_valid, bool compact) {
   ecl_grid_type * grid = util_malloc(sizeof * grid );
   UTIL_TYPE_ID_INIT(grid , ECL_GRID_ID);
   grid->total_active   = 0;
@@ -1497,6 +1658,11 @@ static ecl_grid_type * ecl_grid_alloc_empty(ecl_grid_type * global_grid , int du
   grid->size                  = nx*ny*nz;
   grid->lgr_nr                = lgr_nr;
   grid->global_grid           = global_grid;
+  grid->cells                 = NULL;
+  grid->corners               = NULL;
+  grid->centers               = NULL;
+  grid->compact               = compact;
+  grid->zcorn                 = NULL;
   grid->coarsening_active     = false;
   grid->mapaxes               = NULL;
 
@@ -1569,25 +1735,14 @@ static  int ecl_grid_get_global_index__(const ecl_grid_type * ecl_grid , int i ,
 
 
 static void ecl_grid_set_cell_EGRID(ecl_grid_type * ecl_grid , int i, int j , int k ,
-                                    double x[4][2] , double y[4][2] , double z[4][2] ,
+                                    const float * zcorn , const float * coord ,
                                     const int * actnum, const int * corsnum) {
 
   const int global_index   = ecl_grid_get_global_index__(ecl_grid , i , j  , k );
   ecl_cell_type * cell     = ecl_grid_get_cell( ecl_grid , global_index );
-  int ip , iz;
-
-  for (iz = 0; iz < 2; iz++) {
-    for (ip = 0; ip < 4; ip++) {
-      int c = ip + iz * 4;
-      point_set(&cell->corner_list[c] , x[ip][iz] , y[ip][iz] , z[ip][iz]);
-
-      if (ecl_grid->use_mapaxes)
-        point_mapaxes_transform( &cell->corner_list[c] , ecl_grid->origo , ecl_grid->unit_x , ecl_grid->unit_y );
-    }
-  }
-
-
 
+  if (!ecl_grid->compact)
+    ecl_grid_calc_cell_corners( ecl_grid , zcorn , coord , i , j , k , ecl_grid_get_cell_corners_ref( ecl_grid , global_index ));
 
   /*
     If actnum == NULL that is taken to mean active.
@@ -1685,11 +1840,12 @@ static void ecl_grid_set_cell_GRID(ecl_grid_type * ecl_grid , int coords_size ,
     }
 
     if (matrix_cell) {
+      point_type * corner_list = ecl_grid_get_cell_corners_ref( ecl_grid , global_index );
       for (c = 0; c < 8; c++) {
-        point_set(&cell->corner_list[c] , corners[3*c] , corners[3*c + 1] , corners[3*c + 2]);
+        point_set(&corner_list[c] , corners[3*c] , corners[3*c + 1] , corners[3*c + 2]);
 
         if (ecl_grid->use_mapaxes)
-          point_mapaxes_transform( &cell->corner_list[c] , ecl_grid->origo , ecl_grid->unit_x , ecl_grid->unit_y );
+          point_mapaxes_transform( &corner_list[c] , ecl_grid->origo , ecl_grid->unit_x , ecl_grid->unit_y );
 
       }
     }
@@ -1953,25 +2109,6 @@ bool ecl_grid_cell_in_coarse_group3( const ecl_grid_type * main_grid , int i , i
 
 /*****************************************************************/
 
-static void ecl_grid_pillar_cross_planes(const point_type * p0,
-                                         double e_x , double e_y , double e_z ,
-                                         const double *z , double *x , double *y) {
-  int k;
-  if (e_z != 0) {
-    for (k=0; k < 2; k++) {
-      double t = (z[k] -  p0->z) / e_z;
-      x[k] = p0->x + t * e_x;
-      y[k] = p0->y + t * e_y;
-    }
-  } else {
-    for (k=0; k < 2; k++) {
-      x[k] = p0->x;
-      y[k] = p0->y;
-    }
-  }
-}
-
-
 /**
    This function must be run before the cell coordinates are
    calculated.  This function is only called for the main grid
@@ -2176,71 +2313,12 @@ int ecl_grid_zcorn_index(const ecl_grid_type * grid , int i, int j , int k , int
 
 static void ecl_grid_init_GRDECL_data_jslice(ecl_grid_type * ecl_grid ,  const float * zcorn , const float * coord , const int * actnum, const int * corsnum , int j) {
   const int nx = ecl_grid->nx;
-  const int ny = ecl_grid->ny;
   const int nz = ecl_grid->nz;
-  int i;
-
-
-  for (i=0; i < nx; i++) {
-    point_type pillars[4][2];
-    int pillar_index[4];
-    pillar_index[0] = 6 * ( j      * (nx + 1) + i    );
-    pillar_index[1] = 6 * ( j      * (nx + 1) + i + 1);
-    pillar_index[2] = 6 * ((j + 1) * (nx + 1) + i    );
-    pillar_index[3] = 6 * ((j + 1) * (nx + 1) + i + 1);
-
-    {
-      int ip;
-      for (ip = 0; ip < 4; ip++) {
-        int index = pillar_index[ip];
-        point_set(&pillars[ip][0] , coord[index] , coord[index + 1] , coord[index + 2]);
-
-        index += 3;
-        point_set(&pillars[ip][1] , coord[index] , coord[index + 1] , coord[index + 2]);
-      }
-    }
-
-    {
-      double ex[4];
-      double ey[4];
-      double ez[4];
-      int k;
-
-      {
-        int ip;
-        for (ip = 0; ip <  4; ip++) {
-          ex[ip] = pillars[ip][1].x - pillars[ip][0].x;
-          ey[ip] = pillars[ip][1].y - pillars[ip][0].y;
-          ez[ip] = pillars[ip][1].z - pillars[ip][0].z;
-        }
-      }
-
+  int i , k;
 
-      for (k=0; k < nz; k++) {
-        double x[4][2];
-        double y[4][2];
-        double z[4][2];
-
-        {
-          int c;
-          for (c = 0; c < 2; c++) {
-            z[0][c] = zcorn[k*8*nx*ny + j*4*nx + 2*i            + c*4*nx*ny];
-            z[1][c] = zcorn[k*8*nx*ny + j*4*nx + 2*i  +  1      + c*4*nx*ny];
-            z[2][c] = zcorn[k*8*nx*ny + j*4*nx + 2*nx + 2*i     + c*4*nx*ny];
-            z[3][c] = zcorn[k*8*nx*ny + j*4*nx + 2*nx + 2*i + 1 + c*4*nx*ny];
-          }
-        }
-
-        {
-          int ip;
-          for (ip = 0; ip <  4; ip++)
-            ecl_grid_pillar_cross_planes(&pillars[ip][0] , ex[ip], ey[ip] , ez[ip] , z[ip] , x[ip] , y[ip]);
-        }
-
-        ecl_grid_set_cell_EGRID(ecl_grid , i , j , k , x , y , z , actnum , corsnum);
-      }
-    }
-  }
+  for (i=0; i < nx; i++)
+    for (k=0; k < nz; k++)
+      ecl_grid_set_cell_EGRID(ecl_grid , i , j , k , zcorn , coord , actnum , corsnum);
 }
 
 
@@ -2263,9 +2341,9 @@ void ecl_grid_init_GRDECL_data(ecl_grid_type * ecl_grid ,  const float * zcorn ,
 static ecl_grid_type * ecl_grid_alloc_GRDECL_data__(ecl_grid_type * global_grid ,
                                                     int dualp_flag , bool apply_mapaxes, int nx , int ny , int nz ,
                                                     const float * zcorn , const float * coord , const int * actnum, const float * mapaxes, const int * corsnum,
-                                                    int lgr_nr) {
+                                                    int lgr_nr, bool compact) {
 
-  ecl_grid_type * ecl_grid = ecl_grid_alloc_empty(global_grid , dualp_flag , nx,ny,nz,lgr_nr,true);
+  ecl_grid_type * ecl_grid = ecl_grid_alloc_empty(global_grid , dualp_flag , nx,ny,nz,lgr_nr,true,compact);
   if (ecl_grid) {
     if (mapaxes != NULL)
       ecl_grid_init_mapaxes( ecl_grid , apply_mapaxes, mapaxes );
@@ -2274,6 +2352,8 @@ static ecl_grid_type * ecl_grid_alloc_GRDECL_data__(ecl_grid_type * global_grid
       ecl_grid->coarsening_active = true;
 
     ecl_grid->coord_kw = ecl_kw_alloc_new("COORD" , 6*(nx + 1) * (ny + 1) , ECL_FLOAT_TYPE , coord );
+    if (compact)
+      ecl_grid->zcorn = util_alloc_copy( zcorn , 8 * (size_t) ecl_grid->size * sizeof * zcorn );
     ecl_grid_init_GRDECL_data( ecl_grid , zcorn , coord , actnum , corsnum);
 
     ecl_grid_init_coarse_cells( ecl_grid );
@@ -2309,6 +2389,15 @@ static void ecl_grid_copy_content( ecl_grid_type * target_grid , const ecl_grid_
     if (src_cell->nnc_info)
       target_cell->nnc_info = nnc_info_alloc_copy( src_cell->nnc_info );
   }
+
+  if (src_grid->compact) {
+    target_grid->zcorn = util_alloc_copy( src_grid->zcorn , 8 * (size_t) src_grid->size * sizeof * src_grid->zcorn );
+    target_grid->coord_kw = ecl_kw_alloc_copy( src_grid->coord_kw );
+  } else {
+    memcpy( target_grid->corners , src_grid->corners , 8 * (size_t) src_grid->size * sizeof * src_grid->corners );
+    memcpy( target_grid->centers , src_grid->centers , (size_t) src_grid->size * sizeof * src_grid->centers );
+  }
+
   ecl_grid_copy_mapaxes( target_grid , src_grid );
 
   target_grid->parent_name = util_alloc_string_copy( src_grid->parent_name );
@@ -2325,7 +2414,8 @@ static ecl_grid_type * ecl_grid_alloc_copy__( const ecl_grid_type * src_grid,  e
                                                     ecl_grid_get_ny( src_grid ) ,
                                                     ecl_grid_get_nz( src_grid ) ,
                                                     0 ,
-                                                    false );
+                                                    false ,
+                                                    src_grid->compact );
   if (copy_grid) {
     ecl_grid_copy_content( copy_grid , src_grid );  // This will handle everything except LGR relationships which is established in the calling routine
     ecl_grid_update_index( copy_grid );
@@ -2417,7 +2507,7 @@ ecl_grid_type * ecl_grid_alloc_processed_copy( const ecl_grid_type * src_grid ,
 */
 
 ecl_grid_type * ecl_grid_alloc_GRDECL_data(int nx , int ny , int nz , const float * zcorn , const float * coord , const int * actnum, bool apply_mapaxes , const float * mapaxes) {
-  return ecl_grid_alloc_GRDECL_data__(NULL , FILEHEAD_SINGLE_POROSITY , apply_mapaxes , nx , ny , nz , zcorn , coord , actnum , mapaxes , NULL , 0);
+  return ecl_grid_alloc_GRDECL_data__(NULL , FILEHEAD_SINGLE_POROSITY , apply_mapaxes , nx , ny , nz , zcorn , coord , actnum , mapaxes , NULL , 0 , false);
 }
 
 
@@ -2446,7 +2536,8 @@ static ecl_grid_type * ecl_grid_alloc_GRDECL_kw__(ecl_grid_type * global_grid ,
                                                   const ecl_kw_type * coord_kw ,
                                                   const ecl_kw_type * actnum_kw ,    /* Can be NULL */
                                                   const ecl_kw_type * mapaxes_kw ,   /* Can be NULL */
-                                                  const ecl_kw_type * corsnum_kw) {   /* Can be NULL */
+                                                  const ecl_kw_type * corsnum_kw,    /* Can be NULL */
+                                                  bool compact) {
    int gtype, nx,ny,nz, lgr_nr;
 
   gtype   = ecl_kw_iget_int(gridhead_kw , GRIDHEAD_TYPE_INDEX);
@@ -2490,7 +2581,8 @@ static ecl_grid_type * ecl_grid_alloc_GRDECL_kw__(ecl_grid_type * global_grid ,
                                         actnum_data,
                                         mapaxes_data,
                                         corsnum_data,
-                                        lgr_nr);
+                                        lgr_nr,
+                                        compact);
   }
 }
 
@@ -2510,7 +2602,7 @@ ecl_grid_type * ecl_grid_alloc_GRDECL_kw( int nx, int ny , int nz ,
 
   bool apply_mapaxes = true;
   ecl_kw_type * gridhead_kw = ecl_grid_alloc_gridhead_kw( nx , ny , nz , 0);
-  ecl_grid_type * ecl_grid = ecl_grid_alloc_GRDECL_kw__(NULL , FILEHEAD_SINGLE_POROSITY , apply_mapaxes , gridhead_kw , zcorn_kw , coord_kw , actnum_kw , mapaxes_kw , NULL);
+  ecl_grid_type * ecl_grid = ecl_grid_alloc_GRDECL_kw__(NULL , FILEHEAD_SINGLE_POROSITY , apply_mapaxes , gridhead_kw , zcorn_kw , coord_kw , actnum_kw , mapaxes_kw , NULL , false);
   ecl_kw_free( gridhead_kw );
   return ecl_grid;
 
@@ -2728,7 +2820,7 @@ static void ecl_grid_init_nnc_amalgamated(ecl_grid_type * main_grid, ecl_file_ty
 */
 
 
-static ecl_grid_type * ecl_grid_alloc_EGRID__( ecl_grid_type * main_grid , const ecl_file_type * ecl_file , int grid_nr, bool apply_mapaxes) {
+static ecl_grid_type * ecl_grid_alloc_EGRID__( ecl_grid_type * main_grid , const ecl_file_type * ecl_file , int grid_nr, bool apply_mapaxes, bool compact) {
   ecl_kw_type * gridhead_kw  = ecl_file_iget_named_kw( ecl_file , GRIDHEAD_KW  , grid_nr);
   ecl_kw_type * zcorn_kw     = ecl_file_iget_named_kw( ecl_file , ZCORN_KW     , grid_nr);
   ecl_kw_type * coord_kw     = ecl_file_iget_named_kw( ecl_file , COORD_KW     , grid_nr);
@@ -2771,7 +2863,8 @@ static ecl_grid_type * ecl_grid_alloc_EGRID__( ecl_grid_type * main_grid , const
                                                            coord_kw ,
                                                            actnum_kw ,
                                                            mapaxes_kw ,
-                                                           corsnum_kw );
+                                                           corsnum_kw ,
+                                                           compact );
 
     if (ECL_GRID_MAINGRID_LGR_NR != grid_nr) ecl_grid_set_lgr_name_EGRID(ecl_grid , ecl_file , grid_nr);
     ecl_grid->eclipse_version = eclipse_version;
@@ -2781,7 +2874,7 @@ static ecl_grid_type * ecl_grid_alloc_EGRID__( ecl_grid_type * main_grid , const
 
 
 
-ecl_grid_type * ecl_grid_alloc_EGRID(const char * grid_file, bool apply_mapaxes) {
+static ecl_grid_type * ecl_grid_alloc_EGRID_file__(const char * grid_file, bool apply_mapaxes, bool compact) {
   ecl_file_enum   file_type;
   file_type = ecl_util_get_file_type(grid_file , NULL , NULL);
   if (file_type != ECL_EGRID_FILE)
@@ -2790,11 +2883,11 @@ ecl_grid_type * ecl_grid_alloc_EGRID(const char * grid_file, bool apply_mapaxes)
     ecl_file_type * ecl_file   = ecl_file_open( grid_file , 0);
     if (ecl_file) {
       int num_grid               = ecl_file_get_num_named_kw( ecl_file , GRIDHEAD_KW );
-      ecl_grid_type * main_grid  = ecl_grid_alloc_EGRID__( NULL , ecl_file , 0 , apply_mapaxes);
+      ecl_grid_type * main_grid  = ecl_grid_alloc_EGRID__( NULL , ecl_file , 0 , apply_mapaxes , compact);
       int grid_nr;
 
       for ( grid_nr = 1; grid_nr < num_grid; grid_nr++) {
-        ecl_grid_type * lgr_grid = ecl_grid_alloc_EGRID__( main_grid , ecl_file , grid_nr , false);  /* The apply_mapaxes argument is ignored for LGR - it inherits from parent anyway. */
+        ecl_grid_type * lgr_grid = ecl_grid_alloc_EGRID__( main_grid , ecl_file , grid_nr , false , compact);  /* The apply_mapaxes argument is ignored for LGR - it inherits from parent anyway. */
         ecl_grid_add_lgr( main_grid , lgr_grid );
         {
           ecl_grid_type * host_grid;
@@ -2819,6 +2912,31 @@ ecl_grid_type * ecl_grid_alloc_EGRID(const char * grid_file, bool apply_mapaxes)
 }
 
 
+ecl_grid_type * ecl_grid_alloc_EGRID(const char * grid_file, bool apply_mapaxes) {
+  return ecl_grid_alloc_EGRID_file__( grid_file , apply_mapaxes , false );
+}
+
+
+/**
+   Will load the EGRID file as a compact grid. For a compact grid the
+   cell corners are not stored; instead the COORD and ZCORN keywords
+   are retained in their original float representation and the
+   corners are calculated on demand. This reduces the memory usage
+   from roughly 250 bytes per cell to roughly 80 bytes per cell, at
+   the cost of slower access to cell geometry; all the ecl_grid_get_*
+   functions work as for a normal grid.
+*/
+
+ecl_grid_type * ecl_grid_alloc_EGRID_compact(const char * grid_file, bool apply_mapaxes) {
+  return ecl_grid_alloc_EGRID_file__( grid_file , apply_mapaxes , true );
+}
+
+
+bool ecl_grid_is_compact( const ecl_grid_type * grid ) {
+  return grid->compact;
+}
+
+
 
 
 
@@ -2826,7 +2944,7 @@ static ecl_grid_type * ecl_grid_alloc_GRID_data__(ecl_grid_type * global_grid ,
   if (dualp_flag != FILEHEAD_SINGLE_POROSITY)
     nz = nz / 2;
   {
-    ecl_grid_type * grid = ecl_grid_alloc_empty( global_grid , dualp_flag , nx , ny , nz , grid_nr, false);
+    ecl_grid_type * grid = ecl_grid_alloc_empty( global_grid , dualp_flag , nx , ny , nz , grid_nr, false, false);
     if (grid) {
       if (mapaxes != NULL)
         ecl_grid_init_mapaxes( grid , apply_mapaxes , mapaxes);
@@ -3065,7 +3183,7 @@ ecl_grid_type * ecl_grid_alloc_GRID(const char * grid_file, bool apply_mapaxes)
    which case all cells will be active.
 */
 ecl_grid_type * ecl_grid_alloc_regular( int nx, int ny , int nz , const double * ivec, const double * jvec , const double * kvec , const int * actnum) {
-  ecl_grid_type * grid = ecl_grid_alloc_empty(NULL , FILEHEAD_SINGLE_POROSITY , nx , ny , nz , 0, true);
+  ecl_grid_type * grid = ecl_grid_alloc_empty(NULL , FILEHEAD_SINGLE_POROSITY , nx , ny , nz , 0, true, false);
   if (grid) {
     const double grid_offset[3] = {0,0,0};
 
@@ -3081,7 +3199,7 @@ ecl_grid_type * ecl_grid_alloc_regular( int nx, int ny , int nz , const double *
           };
 
           ecl_cell_type * cell = ecl_grid_get_cell(grid , global_index );
-          ecl_cell_init_regular( cell , offset , i,j,k,global_index , ivec , jvec , kvec , actnum );
+          ecl_cell_init_regular( cell , ecl_grid_get_cell_corners_ref( grid , global_index ) , offset , i,j,k,global_index , ivec , jvec , kvec , actnum );
         }
       }
     }
@@ -3125,7 +3243,7 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv( int nx, int ny , int nz , const doub
     ecl_grid_type* grid = ecl_grid_alloc_empty(NULL,
                                                FILEHEAD_SINGLE_POROSITY,
                                                nx, ny, nz,
-                                               /*lgr_nr=*/0, /*init_valid=*/true);
+                                               /*lgr_nr=*/0, /*init_valid=*/true, /*compact=*/false);
     if (grid) {
       double ivec[3] = { 0, 0, 0 };
       double jvec[3] = { 0, 0, 0 };
@@ -3146,7 +3264,7 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv( int nx, int ny , int nz , const doub
             ecl_cell_type* cell = ecl_grid_get_cell(grid, global_index);
             ivec[0] = dxv[i];
 
-            ecl_cell_init_regular(cell, offset,
+            ecl_cell_init_regular(cell, ecl_grid_get_cell_corners_ref(grid, global_index), offset,
                                   i,j,k,global_index,
                                   ivec,jvec,kvec,
                                   actnum);
@@ -3168,7 +3286,7 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv_depthz( int nx, int ny , int nz , con
     ecl_grid_type* grid = ecl_grid_alloc_empty(NULL,
                                                FILEHEAD_SINGLE_POROSITY,
                                                nx, ny, nz,
-                                               /*lgr_nr=*/0, /*init_valid=*/true);
+                                               /*lgr_nr=*/0, /*init_valid=*/true, /*compact=*/false);
 
 
     /* First layer - where the DEPTHZ keyword applies. */
@@ -3180,22 +3298,22 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv_depthz( int nx, int ny , int nz , con
         double x0 = 0;
         for (i = 0; i < nx; i++) {
           int global_index = i + j*nx + k*nx*ny;
-          ecl_cell_type* cell = ecl_grid_get_cell(grid, global_index);
+          point_type * corner_list = ecl_grid_get_cell_corners_ref(grid, global_index);
           double z0 = depthz[ i     + j*(nx + 1)];
           double z1 = depthz[ i + 1 + j*(nx + 1)];
           double z2 = depthz[ i +     (j + 1)*(nx + 1)];
           double z3 = depthz[ i + 1 + (j + 1)*(nx + 1)];
 
 
-          point_set(&cell->corner_list[0] , x0 , y0 , z0);
-          point_set(&cell->corner_list[1] , x0 + dxv[i] , y0 , z1);
-          point_set(&cell->corner_list[2] , x0          , y0 + dyv[j] , z2);
-          point_set(&cell->corner_list[3] , x0 + dxv[i] , y0 + dyv[j] , z3);
+          point_set(&corner_list[0] , x0 , y0 , z0);
+          point_set(&corner_list[1] , x0 + dxv[i] , y0 , z1);
+          point_set(&corner_list[2] , x0          , y0 + dyv[j] , z2);
+          point_set(&corner_list[3] , x0 + dxv[i] , y0 + dyv[j] , z3);
           {
             int c;
             for (c = 0; c < 4; c++) {
-              cell->corner_list[c + 4] = cell->corner_list[c];
-              point_shift(&cell->corner_list[c + 4] , 0 , 0 , dzv[0]);
+              corner_list[c + 4] = corner_list[c];
+              point_shift(&corner_list[c + 4] , 0 , 0 , dzv[0]);
             }
           }
           x0 += dxv[i];
@@ -3212,14 +3330,14 @@ ecl_grid_type * ecl_grid_alloc_dxv_dyv_dzv_depthz( int nx, int ny , int nz , con
           for (i=0; i < nx; i++) {
             int g2 = i + j*nx + k*nx*ny;
             int g1 = i + j*nx + (k - 1)*nx*ny;
-            ecl_cell_type* cell2 = ecl_grid_get_cell(grid, g2);
-            ecl_cell_type* cell1 = ecl_grid_get_cell(grid, g1);
+            point_type * corner_list2 = ecl_grid_get_cell_corners_ref(grid, g2);
+            const point_type * corner_list1 = ecl_grid_get_cell_corners_ref(grid, g1);
             int c;
 
             for (c = 0; c < 4; c++) {
-              cell2->corner_list[c] = cell1->corner_list[c + 4];
-              cell2->corner_list[c + 4] = cell1->corner_list[c + 4];
-              point_shift( &cell2->corner_list[c + 4] , 0 , 0 , dzv[k]);
+              corner_list2[c] = corner_list1[c + 4];
+              corner_list2[c + 4] = corner_list1[c + 4];
+              point_shift( &corner_list2[c + 4] , 0 , 0 , dzv[k]);
             }
           }
         }
@@ -3272,7 +3390,7 @@ ecl_grid_type * ecl_grid_alloc_dx_dy_dz_tops( int nx, int ny , int nz , const do
   ecl_grid_type* grid = ecl_grid_alloc_empty(NULL,
                                              FILEHEAD_SINGLE_POROSITY,
                                              nx, ny, nz,
-                                             0, true);
+                                             0, true, false);
   if (grid) {
     int i, j, k;
     double * y0 = util_calloc( nx, sizeof * y0 );
@@ -3286,17 +3404,18 @@ ecl_grid_type * ecl_grid_alloc_dx_dy_dz_tops( int nx, int ny , int nz , const do
         for (i=0; i < nx; i++) {
           int g = i + j*nx + k*nx*ny;
           ecl_cell_type* cell = ecl_grid_get_cell(grid, g);
+          point_type * corner_list = ecl_grid_get_cell_corners_ref(grid, g);
           double z0 = tops[ g ];
 
-          point_set(&cell->corner_list[0] , x0         , y0[i]         , z0);
-          point_set(&cell->corner_list[1] , x0 + dx[g] , y0[i]         , z0);
-          point_set(&cell->corner_list[2] , x0         , y0[i] + dy[g] , z0);
-          point_set(&cell->corner_list[3] , x0 + dx[g] , y0[i] + dy[g] , z0);
+          point_set(&corner_list[0] , x0         , y0[i]         , z0);
+          point_set(&corner_list[1] , x0 + dx[g] , y0[i]         , z0);
+          point_set(&corner_list[2] , x0         , y0[i] + dy[g] , z0);
+          point_set(&corner_list[3] , x0 + dx[g] , y0[i] + dy[g] , z0);
 
-          point_set(&cell->corner_list[4] , x0         , y0[i]         , z0 + dz[g]);
-          point_set(&cell->corner_list[5] , x0 + dx[g] , y0[i]         , z0 + dz[g]);
-          point_set(&cell->corner_list[6] , x0         , y0[i] + dy[g] , z0 + dz[g]);
-          point_set(&cell->corner_list[7] , x0 + dx[g] , y0[i] + dy[g] , z0 + dz[g]);
+          point_set(&corner_list[4] , x0         , y0[i]         , z0 + dz[g]);
+          point_set(&corner_list[5] , x0 + dx[g] , y0[i]         , z0 + dz[g]);
+          point_set(&corner_list[6] , x0         , y0[i] + dy[g] , z0 + dz[g]);
+          point_set(&corner_list[7] , x0 + dx[g] , y0[i] + dy[g] , z0 + dz[g]);
 
           x0    += dx[g];
           y0[i] += dy[g];
@@ -3591,18 +3710,22 @@ static bool ecl_grid_compare_cells(const ecl_grid_type * g1 , const ecl_grid_typ
     bool this_equal = true;
     ecl_cell_type *c1 = ecl_grid_get_cell( g1 , g );
     ecl_cell_type *c2 = ecl_grid_get_cell( g2 , g );
-    ecl_cell_compare(c1 , c2 ,  include_nnc , &this_equal);
+    point_type corner_buffer1[8];
+    point_type corner_buffer2[8];
+    const point_type * corner_list1 = ecl_grid_get_cell_corners( g1 , g , corner_buffer1 );
+    const point_type * corner_list2 = ecl_grid_get_cell_corners( g2 , g , corner_buffer2 );
+    ecl_cell_compare(c1 , corner_list1 , c2 , corner_list2 , include_nnc , &this_equal);
 
     if (!this_equal) {
       if (verbose) {
         int i,j,k;
         ecl_grid_get_ijk1( g1 , g , &i , &j , &k);
 
-        printf("Difference in cell: %d : %d,%d,%d  nnc_equal:%d Volume:%g \n",g,i,j,k , nnc_info_equal( c1->nnc_info , c2->nnc_info) , ecl_cell_get_volume( c1 ));
+        printf("Difference in cell: %d : %d,%d,%d  nnc_equal:%d Volume:%g \n",g,i,j,k , nnc_info_equal( c1->nnc_info , c2->nnc_info) , ecl_cell_get_volume( c1 , corner_list1 ));
         printf("-----------------------------------------------------------------\n");
-        ecl_cell_dump_ascii( c1 , i , j , k , stdout , NULL);
+        ecl_cell_dump_ascii( c1 , corner_list1 , i , j , k , stdout , NULL);
         printf("-----------------------------------------------------------------\n");
-        ecl_cell_dump_ascii( c2 , i , j , k , stdout , NULL );
+        ecl_cell_dump_ascii( c2 , corner_list2 , i , j , k , stdout , NULL );
         printf("-----------------------------------------------------------------\n");
 
       }
@@ -3755,6 +3878,8 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
   const double min_volume = 1e-9;
   point_type p;
   ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
+  point_type corner_buffer[8];
+  const point_type * corner_list;
 
   point_set( &p , x , y , z);
   /*
@@ -3768,50 +3893,51 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
   if (GET_CELL_FLAG(cell , CELL_FLAG_TAINTED))
     return false;
 
-  if (p.z < ecl_cell_min_z( cell ))
+  corner_list = ecl_grid_get_cell_corners( ecl_grid , global_index , corner_buffer );
+
+  if (p.z < ecl_cell_min_z( corner_list ))
     return false;
 
-  if (p.z > ecl_cell_max_z( cell ))
+  if (p.z > ecl_cell_max_z( corner_list ))
     return false;
 
-  if (p.x < ecl_cell_min_x( cell ))
+  if (p.x < ecl_cell_min_x( corner_list ))
     return false;
 
-  if (p.x > ecl_cell_max_x( cell ))
+  if (p.x > ecl_cell_max_x( corner_list ))
     return false;
 
-  if (p.y < ecl_cell_min_y( cell ))
+  if (p.y < ecl_cell_min_y( corner_list ))
     return false;
 
-  if (p.y > ecl_cell_max_y( cell ))
+  if (p.y > ecl_cell_max_y( corner_list ))
     return false;
 
   {
     int i,j,k;
     ecl_grid_get_ijk1( ecl_grid , global_index , &i , &j , &k);
-    ecl_cell_assert_center( cell );
 
     /*
       Special case checks for the corner points.
     */
-    if (point_equal( &p , &cell->corner_list[0]))
+    if (point_equal( &p , &corner_list[0]))
       return true;
 
-    if (point_equal( &p , &cell->corner_list[1] )) {
+    if (point_equal( &p , &corner_list[1] )) {
       if (i == (ecl_grid->nx - 1))
         return true;
       else
         return false;
     }
 
-    if (point_equal( &p , &cell->corner_list[2])) {
+    if (point_equal( &p , &corner_list[2])) {
       if (j == (ecl_grid->ny - 1))
         return true;
       else
         return false;
     }
 
-    if (point_equal( &p , &cell->corner_list[3])) {
+    if (point_equal( &p , &corner_list[3])) {
       if ((j == (ecl_grid->ny - 1)) &&
           (i == (ecl_grid->nx - 1)))
         return true;
@@ -3819,14 +3945,14 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
         return false;
     }
 
-    if (point_equal( &p , &cell->corner_list[4])) {
+    if (point_equal( &p , &corner_list[4])) {
       if (k == (ecl_grid->nz - 1))
         return true;
       else
         return false;
     }
 
-    if (point_equal( &p , &cell->corner_list[5] )) {
+    if (point_equal( &p , &corner_list[5] )) {
       if ((i == (ecl_grid->nx - 1)) &&
           (k == (ecl_grid->nz - 1)))
         return true;
@@ -3834,7 +3960,7 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
         return false;
     }
 
-    if (point_equal( &p , &cell->corner_list[6] )) {
+    if (point_equal( &p , &corner_list[6] )) {
       if ((j == (ecl_grid->ny - 1)) &&
           (k == (ecl_grid->nz - 1)))
         return true;
@@ -3842,7 +3968,7 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
         return false;
     }
 
-    if (point_equal( &p , &cell->corner_list[7] )) {
+    if (point_equal( &p , &corner_list[7] )) {
       if ((i == (ecl_grid->nx - 1)) &&
           (j == (ecl_grid->ny - 1)) &&
           (k == (ecl_grid->nz - 1)))
@@ -3854,19 +3980,19 @@ bool ecl_grid_cell_contains_xyz1( const ecl_grid_type * ecl_grid , int global_in
     {
       double sign = 1.0;
       int plane_nr = 0;
-      double signed_volume = ecl_cell_get_signed_volume( cell );
+      double signed_volume = ecl_cell_get_signed_volume( cell , corner_list );
       if (fabs(signed_volume) > min_volume) {
-        point_type * p0;
-        point_type * p1;
-        point_type * p2;
+        const point_type * p0;
+        const point_type * p1;
+        const point_type * p2;
 
         if (signed_volume < 0)
           sign = -1;
         {
           while (true) {
-            p0 = &cell->corner_list[ bounding_planes[plane_nr][0] ];
-            p1 = &cell->corner_list[ bounding_planes[plane_nr][1] ];
-            p2 = &cell->corner_list[ bounding_planes[plane_nr][2] ];
+            p0 = &corner_list[ bounding_planes[plane_nr][0] ];
+            p1 = &corner_list[ bounding_planes[plane_nr][1] ];
+            p2 = &corner_list[ bounding_planes[plane_nr][2] ];
 
             if (point_equal(p0, p1) || point_equal(p0,p2) || point_equal(p1,p2))
               return false;
@@ -3902,7 +4028,9 @@ int ecl_grid_get_global_index_from_xy( const ecl_grid_type * ecl_grid , int k ,
   for (j=0; j < ecl_grid->ny; j++)
     for (i=0; i < ecl_grid->nx; i++) {
       int global_index = ecl_grid_get_global_index3( ecl_grid , i , j , k );
-      if (ecl_cell_layer_contains_xy( ecl_grid_get_cell( ecl_grid , global_index ) , lower_layer , x , y))
+      point_type corner_buffer[8];
+      const point_type * corner_list = ecl_grid_get_cell_corners( ecl_grid , global_index , corner_buffer );
+      if (ecl_cell_layer_contains_xy( ecl_grid_get_cell( ecl_grid , global_index ) , corner_list , lower_layer , x , y))
         return global_index;
     }
   return -1; /* Did not find x,y */
@@ -4001,6 +4129,8 @@ static int ecl_grid_get_global_index_from_xyz_around_box(ecl_grid_type * grid ,
         2. Check the neighbours (i +/- 1, j +/- 1, k +/- 1 ).
         3. Give up and do a linear search starting from start_index.
 
+   The function is not thread safe. To locate many points use the
+   prebuilt index in ecl_grid_search.c instead.
 */
 int ecl_grid_get_global_index_from_xyz(ecl_grid_type * grid , double x , double y , double z , int start_index) {
   int global_index;
@@ -4234,15 +4364,15 @@ void ecl_grid_free__( void * arg ) {
 
 
 void ecl_grid_get_distance(const ecl_grid_type * grid , int global_index1, int global_index2 , double *dx , double *dy , double *dz) {
-  ecl_cell_type * cell1 = ecl_grid_get_cell( grid , global_index1);
-  ecl_cell_type * cell2 = ecl_grid_get_cell( grid , global_index2);
+  point_type center1;
+  point_type center2;
 
-  ecl_cell_assert_center( cell1 );
-  ecl_cell_assert_center( cell2 );
+  ecl_grid_get_cell_center( grid , global_index1 , &center1 );
+  ecl_grid_get_cell_center( grid , global_index2 , &center2 );
   {
-    *dx = cell1->center.x - cell2->center.x;
-    *dy = cell1->center.y - cell2->center.y;
-    *dz = cell1->center.z - cell2->center.z;
+    *dx = center1.x - center2.x;
+    *dy = center1.y - center2.y;
+    *dz = center1.z - center2.z;
   }
 }
 
@@ -4449,12 +4579,12 @@ void ecl_grid_get_ijk1A(const ecl_grid_type *ecl_grid , int active_index , int *
 */
 
 void ecl_grid_get_xyz1(const ecl_grid_type * grid , int global_index , double *xpos , double *ypos , double *zpos) {
-  ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
-  ecl_cell_assert_center( cell );
+  point_type center;
+  ecl_grid_get_cell_center( grid , global_index , &center );
   {
-    *xpos = cell->center.x;
-    *ypos = cell->center.y;
-    *zpos = cell->center.z;
+    *xpos = center.x;
+    *ypos = center.y;
+    *zpos = center.z;
   }
 }
 
@@ -4478,8 +4608,9 @@ void ecl_grid_get_xyz3(const ecl_grid_type * grid , int i, int j , int k, double
 
 void ecl_grid_get_cell_corner_xyz1(const ecl_grid_type * grid , int global_index , int corner_nr , double * xpos , double * ypos , double * zpos ) {
   if ((corner_nr >= 0) &&  (corner_nr <= 7)) {
-    const ecl_cell_type * cell  = ecl_grid_get_cell( grid , global_index );
-    const point_type      point = cell->corner_list[ corner_nr ];
+    point_type corner_buffer[8];
+    const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , corner_buffer );
+    const point_type      point = corner_list[ corner_nr ];
     *xpos = point.x;
     *ypos = point.y;
     *zpos = point.z;
@@ -4487,6 +4618,27 @@ void ecl_grid_get_cell_corner_xyz1(const ecl_grid_type * grid , int global_index
 }
 
 
+/**
+   Will fill the xpos, ypos and zpos arrays, which must have room for
+   eight elements each, with the coordinates of all the corners of
+   cell 'global_index'. Prefer this to eight calls to
+   ecl_grid_get_cell_corner_xyz1() for compact grids, where the
+   corners are calculated on each call.
+*/
+
+void ecl_grid_get_cell_corners_xyz1(const ecl_grid_type * grid , int global_index , double * xpos , double * ypos , double * zpos ) {
+  point_type corner_buffer[8];
+  const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , corner_buffer );
+  int c;
+
+  for (c = 0; c < 8; c++) {
+    xpos[c] = corner_list[c].x;
+    ypos[c] = corner_list[c].y;
+    zpos[c] = corner_list[c].z;
+  }
+}
+
+
 void ecl_grid_get_cell_corner_xyz3(const ecl_grid_type * grid , int i , int j , int k, int corner_nr , double * xpos , double * ypos , double * zpos ) {
   const int global_index = ecl_grid_get_global_index__(grid , i , j , k );
   ecl_grid_get_cell_corner_xyz1( grid , global_index , corner_nr , xpos , ypos , zpos);
@@ -4534,9 +4686,9 @@ void ecl_grid_get_xyz1A(const ecl_grid_type * grid , int active_index , double *
 
 
 double ecl_grid_get_cdepth1(const ecl_grid_type * grid , int global_index) {
-  ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
-  ecl_cell_assert_center( cell );
-  return cell->center.z;
+  point_type center;
+  ecl_grid_get_cell_center( grid , global_index , &center );
+  return center.z;
 }
 
 
@@ -4584,12 +4736,13 @@ int ecl_grid_locate_depth( const ecl_grid_type * grid , double depth , int i , i
 */
 
 double ecl_grid_get_top1(const ecl_grid_type * grid , int global_index) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
+  point_type corner_buffer[8];
+  const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , corner_buffer );
   double depth = 0;
   int ij;
 
   for (ij = 0; ij < 4; ij++)
-    depth += cell->corner_list[ij].z;
+    depth += corner_list[ij].z;
 
   return depth * 0.25;
 }
@@ -4626,12 +4779,13 @@ double ecl_grid_get_top1A(const ecl_grid_type * grid , int active_index) {
 */
 
 double ecl_grid_get_bottom1(const ecl_grid_type * grid , int global_index) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
+  point_type corner_buffer[8];
+  const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , corner_buffer );
   double depth = 0;
   int ij;
 
   for (ij = 0; ij < 4; ij++)
-    depth += cell->corner_list[ij + 4].z;
+    depth += corner_list[ij + 4].z;
 
   return depth * 0.25;
 }
@@ -4652,12 +4806,13 @@ double ecl_grid_get_bottom1A(const ecl_grid_type * grid , int active_index) {
 
 
 double ecl_grid_get_cell_dz1( const ecl_grid_type * grid , int global_index ) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
+  point_type corner_buffer[8];
+  const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , corner_buffer );
   double dz = 0;
   int ij;
 
   for (ij = 0; ij < 4; ij++)
-    dz += (cell->corner_list[ij + 4].z - cell->corner_list[ij].z);
+    dz += (corner_list[ij + 4].z - corner_list[ij].z);
 
   return dz * 0.25;
 }
@@ -4692,14 +4847,15 @@ double ecl_grid_get_cell_thickness1A( const ecl_grid_type * grid , int active_in
 
 
 double ecl_grid_get_cell_dx1( const ecl_grid_type * grid , int global_index ) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
+  point_type corner_buffer[8];
+  const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , corner_buffer );
   double dx = 0;
   double dy = 0;
   int c;
 
   for (c = 1; c < 8; c += 2) {
-    dx += cell->corner_list[c].x - cell->corner_list[c - 1].x;
-    dy += cell->corner_list[c].y - cell->corner_list[c - 1].y;
+    dx += corner_list[c].x - corner_list[c - 1].x;
+    dy += corner_list[c].y - corner_list[c - 1].y;
   }
   dx *= 0.25;
   dy *= 0.25;
@@ -4730,7 +4886,8 @@ double ecl_grid_get_cell_dx1A( const ecl_grid_type * grid , int active_index) {
 */
 
 double ecl_grid_get_cell_dy1( const ecl_grid_type * grid , int global_index ) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index);
+  point_type corner_buffer[8];
+  const point_type * corner_list = ecl_grid_get_cell_corners( grid , global_index , corner_buffer );
   double dx = 0;
   double dy = 0;
 
@@ -4738,8 +4895,8 @@ double ecl_grid_get_cell_dy1( const ecl_grid_type * grid , int global_index ) {
     for (int i = 0; i < 2; i++) {
       int c1 = i + k*4;
       int c2 = c1 + 2;
-      dx += cell->corner_list[c2].x - cell->corner_list[c1].x;
-      dy += cell->corner_list[c2].y - cell->corner_list[c1].y;
+      dx += corner_list[c2].x - corner_list[c1].x;
+      dy += corner_list[c2].y - corner_list[c1].y;
     }
   }
   dx *= 0.25;
@@ -5061,9 +5218,8 @@ bool ecl_grid_cell_regular3( const ecl_grid_type * ecl_grid, int i,int j,int k)
 
 double ecl_grid_get_cell_volume1( const ecl_grid_type * ecl_grid, int global_index ) {
   ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
-  int i,j,k;
-  ecl_grid_get_ijk1( ecl_grid , global_index, &i , &j , &k);
-  return ecl_cell_get_volume( cell );
+  point_type corner_buffer[8];
+  return ecl_cell_get_volume( cell , ecl_grid_get_cell_corners( ecl_grid , global_index , corner_buffer ));
 }
 
 
@@ -5075,8 +5231,8 @@ double ecl_grid_get_cell_volume1A( const ecl_grid_type * ecl_grid, int active_in
 
 
 double ecl_grid_get_cell_volume1_tskille( const ecl_grid_type * ecl_grid, int global_index ) {
-  ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
-  return ecl_cell_get_volume_tskille( cell );
+  point_type corner_buffer[8];
+  return ecl_cell_get_volume_tskille( ecl_grid_get_cell_corners( ecl_grid , global_index , corner_buffer ));
 }
 
 
@@ -5457,8 +5613,8 @@ static void ecl_grid_dump__(const ecl_grid_type * grid , FILE * stream) {
   {
     int i;
     for (i=0; i < grid->size; i++) {
-      const ecl_cell_type * cell = ecl_grid_get_cell( grid , i );
-      ecl_cell_dump( cell , stream );
+      point_type corner_buffer[8];
+      ecl_cell_dump( ecl_grid_get_cell_corners( grid , i , corner_buffer ) , stream );
     }
   }
 }
@@ -5479,8 +5635,9 @@ static void ecl_grid_dump_ascii__(ecl_grid_type * grid , bool active_only , FILE
       ecl_cell_type * cell = ecl_grid_get_cell( grid , l );
       if (cell->active_index[MATRIX_INDEX] >= 0 || !active_only) {
         int i,j,k;
+        point_type corner_buffer[8];
         ecl_grid_get_ijk1( grid , l , &i , &j , &k);
-        ecl_cell_dump_ascii( cell , i,j,k , stream , NULL);
+        ecl_cell_dump_ascii( cell , ecl_grid_get_cell_corners( grid , l , corner_buffer ) , i,j,k , stream , NULL);
       }
     }
   }
@@ -5517,16 +5674,18 @@ void ecl_grid_dump_ascii(ecl_grid_type * grid , bool active_only , FILE * stream
 
 void ecl_grid_dump_ascii_cell1(ecl_grid_type * grid , int global_index , FILE * stream , const double * offset) {
   ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
+  point_type corner_buffer[8];
   int i,j,k;
   ecl_grid_get_ijk1( grid , global_index , &i , &j , &k);
-  ecl_cell_dump_ascii(cell , i,j,k, stream , offset);
+  ecl_cell_dump_ascii(cell , ecl_grid_get_cell_corners( grid , global_index , corner_buffer ) , i,j,k, stream , offset);
 }
 
 
 void ecl_grid_dump_ascii_cell3(ecl_grid_type * grid , int i , int j , int k , FILE * stream , const double * offset) {
   int global_index  = ecl_grid_get_global_index3(grid , i,j,k);
   ecl_cell_type * cell = ecl_grid_get_cell( grid , global_index );
-  ecl_cell_dump_ascii(cell , i,j,k, stream , offset);
+  point_type corner_buffer[8];
+  ecl_cell_dump_ascii(cell , ecl_grid_get_cell_corners( grid , global_index , corner_buffer ) , i,j,k, stream , offset);
 }
 
 /*****************************************************************/
@@ -5857,8 +6016,10 @@ static bool ecl_grid_init_coord_section__( const ecl_grid_type * grid , int i, i
     point_type top_point;
     point_type bottom_point;
 
-    const ecl_cell_type * bottom_cell = ecl_grid_get_cell( grid , bottom_index );
-    const ecl_cell_type * top_cell    = ecl_grid_get_cell( grid , top_index);
+    point_type bottom_buffer[8];
+    point_type top_buffer[8];
+    const point_type * bottom_corners = ecl_grid_get_cell_corners( grid , bottom_index , bottom_buffer );
+    const point_type * top_corners    = ecl_grid_get_cell_corners( grid , top_index , top_buffer );
 
     /*
       2---3
@@ -5868,8 +6029,8 @@ static bool ecl_grid_init_coord_section__( const ecl_grid_type * grid , int i, i
     int corner_index = j_corner*2 + i_corner;
     int coord_offset = 6 * ( (j + j_corner) * (grid->nx + 1) + (i + i_corner) );
     {
-      point_copy_values( &top_point    , &top_cell->corner_list[corner_index]);
-      point_copy_values( &bottom_point , &bottom_cell->corner_list[ corner_index + 4]);
+      point_copy_values( &top_point    , &top_corners[corner_index]);
+      point_copy_values( &bottom_point , &bottom_corners[ corner_index + 4]);
 
 
       if ((top_point.z == bottom_point.z) && (force_set == false)) {
@@ -5992,14 +6153,15 @@ static void ecl_grid_init_zcorn_data__( const ecl_grid_type * grid , float * zco
     for (i=0; i < nx; i++) {
       for (k=0; k < nz; k++) {
         const int cell_index   = ecl_grid_get_global_index3( grid , i,j,k);
-        const ecl_cell_type * cell = ecl_grid_get_cell( grid , cell_index );
+        point_type corner_buffer[8];
+        const point_type * corner_list = ecl_grid_get_cell_corners( grid , cell_index , corner_buffer );
         int l;
 
         for (l=0; l < 2; l++) {
-          point_type p0 = cell->corner_list[ 4*l];
-          point_type p1 = cell->corner_list[ 4*l + 1];
-          point_type p2 = cell->corner_list[ 4*l + 2];
-          point_type p3 = cell->corner_list[ 4*l + 3];
+          point_type p0 = corner_list[ 4*l];
+          point_type p1 = corner_list[ 4*l + 1];
+          point_type p2 = corner_list[ 4*l + 2];
+          point_type p3 = corner_list[ 4*l + 3];
 
           int z1 = k*8*nx*ny + j*4*nx + 2*i            + l*4*nx*ny;
           int z2 = k*8*nx*ny + j*4*nx + 2*i  +  1      + l*4*nx*ny;
@@ -6487,9 +6649,9 @@ void ecl_grid_fprintf_grdecl(ecl_grid_type * grid , FILE * stream ) {
 */
 
 void ecl_grid_cell_ri_export( const ecl_grid_type * ecl_grid , int global_index , double * ri_points) {
-  const ecl_cell_type * cell = ecl_grid_get_cell( ecl_grid , global_index );
+  point_type corner_buffer[8];
   int offset = global_index * 8 * 3;
-  ecl_cell_ri_export( cell , &ri_points[ offset ] );
+  ecl_cell_ri_export( ecl_grid_get_cell_corners( ecl_grid , global_index , corner_buffer ) , &ri_points[ offset ] );
 }
 
 
@@ -0,0 +1,367 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_grid_search.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <math.h>
+#include <stdbool.h>
+
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_grid.h>
+#include <ert/ecl/ecl_grid_search.h>
+
+
+/**
+   The ecl_grid_search_struct is a prebuilt index over the cell
+   bounding boxes of a grid, used to find the cell containing a world
+   coordinate (x,y,z) without scanning through the whole grid like
+   ecl_grid_get_global_index_from_xyz() does.
+
+   The index is organized around the (i,j) columns of the grid:
+
+     1. For each column we store the xy bounding box of all the
+        (valid) cells in the column. A uniform 2D bin grid covering
+        the xy bounding box of the whole grid maps each bin to the
+        list of columns overlapping the bin.
+
+     2. Within a column we store, for every layer k, the maximum z of
+        the cells [0,k] and the minimum z of the cells [k,nz). These
+        are monotone in k, so the range of layers which can contain a
+        given z is found with a binary search, without assuming
+        anything about the ordering of the layers.
+
+   The final test is ecl_grid_cell_contains_xyz1(), so the result is
+   exactly the same as an exhaustive search; when several cells
+   contain the point (i.e. on a cell face) the cell with the lowest
+   global index is returned.
+
+   All the cell volumes are calculated when the index is built; after
+   that the queries do not modify the grid or the index, and several
+   threads can query the same index concurrently. The grid must not
+   be modified or freed while the index is in use.
+*/
+
+struct ecl_grid_search_struct {
+  const ecl_grid_type * grid;
+  int                   nx , ny , nz;
+  int                   num_valid_columns;
+  double                xmin , xmax , ymin , ymax;   /* Bounding box of the whole grid. */
+  int                   nbx , nby;
+  double                bin_dx , bin_dy;
+  int                 * bin_offset;                  /* The columns of bin b are bin_columns[bin_offset[b]] ... bin_columns[bin_offset[b+1] - 1]. */
+  int                 * bin_columns;
+  double              * column_bbox;                 /* xmin,xmax,ymin,ymax for each column. */
+  double              * zmax_prefix;                 /* Indexed with column * nz + k. */
+  double              * zmin_suffix;
+};
+
+
+
+static int ecl_grid_search_bin( double pos , double min , double delta , int num_bins ) {
+  if (delta <= 0)
+    return 0;
+  else {
+    int bin = (int) ((pos - min) / delta);
+    return util_int_max( 0 , util_int_min( num_bins - 1 , bin ));
+  }
+}
+
+
+/*
+  Calculates the z bounds of all the cells, and the xy bounding box,
+  of column (i,j). Invalid cells can never contain a point, and are
+  given an empty z interval.
+*/
+
+static void ecl_grid_search_init_column( ecl_grid_search_type * grid_search , int i , int j ) {
+  const int column = i + j * grid_search->nx;
+  const int nz = grid_search->nz;
+  double * bbox = &grid_search->column_bbox[ 4 * column ];
+  double * zmax_prefix = &grid_search->zmax_prefix[ column * nz ];
+  double * zmin_suffix = &grid_search->zmin_suffix[ column * nz ];
+  int k;
+
+  bbox[0] = bbox[2] = HUGE_VAL;
+  bbox[1] = bbox[3] = -HUGE_VAL;
+  for (k = 0; k < nz; k++) {
+    int global_index = ecl_grid_get_global_index3( grid_search->grid , i , j , k );
+
+    zmax_prefix[k] = -HUGE_VAL;
+    zmin_suffix[k] = HUGE_VAL;
+    if (!ecl_grid_cell_invalid1( grid_search->grid , global_index )) {
+      double xpos[8] , ypos[8] , zpos[8];
+      int c;
+
+      ecl_grid_get_cell_corners_xyz1( grid_search->grid , global_index , xpos , ypos , zpos );
+      for (c = 0; c < 8; c++) {
+        bbox[0] = util_double_min( bbox[0] , xpos[c] );
+        bbox[1] = util_double_max( bbox[1] , xpos[c] );
+        bbox[2] = util_double_min( bbox[2] , ypos[c] );
+        bbox[3] = util_double_max( bbox[3] , ypos[c] );
+        zmin_suffix[k] = util_double_min( zmin_suffix[k] , zpos[c] );
+        zmax_prefix[k] = util_double_max( zmax_prefix[k] , zpos[c] );
+      }
+
+      /* Fills the volume cache of the cell; see the comment above. */
+      ecl_grid_get_cell_volume1( grid_search->grid , global_index );
+    }
+  }
+
+  for (k = 1; k < nz; k++)
+    zmax_prefix[k] = util_double_max( zmax_prefix[k] , zmax_prefix[k - 1] );
+
+  for (k = nz - 2; k >= 0; k--)
+    zmin_suffix[k] = util_double_min( zmin_suffix[k] , zmin_suffix[k + 1] );
+}
+
+
+static bool ecl_grid_search_valid_column( const ecl_grid_search_type * grid_search , int column ) {
+  const double * bbox = &grid_search->column_bbox[ 4 * column ];
+  return (bbox[0] <= bbox[1]);
+}
+
+
+/*
+  The number of bins is approximately equal to the number of valid
+  columns, distributed according to the aspect ratio of the grid.
+*/
+
+static void ecl_grid_search_init_bins( ecl_grid_search_type * grid_search ) {
+  const int num_columns = grid_search->nx * grid_search->ny;
+  const int num_valid = grid_search->num_valid_columns;
+  double width  = grid_search->xmax - grid_search->xmin;
+  double height = grid_search->ymax - grid_search->ymin;
+  int * bin_pos;
+  int column;
+
+  if (width > 0 && height > 0)
+    grid_search->nbx = (int) ceil( sqrt( num_valid * width / height ));
+  else
+    grid_search->nbx = (width > 0) ? num_valid : 1;
+  grid_search->nbx = util_int_max( 1 , util_int_min( num_valid , grid_search->nbx ));
+
+  if (height > 0)
+    grid_search->nby = util_int_max( 1 , (num_valid + grid_search->nbx - 1) / grid_search->nbx );
+  else
+    grid_search->nby = 1;
+
+  grid_search->bin_dx = width / grid_search->nbx;
+  grid_search->bin_dy = height / grid_search->nby;
+
+  {
+    const int num_bins = grid_search->nbx * grid_search->nby;
+    int b;
+
+    grid_search->bin_offset = util_calloc( num_bins + 1 , sizeof * grid_search->bin_offset );
+    bin_pos = util_calloc( num_bins , sizeof * bin_pos );
+    for (b = 0; b <= num_bins; b++)
+      grid_search->bin_offset[b] = 0;
+
+    /* First pass: count the number of columns in each bin. */
+    for (column = 0; column < num_columns; column++) {
+      if (ecl_grid_search_valid_column( grid_search , column )) {
+        const double * bbox = &grid_search->column_bbox[ 4 * column ];
+        int bx1 = ecl_grid_search_bin( bbox[0] , grid_search->xmin , grid_search->bin_dx , grid_search->nbx );
+        int bx2 = ecl_grid_search_bin( bbox[1] , grid_search->xmin , grid_search->bin_dx , grid_search->nbx );
+        int by1 = ecl_grid_search_bin( bbox[2] , grid_search->ymin , grid_search->bin_dy , grid_search->nby );
+        int by2 = ecl_grid_search_bin( bbox[3] , grid_search->ymin , grid_search->bin_dy , grid_search->nby );
+        int bx , by;
+
+        for (by = by1; by <= by2; by++)
+          for (bx = bx1; bx <= bx2; bx++)
+            grid_search->bin_offset[ bx + by * grid_search->nbx + 1 ]++;
+      }
+    }
+
+    for (b = 0; b < num_bins; b++) {
+      grid_search->bin_offset[b + 1] += grid_search->bin_offset[b];
+      bin_pos[b] = grid_search->bin_offset[b];
+    }
+
+    /* Second pass: fill in the columns, in increasing column order. */
+    grid_search->bin_columns = util_calloc( util_int_max( 1 , grid_search->bin_offset[ num_bins ] ) , sizeof * grid_search->bin_columns );
+    for (column = 0; column < num_columns; column++) {
+      if (ecl_grid_search_valid_column( grid_search , column )) {
+        const double * bbox = &grid_search->column_bbox[ 4 * column ];
+        int bx1 = ecl_grid_search_bin( bbox[0] , grid_search->xmin , grid_search->bin_dx , grid_search->nbx );
+        int bx2 = ecl_grid_search_bin( bbox[1] , grid_search->xmin , grid_search->bin_dx , grid_search->nbx );
+        int by1 = ecl_grid_search_bin( bbox[2] , grid_search->ymin , grid_search->bin_dy , grid_search->nby );
+        int by2 = ecl_grid_search_bin( bbox[3] , grid_search->ymin , grid_search->bin_dy , grid_search->nby );
+        int bx , by;
+
+        for (by = by1; by <= by2; by++)
+          for (bx = bx1; bx <= bx2; bx++) {
+            int bin = bx + by * grid_search->nbx;
+            grid_search->bin_columns[ bin_pos[bin] ] = column;
+            bin_pos[bin]++;
+          }
+      }
+    }
+  }
+  free( bin_pos );
+}
+
+
+
+ecl_grid_search_type * ecl_grid_search_alloc( const ecl_grid_type * grid ) {
+  ecl_grid_search_type * grid_search = util_malloc( sizeof * grid_search );
+  int num_columns;
+
+  grid_search->grid = grid;
+  ecl_grid_get_dims( grid , &grid_search->nx , &grid_search->ny , &grid_search->nz , NULL );
+  num_columns = grid_search->nx * grid_search->ny;
+
+  grid_search->column_bbox = util_calloc( 4 * num_columns , sizeof * grid_search->column_bbox );
+  grid_search->zmax_prefix = util_calloc( num_columns * grid_search->nz , sizeof * grid_search->zmax_prefix );
+  grid_search->zmin_suffix = util_calloc( num_columns * grid_search->nz , sizeof * grid_search->zmin_suffix );
+  {
+    const int nx = grid_search->nx;
+    const int ny = grid_search->ny;
+    int j;
+
+#pragma omp parallel for
+    for (j = 0; j < ny; j++) {
+      int i;
+      for (i = 0; i < nx; i++)
+        ecl_grid_search_init_column( grid_search , i , j );
+    }
+  }
+
+  {
+    int column;
+
+    grid_search->num_valid_columns = 0;
+    grid_search->xmin = grid_search->ymin = HUGE_VAL;
+    grid_search->xmax = grid_search->ymax = -HUGE_VAL;
+    for (column = 0; column < num_columns; column++) {
+      if (ecl_grid_search_valid_column( grid_search , column )) {
+        const double * bbox = &grid_search->column_bbox[ 4 * column ];
+        grid_search->xmin = util_double_min( grid_search->xmin , bbox[0] );
+        grid_search->xmax = util_double_max( grid_search->xmax , bbox[1] );
+        grid_search->ymin = util_double_min( grid_search->ymin , bbox[2] );
+        grid_search->ymax = util_double_max( grid_search->ymax , bbox[3] );
+        grid_search->num_valid_columns++;
+      }
+    }
+  }
+
+  grid_search->bin_offset = NULL;
+  grid_search->bin_columns = NULL;
+  if (grid_search->num_valid_columns > 0)
+    ecl_grid_search_init_bins( grid_search );
+
+  return grid_search;
+}
+
+
+
+/*
+  Returns the lowest global index of a cell in the column which
+  contains the point, and is lower than 'limit'; or -1.
+*/
+
+static int ecl_grid_search_find_column( const ecl_grid_search_type * grid_search , int column , double x , double y , double z , int limit) {
+  const int nz = grid_search->nz;
+  const int layer_size = grid_search->nx * grid_search->ny;
+  const double * zmax_prefix = &grid_search->zmax_prefix[ column * nz ];
+  const double * zmin_suffix = &grid_search->zmin_suffix[ column * nz ];
+  int k1 = 0;
+  int k2 = nz;
+  int k;
+
+  /* Find the first layer where zmax_prefix[k] >= z. */
+  while (k1 < k2) {
+    int mid = (k1 + k2) / 2;
+    if (zmax_prefix[mid] < z)
+      k1 = mid + 1;
+    else
+      k2 = mid;
+  }
+
+  for (k = k1; k < nz && zmin_suffix[k] <= z; k++) {
+    int global_index = column + k * layer_size;
+    if (global_index >= limit)
+      break;
+
+    if (ecl_grid_cell_contains_xyz1( grid_search->grid , global_index , x , y , z ))
+      return global_index;
+  }
+  return -1;
+}
+
+
+/**
+   Returns the global index of the cell containing the point (x,y,z),
+   or -1 if the point is not inside the grid.
+*/
+
+int ecl_grid_search_find( const ecl_grid_search_type * grid_search , double x , double y , double z) {
+  int global_index = -1;
+
+  if (grid_search->num_valid_columns == 0)
+    return -1;
+
+  if (!((x >= grid_search->xmin) && (x <= grid_search->xmax) &&
+        (y >= grid_search->ymin) && (y <= grid_search->ymax)))
+    return -1;
+
+  {
+    int bx = ecl_grid_search_bin( x , grid_search->xmin , grid_search->bin_dx , grid_search->nbx );
+    int by = ecl_grid_search_bin( y , grid_search->ymin , grid_search->bin_dy , grid_search->nby );
+    int bin = bx + by * grid_search->nbx;
+    int index;
+
+    for (index = grid_search->bin_offset[bin]; index < grid_search->bin_offset[bin + 1]; index++) {
+      int column = grid_search->bin_columns[index];
+      const double * bbox = &grid_search->column_bbox[ 4 * column ];
+
+      if ((x >= bbox[0]) && (x <= bbox[1]) && (y >= bbox[2]) && (y <= bbox[3])) {
+        int limit = (global_index < 0) ? ecl_grid_get_global_size( grid_search->grid ) : global_index;
+        int column_index = ecl_grid_search_find_column( grid_search , column , x , y , z , limit );
+        if (column_index >= 0)
+          global_index = column_index;
+      }
+    }
+  }
+  return global_index;
+}
+
+
+/**
+   Locates all the points (x[i],y[i],z[i]) and stores the result in
+   global_index[i]; when compiled with OpenMP the points are located
+   in parallel.
+*/
+
+void ecl_grid_search_find_points( const ecl_grid_search_type * grid_search , int num_points , const double * x , const double * y , const double * z , int * global_index) {
+  int i;
+
+#pragma omp parallel for
+  for (i = 0; i < num_points; i++)
+    global_index[i] = ecl_grid_search_find( grid_search , x[i] , y[i] , z[i] );
+}
+
+
+void ecl_grid_search_free( ecl_grid_search_type * grid_search ) {
+  free( grid_search->column_bbox );
+  free( grid_search->zmax_prefix );
+  free( grid_search->zmin_suffix );
+  free( grid_search->bin_offset );
+  free( grid_search->bin_columns );
+  free( grid_search );
+}
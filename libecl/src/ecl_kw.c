@@ -20,9 +20,12 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <string.h>
+#include <stdint.h>
+#include <limits.h>
 #include <math.h>
 
 #include <ert/util/util.h>
+#include <ert/util/util_kernels.h>
 #include <ert/util/buffer.h>
 #include <ert/util/int_vector.h>
 
@@ -94,32 +97,22 @@ UTIL_IS_INSTANCE_FUNCTION(ecl_kw , ECL_KW_TYPE_ID )
 
 
 /*****************************************************************/
-/* Format string used when reading and writing formatted
-   files. Observe the following about these format strings:
+/* Format string used when writing formatted files. Observe the
+   following about these format strings:
 
-    1. The format string for reading double contains two '%'
-       identifiers, that is because doubles are read by parsing a
-       prefix and power separately.
-
-    2. For both double and float the write format contains two '%'
+    1. For both double and float the write format contains two '%'
        characters - that is because the values are split in a prefix
        and a power prior to writing - see the function
-       __fprintf_scientific().
+       __sprintf_scientific().
 
-    3. The logical type involves converting back and forth between 'T'
+    2. The logical type involves converting back and forth between 'T'
        and 'F' and internal logical representation. The format strings
        are therefor for reading/writing a character.
 
+   The formatted data is not read with format strings, see
+   ecl_kw_fmt_parse_double() and ecl_kw_fmt_parse_int().
 */
 
-#define READ_FMT_CHAR     "%8c"
-#define READ_FMT_FLOAT    "%gE"
-#define READ_FMT_INT      "%d"
-#define READ_FMT_MESS     "%8c"
-#define READ_FMT_BOOL     "  %c"
-#define READ_FMT_DOUBLE   "%lgD%d"
-
-
 #define WRITE_FMT_CHAR    " '%-8s'"
 #define WRITE_FMT_INT     " %11d"
 #define WRITE_FMT_FLOAT   "  %11.8fE%+03d"
@@ -157,33 +150,6 @@ UTIL_IS_INSTANCE_FUNCTION(ecl_kw , ECL_KW_TYPE_ID )
 
 
 
-static const char * get_read_fmt( ecl_type_enum ecl_type ) {
-  switch(ecl_type) {
-  case(ECL_CHAR_TYPE):
-    return READ_FMT_CHAR;
-    break;
-  case(ECL_INT_TYPE):
-    return READ_FMT_INT;
-    break;
-  case(ECL_FLOAT_TYPE):
-    return READ_FMT_FLOAT;
-    break;
-  case(ECL_DOUBLE_TYPE):
-    return READ_FMT_DOUBLE;
-    break;
-  case(ECL_BOOL_TYPE):
-    return READ_FMT_BOOL;
-    break;
-  case(ECL_MESS_TYPE):
-    return READ_FMT_MESS;
-    break;
-  default:
-    util_abort("%s: invalid ecl_type:%d \n",__func__ , ecl_type);
-    return NULL;
-  }
-}
-
-
 const char * ecl_kw_get_write_fmt( ecl_type_enum ecl_type ) {
   switch(ecl_type) {
   case(ECL_CHAR_TYPE):
@@ -247,6 +213,32 @@ static int get_columns( ecl_type_enum ecl_type ) {
 }
 
 
+/*
+  The maximum width of one element written with the WRITE_FMT_xxx
+  formats above, including the leading blanks; the double exponent
+  can have three digits.
+*/
+
+static int get_fmt_width( ecl_type_enum ecl_type ) {
+  switch(ecl_type) {
+  case(ECL_CHAR_TYPE):
+  case(ECL_MESS_TYPE):
+    return ECL_STRING_LENGTH + 3;
+  case(ECL_INT_TYPE):
+    return 12;
+  case(ECL_FLOAT_TYPE):
+    return 17;
+  case(ECL_DOUBLE_TYPE):
+    return 24;
+  case(ECL_BOOL_TYPE):
+    return 3;
+  default:
+    util_abort("%s: invalid ecl_type:%d \n",__func__ , ecl_type);
+    return -1;
+  }
+}
+
+
 
 /******************************************************************/
 
@@ -1055,92 +1047,410 @@ static bool ecl_kw_fscanf_qstring(char *s , const char *fmt , int len, FILE *str
 
 
 
+/*****************************************************************/
 /*
-  This rather painful parsing is because formatted eclipse double
-  format : 0.ddddD+01 - difficult to parse the 'D';
+  Parsing of the data section of formatted keywords. Instead of
+  reading the file one element at a time with fscanf() the text is
+  read in large blocks, split in tokens and converted with the
+  ecl_kw_fmt_parse_xxx() functions below; these functions do not
+  depend on the current locale, and accept the Fortran 'D' exponent
+  character used for double precision values, as well as exponents
+  without exponent character, e.g. 0.12345678-105.
+
+  After the last element has been parsed the stream is positioned
+  immediately after the last element, i.e. exactly as it would have
+  been when reading with fscanf().
+
+  Each read is capped at the maximum text size of the keyword, see
+  ecl_kw_fmt_max_text_size(), so a small keyword does not read, and
+  then seek back over, a full ECL_KW_FMT_READ_SIZE block. The cap
+  only sizes the reads; text which is wider than the ERT write format
+  is read with more reads.
 */
-/** Should be: NESTED */
-
-static double __fscanf_ECL_double( FILE * stream , const char * fmt) {
-  int    read_count , power;
-  double value , arg;
-  read_count = fscanf( stream , fmt , &arg , &power);
-  if (read_count == 2)
-    value = arg * pow(10 , power );
-  else {
-    util_abort("%s: read failed \n",__func__);
-    value = -1;
+
+#define ECL_KW_FMT_READ_SIZE 65536
+
+typedef struct {
+  FILE        * stream;
+  char        * buffer;
+  int           alloc_size;
+  int           read_size;        /* The maximum number of bytes read by one fread(). */
+  int           data_size;
+  int           pos;
+  offset_type   buffer_offset;    /* File offset of buffer[0]. */
+  bool          at_eof;
+} ecl_kw_fmt_reader_type;
+
+
+static int ecl_kw_fmt_max_text_size( ecl_type_enum ecl_type , int kw_size ) {
+  int64_t text_size = (int64_t) kw_size * get_fmt_width( ecl_type ) + kw_size / get_columns( ecl_type ) + 2;
+  if (text_size > ECL_KW_FMT_READ_SIZE)
+    return ECL_KW_FMT_READ_SIZE;
+  else
+    return (int) text_size;
+}
+
+
+static void ecl_kw_fmt_reader_init( ecl_kw_fmt_reader_type * reader , FILE * stream , int read_size ) {
+  reader->stream        = stream;
+  reader->read_size     = read_size;
+  reader->alloc_size    = read_size;
+  reader->buffer        = util_malloc( reader->alloc_size );
+  reader->data_size     = 0;
+  reader->pos           = 0;
+  reader->buffer_offset = util_ftell( stream );
+  reader->at_eof        = false;
+}
+
+
+/*
+  Will discard the consumed part of the buffer, and read more data
+  from the stream. Returns false if no more data could be read.
+*/
+
+static bool ecl_kw_fmt_reader_fill( ecl_kw_fmt_reader_type * reader ) {
+  if (reader->at_eof)
+    return false;
+
+  {
+    int remaining = reader->data_size - reader->pos;
+    memmove( reader->buffer , &reader->buffer[reader->pos] , remaining );
+    reader->buffer_offset += reader->pos;
+    reader->data_size = remaining;
+    reader->pos = 0;
+
+    if (reader->data_size == reader->alloc_size) {
+      reader->alloc_size *= 2;
+      reader->buffer = util_realloc( reader->buffer , reader->alloc_size );
+    }
+
+    {
+      int read_size = util_int_min( reader->alloc_size - reader->data_size , reader->read_size );
+      size_t bytes_read = fread( &reader->buffer[reader->data_size] , 1 , read_size , reader->stream );
+      if (bytes_read == 0)
+        reader->at_eof = true;
+      reader->data_size += bytes_read;
+      return (bytes_read > 0);
+    }
   }
-  return value;
 }
 
+
+/*
+  Repositions the stream immediately after the consumed data and
+  frees the buffer.
+*/
+
+static void ecl_kw_fmt_reader_close( ecl_kw_fmt_reader_type * reader ) {
+  util_fseek( reader->stream , reader->buffer_offset + reader->pos , SEEK_SET );
+  free( reader->buffer );
+}
+
+
+static bool ecl_kw_fmt_isspace( char c ) {
+  return (c == ' ' || c == '\n' || c == '\r' || c == '\t');
+}
+
+
+/*
+  Returns a pointer to the next whitespace separated token, or NULL at
+  end of file. The token is not \0 terminated, the length is returned
+  in *length.
+*/
+
+static const char * ecl_kw_fmt_reader_next_token( ecl_kw_fmt_reader_type * reader , int * length ) {
+  while (true) {
+    while (reader->pos < reader->data_size && ecl_kw_fmt_isspace( reader->buffer[reader->pos] ))
+      reader->pos++;
+
+    if (reader->pos < reader->data_size)
+      break;
+
+    if (!ecl_kw_fmt_reader_fill( reader ))
+      return NULL;
+  }
+
+  {
+    int end = reader->pos;
+    while (true) {
+      while (end < reader->data_size && !ecl_kw_fmt_isspace( reader->buffer[end] ))
+        end++;
+
+      if (end < reader->data_size || reader->at_eof)
+        break;
+
+      {
+        int token_offset = end - reader->pos;
+        if (!ecl_kw_fmt_reader_fill( reader ))
+          break;
+        end = token_offset;
+      }
+    }
+
+    {
+      const char * token = &reader->buffer[reader->pos];
+      *length = end - reader->pos;
+      reader->pos = end;
+      return token;
+    }
+  }
+}
+
+
+/*
+  Reads a string of the form 'xxxxxxxx', where the eight characters
+  between the quotes can contain spaces, into s.
+*/
+
+static bool ecl_kw_fmt_reader_qstring( ecl_kw_fmt_reader_type * reader , char * s ) {
+  while (true) {
+    while (reader->pos < reader->data_size && reader->buffer[reader->pos] != '\'')
+      reader->pos++;
+
+    if (reader->pos < reader->data_size)
+      break;
+
+    if (!ecl_kw_fmt_reader_fill( reader ))
+      return false;
+  }
+
+  while (reader->data_size - reader->pos < ECL_STRING_LENGTH + 2) {
+    if (!ecl_kw_fmt_reader_fill( reader ))
+      return false;
+  }
+
+  memcpy( s , &reader->buffer[reader->pos + 1] , ECL_STRING_LENGTH );
+  s[ECL_STRING_LENGTH] = '\0';
+  reader->pos += ECL_STRING_LENGTH + 2;
+  return true;
+}
+
+
+static bool ecl_kw_fmt_parse_int( const char * s , int length , int * value ) {
+  int i = 0;
+  bool negative = false;
+  long long acc = 0;
+
+  if (length > 0 && (s[0] == '-' || s[0] == '+')) {
+    negative = (s[0] == '-');
+    i++;
+  }
+
+  if (i == length)
+    return false;
+
+  for (; i < length; i++) {
+    if (s[i] < '0' || s[i] > '9')
+      return false;
+    acc = 10 * acc + (s[i] - '0');
+    if (acc > 2147483648LL)
+      return false;
+  }
+
+  if (negative)
+    acc = -acc;
+
+  if (acc > INT_MAX)
+    return false;
+
+  *value = (int) acc;
+  return true;
+}
+
+
+static const double ecl_kw_fmt_pow10[] = {1e0  , 1e1  , 1e2  , 1e3  , 1e4  , 1e5  , 1e6  , 1e7  ,
+                                          1e8  , 1e9  , 1e10 , 1e11 , 1e12 , 1e13 , 1e14 , 1e15 ,
+                                          1e16 , 1e17 , 1e18 , 1e19 , 1e20 , 1e21 , 1e22 };
+
+#define ECL_KW_FMT_MAX_DIGITS 19
+
+
+/*
+  Will parse a number on the form [+-]ddd.dddd[EeDd][+-]ddd. When the
+  significant digits fit in 2^53 and the decimal exponent is at most
+  22 the conversion is done with one exact operation, which gives the
+  correctly rounded result [Clinger]. In all other cases - which are
+  rare in ECLIPSE files - the number is normalized to the form
+  ddddde[+-]ddd, which does not contain the locale dependent decimal
+  point, and converted with strtod().
+
+  If float_value is non NULL the result is also returned as a
+  correctly rounded float; observe that rounding a double which falls
+  exactly between two floats would suffer from double rounding, in
+  that case strtof() is used.
+*/
+
+static bool ecl_kw_fmt_parse_double( const char * s , int length , double * value , float * float_value) {
+  char digits[ECL_KW_FMT_MAX_DIGITS + 1];
+  uint64_t mantissa = 0;
+  int num_digits = 0;        /* Significant digits stored in mantissa / digits. */
+  int dropped_digits = 0;    /* Integer digits beyond ECL_KW_FMT_MAX_DIGITS. */
+  bool truncated = false;
+  int fraction_digits = 0;
+  int exponent = 0;
+  bool negative = false;
+  bool any_digit = false;
+  int i = 0;
+
+  if (i < length && (s[i] == '-' || s[i] == '+')) {
+    negative = (s[i] == '-');
+    i++;
+  }
+
+  {
+    bool in_fraction = false;
+    for (; i < length; i++) {
+      char c = s[i];
+      if (c >= '0' && c <= '9') {
+        any_digit = true;
+        if (num_digits == 0 && c == '0') {
+          if (in_fraction)
+            fraction_digits++;
+          continue;
+        }
+
+        if (num_digits < ECL_KW_FMT_MAX_DIGITS) {
+          digits[num_digits++] = c;
+          mantissa = 10 * mantissa + (c - '0');
+          if (in_fraction)
+            fraction_digits++;
+        } else {
+          if (c != '0')
+            truncated = true;
+          if (!in_fraction)
+            dropped_digits++;
+        }
+      } else if (c == '.' && !in_fraction)
+        in_fraction = true;
+      else
+        break;
+    }
+  }
+
+  if (!any_digit)
+    return false;
+
+  if (i < length) {
+    char c = s[i];
+    if (c == 'E' || c == 'e' || c == 'D' || c == 'd')
+      i++;
+    else if (c != '+' && c != '-')
+      return false;
+
+    {
+      int exp_value;
+      if (!ecl_kw_fmt_parse_int( &s[i] , length - i , &exp_value ))
+        return false;
+      exponent = exp_value;
+      i = length;
+    }
+  }
+
+  exponent += dropped_digits - fraction_digits;
+  if (mantissa == 0) {
+    *value = negative ? -0.0 : 0.0;
+    if (float_value)
+      *float_value = (float) *value;
+    return true;
+  }
+
+  {
+    bool fast_path = (!truncated && mantissa <= ((uint64_t) 1 << 53) && exponent >= -22 && exponent <= 22);
+    char normalized[ECL_KW_FMT_MAX_DIGITS + 16];
+
+    if (!fast_path || float_value) {
+      memcpy( normalized , digits , num_digits );
+      /* A truncated mantissa gets an extra '1' digit to break possible ties correctly. */
+      if (truncated) {
+        normalized[num_digits] = '1';
+        sprintf( &normalized[num_digits + 1] , "e%d" , exponent - 1);
+      } else
+        sprintf( &normalized[num_digits] , "e%d" , exponent);
+    }
+
+    if (fast_path) {
+      if (exponent >= 0)
+        *value = (double) mantissa * ecl_kw_fmt_pow10[exponent];
+      else
+        *value = (double) mantissa / ecl_kw_fmt_pow10[-exponent];
+    } else
+      *value = strtod( normalized , NULL );
+
+    if (float_value) {
+      float f = (float) *value;
+      if ((double) f != *value && isfinite( f )) {
+        float other = nextafterf( f , (*value > f) ? INFINITY : -INFINITY );
+        if (*value - (double) f == (double) other - *value)
+          f = strtof( normalized , NULL );
+      }
+      *float_value = negative ? -f : f;
+    }
+
+    if (negative)
+      *value = -*value;
+  }
+  return true;
+}
+
+#undef ECL_KW_FMT_MAX_DIGITS
+
+
+
 bool ecl_kw_fread_data(ecl_kw_type *ecl_kw, fortio_type *fortio) {
   const char null_char         = '\0';
   bool fmt_file                = fortio_fmt_file( fortio );
   if (ecl_kw->size > 0) {
     const int blocksize = get_blocksize( ecl_kw->ecl_type );
     if (fmt_file) {
-      const int blocks      = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
-      const char * read_fmt = get_read_fmt( ecl_kw->ecl_type );
-      FILE * stream         = fortio_get_FILE(fortio);
-      int    offset         = 0;
-      int    index          = 0;
-      int    ib,ir;
-      for (ib = 0; ib < blocks; ib++) {
-        int read_elm = util_int_min((ib + 1) * blocksize , ecl_kw->size) - ib * blocksize;
-        for (ir = 0; ir < read_elm; ir++) {
-          switch(ecl_kw->ecl_type) {
-          case(ECL_CHAR_TYPE):
-            ecl_kw_fscanf_qstring(&ecl_kw->data[offset] , read_fmt , 8, stream);
-            break;
-          case(ECL_INT_TYPE):
-            {
-              int iread = fscanf(stream , read_fmt , (int *) &ecl_kw->data[offset]);
-              if (iread != 1)
-                util_abort("%s: after reading %d values reading of keyword:%s from:%s failed - aborting \n",__func__ , offset / ecl_kw->sizeof_ctype , ecl_kw->header8 , fortio_filename_ref(fortio));
-            }
-            break;
-          case(ECL_FLOAT_TYPE):
-            {
-              int iread = fscanf(stream , read_fmt , (float *) &ecl_kw->data[offset]);
-              if (iread != 1) {
-                util_abort("%s: after reading %d values reading of keyword:%s from:%s failed - aborting \n",__func__ ,
-                           offset / ecl_kw->sizeof_ctype ,
-                           ecl_kw->header8 ,
-                           fortio_filename_ref(fortio));
+      ecl_kw_fmt_reader_type reader;
+      bool read_ok = true;
+      int  index;
+
+      ecl_kw_fmt_reader_init( &reader , fortio_get_FILE(fortio) , ecl_kw_fmt_max_text_size( ecl_kw->ecl_type , ecl_kw->size ));
+      for (index = 0; index < ecl_kw->size; index++) {
+        char * data_ptr = &ecl_kw->data[index * ecl_kw->sizeof_ctype];
+        if (ecl_kw->ecl_type == ECL_CHAR_TYPE || ecl_kw->ecl_type == ECL_MESS_TYPE)
+          read_ok = ecl_kw_fmt_reader_qstring( &reader , data_ptr );
+        else {
+          int length;
+          const char * token = ecl_kw_fmt_reader_next_token( &reader , &length );
+          if (token == NULL)
+            read_ok = false;
+          else {
+            switch(ecl_kw->ecl_type) {
+            case(ECL_INT_TYPE):
+              read_ok = ecl_kw_fmt_parse_int( token , length , (int *) data_ptr );
+              break;
+            case(ECL_FLOAT_TYPE):
+              {
+                double double_value;
+                read_ok = ecl_kw_fmt_parse_double( token , length , &double_value , (float *) data_ptr );
               }
+              break;
+            case(ECL_DOUBLE_TYPE):
+              read_ok = ecl_kw_fmt_parse_double( token , length , (double *) data_ptr , NULL );
+              break;
+            case(ECL_BOOL_TYPE):
+              if (length == 1 && token[0] == BOOL_TRUE_CHAR)
+                ecl_kw_iset_bool(ecl_kw , index , true);
+              else if (length == 1 && token[0] == BOOL_FALSE_CHAR)
+                ecl_kw_iset_bool(ecl_kw , index , false);
+              else
+                util_abort("%s: Logical value: [%c] not recogniced - aborting \n", __func__ , token[0]);
+              break;
+            default:
+              util_abort("%s: Internal error: internal eclipse_type: %d not recognized - aborting \n",__func__ , ecl_kw->ecl_type);
             }
-            break;
-          case(ECL_DOUBLE_TYPE):
-            {
-              double value = __fscanf_ECL_double( stream , read_fmt );
-              ecl_kw_iset(ecl_kw , index , &value);
-            }
-            break;
-          case(ECL_BOOL_TYPE):
-            {
-              char bool_char;
-              if (fscanf(stream , read_fmt , &bool_char) == 1) {
-                if (bool_char == BOOL_TRUE_CHAR)
-                  ecl_kw_iset_bool(ecl_kw , index , true);
-                else if (bool_char == BOOL_FALSE_CHAR)
-                  ecl_kw_iset_bool(ecl_kw , index , false);
-                else
-                  util_abort("%s: Logical value: [%c] not recogniced - aborting \n", __func__ , bool_char);
-              } else
-                util_abort("%s: read failed - premature file end? \n",__func__ );
-            }
-            break;
-          case(ECL_MESS_TYPE):
-            ecl_kw_fscanf_qstring(&ecl_kw->data[offset] , read_fmt , 8 , stream);
-            break;
-          default:
-            util_abort("%s: Internal error: internal eclipse_type: %d not recognized - aborting \n",__func__ , ecl_kw->ecl_type);
           }
-          offset += ecl_kw->sizeof_ctype;
-          index++;
         }
+
+        if (!read_ok)
+          break;
       }
+      ecl_kw_fmt_reader_close( &reader );
+
+      if (!read_ok)
+        util_abort("%s: after reading %d values reading of keyword:%s from:%s failed - aborting \n",__func__ , index , ecl_kw->header8 , fortio_filename_ref(fortio));
 
       /* Skip the trailing newline */
       fortio_fseek( fortio , 1 , SEEK_CUR);
@@ -1518,6 +1828,209 @@ void ecl_kw_fskip(fortio_type *fortio) {
 
 
 
+/*****************************************************************/
+/*
+   The ecl_kw_mmap_xxx() functions read keywords directly from a file
+   which has been memory mapped with fortio_mmap(). Instead of going
+   through the stream the functions take an offset into the mapping;
+   the offset is advanced past the part of the file which has been
+   consumed. The functions return false if the file content at offset
+   is not a valid keyword, in which case the offset is not updated.
+*/
+
+
+/*
+   Will return the size of the Fortran record starting at offset, or
+   -1 if the record header/trailer pair does not fit in the mapping.
+*/
+
+static int ecl_kw_mmap_record_size( const fortio_type * fortio , offset_type offset ) {
+  const char * map    = fortio_mmap_data( fortio );
+  offset_type map_size = fortio_mmap_size( fortio );
+  int record_size;
+
+  if (offset + (offset_type) sizeof record_size > map_size)
+    return -1;
+
+  memcpy( &record_size , &map[offset] , sizeof record_size );
+  if (fortio_endian_flip_header( fortio ))
+    util_endian_flip_vector( &record_size , sizeof record_size , 1 );
+
+  if (record_size < 0)
+    return -1;
+
+  if (offset + 2 * (offset_type) sizeof record_size + record_size > map_size)
+    return -1;
+
+  {
+    int trailer;
+    memcpy( &trailer , &map[offset + sizeof record_size + record_size] , sizeof trailer );
+    if (fortio_endian_flip_header( fortio ))
+      util_endian_flip_vector( &trailer , sizeof trailer , 1 );
+
+    if (trailer != record_size)
+      return -1;
+  }
+
+  return record_size;
+}
+
+
+/*
+   Copies count elements from the mapping to the target, and flips the
+   byte order on the fly if needed; i.e. the data is only traversed
+   once.
+*/
+
+static void ecl_kw_mmap_memcpy( char * target , const char * src , int element_size , int count , bool endian_flip) {
+  if (!endian_flip || element_size == 1)
+    memcpy( target , src , (size_t) element_size * count );
+  else if (element_size == 4)
+    util_kernel_bswap32_copy( target , src , count );
+  else if (element_size == 8)
+    util_kernel_bswap64_copy( target , src , count );
+  else {
+    memcpy( target , src , (size_t) element_size * count );
+    util_endian_flip_vector( target , element_size , count );
+  }
+}
+
+
+bool ecl_kw_mmap_read_header( ecl_kw_type * ecl_kw , const fortio_type * fortio , offset_type * offset) {
+  const char * map = fortio_mmap_data( fortio );
+  if (map == NULL)
+    return false;
+
+  if (ecl_kw_mmap_record_size( fortio , *offset ) != ECL_KW_HEADER_DATA_SIZE)
+    return false;
+
+  {
+    const char * buffer = &map[*offset + 4];
+    char header[ECL_STRING_LENGTH + 1];
+    char ecl_type_str[ECL_TYPE_LENGTH + 1];
+    int size;
+
+    memcpy( header , &buffer[0] , ECL_STRING_LENGTH);
+    memcpy( &size , &buffer[ECL_STRING_LENGTH] , sizeof size );
+    memcpy( ecl_type_str , &buffer[ECL_STRING_LENGTH + sizeof(size)] , ECL_TYPE_LENGTH);
+    header[ECL_STRING_LENGTH]     = '\0';
+    ecl_type_str[ECL_TYPE_LENGTH] = '\0';
+
+    if (ECL_ENDIAN_FLIP)
+      util_endian_flip_vector(&size , sizeof size , 1);
+
+    ecl_kw_set_header(ecl_kw , header , size , ecl_type_str);
+  }
+  *offset += ECL_KW_HEADER_FORTIO_SIZE;
+  return true;
+}
+
+
+/*
+   Skipping the data part only involves arithmetic on the header
+   content; the data pages of the mapping are not touched.
+*/
+
+bool ecl_kw_mmap_skip_data( const ecl_kw_type * ecl_kw , const fortio_type * fortio , offset_type * offset) {
+  if (ecl_kw->size > 0) {
+    const int blocksize   = get_blocksize( ecl_kw->ecl_type );
+    const int block_count = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
+    int element_size = ecl_kw->sizeof_ctype;
+    if (ecl_kw->ecl_type == ECL_CHAR_TYPE || ecl_kw->ecl_type == ECL_MESS_TYPE)
+      element_size = ECL_STRING_LENGTH;
+
+    {
+      offset_type data_size = (offset_type) block_count * 8 + (offset_type) element_size * ecl_kw->size;
+      if (*offset + data_size > fortio_mmap_size( fortio ))
+        return false;
+
+      *offset += data_size;
+    }
+  }
+  return true;
+}
+
+
+/*
+   The storage of the keyword must be allocated before calling this
+   function.
+*/
+
+bool ecl_kw_mmap_read_data( ecl_kw_type * ecl_kw , const fortio_type * fortio , offset_type * offset) {
+  const char * map = fortio_mmap_data( fortio );
+  offset_type current_offset = *offset;
+  if (map == NULL)
+    return false;
+
+  if (ecl_kw->size > 0) {
+    if (ecl_kw->ecl_type == ECL_CHAR_TYPE || ecl_kw->ecl_type == ECL_MESS_TYPE) {
+      const int blocksize = get_blocksize( ecl_kw->ecl_type );
+      const int blocks    = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
+      int ib;
+      for (ib = 0; ib < blocks; ib++) {
+        int read_elm    = util_int_min((ib + 1) * blocksize , ecl_kw->size) - ib * blocksize;
+        int record_size = ecl_kw_mmap_record_size( fortio , current_offset );
+        if (record_size != read_elm * ECL_STRING_LENGTH)
+          return false;
+
+        {
+          const char * src = &map[current_offset + 4];
+          int ir;
+          for (ir = 0; ir < read_elm; ir++) {
+            char * target = &ecl_kw->data[(ib * blocksize + ir) * ecl_kw->sizeof_ctype];
+            memcpy( target , &src[ir * ECL_STRING_LENGTH] , ECL_STRING_LENGTH );
+            target[ECL_STRING_LENGTH] = '\0';
+          }
+        }
+        current_offset += record_size + 8;
+      }
+    } else {
+      /*
+         Numeric data is stored contiguously apart from the record
+         markers, the records are copied one by one.
+      */
+      size_t data_size   = (size_t) ecl_kw->size * ecl_kw->sizeof_ctype;
+      size_t data_offset = 0;
+      while (data_offset < data_size) {
+        int record_size = ecl_kw_mmap_record_size( fortio , current_offset );
+        if ((record_size <= 0) || ((record_size % ecl_kw->sizeof_ctype) != 0) || (data_offset + record_size > data_size))
+          return false;
+
+        ecl_kw_mmap_memcpy( &ecl_kw->data[data_offset] ,
+                            &map[current_offset + 4] ,
+                            ecl_kw->sizeof_ctype ,
+                            record_size / ecl_kw->sizeof_ctype ,
+                            ECL_ENDIAN_FLIP );
+
+        data_offset    += record_size;
+        current_offset += record_size + 8;
+      }
+    }
+  }
+  *offset = current_offset;
+  return true;
+}
+
+
+/*
+   Returns NULL if a keyword can not be read from the mapping at
+   offset.
+*/
+
+ecl_kw_type * ecl_kw_mmap_alloc( const fortio_type * fortio , offset_type offset) {
+  ecl_kw_type * ecl_kw = ecl_kw_alloc_empty();
+  if (ecl_kw_mmap_read_header( ecl_kw , fortio , &offset )) {
+    ecl_kw_alloc_data( ecl_kw );
+    if (ecl_kw_mmap_read_data( ecl_kw , fortio , &offset ))
+      return ecl_kw;
+  }
+
+  ecl_kw_free( ecl_kw );
+  return NULL;
+}
+
+
+
 
 static void ecl_kw_fwrite_data_unformatted( ecl_kw_type * ecl_kw , fortio_type * fortio ) {
   if (ECL_ENDIAN_FLIP)
@@ -1571,12 +2084,16 @@ static void ecl_kw_fwrite_data_unformatted( ecl_kw_type * ecl_kw , fortio_type *
         2. To use 'D' as the exponent start for double values.
 
      If you are more proficient with C fprintf() format strings than I
-     am, the __fprintf_scientific() function should be removed, and
+     am, the __sprintf_scientific() function should be removed, and
      the WRITE_FMT_DOUBLE and WRITE_FMT_FLOAT format specifiers
      updated accordingly.
+
+     The formatted writer does not call this function for each
+     element, see ecl_kw_fmt_scientific() below; it is only used for
+     the non finite values.
   */
 
-   static void __fprintf_scientific(FILE * stream, const char * fmt , double x) {
+static int __sprintf_scientific(char * buffer, const char * fmt , double x) {
     double pow_x = ceil(log10(fabs(x)));
     double arg_x   = x / pow(10.0 , pow_x);
     if (x != 0.0) {
@@ -1588,9 +2105,132 @@ static void ecl_kw_fwrite_data_unformatted( ecl_kw_type * ecl_kw , fortio_type *
       arg_x = 0.0;
       pow_x = 0.0;
     }
-    fprintf(stream , fmt , arg_x , (int) pow_x);
+    return sprintf(buffer , fmt , arg_x , (int) pow_x);
+  }
+
+
+/*****************************************************************/
+/*
+  Fast formatting of the elements of formatted keywords. The
+  functions format one element into a buffer and return the number of
+  characters written; the output is identical to what is produced by
+  the WRITE_FMT_XXX format strings.
+*/
+
+static int ecl_kw_fmt_uint( char * buffer , unsigned long long value , int min_digits ) {
+  char tmp[24];
+  int n = 0;
+  do {
+    tmp[n++] = '0' + (char) (value % 10);
+    value /= 10;
+  } while (value > 0 || n < min_digits);
+
+  {
+    int i;
+    for (i=0; i < n; i++)
+      buffer[i] = tmp[n - 1 - i];
+  }
+  return n;
+}
+
+
+static int ecl_kw_fmt_pad( char * buffer , const char * src , int length , int width ) {
+  int pad = width - length;
+  if (pad < 0)
+    pad = 0;
+  memset( buffer , ' ' , pad );
+  memcpy( &buffer[pad] , src , length );
+  return pad + length;
+}
+
+
+/* Corresponds to the format " %11d". */
+static int ecl_kw_fmt_int( char * buffer , int value ) {
+  char tmp[16];
+  int n = 0;
+  long long v = value;
+  if (v < 0) {
+    tmp[n++] = '-';
+    v = -v;
+  }
+  n += ecl_kw_fmt_uint( &tmp[n] , v , 1 );
+  buffer[0] = ' ';
+  return 1 + ecl_kw_fmt_pad( &buffer[1] , tmp , n , 11 );
+}
+
+
+/*
+  Corresponds to __sprintf_scientific() with the format "  %W.Df%c%+03d";
+  i.e. WRITE_FMT_FLOAT or WRITE_FMT_DOUBLE. The scaled argument, which
+  is in the interval [0.1,1], is rounded to the requested number of
+  decimals exactly like printf() does: round to nearest with ties
+  to even on the exact binary value; the rounding error of the
+  multiplication is recovered with fma().
+*/
+
+static int ecl_kw_fmt_scientific( char * buffer , double x , int decimals , char exp_char , const char * fmt ) {
+  if (!isfinite( x ))
+    return __sprintf_scientific( buffer , fmt , x );
+
+  {
+    double pow_x = 0;
+    double arg_x = 0;
+    if (x != 0.0) {
+      pow_x = ceil(log10(fabs(x)));
+      /* The positive powers of ten up to 1e22 are exact, i.e. identical to the pow() result. */
+      if (pow_x >= 0 && pow_x <= 22)
+        arg_x = x / ecl_kw_fmt_pow10[(int) pow_x];
+      else
+        arg_x = x / pow(10.0 , pow_x);
+
+      if (fabs(arg_x) == 1.0) {
+        arg_x *= 0.10;
+        pow_x += 1;
+      }
+    }
+
+    {
+      char tmp[32];
+      int  n = 0;
+      double scale = ecl_kw_fmt_pow10[decimals];
+      double abs_arg = fabs( arg_x );
+      double p = abs_arg * scale;
+      double err = fma( abs_arg , scale , -p );
+      double q = floor( p );
+      double frac = p - q;
+      unsigned long long int_value;
+
+      if (frac > 0.5 || (frac == 0.5 && (err > 0 || (err == 0 && fmod( q , 2 ) != 0))))
+        q += 1;
+
+      int_value = (unsigned long long) q;
+      if (signbit( arg_x ))
+        tmp[n++] = '-';
+
+      n += ecl_kw_fmt_uint( &tmp[n] , int_value / (unsigned long long) scale , 1 );
+      tmp[n++] = '.';
+      n += ecl_kw_fmt_uint( &tmp[n] , int_value % (unsigned long long) scale , decimals );
+
+      buffer[0] = ' ';
+      buffer[1] = ' ';
+      n = 2 + ecl_kw_fmt_pad( &buffer[2] , tmp , n , decimals + 3 );
+      buffer[n++] = exp_char;
+      {
+        int exp_value = (int) pow_x;
+        buffer[n++] = (exp_value < 0) ? '-' : '+';
+        n += ecl_kw_fmt_uint( &buffer[n] , (exp_value < 0) ? -exp_value : exp_value , 2 );
+      }
+      return n;
+    }
   }
+}
+
 
+/*
+  Upper limit of the formatted width of one element, including
+  separating spaces.
+*/
+#define ECL_KW_FMT_MAX_WIDTH 40
 
 static void ecl_kw_fwrite_data_formatted( ecl_kw_type * ecl_kw , fortio_type * fortio ) {
 
@@ -1601,11 +2241,13 @@ static void ecl_kw_fwrite_data_formatted( ecl_kw_type * ecl_kw , fortio_type * f
     const  int columns      = get_columns( ecl_kw->ecl_type );
     const  char * write_fmt = ecl_kw_get_write_fmt( ecl_kw->ecl_type );
     const int num_blocks    = ecl_kw->size / blocksize + (ecl_kw->size % blocksize == 0 ? 0 : 1);
+    char * buffer           = util_malloc( blocksize * (ECL_KW_FMT_MAX_WIDTH + 1) );
     int block_nr;
 
     for (block_nr = 0; block_nr < num_blocks; block_nr++) {
       int this_blocksize = util_int_min((block_nr + 1)*blocksize , ecl_kw->size) - block_nr*blocksize;
       int num_lines      = this_blocksize / columns + ( this_blocksize % columns == 0 ? 0 : 1);
+      int length         = 0;
       int line_nr;
       for (line_nr = 0; line_nr < num_lines; line_nr++) {
         int num_columns = util_int_min( (line_nr + 1)*columns , this_blocksize) - columns * line_nr;
@@ -1613,48 +2255,56 @@ static void ecl_kw_fwrite_data_formatted( ecl_kw_type * ecl_kw , fortio_type * f
         for (col_nr =0; col_nr < num_columns; col_nr++) {
           int data_index  = block_nr * blocksize + line_nr * columns + col_nr;
           void * data_ptr = ecl_kw_iget_ptr_static( ecl_kw , data_index );
+          char * target   = &buffer[length];
           switch (ecl_kw->ecl_type) {
           case(ECL_CHAR_TYPE):
-            fprintf(stream , write_fmt , data_ptr);
-            break;
-          case(ECL_INT_TYPE):
             {
-              int int_value = ((int *) data_ptr)[0];
-              fprintf(stream , write_fmt , int_value);
+              const char * s = data_ptr;
+              int s_length = 0;
+              while (s_length < ECL_STRING_LENGTH && s[s_length] != '\0')
+                s_length++;
+
+              target[0] = ' ';
+              target[1] = '\'';
+              memcpy( &target[2] , s , s_length );
+              memset( &target[2 + s_length] , ' ' , ECL_STRING_LENGTH - s_length );
+              target[2 + ECL_STRING_LENGTH] = '\'';
+              length += ECL_STRING_LENGTH + 3;
             }
             break;
+          case(ECL_INT_TYPE):
+            length += ecl_kw_fmt_int( target , ((int *) data_ptr)[0] );
+            break;
           case(ECL_BOOL_TYPE):
             {
               bool bool_value = ((bool *) data_ptr)[0];
-              if (bool_value)
-                fprintf(stream , write_fmt , BOOL_TRUE_CHAR);
-              else
-                fprintf(stream , write_fmt , BOOL_FALSE_CHAR);
+              target[0] = ' ';
+              target[1] = ' ';
+              target[2] = bool_value ? BOOL_TRUE_CHAR : BOOL_FALSE_CHAR;
+              length += 3;
             }
             break;
           case(ECL_FLOAT_TYPE):
-            {
-              float float_value = ((float *) data_ptr)[0];
-              __fprintf_scientific( stream , write_fmt , float_value );
-            }
+            length += ecl_kw_fmt_scientific( target , ((float *) data_ptr)[0] , 8 , 'E' , write_fmt );
             break;
           case(ECL_DOUBLE_TYPE):
-            {
-              double double_value = ((double *) data_ptr)[0];
-              __fprintf_scientific( stream , write_fmt , double_value );
-            }
+            length += ecl_kw_fmt_scientific( target , ((double *) data_ptr)[0] , 14 , 'D' , write_fmt );
             break;
           case(ECL_MESS_TYPE):
             util_abort("%s: internal fuckup : message type keywords should NOT have data ??\n",__func__);
             break;
           }
         }
-        fprintf(stream , "\n");
+        buffer[length++] = '\n';
       }
+      fwrite( buffer , 1 , length , stream );
     }
+    free( buffer );
   }
 }
 
+#undef ECL_KW_FMT_MAX_WIDTH
+
 
 void ecl_kw_fwrite_data(const ecl_kw_type *_ecl_kw , fortio_type *fortio) {
   ecl_kw_type *ecl_kw = (ecl_kw_type *) _ecl_kw;
@@ -1978,10 +2628,32 @@ void ecl_kw_scale_ ## ctype (ecl_kw_type * ecl_kw , ctype scale_factor) {
 }
 
 ECL_KW_SCALE_TYPED( int , ECL_INT_TYPE)
-ECL_KW_SCALE_TYPED( float , ECL_FLOAT_TYPE)
-ECL_KW_SCALE_TYPED( double , ECL_DOUBLE_TYPE )
 #undef ECL_KW_SCALE_TYPED
 
+
+/*
+  The float and double variants are implemented with the fused
+  scale/shift kernel; with a shift of -0.0 the result is identical to
+  a plain multiplication.
+*/
+
+#define ECL_KW_SCALE_SHIFT_TYPED( ctype , ECL_TYPE )                                                  \
+void ecl_kw_scale_ ## ctype (ecl_kw_type * ecl_kw , ctype scale_factor) {                             \
+  if (ecl_kw_get_type(ecl_kw) != ECL_TYPE)                                                            \
+    util_abort("%s: Keyword: %s is wrong type - aborting \n",__func__ , ecl_kw_get_header8(ecl_kw));  \
+  util_kernel_scale_shift_ ## ctype( ecl_kw_get_data_ref( ecl_kw ) , ecl_kw_get_size( ecl_kw ) , scale_factor , -0.0 ); \
+}                                                                                                     \
+                                                                                                      \
+void ecl_kw_shift_ ## ctype (ecl_kw_type * ecl_kw , ctype shift_value) {                              \
+  if (ecl_kw_get_type(ecl_kw) != ECL_TYPE)                                                            \
+    util_abort("%s: Keyword: %s is wrong type - aborting \n",__func__ , ecl_kw_get_header8(ecl_kw));  \
+  util_kernel_scale_shift_ ## ctype( ecl_kw_get_data_ref( ecl_kw ) , ecl_kw_get_size( ecl_kw ) , 1 , shift_value ); \
+}
+
+ECL_KW_SCALE_SHIFT_TYPED( float , ECL_FLOAT_TYPE)
+ECL_KW_SCALE_SHIFT_TYPED( double , ECL_DOUBLE_TYPE )
+#undef ECL_KW_SCALE_SHIFT_TYPED
+
 void ecl_kw_scale_float_or_double( ecl_kw_type * ecl_kw , double scale_factor ) {
   ecl_type_enum ecl_type = ecl_kw_get_type(ecl_kw);
   if (ecl_type == ECL_FLOAT_TYPE)
@@ -2007,8 +2679,6 @@ void ecl_kw_shift_ ## ctype (ecl_kw_type * ecl_kw , ctype shift_value) {
 }
 
 ECL_KW_SHIFT_TYPED( int , ECL_INT_TYPE)
-ECL_KW_SHIFT_TYPED( float , ECL_FLOAT_TYPE)
-ECL_KW_SHIFT_TYPED( double , ECL_DOUBLE_TYPE )
 #undef ECL_KW_SHIFT_TYPED
 
 
@@ -2024,6 +2694,23 @@ void ecl_kw_shift_float_or_double( ecl_kw_type * ecl_kw , double shift_value ) {
 
 
 
+/*
+   Will update all elements as: x -> x * scale_factor + shift_value in
+   one pass.
+*/
+
+void ecl_kw_scale_shift_float_or_double( ecl_kw_type * ecl_kw , double scale_factor , double shift_value ) {
+  ecl_type_enum ecl_type = ecl_kw_get_type(ecl_kw);
+  if (ecl_type == ECL_FLOAT_TYPE)
+    util_kernel_scale_shift_float( ecl_kw_get_data_ref( ecl_kw ) , ecl_kw_get_size( ecl_kw ) , (float) scale_factor , (float) shift_value );
+  else if (ecl_type == ECL_DOUBLE_TYPE)
+    util_kernel_scale_shift_double( ecl_kw_get_data_ref( ecl_kw ) , ecl_kw_get_size( ecl_kw ) , scale_factor , shift_value );
+  else
+    util_abort("%s: wrong type \n",__func__);
+}
+
+
+
 bool ecl_kw_assert_numeric( const ecl_kw_type * kw ) {
   if ((kw->ecl_type == ECL_INT_TYPE) || (kw->ecl_type == ECL_FLOAT_TYPE) || (kw->ecl_type == ECL_DOUBLE_TYPE))
     return true;
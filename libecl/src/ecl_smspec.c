@@ -117,6 +117,8 @@ struct ecl_smspec_struct {
   bool                 need_nums;
   bool                 locked;
   int_vector_type    * index_map;
+  int_vector_type    * params_map;                 /* For selectively loaded headers: compact params_index -> index in the PARAMS keyword on file; NULL when all keys are loaded. */
+  int                  file_params_size;           /* Number of elements in the PARAMS keyword on file. */
 
   /*-----------------------------------------------------------------*/
 
@@ -269,6 +271,8 @@ static ecl_smspec_type * ecl_smspec_alloc_empty(bool write_mode , const char * k
   ecl_smspec->time_seconds = -1;
 
   ecl_smspec->index_map = int_vector_alloc(0,0);
+  ecl_smspec->params_map = NULL;
+  ecl_smspec->file_params_size = 0;
   ecl_smspec->restart_list = stringlist_alloc_new();
   ecl_smspec->params_default = float_vector_alloc(0 , PARAMS_GLOBAL_DEFAULT);
   ecl_smspec->write_mode = write_mode;
@@ -1100,7 +1104,41 @@ static bool ecl_smspec_check_header( ecl_file_type * header ) {
 }
 
 
-static bool ecl_smspec_fread_header(ecl_smspec_type * ecl_smspec, const char * header_file , bool include_restart) {
+/**
+   Decides whether a node should be loaded when the header is loaded
+   selectively. The time keywords are always loaded, because they are
+   needed to assign a time to each ministep; the remaining nodes are
+   loaded if one of the key patterns matches the general key of the
+   node.
+*/
+
+static bool ecl_smspec_select_node( const stringlist_type * key_patterns , const smspec_node_type * smspec_node) {
+  const char * keyword = smspec_node_get_keyword( smspec_node );
+  if (util_string_equal( keyword , "TIME" ) ||
+      util_string_equal( keyword , "DAY"  ) ||
+      util_string_equal( keyword , "MONTH") ||
+      util_string_equal( keyword , "YEAR" ))
+    return true;
+
+  {
+    const char * gen_key1 = smspec_node_get_gen_key1( smspec_node );
+    const char * gen_key2 = smspec_node_get_gen_key2( smspec_node );
+    int i;
+
+    for (i=0; i < stringlist_get_size( key_patterns ); i++) {
+      const char * pattern = stringlist_iget( key_patterns , i );
+      if ((gen_key1 != NULL) && (util_fnmatch( pattern , gen_key1 ) == 0))
+        return true;
+
+      if ((gen_key2 != NULL) && (util_fnmatch( pattern , gen_key2 ) == 0))
+        return true;
+    }
+  }
+  return false;
+}
+
+
+static bool ecl_smspec_fread_header(ecl_smspec_type * ecl_smspec, const char * header_file , bool include_restart , const stringlist_type * key_patterns) {
   ecl_file_type * header = ecl_file_open( header_file , 0);
   if (header && ecl_smspec_check_header( header )) {
     ecl_kw_type *wells     = ecl_file_iget_named_kw(header, WGNAMES_KW  , 0);
@@ -1140,7 +1178,11 @@ static bool ecl_smspec_fread_header(ecl_smspec_type * ecl_smspec, const char * h
     ecl_smspec->grid_dims[0] = ecl_kw_iget_int(dimens , DIMENS_SMSPEC_NX_INDEX );
     ecl_smspec->grid_dims[1] = ecl_kw_iget_int(dimens , DIMENS_SMSPEC_NY_INDEX );
     ecl_smspec->grid_dims[2] = ecl_kw_iget_int(dimens , DIMENS_SMSPEC_NZ_INDEX );
-    ecl_smspec_set_params_size( ecl_smspec , ecl_kw_get_size(keywords));
+    ecl_smspec->file_params_size = ecl_kw_get_size(keywords);
+    if (key_patterns == NULL)
+      ecl_smspec_set_params_size( ecl_smspec , ecl_smspec->file_params_size );
+    else
+      ecl_smspec->params_map = int_vector_alloc(0,0);
 
     ecl_util_get_file_type( header_file , &ecl_smspec->formatted , NULL );
 
@@ -1166,6 +1208,16 @@ static bool ecl_smspec_fread_header(ecl_smspec_type * ecl_smspec, const char * h
           smspec_node = smspec_node_alloc( var_type , well , kw , unit , ecl_smspec->key_join_string , ecl_smspec->grid_dims , num , params_index , default_value);
 
 
+        if ((smspec_node != NULL) && (key_patterns != NULL)) {
+          if (ecl_smspec_select_node( key_patterns , smspec_node )) {
+            smspec_node_set_params_index( smspec_node , int_vector_size( ecl_smspec->params_map ));
+            int_vector_append( ecl_smspec->params_map , params_index );
+          } else {
+            smspec_node_free( smspec_node );
+            smspec_node = NULL;
+          }
+        }
+
         if (smspec_node != NULL) {
           /** OK - we know this is valid shit. */
           ecl_smspec_add_node( ecl_smspec , smspec_node );
@@ -1178,6 +1230,9 @@ static bool ecl_smspec_fread_header(ecl_smspec_type * ecl_smspec, const char * h
       }
     }
 
+    if (key_patterns != NULL)
+      ecl_smspec_set_params_size( ecl_smspec , int_vector_size( ecl_smspec->params_map ));
+
     ecl_smspec->header_file = util_alloc_realpath( header_file );
     if (include_restart)
       ecl_smspec_load_restart( ecl_smspec , header );
@@ -1191,7 +1246,17 @@ static bool ecl_smspec_fread_header(ecl_smspec_type * ecl_smspec, const char * h
 
 
 
-ecl_smspec_type * ecl_smspec_fread_alloc(const char *header_file, const char * key_join_string , bool include_restart) {
+/**
+   Will load the header selectively; only the nodes matching one of
+   the patterns in @key_patterns (along with the time keywords) are
+   loaded, and they get consecutive params_index values. The mapping
+   back to the position in the PARAMS keyword on file is available
+   with ecl_smspec_get_params_map(), and is used by ecl_sum_data to
+   read only the requested elements from the data files. With
+   @key_patterns == NULL all keys are loaded.
+*/
+
+ecl_smspec_type * ecl_smspec_fread_alloc_selected(const char *header_file, const char * key_join_string , bool include_restart , const stringlist_type * key_patterns) {
   ecl_smspec_type *ecl_smspec;
 
   {
@@ -1201,7 +1266,7 @@ ecl_smspec_type * ecl_smspec_fread_alloc(const char *header_file, const char * k
     util_safe_free(path);
   }
 
-  if (ecl_smspec_fread_header(ecl_smspec , header_file , include_restart)) {
+  if (ecl_smspec_fread_header(ecl_smspec , header_file , include_restart , key_patterns)) {
 
     if (hash_has_key( ecl_smspec->misc_var_index , "TIME")) {
       const smspec_node_type * time_node = hash_get(ecl_smspec->misc_var_index , "TIME");
@@ -1241,6 +1306,11 @@ ecl_smspec_type * ecl_smspec_fread_alloc(const char *header_file, const char * k
 }
 
 
+ecl_smspec_type * ecl_smspec_fread_alloc(const char *header_file, const char * key_join_string , bool include_restart) {
+  return ecl_smspec_fread_alloc_selected( header_file , key_join_string , include_restart , NULL );
+}
+
+
 int ecl_smspec_get_num_groups(const ecl_smspec_type * ecl_smspec) {
   return hash_get_size(ecl_smspec->group_var_index);
 }
@@ -1640,6 +1710,8 @@ void ecl_smspec_free(ecl_smspec_type *ecl_smspec) {
   hash_free(ecl_smspec->gen_var_index);
   util_safe_free( ecl_smspec->header_file );
   int_vector_free( ecl_smspec->index_map );
+  if (ecl_smspec->params_map != NULL)
+    int_vector_free( ecl_smspec->params_map );
   float_vector_free( ecl_smspec->params_default );
   vector_free( ecl_smspec->smspec_nodes );
   stringlist_free( ecl_smspec->restart_list );
@@ -1833,6 +1905,20 @@ int ecl_smspec_get_params_size( const ecl_smspec_type * smspec ) {
 }
 
 
+/*
+  Returns NULL if all the keys have been loaded.
+*/
+
+const int_vector_type * ecl_smspec_get_params_map( const ecl_smspec_type * smspec ) {
+  return smspec->params_map;
+}
+
+
+int ecl_smspec_get_file_params_size( const ecl_smspec_type * smspec ) {
+  return smspec->file_params_size;
+}
+
+
 
 const int * ecl_smspec_get_grid_dims( const ecl_smspec_type * smspec ) {
   return smspec->grid_dims;
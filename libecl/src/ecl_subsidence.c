@@ -135,16 +135,10 @@ static void ecl_subsidence_survey_free__( void * __subsidence_survey ) {
 
 /*****************************************************************/
 
-static double ecl_subsidence_survey_eval( const ecl_subsidence_survey_type * base_survey ,
-                                          const ecl_subsidence_survey_type * monitor_survey,
-                                          ecl_region_type * region ,
-                                          double utm_x , double utm_y , double depth, 
-                                          double compressibility, double poisson_ratio) {
-
-  const ecl_grid_cache_type * grid_cache = base_survey->grid_cache;
-  const int size  = ecl_grid_cache_get_size( grid_cache );
+static double * ecl_subsidence_survey_alloc_weight( const ecl_subsidence_survey_type * base_survey ,
+                                                    const ecl_subsidence_survey_type * monitor_survey) {
+  const int size  = ecl_grid_cache_get_size( base_survey->grid_cache );
   double * weight = util_calloc( size , sizeof * weight );
-  double deltaz;
   int index;
 
   if (monitor_survey != NULL) {
@@ -154,7 +148,20 @@ static double ecl_subsidence_survey_eval( const ecl_subsidence_survey_type * bas
     for (index = 0; index < size; index++)
       weight[index] = base_survey->porv[index] * base_survey->pressure[index];
   }
-  
+  return weight;
+}
+
+
+static double ecl_subsidence_survey_eval( const ecl_subsidence_survey_type * base_survey ,
+                                          const ecl_subsidence_survey_type * monitor_survey,
+                                          ecl_region_type * region ,
+                                          double utm_x , double utm_y , double depth, 
+                                          double compressibility, double poisson_ratio) {
+
+  const ecl_grid_cache_type * grid_cache = base_survey->grid_cache;
+  double * weight = ecl_subsidence_survey_alloc_weight( base_survey , monitor_survey );
+  double deltaz;
+
   deltaz = compressibility * 31.83099*(1-poisson_ratio) * 
     ecl_grav_common_eval_biot_savart( grid_cache , region , base_survey->aquifer_cell , weight , utm_x , utm_y , depth );
   
@@ -162,6 +169,26 @@ static double ecl_subsidence_survey_eval( const ecl_subsidence_survey_type * bas
   return deltaz;
 }
 
+
+static void ecl_subsidence_survey_eval_stations( const ecl_subsidence_survey_type * base_survey ,
+                                                 const ecl_subsidence_survey_type * monitor_survey,
+                                                 ecl_region_type * region ,
+                                                 int num_stations ,
+                                                 const double * utm_x , const double * utm_y , const double * depth,
+                                                 double compressibility, double poisson_ratio,
+                                                 double * deltaz) {
+
+  const ecl_grid_cache_type * grid_cache = base_survey->grid_cache;
+  double * weight = ecl_subsidence_survey_alloc_weight( base_survey , monitor_survey );
+  int station;
+
+  ecl_grav_common_eval_biot_savart_stations( grid_cache , region , base_survey->aquifer_cell , weight , num_stations , utm_x , utm_y , depth , deltaz );
+  for (station = 0; station < num_stations; station++)
+    deltaz[station] *= compressibility * 31.83099*(1-poisson_ratio);
+
+  free( weight );
+}
+
 /*****************************************************************/
 /**
    The grid instance is only used during the construction phase. The
@@ -221,6 +248,21 @@ double ecl_subsidence_eval( const ecl_subsidence_type * subsidence , const char
   return ecl_subsidence_survey_eval( base_survey , monitor_survey , region , utm_x , utm_y , depth , compressibility, poisson_ratio);
 }
 
+
+/**
+   Will evaluate the subsidence for num_stations stations at the
+   positions (utm_x[i], utm_y[i], depth[i]) and store the results in
+   deltaz[i]; equal to ecl_subsidence_eval() to within rounding.
+*/
+
+void ecl_subsidence_eval_stations( const ecl_subsidence_type * subsidence , const char * base, const char * monitor , ecl_region_type * region ,
+                                   int num_stations , const double * utm_x, const double * utm_y , const double * depth,
+                                   double compressibility, double poisson_ratio, double * deltaz) {
+  ecl_subsidence_survey_type * base_survey    = ecl_subsidence_get_survey( subsidence , base );
+  ecl_subsidence_survey_type * monitor_survey = ecl_subsidence_get_survey( subsidence , monitor );
+  ecl_subsidence_survey_eval_stations( base_survey , monitor_survey , region , num_stations , utm_x , utm_y , depth , compressibility , poisson_ratio , deltaz );
+}
+
 void ecl_subsidence_free( ecl_subsidence_type * ecl_subsidence ) {
   ecl_grid_cache_free( ecl_subsidence->grid_cache );
   free( ecl_subsidence->aquifer_cell );
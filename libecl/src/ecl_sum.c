@@ -37,6 +37,7 @@
 #include <ert/ecl/ecl_sum.h>
 #include <ert/ecl/ecl_smspec.h>
 #include <ert/ecl/ecl_sum_data.h>
+#include <ert/ecl/ecl_sum_vector.h>
 #include <ert/ecl/smspec_node.h>
 
 
@@ -192,8 +193,8 @@ static bool ecl_sum_fread_data( ecl_sum_type * ecl_sum , const stringlist_type *
 
 
 
-static bool ecl_sum_fread(ecl_sum_type * ecl_sum , const char *header_file , const stringlist_type *data_files , bool include_restart) {
-  ecl_sum->smspec = ecl_smspec_fread_alloc( header_file , ecl_sum->key_join_string , include_restart);
+static bool ecl_sum_fread(ecl_sum_type * ecl_sum , const char *header_file , const stringlist_type *data_files , bool include_restart , const stringlist_type * key_patterns) {
+  ecl_sum->smspec = ecl_smspec_fread_alloc_selected( header_file , ecl_sum->key_join_string , include_restart , key_patterns);
   if (ecl_sum->smspec) {
     bool fmt_file;
     ecl_util_get_file_type( header_file , &fmt_file , NULL);
@@ -217,7 +218,7 @@ static bool ecl_sum_fread(ecl_sum_type * ecl_sum , const char *header_file , con
 }
 
 
-static bool ecl_sum_fread_case( ecl_sum_type * ecl_sum , bool include_restart) {
+static bool ecl_sum_fread_case( ecl_sum_type * ecl_sum , bool include_restart , const stringlist_type * key_patterns) {
   char * header_file;
   stringlist_type * summary_file_list = stringlist_alloc_new();
 
@@ -225,7 +226,7 @@ static bool ecl_sum_fread_case( ecl_sum_type * ecl_sum , bool include_restart) {
 
   ecl_util_alloc_summary_files( ecl_sum->path , ecl_sum->base , ecl_sum->ext , &header_file , summary_file_list );
   if ((header_file != NULL) && (stringlist_get_size( summary_file_list ) > 0)) {
-    caseOK = ecl_sum_fread( ecl_sum , header_file , summary_file_list , include_restart );
+    caseOK = ecl_sum_fread( ecl_sum , header_file , summary_file_list , include_restart , key_patterns );
   }
   util_safe_free( header_file );
   stringlist_free( summary_file_list );
@@ -246,11 +247,53 @@ static bool ecl_sum_fread_case( ecl_sum_type * ecl_sum , bool include_restart) {
 
 
 ecl_sum_type * ecl_sum_fread_alloc(const char *header_file , const stringlist_type *data_files , const char * key_join_string) {
+  return ecl_sum_fread_alloc_selected( header_file , data_files , key_join_string , NULL );
+}
+
+
+/**
+   Selective loading: only the summary vectors matching one of the
+   patterns in @key_patterns are loaded; the patterns are matched with
+   util_fnmatch() against the general keys, i.e. "WOPR:*" or
+   "FOPT". The time keywords are always loaded. For unformatted files
+   only the requested elements of the PARAMS keywords are read from
+   disk, so memory and load time scale with the number of keys
+   requested and not the size of the summary files. Keys which have
+   not been loaded are invisible, i.e. ecl_sum_has_key() will return
+   false for them. With @key_patterns == NULL all keys are loaded.
+*/
+
+ecl_sum_type * ecl_sum_fread_alloc_selected(const char *header_file , const stringlist_type *data_files , const char * key_join_string , const stringlist_type * key_patterns) {
   ecl_sum_type * ecl_sum = ecl_sum_alloc__( header_file , key_join_string );
-  ecl_sum_fread( ecl_sum , header_file , data_files , false );
+  ecl_sum_fread( ecl_sum , header_file , data_files , false , key_patterns );
   return ecl_sum;
 }
 
+/**
+   Will load the timesteps which have been added to the summary data
+   files since the case was loaded, or since the previous call to
+   ecl_sum_refresh(). This is intended for monitoring of running
+   simulations: the data files are read from where the previous
+   refresh stopped, and a truncated keyword at the end of a data file
+   (i.e. a timestep which is currently being written) is left for the
+   next refresh. The return value is the number of new timesteps.
+
+   Only unformatted summary files can be refreshed; for formatted
+   cases the function returns 0. Restart cases are not considered.
+*/
+
+int ecl_sum_refresh( ecl_sum_type * ecl_sum ) {
+  int new_ministeps = 0;
+  if (ecl_sum->data != NULL) {
+    stringlist_type * data_files = stringlist_alloc_new();
+    ecl_util_alloc_summary_data_files( ecl_sum->path , ecl_sum->base , ecl_sum->fmt_case , data_files );
+    new_ministeps = ecl_sum_data_refresh( ecl_sum->data , data_files );
+    stringlist_free( data_files );
+  }
+  return new_ministeps;
+}
+
+
 /*****************************************************************/
 
 void ecl_sum_set_unified( ecl_sum_type * ecl_sum , bool unified ) {
@@ -386,9 +429,9 @@ void ecl_sum_free__(void * __ecl_sum) {
 */
 
 
-ecl_sum_type * ecl_sum_fread_alloc_case__(const char * input_file , const char * key_join_string , bool include_restart){
+static ecl_sum_type * ecl_sum_fread_alloc_case_selected__(const char * input_file , const char * key_join_string , bool include_restart , const stringlist_type * key_patterns){
   ecl_sum_type * ecl_sum     = ecl_sum_alloc__(input_file , key_join_string);
-  if (ecl_sum_fread_case( ecl_sum , include_restart))
+  if (ecl_sum_fread_case( ecl_sum , include_restart , key_patterns))
     return ecl_sum;
   else {
     /*
@@ -402,12 +445,27 @@ ecl_sum_type * ecl_sum_fread_alloc_case__(const char * input_file , const char *
 
 
 
+ecl_sum_type * ecl_sum_fread_alloc_case__(const char * input_file , const char * key_join_string , bool include_restart){
+  return ecl_sum_fread_alloc_case_selected__( input_file , key_join_string , include_restart , NULL );
+}
+
+
 ecl_sum_type * ecl_sum_fread_alloc_case(const char * input_file , const char * key_join_string){
   bool include_restart = true;
   return ecl_sum_fread_alloc_case__( input_file , key_join_string , include_restart );
 }
 
 
+/*
+  See the documentation of ecl_sum_fread_alloc_selected().
+*/
+
+ecl_sum_type * ecl_sum_fread_alloc_case_selected(const char * input_file , const char * key_join_string , const stringlist_type * key_patterns){
+  bool include_restart = true;
+  return ecl_sum_fread_alloc_case_selected__( input_file , key_join_string , include_restart , key_patterns );
+}
+
+
 bool ecl_sum_case_exists( const char * input_file ) {
   char * smspec_file = NULL;
   stringlist_type * data_files = stringlist_alloc_new();
@@ -665,6 +723,11 @@ void ecl_sum_fwrite_interp_csv_line(const ecl_sum_type * ecl_sum, time_t sim_tim
 }
 
 
+void ecl_sum_get_interp_vector( const ecl_sum_type * ecl_sum , time_t sim_time , const ecl_sum_vector_type * keylist , double_vector_type * values) {
+  ecl_sum_data_get_interp_vector( ecl_sum->data , sim_time , keylist , values );
+}
+
+
 
 double ecl_sum_get_general_var_from_sim_time( const ecl_sum_type * ecl_sum , time_t sim_time , const char * var) {
   const smspec_node_type * node = ecl_sum_get_general_var_node( ecl_sum , var );
@@ -1189,6 +1252,22 @@ void ecl_sum_shift_vector( ecl_sum_type * ecl_sum, int index, double addend ) {
   ecl_sum_data_shift_vector( ecl_sum->data, index, addend );
 }
 
+
+/**
+   Will enable or disable the column store of the summary data, see
+   the documentation in ecl_sum_data.c. The column store makes
+   extraction of complete vectors and interpolation of many keys
+   faster, at the cost of holding the data twice in memory.
+*/
+
+void ecl_sum_set_column_store( ecl_sum_type * ecl_sum , bool column_store ) {
+  ecl_sum_data_set_column_store( ecl_sum->data , column_store );
+}
+
+bool ecl_sum_has_column_store( const ecl_sum_type * ecl_sum ) {
+  return ecl_sum_data_has_column_store( ecl_sum->data );
+}
+
 bool ecl_sum_check_sim_time( const ecl_sum_type * sum , time_t sim_time) {
   return ecl_sum_data_check_sim_time( sum->data , sim_time );
 }
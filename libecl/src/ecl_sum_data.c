@@ -225,6 +225,14 @@ struct ecl_sum_data_struct {
   time_interval_type     * sim_time;               /* The time interval sim_time goes from the first time value where we have
                                                       data to the end of the simulation. In the case of restarts the start
                                                       value might disagree with the simulation start reported by the smspec file. */
+  bool                     column_store;           /* Should the data be kept in the column store as well? */
+  float                  * columns;                /* The column store; NULL if not built - see ecl_sum_data_build_columns(). */
+  int                      columns_length;         /* The number of ministeps in the column store. */
+  int                      columns_params_size;    /* The number of params in the column store. */
+  char                   * tail_file;              /* The data file the next ecl_sum_data_refresh() will continue reading from. */
+  offset_type              tail_offset;            /* Offset in tail_file after the last complete record. */
+  int                      tail_report_step;       /* The report step at tail_offset. */
+  int                      tail_ministep;          /* The largest ministep loaded from the data files of this case. */
 };
 
 
@@ -234,6 +242,8 @@ struct ecl_sum_data_struct {
 /*****************************************************************/
 
  void ecl_sum_data_free( ecl_sum_data_type * data ) {
+  util_safe_free( data->columns );
+  util_safe_free( data->tail_file );
   vector_free( data->data );
   int_vector_free( data->report_first_index );
   int_vector_free( data->report_last_index  );
@@ -273,6 +283,16 @@ ecl_sum_data_type * ecl_sum_data_alloc(ecl_smspec_type * smspec) {
   data->report_last_index     = int_vector_alloc( 0 , INVALID_MINISTEP_NR );
   data->sim_time              = time_interval_alloc_open();
 
+  data->column_store          = false;
+  data->columns               = NULL;
+  data->columns_length        = 0;
+  data->columns_params_size   = 0;
+
+  data->tail_file             = NULL;
+  data->tail_offset           = 0;
+  data->tail_report_step      = 0;
+  data->tail_ministep         = INVALID_MINISTEP_NR;
+
   ecl_sum_data_clear_index( data );
   return data;
 }
@@ -306,6 +326,107 @@ static ecl_sum_tstep_type * ecl_sum_data_iget_ministep( const ecl_sum_data_type
 
 
 
+/*
+  The column store
+  ----------------
+
+  The natural storage of the summary data is one ecl_sum_tstep
+  instance for each ministep, holding the PARAMS vector with the
+  values of all the variables at that time. Extracting the time
+  series of one variable must then visit all the tstep instances,
+  with one cache miss per ministep; for cases with many vectors and
+  many ministeps this dominates e.g. ecl_quantile.
+
+  Optionally the data can in addition be held in a column store,
+  where the time series of each variable is one contiguous block:
+
+     columns[ params_index * columns_length + internal_index ]
+
+  The column store duplicates the data, it is therefor not built by
+  default; it is enabled with ecl_sum_data_set_column_store(). When
+  enabled the column store is (re)built when the index is built,
+  i.e. when the summary files have been loaded, and it is discarded
+  when new ministeps are added. The column store is a snapshot of the
+  data in the tstep instances; in write mode the ecl_sum_tstep_iset()
+  calls after the column store has been built are not reflected in
+  the column store.
+*/
+
+
+static void ecl_sum_data_free_columns( ecl_sum_data_type * data ) {
+  util_safe_free( data->columns );
+  data->columns = NULL;
+  data->columns_length = 0;
+  data->columns_params_size = 0;
+}
+
+
+/*
+  The transpose is done in blocks of COLUMN_BLOCK ministeps, so that
+  the writes to the columns are contiguous for each block.
+*/
+
+#define COLUMN_BLOCK 64
+
+static void ecl_sum_data_build_columns( ecl_sum_data_type * data ) {
+  const int length = vector_get_size( data->data );
+  const int params_size = ecl_smspec_get_params_size( data->smspec );
+
+  ecl_sum_data_free_columns( data );
+  if ((length == 0) || (params_size == 0))
+    return;
+
+  data->columns = util_malloc( (size_t) length * params_size * sizeof * data->columns );
+  data->columns_length = length;
+  data->columns_params_size = params_size;
+
+  for (int block_start = 0; block_start < length; block_start += COLUMN_BLOCK) {
+    const int block_end = util_int_min( length , block_start + COLUMN_BLOCK );
+    const float * rows[COLUMN_BLOCK];
+
+    for (int index = block_start; index < block_end; index++)
+      rows[index - block_start] = ecl_sum_tstep_get_data( ecl_sum_data_iget_ministep( data , index ));
+
+    for (int params_index = 0; params_index < params_size; params_index++) {
+      float * column = &data->columns[ (size_t) params_index * length ];
+      for (int index = block_start; index < block_end; index++)
+        column[index] = rows[index - block_start][params_index];
+    }
+  }
+}
+
+#undef COLUMN_BLOCK
+
+
+/**
+   Will enable or disable the column store; when enabling the column
+   store it is built immediately - if there is data.
+*/
+
+void ecl_sum_data_set_column_store( ecl_sum_data_type * data , bool column_store ) {
+  data->column_store = column_store;
+  if (column_store) {
+    if (data->index_valid)
+      ecl_sum_data_build_columns( data );
+  } else
+    ecl_sum_data_free_columns( data );
+}
+
+
+bool ecl_sum_data_has_column_store( const ecl_sum_data_type * data ) {
+  return (data->columns != NULL);
+}
+
+
+static const float * ecl_sum_data_get_column( const ecl_sum_data_type * data , int params_index ) {
+  if ((params_index < 0) || (params_index >= data->columns_params_size))
+    util_abort("%s: params_index:%d invalid - valid range [0,%d) \n",__func__ , params_index , data->columns_params_size);
+
+  return &data->columns[ (size_t) params_index * data->columns_length ];
+}
+
+
+
 void ecl_sum_data_report2internal_range(const ecl_sum_data_type * data , int report_step , int * index1 , int * index2 ){
   if (index1 != NULL)
     *index1 = int_vector_safe_iget( data->report_first_index , report_step );
@@ -750,6 +871,7 @@ static void ecl_sum_data_append_tstep__( ecl_sum_data_type * data , int ministep
 
   vector_append_owned_ref( data->data , tstep , ecl_sum_tstep_free__);
   data->index_valid = false;
+  ecl_sum_data_free_columns( data );
 }
 
 
@@ -835,6 +957,9 @@ static void ecl_sum_data_build_index( ecl_sum_data_type * sum_data ) {
     }
   }
   sum_data->index_valid = true;
+
+  if (sum_data->column_store)
+    ecl_sum_data_build_columns( sum_data );
 }
 
 
@@ -921,20 +1046,48 @@ static void ecl_sum_data_add_ecl_file(ecl_sum_data_type * data         ,
 
   int num_ministep  = ecl_file_get_num_named_kw( ecl_file , PARAMS_KW);
   if (num_ministep > 0) {
+    const int_vector_type * params_map = ecl_smspec_get_params_map( smspec );
+    float * params_buffer = NULL;
     int ikw;
 
+    /*
+      When the header has been loaded selectively we read only the
+      requested elements of the PARAMS keywords, instead of loading
+      the complete keywords. The partial read is based on seeking in
+      the file, and is only possible for unformatted files; formatted
+      files are loaded in full and the elements are picked out by
+      ecl_sum_tstep_alloc_from_file().
+    */
+    if (params_map != NULL) {
+      bool fmt_file;
+      ecl_util_get_file_type( ecl_file_get_src_file( ecl_file ) , &fmt_file , NULL );
+      if (!fmt_file)
+        params_buffer = util_calloc( int_vector_size( params_map ) , sizeof * params_buffer );
+    }
+
     for (ikw = 0; ikw < num_ministep; ikw++) {
       ecl_kw_type * ministep_kw = ecl_file_iget_named_kw( ecl_file , MINISTEP_KW , ikw);
-      ecl_kw_type * params_kw   = ecl_file_iget_named_kw( ecl_file , PARAMS_KW   , ikw);
 
       {
         ecl_sum_tstep_type * tstep;
         int ministep_nr = ecl_kw_iget_int( ministep_kw , 0 );
-        tstep = ecl_sum_tstep_alloc_from_file( report_step ,
-                                               ministep_nr ,
-                                               params_kw ,
-                                               ecl_file_get_src_file( ecl_file ),
-                                               smspec );
+        if (params_buffer != NULL) {
+          if (ecl_file_iget_named_size( ecl_file , PARAMS_KW , ikw ) == ecl_smspec_get_file_params_size( smspec )) {
+            ecl_file_indexed_read( ecl_file , PARAMS_KW , ikw , params_map , (char *) params_buffer );
+            tstep = ecl_sum_tstep_alloc_from_data( report_step , ministep_nr , params_buffer , smspec );
+          } else {
+            fprintf(stderr , "** Warning size mismatch between timestep loaded from:%s and header:%s - timestep discarded.\n" ,
+                    ecl_file_get_src_file( ecl_file ) , ecl_smspec_get_header_file( smspec ));
+            tstep = NULL;
+          }
+        } else {
+          ecl_kw_type * params_kw = ecl_file_iget_named_kw( ecl_file , PARAMS_KW , ikw);
+          tstep = ecl_sum_tstep_alloc_from_file( report_step ,
+                                                 ministep_nr ,
+                                                 params_kw ,
+                                                 ecl_file_get_src_file( ecl_file ),
+                                                 smspec );
+        }
 
         if (tstep != NULL) {
           if (load_end == 0 || (ecl_sum_tstep_get_sim_time( tstep ) < load_end))
@@ -946,6 +1099,7 @@ static void ecl_sum_data_add_ecl_file(ecl_sum_data_type * data         ,
         }
       }
     }
+    util_safe_free( params_buffer );
   }
 }
 
@@ -1030,7 +1184,155 @@ static bool ecl_sum_data_fread__( ecl_sum_data_type * data , time_t load_end , c
 }
 
 bool ecl_sum_data_fread( ecl_sum_data_type * data , const stringlist_type * filelist) {
-  return ecl_sum_data_fread__( data , 0 , filelist );
+  bool load_ok = ecl_sum_data_fread__( data , 0 , filelist );
+  if (load_ok)
+    data->tail_ministep = data->last_ministep;
+  return load_ok;
+}
+
+
+
+/*
+  Incremental loading of the data files of a running simulation.
+
+  The data files are written by the simulator while it is running,
+  one MINISTEP/PARAMS pair per timestep; i.e. when a data file is read
+  the last keyword can be incomplete. The refresh functionality reads
+  the data files keyword by keyword with fortio, starting at the
+  offset where the previous refresh stopped, and stops at the first
+  keyword which can not be read completely. The offset of the last
+  complete record is stored in the tail_offset field, and the next
+  refresh starts reading from there.
+
+  Ministeps with ministep number less than or equal to tail_ministep
+  have already been loaded and are skipped without reading the
+  data. That way the first refresh after a normal load, which must
+  start at the beginning of the file, only reads the keyword headers
+  of the data which is already loaded.
+
+  Only unformatted files can be refreshed; the formatted reader does
+  not handle truncated keywords.
+*/
+
+static bool ecl_sum_data_tail_fskip_data( ecl_kw_type * ecl_kw , fortio_type * fortio , offset_type file_size) {
+  if (ecl_kw_fskip_data( ecl_kw , fortio ))
+    return (fortio_ftell( fortio ) <= file_size);
+  else
+    return false;
+}
+
+
+static int ecl_sum_data_fread_tail( ecl_sum_data_type * data , const char * data_file , offset_type offset , int report_step , bool unified) {
+  int new_ministeps = 0;
+  fortio_type * fortio = fortio_open_reader( data_file , false , ECL_ENDIAN_FLIP );
+
+  if (fortio) {
+    ecl_kw_type * ecl_kw = ecl_kw_alloc_empty();
+    offset_type file_size = util_file_size( data_file );
+    offset_type complete_offset = offset;
+    int complete_report_step = report_step;
+
+    fortio_fseek( fortio , offset , SEEK_SET );
+    while (true) {
+      if (!ecl_kw_fread_header( ecl_kw , fortio ))
+        break;
+
+      if (ecl_kw_name_equal( ecl_kw , MINISTEP_KW )) {
+        int ministep_nr;
+
+        if (!ecl_kw_fread_realloc_data( ecl_kw , fortio ))
+          break;
+        ministep_nr = ecl_kw_iget_int( ecl_kw , 0 );
+
+        if (!ecl_kw_fread_header( ecl_kw , fortio ))
+          break;
+
+        if (!ecl_kw_name_equal( ecl_kw , PARAMS_KW ))
+          util_abort("%s: expected %s keyword after %s in:%s \n",__func__ , PARAMS_KW , MINISTEP_KW , data_file);
+
+        if (ministep_nr <= data->tail_ministep) {
+          if (!ecl_sum_data_tail_fskip_data( ecl_kw , fortio , file_size))
+            break;
+        } else {
+          ecl_sum_tstep_type * tstep;
+          if (!ecl_kw_fread_realloc_data( ecl_kw , fortio ))
+            break;
+
+          tstep = ecl_sum_tstep_alloc_from_file( report_step , ministep_nr , ecl_kw , data_file , data->smspec );
+          if (tstep != NULL) {
+            ecl_sum_data_append_tstep__( data , ministep_nr , tstep );
+            data->tail_ministep = ministep_nr;
+            new_ministeps++;
+          }
+        }
+      } else {
+        if (!ecl_sum_data_tail_fskip_data( ecl_kw , fortio , file_size))
+          break;
+
+        /* In the unified file a new report step starts with each SEQHDR keyword. */
+        if (unified && ecl_kw_name_equal( ecl_kw , SEQHDR_KW ))
+          report_step++;
+      }
+
+      complete_offset = fortio_ftell( fortio );
+      complete_report_step = report_step;
+    }
+
+    data->tail_file = util_realloc_string_copy( data->tail_file , data_file );
+    data->tail_offset = complete_offset;
+    data->tail_report_step = complete_report_step;
+
+    ecl_kw_free( ecl_kw );
+    fortio_fclose( fortio );
+  }
+  return new_ministeps;
+}
+
+
+/**
+   Will load the ministeps which have been added to the data files
+   since the previous load or refresh, and update the index. The
+   @filelist should be the current list of data files for the case,
+   i.e. for a simulation with non unified summary files new files will
+   appear while the simulation is running. Returns the number of new
+   ministeps.
+*/
+
+int ecl_sum_data_refresh( ecl_sum_data_type * data , const stringlist_type * filelist) {
+  int new_ministeps = 0;
+
+  if (stringlist_get_size( filelist ) > 0) {
+    bool fmt_file;
+    ecl_file_enum file_type = ecl_util_get_file_type( stringlist_iget( filelist , 0 ) , &fmt_file , NULL);
+
+    if (!fmt_file) {
+      if (file_type == ECL_UNIFIED_SUMMARY_FILE) {
+        const char * data_file = stringlist_iget( filelist , 0 );
+        if (util_string_equal( data_file , data->tail_file ))
+          new_ministeps += ecl_sum_data_fread_tail( data , data_file , data->tail_offset , data->tail_report_step , true );
+        else
+          new_ministeps += ecl_sum_data_fread_tail( data , data_file , 0 , 0 , true );
+      } else if (file_type == ECL_SUMMARY_FILE) {
+        int filenr;
+        for (filenr = 0; filenr < stringlist_get_size( filelist ); filenr++) {
+          const char * data_file = stringlist_iget( filelist , filenr);
+          int report_step;
+
+          ecl_util_get_file_type( data_file , NULL , &report_step);
+          if (util_string_equal( data_file , data->tail_file ))
+            new_ministeps += ecl_sum_data_fread_tail( data , data_file , data->tail_offset , data->tail_report_step , false );
+          else if ((data->tail_file == NULL) || (report_step > data->tail_report_step))
+            new_ministeps += ecl_sum_data_fread_tail( data , data_file , 0 , report_step , false );
+        }
+      } else
+        util_abort("%s: invalid file type:%s \n",__func__ , ecl_util_file_type_name(file_type ));
+    }
+  }
+
+  if (new_ministeps > 0)
+    ecl_sum_data_build_index( data );
+
+  return new_ministeps;
 }
 
 
@@ -1154,8 +1456,14 @@ int ecl_sum_data_iget_mini_step(const ecl_sum_data_type * data , int internal_in
 
 
 double ecl_sum_data_iget( const ecl_sum_data_type * data , int time_index , int params_index ) {
-  const ecl_sum_tstep_type * ministep_data = ecl_sum_data_iget_ministep( data , time_index  );
-  return ecl_sum_tstep_iget( ministep_data , params_index);
+  if (data->columns != NULL) {
+    if ((time_index < 0) || (time_index >= data->columns_length))
+      util_abort("%s: time_index:%d invalid - valid range [0,%d) \n",__func__ , time_index , data->columns_length);
+    return ecl_sum_data_get_column( data , params_index )[time_index];
+  } else {
+    const ecl_sum_tstep_type * ministep_data = ecl_sum_data_iget_ministep( data , time_index  );
+    return ecl_sum_tstep_iget( ministep_data , params_index);
+  }
 }
 
 
@@ -1172,42 +1480,86 @@ double ecl_sum_data_iget( const ecl_sum_data_type * data , int time_index , int
 */
 
 double ecl_sum_data_interp_get(const ecl_sum_data_type * data , int time_index1 , int time_index2 , double weight1 , double weight2 , int params_index) {
-  const ecl_sum_tstep_type * ministep_data1 = ecl_sum_data_iget_ministep( data , time_index1 );
-  const ecl_sum_tstep_type * ministep_data2 = ecl_sum_data_iget_ministep( data , time_index2 );
+  return ecl_sum_data_iget( data , time_index1 , params_index ) * weight1 + ecl_sum_data_iget( data , time_index2 , params_index ) * weight2;
+}
+
 
-  return ecl_sum_tstep_iget( ministep_data1 , params_index ) * weight1 + ecl_sum_tstep_iget( ministep_data2 , params_index ) * weight2;
+/*
+  See the documentation of ecl_sum_data_get_from_sim_time() for the
+  special treatment of the start time for rate variables.
+*/
+
+static int ecl_sum_data_get_rate_index_from_sim_time( const ecl_sum_data_type * data , time_t sim_time ) {
+  if (sim_time == time_interval_get_start( data->sim_time ))
+    return 0;
+  else
+    return ecl_sum_data_get_index_from_sim_time( data , sim_time );
 }
 
 
-void ecl_sum_data_fwrite_interp_csv_line(const ecl_sum_data_type * data , time_t sim_time, const ecl_sum_vector_type * keylist, FILE *fp){
-    int num_keywords = ecl_sum_vector_get_size(keylist);
-    double weight1 , weight2;
-    int    time_index1 , time_index2;
-    double value = 0.0;
-    int i;
+/**
+   Will evaluate all the vectors in keylist at sim_time, with the same
+   semantics as ecl_sum_data_get_from_sim_time(), and store the result
+   in values. The time lookup is only done once, and the inner loops
+   are plain loops over the two rows (or columns) of data.
+*/
 
-    ecl_sum_data_init_interp_from_sim_time( data , sim_time , &time_index1 , &time_index2 , &weight1 , &weight2);
-    for(i = 0; i< num_keywords; i++  ){
-        bool is_rate = ecl_sum_vector_iget_is_rate(keylist, i);
-        int params_index = ecl_sum_vector_iget_param_index(keylist , i);
-        if(is_rate){
-            int time_index;
-            if (sim_time == time_interval_get_start( data->sim_time ))
-                time_index = 0;
-            else
-                time_index = ecl_sum_data_get_index_from_sim_time( data , sim_time );
+void ecl_sum_data_get_interp_vector( const ecl_sum_data_type * data , time_t sim_time , const ecl_sum_vector_type * keylist , double_vector_type * values) {
+  const int num_keywords = ecl_sum_vector_get_size( keylist );
+  double weight1 , weight2;
+  int    time_index1 , time_index2;
+  int    rate_index = ecl_sum_data_get_rate_index_from_sim_time( data , sim_time );
 
-           value = ecl_sum_data_iget( data , time_index , params_index);
-        } else {
-           value = ecl_sum_data_interp_get( data , time_index1 , time_index2 , weight1 , weight2 , params_index);
+  double_vector_reset( values );
+  if (num_keywords == 0)
+    return;
 
-        }
+  ecl_sum_data_init_interp_from_sim_time( data , sim_time , &time_index1 , &time_index2 , &weight1 , &weight2);
+  double_vector_iset( values , num_keywords - 1 , 0 );
+  {
+    double * value_data = double_vector_get_ptr( values );
+
+    if (data->columns != NULL) {
+      const size_t length = data->columns_length;
+      const float * columns = data->columns;
+
+      for (int i = 0; i < num_keywords; i++) {
+        const size_t offset = ecl_sum_vector_iget_param_index( keylist , i ) * length;
+        if (ecl_sum_vector_iget_is_rate( keylist , i ))
+          value_data[i] = columns[ offset + rate_index ];
+        else
+          value_data[i] = columns[ offset + time_index1 ] * weight1 + columns[ offset + time_index2 ] * weight2;
+      }
+    } else {
+      const float * row1 = ecl_sum_tstep_get_data( ecl_sum_data_iget_ministep( data , time_index1 ));
+      const float * row2 = ecl_sum_tstep_get_data( ecl_sum_data_iget_ministep( data , time_index2 ));
+      const float * rate_row = ecl_sum_tstep_get_data( ecl_sum_data_iget_ministep( data , rate_index ));
+
+      for (int i = 0; i < num_keywords; i++) {
+        const int params_index = ecl_sum_vector_iget_param_index( keylist , i );
+        if (ecl_sum_vector_iget_is_rate( keylist , i ))
+          value_data[i] = rate_row[ params_index ];
+        else
+          value_data[i] = row1[ params_index ] * weight1 + row2[ params_index ] * weight2;
+      }
+    }
+  }
+}
+
+
+void ecl_sum_data_fwrite_interp_csv_line(const ecl_sum_data_type * data , time_t sim_time, const ecl_sum_vector_type * keylist, FILE *fp){
+    double_vector_type * values = double_vector_alloc( 0 , 0 );
+    int i;
+
+    ecl_sum_data_get_interp_vector( data , sim_time , keylist , values );
+    for(i = 0; i < double_vector_size( values ); i++){
         if(i == 0){
-            fprintf(fp , "%f",value);
+            fprintf(fp , "%f",double_vector_iget( values , i ));
         }else{
-            fprintf(fp , ",%f",value);
+            fprintf(fp , ",%f",double_vector_iget( values , i ));
         }
     }
+    double_vector_free( values );
 }
 
 
@@ -1230,11 +1582,7 @@ double ecl_sum_data_get_from_sim_time( const ecl_sum_data_type * data , time_t s
        with the ECLIPSE results if you ask for a value interpolated to
        the starting time.
     */
-    if (sim_time == time_interval_get_start( data->sim_time ))
-      time_index = 0;
-    else
-      time_index = ecl_sum_data_get_index_from_sim_time( data , sim_time );
-
+    time_index = ecl_sum_data_get_rate_index_from_sim_time( data , sim_time );
     return ecl_sum_data_iget( data , time_index , params_index);
   } else {
     /* Interpolated lookup based on two (hopefully) consecutive ministeps. */
@@ -1426,14 +1774,19 @@ void ecl_sum_data_init_data_vector( const ecl_sum_data_type * data , double_vect
     int report_step;
     for (report_step = data->first_report_step; report_step <= data->last_report_step; report_step++) {
       int last_index = int_vector_iget(data->report_last_index , report_step);
-      const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , last_index );
-      double_vector_append( data_vector , ecl_sum_tstep_iget( ministep , data_index ));
+      double_vector_append( data_vector , ecl_sum_data_iget( data , last_index , data_index ));
     }
   } else {
     int i;
-    for (i = 0; i < vector_get_size(data->data); i++) {
-      const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , i  );
-      double_vector_append( data_vector , ecl_sum_tstep_iget( ministep , data_index ));
+    if (data->columns != NULL) {
+      const float * column = ecl_sum_data_get_column( data , data_index );
+      for (i = 0; i < data->columns_length; i++)
+        double_vector_append( data_vector , column[i] );
+    } else {
+      for (i = 0; i < vector_get_size(data->data); i++) {
+        const ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep( data , i  );
+        double_vector_append( data_vector , ecl_sum_tstep_iget( ministep , data_index ));
+      }
     }
   }
 }
@@ -1462,6 +1815,8 @@ void ecl_sum_data_scale_vector(ecl_sum_data_type * data, int index, double scala
   for (int i = 0; i < len; i++) {
     ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep(data,i);
     ecl_sum_tstep_iscale(ministep, index, scalar);
+    if (data->columns != NULL)
+      data->columns[ (size_t) index * data->columns_length + i ] = ecl_sum_tstep_iget( ministep , index );
   }
 }
 
@@ -1470,6 +1825,8 @@ void ecl_sum_data_shift_vector(ecl_sum_data_type * data, int index, double adden
   for (int i = 0; i < len; i++) {
     ecl_sum_tstep_type * ministep = ecl_sum_data_iget_ministep(data,i);
     ecl_sum_tstep_ishift(ministep, index, addend);
+    if (data->columns != NULL)
+      data->columns[ (size_t) index * data->columns_length + i ] = ecl_sum_tstep_iget( ministep , index );
   }
 }
 
@@ -18,6 +18,7 @@
 
 #include <time.h>
 #include <math.h>
+#include <string.h>
 
 #include <ert/util/util.h>
 #include <ert/util/type_macros.h>
@@ -172,12 +173,22 @@ ecl_sum_tstep_type * ecl_sum_tstep_alloc_from_file( int report_step    ,
                                                     const ecl_smspec_type * smspec) {
 
   int data_size = ecl_kw_get_size( params_kw );
+  const int_vector_type * params_map = ecl_smspec_get_params_map( smspec );
 
-  if (data_size == ecl_smspec_get_params_size( smspec )) {
+  if ((params_map == NULL) && (data_size == ecl_smspec_get_params_size( smspec ))) {
     ecl_sum_tstep_type * ministep = ecl_sum_tstep_alloc( report_step , ministep_nr , smspec);
     ecl_kw_get_memcpy_data( params_kw , ministep->data );
     ecl_sum_tstep_set_time_info( ministep , smspec );
     return ministep;
+  } else if ((params_map != NULL) && (data_size == ecl_smspec_get_file_params_size( smspec ))) {
+    /* The header has been loaded selectively; pick out the loaded elements. */
+    ecl_sum_tstep_type * ministep = ecl_sum_tstep_alloc( report_step , ministep_nr , smspec);
+    const float * params = ecl_kw_get_float_ptr( params_kw );
+    int i;
+    for (i=0; i < ministep->data_size; i++)
+      ministep->data[i] = params[ int_vector_iget( params_map , i ) ];
+    ecl_sum_tstep_set_time_info( ministep , smspec );
+    return ministep;
   } else {
     /*
        This is actually a fatal error / bug; the difference in smspec
@@ -191,6 +202,20 @@ ecl_sum_tstep_type * ecl_sum_tstep_alloc_from_file( int report_step    ,
 }
 
 
+/**
+   Will create a new tstep from the @data vector, which must contain
+   ecl_smspec_get_params_size() elements ordered according to the
+   params_index of the smspec nodes.
+*/
+
+ecl_sum_tstep_type * ecl_sum_tstep_alloc_from_data( int report_step , int ministep_nr , const float * data , const ecl_smspec_type * smspec) {
+  ecl_sum_tstep_type * ministep = ecl_sum_tstep_alloc( report_step , ministep_nr , smspec);
+  memcpy( ministep->data , data , ministep->data_size * sizeof * ministep->data );
+  ecl_sum_tstep_set_time_info( ministep , smspec );
+  return ministep;
+}
+
+
 /*
   Should be called in write mode.
 */
@@ -218,6 +243,15 @@ double ecl_sum_tstep_iget(const ecl_sum_tstep_type * ministep , int index) {
 }
 
 
+/*
+  Returns a pointer to the raw PARAMS data of the tstep.
+*/
+
+const float * ecl_sum_tstep_get_data(const ecl_sum_tstep_type * ministep) {
+  return ministep->data;
+}
+
+
 time_t ecl_sum_tstep_get_sim_time(const ecl_sum_tstep_type * ministep) {
   return ministep->sim_time;
 }
@@ -22,6 +22,13 @@
 #include <string.h>
 #include <errno.h>
 
+#include "ert/util/build_config.h"
+
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include <ert/util/util.h>
 #include <ert/util/type_macros.h>
 #include <ert/ecl/fortio.h>
@@ -90,6 +97,14 @@ struct fortio_struct {
   */
   bool               readable;
   offset_type        read_size;
+
+  /*
+    Optional read only memory mapping of the complete file, see
+    fortio_mmap(). The mapping is an alternative view of the file
+    content, the stream based functions are not affected.
+  */
+  char             * mmap_data;
+  offset_type        mmap_size;
 };
 
 
@@ -105,6 +120,8 @@ static fortio_type * fortio_alloc__(const char *filename , bool fmt_file , bool
   fortio->stream_owner       = stream_owner;
   fortio->read_size          = 0;
   fortio->readable           = readable;
+  fortio->mmap_data          = NULL;
+  fortio->mmap_size          = 0;
   return fortio;
 }
 
@@ -395,7 +412,19 @@ bool fortio_assert_stream_open( fortio_type * fortio ) {
 /*****************************************************************/
 
 
+static void fortio_munmap( fortio_type * fortio ) {
+#ifdef HAVE_MMAP
+  if (fortio->mmap_data != NULL) {
+    munmap( fortio->mmap_data , fortio->mmap_size );
+    fortio->mmap_data = NULL;
+    fortio->mmap_size = 0;
+  }
+#endif
+}
+
+
 static void fortio_free__(fortio_type * fortio) {
+  fortio_munmap( fortio );
   util_safe_free(fortio->filename);
   free(fortio);
 }
@@ -405,6 +434,60 @@ void fortio_free_FILE_wrapper(fortio_type * fortio) {
 }
 
 
+/**
+   Will create a read only memory mapping of the complete file; the
+   keyword layer can then read headers and data directly from the
+   mapping, see ecl_kw_mmap_read_header() and ecl_kw_mmap_read_data().
+   The mapping is only created for unformatted files which have been
+   opened with fortio_open_reader(); for other files, on platforms
+   without mmap() or if the mmap() call fails the function will return
+   false and the stream based functions must be used. The mapping
+   stays valid until the fortio instance is closed, also when the
+   stream is closed with fortio_fclose_stream().
+*/
+
+bool fortio_mmap( fortio_type * fortio ) {
+#ifdef HAVE_MMAP
+  if ((fortio->mmap_data == NULL) &&
+      (fortio->stream != NULL) &&
+      !fortio->fmt_file &&
+      (strcmp( fortio->fopen_mode , READ_MODE_BINARY ) == 0)) {
+    struct stat stat_buffer;
+
+    if (fstat( fileno( fortio->stream ) , &stat_buffer ) == 0) {
+      if (stat_buffer.st_size > 0) {
+        void * map = mmap( NULL , stat_buffer.st_size , PROT_READ , MAP_SHARED , fileno( fortio->stream ) , 0 );
+        if (map != MAP_FAILED) {
+          fortio->mmap_data = map;
+          fortio->mmap_size = stat_buffer.st_size;
+        }
+      }
+    }
+  }
+#endif
+  return (fortio->mmap_data != NULL);
+}
+
+
+/*
+  Returns NULL if the file has not been mapped.
+*/
+
+const char * fortio_mmap_data( const fortio_type * fortio ) {
+  return fortio->mmap_data;
+}
+
+
+offset_type fortio_mmap_size( const fortio_type * fortio ) {
+  return fortio->mmap_size;
+}
+
+
+bool fortio_endian_flip_header( const fortio_type * fortio ) {
+  return fortio->endian_flip_header;
+}
+
+
 void fortio_fclose(fortio_type *fortio) {
   if (fortio->stream) {
     fclose(fortio->stream);
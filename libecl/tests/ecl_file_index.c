@@ -0,0 +1,118 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_file_index.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include <utime.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+
+/*
+  The index is not written for files modified during the current
+  second, the modification time is therefor set back in time.
+*/
+
+void write_file( const char * filename , int num_kw , time_t mtime) {
+  fortio_type * fortio = fortio_open_writer( filename , false , ECL_ENDIAN_FLIP );
+  int i;
+  for (i=0; i < num_kw; i++) {
+    ecl_kw_type * kw = ecl_kw_alloc( (i % 2) ? "ODD" : "EVEN" , 100 + i , ECL_INT_TYPE );
+    ecl_kw_scalar_set_int( kw , i );
+    ecl_kw_fwrite( kw , fortio );
+    ecl_kw_free( kw );
+  }
+  fortio_fclose( fortio );
+  {
+    struct utimbuf times;
+    times.actime = mtime;
+    times.modtime = mtime;
+    utime( filename , &times );
+  }
+}
+
+
+void test_file( const char * filename , int num_kw ) {
+  ecl_file_type * ecl_file = ecl_file_open( filename , ECL_FILE_INDEX );
+  int i;
+  test_assert_int_equal( ecl_file_get_size( ecl_file ) , num_kw );
+  test_assert_int_equal( ecl_file_get_num_named_kw( ecl_file , "EVEN" ) , (num_kw + 1) / 2);
+  for (i=0; i < num_kw; i++) {
+    ecl_kw_type * kw = ecl_file_iget_kw( ecl_file , i );
+    test_assert_int_equal( ecl_kw_get_size( kw ) , 100 + i );
+    test_assert_int_equal( ecl_kw_iget_int( kw , 0 ) , i );
+  }
+  ecl_file_close( ecl_file );
+}
+
+
+void test_index() {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_file_index" );
+  time_t mtime = time( NULL ) - 100;
+
+  write_file( "TEST.UNRST" , 5 , mtime );
+  {
+    ecl_file_type * ecl_file = ecl_file_open( "TEST.UNRST" , 0 );
+    ecl_file_close( ecl_file );
+    test_assert_false( util_file_exists( ".TEST.UNRST.index" ));
+  }
+
+  test_file( "TEST.UNRST" , 5 );
+  test_assert_true( util_file_exists( ".TEST.UNRST.index" ));
+  test_file( "TEST.UNRST" , 5 );
+
+  /* Stale index - the file has been rewritten. */
+  write_file( "TEST.UNRST" , 8 , mtime + 10 );
+  test_file( "TEST.UNRST" , 8 );
+  test_file( "TEST.UNRST" , 8 );
+
+  /* Corrupt index. */
+  {
+    FILE * stream = util_fopen( ".TEST.UNRST.index" , "r+");
+    util_ftruncate( stream , util_file_size( ".TEST.UNRST.index" ) - 3 );
+    fclose( stream );
+  }
+  test_file( "TEST.UNRST" , 8 );
+  test_file( "TEST.UNRST" , 8 );
+
+  /* Invalid type name in the first record - after the index header and the keyword header. */
+  {
+    FILE * stream = util_fopen( ".TEST.UNRST.index" , "r+");
+    long type_offset = 3 * sizeof(int) + sizeof(size_t) + sizeof(time_t) + 8;
+    fseek( stream , type_offset , SEEK_SET );
+    fwrite( "XXXX" , 1 , 4 , stream );
+    fclose( stream );
+  }
+  test_file( "TEST.UNRST" , 8 );
+  test_file( "TEST.UNRST" , 8 );
+
+  test_work_area_free( work_area );
+}
+
+
+int main( int argc , char ** argv) {
+  test_index();
+  exit(0);
+}
@@ -0,0 +1,118 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'ecl_file_mmap.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/ecl_endian_flip.h>
+
+
+void write_file( const char * filename ) {
+  fortio_type * fortio = fortio_open_writer( filename , false , ECL_ENDIAN_FLIP );
+  {
+    ecl_kw_type * int_kw    = ecl_kw_alloc( "INT" , 2500 , ECL_INT_TYPE );
+    ecl_kw_type * float_kw  = ecl_kw_alloc( "FLOAT" , 1001 , ECL_FLOAT_TYPE );
+    ecl_kw_type * double_kw = ecl_kw_alloc( "DOUBLE" , 10 , ECL_DOUBLE_TYPE );
+    ecl_kw_type * char_kw   = ecl_kw_alloc( "CHAR" , 250 , ECL_CHAR_TYPE );
+    ecl_kw_type * mess_kw   = ecl_kw_alloc( "MESS" , 0 , ECL_MESS_TYPE );
+    int i;
+
+    for (i=0; i < 2500; i++)
+      ecl_kw_iset_int( int_kw , i , i * 7 - 100);
+
+    for (i=0; i < 1001; i++)
+      ecl_kw_iset_float( float_kw , i , i * 0.25 );
+
+    for (i=0; i < 10; i++)
+      ecl_kw_iset_double( double_kw , i , i * 1e10 );
+
+    for (i=0; i < 250; i++) {
+      char * s = util_alloc_sprintf("S%d" , i);
+      ecl_kw_iset_string8( char_kw , i , s );
+      free( s );
+    }
+
+    ecl_kw_fwrite( int_kw , fortio );
+    ecl_kw_fwrite( float_kw , fortio );
+    ecl_kw_fwrite( mess_kw , fortio );
+    ecl_kw_fwrite( double_kw , fortio );
+    ecl_kw_fwrite( char_kw , fortio );
+    ecl_kw_fwrite( int_kw , fortio );
+
+    ecl_kw_free( int_kw );
+    ecl_kw_free( float_kw );
+    ecl_kw_free( double_kw );
+    ecl_kw_free( char_kw );
+    ecl_kw_free( mess_kw );
+  }
+  fortio_fclose( fortio );
+}
+
+
+void test_load() {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_file_mmap" );
+  write_file( "TEST.X0000" );
+  {
+    ecl_file_type * stream_file = ecl_file_open( "TEST.X0000" , 0 );
+    ecl_file_type * mmap_file   = ecl_file_open( "TEST.X0000" , ECL_FILE_MMAP );
+    int i;
+
+    test_assert_true( ecl_file_is_instance( mmap_file ));
+    test_assert_int_equal( ecl_file_get_size( stream_file ) , 6 );
+    test_assert_int_equal( ecl_file_get_size( stream_file ) , ecl_file_get_size( mmap_file ));
+
+    for (i=0; i < ecl_file_get_size( stream_file ); i++) {
+      ecl_kw_type * kw1 = ecl_file_iget_kw( stream_file , i );
+      ecl_kw_type * kw2 = ecl_file_iget_kw( mmap_file , i );
+      test_assert_true( ecl_kw_equal( kw1 , kw2 ));
+    }
+    test_assert_int_equal( ecl_file_get_num_named_kw( mmap_file , "INT" ) , 2 );
+
+    ecl_file_close( stream_file );
+    ecl_file_close( mmap_file );
+  }
+
+  {
+    ecl_file_type * ecl_file = ecl_file_open( "TEST.X0000" , ECL_FILE_MMAP | ECL_FILE_CLOSE_STREAM );
+    ecl_kw_type * kw = ecl_file_iget_named_kw( ecl_file , "CHAR" , 0 );
+    test_assert_string_equal( ecl_kw_iget_char_ptr( kw , 249 ) , "S249    " );
+    ecl_file_close( ecl_file );
+  }
+
+  {
+    offset_type file_size = util_file_size( "TEST.X0000" );
+    FILE * stream = util_fopen( "TEST.X0000" , "r+" );
+    util_ftruncate( stream , file_size - 10 );
+    fclose( stream );
+
+    test_assert_NULL( ecl_file_open( "TEST.X0000" , ECL_FILE_MMAP ));
+  }
+  test_work_area_free( work_area );
+}
+
+
+int main( int argc , char ** argv) {
+  test_load();
+  exit(0);
+}
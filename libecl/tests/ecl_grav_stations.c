@@ -0,0 +1,201 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_grav_stations.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/util_kernels.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/fortio.h>
+#include <ert/ecl/ecl_endian_flip.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/ecl_grid.h>
+#include <ert/ecl/ecl_region.h>
+#include <ert/ecl/ecl_kw_magic.h>
+#include <ert/ecl/ecl_grav.h>
+#include <ert/ecl/ecl_subsidence.h>
+
+#define NUM_STATIONS 37
+
+/*
+  The multi station functions are compared with the single station
+  functions on a small synthetic case; the results should be equal to
+  within rounding.
+*/
+
+
+static void write_kw( fortio_type * fortio , const char * name , int size , ecl_type_enum type , int seed ) {
+  ecl_kw_type * kw = ecl_kw_alloc( name , size , type );
+  int i;
+
+  for (i = 0; i < size; i++) {
+    if (type == ECL_FLOAT_TYPE)
+      ecl_kw_iset_float( kw , i , 100 + 50 * sin( 0.37 * i + seed ));
+    else
+      ecl_kw_iset_int( kw , i , 1 + (i + seed) % 3 );
+  }
+  ecl_kw_fwrite( kw , fortio );
+  ecl_kw_free( kw );
+}
+
+
+static void write_init( const char * filename , const ecl_grid_type * grid ) {
+  fortio_type * fortio = fortio_open_writer( filename , false , ECL_ENDIAN_FLIP );
+  const int active_size = ecl_grid_get_active_size( grid );
+  {
+    ecl_kw_type * intehead = ecl_kw_alloc( INTEHEAD_KW , 100 , ECL_INT_TYPE );
+    ecl_kw_scalar_set_int( intehead , 0 );
+    ecl_kw_iset_int( intehead , INTEHEAD_PHASE_INDEX , ECL_OIL_PHASE + ECL_GAS_PHASE + ECL_WATER_PHASE );
+    ecl_kw_iset_int( intehead , INTEHEAD_IPROG_INDEX , INTEHEAD_ECLIPSE100_VALUE );
+    ecl_kw_fwrite( intehead , fortio );
+    ecl_kw_free( intehead );
+  }
+  write_kw( fortio , PORV_KW , ecl_grid_get_global_size( grid ) , ECL_FLOAT_TYPE , 0 );
+  write_kw( fortio , PVTNUM_KW , active_size , ECL_INT_TYPE , 0 );
+  {
+    ecl_kw_type * aquifer = ecl_kw_alloc( AQUIFER_KW , active_size , ECL_INT_TYPE );
+    int i;
+    for (i = 0; i < active_size; i++)
+      ecl_kw_iset_int( aquifer , i , (i % 11 == 0) ? -1 : 0 );
+    ecl_kw_fwrite( aquifer , fortio );
+    ecl_kw_free( aquifer );
+  }
+  fortio_fclose( fortio );
+}
+
+
+static void write_restart( const char * filename , const ecl_grid_type * grid , int seed ) {
+  fortio_type * fortio = fortio_open_writer( filename , false , ECL_ENDIAN_FLIP );
+  const int active_size = ecl_grid_get_active_size( grid );
+
+  write_kw( fortio , "FIPOIL" , active_size , ECL_FLOAT_TYPE , seed );
+  write_kw( fortio , "FIPGAS" , active_size , ECL_FLOAT_TYPE , seed + 1 );
+  write_kw( fortio , "FIPWAT" , active_size , ECL_FLOAT_TYPE , seed + 2 );
+  write_kw( fortio , PRESSURE_KW , active_size , ECL_FLOAT_TYPE , seed + 3 );
+  fortio_fclose( fortio );
+}
+
+
+static void init_stations( double * utm_x , double * utm_y , double * depth ) {
+  int station;
+  for (station = 0; station < NUM_STATIONS; station++) {
+    utm_x[station] = -200 + 43 * station;
+    utm_y[station] = 1200 - 31 * station;
+    depth[station] = (station % 5) * 10;
+  }
+  /* One station inside the reservoir. */
+  utm_x[0] = 510;
+  utm_y[0] = 480;
+  depth[0] = 25;
+}
+
+
+static void test_grav( const ecl_grav_type * grav , ecl_region_type * region , const char * monitor , int phase_mask) {
+  double utm_x[NUM_STATIONS] , utm_y[NUM_STATIONS] , depth[NUM_STATIONS] , deltag[NUM_STATIONS];
+  int station;
+
+  init_stations( utm_x , utm_y , depth );
+  ecl_grav_eval_stations( grav , "BASE" , monitor , region , NUM_STATIONS , utm_x , utm_y , depth , phase_mask , deltag );
+  for (station = 0; station < NUM_STATIONS; station++) {
+    double expected = ecl_grav_eval( grav , "BASE" , monitor , region , utm_x[station] , utm_y[station] , depth[station] , phase_mask );
+    test_assert_true( expected != 0 );
+    test_assert_true( util_double_approx_equal__( deltag[station] , expected , 1e-10 ));
+  }
+}
+
+
+static void test_subsidence( const ecl_subsidence_type * subsidence , ecl_region_type * region , const char * monitor) {
+  double utm_x[NUM_STATIONS] , utm_y[NUM_STATIONS] , depth[NUM_STATIONS] , deltaz[NUM_STATIONS];
+  int station;
+
+  init_stations( utm_x , utm_y , depth );
+  ecl_subsidence_eval_stations( subsidence , "BASE" , monitor , region , NUM_STATIONS , utm_x , utm_y , depth , 1e-4 , 0.3 , deltaz );
+  for (station = 0; station < NUM_STATIONS; station++) {
+    double expected = ecl_subsidence_eval( subsidence , "BASE" , monitor , region , utm_x[station] , utm_y[station] , depth[station] , 1e-4 , 0.3 );
+    test_assert_true( expected != 0 );
+    test_assert_true( util_double_approx_equal__( deltaz[station] , expected , 1e-10 ));
+  }
+}
+
+
+int main( int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_grav_stations" );
+  const int nx = 20 , ny = 16 , nz = 8;   /* More cells than one cell block. */
+  int * actnum = util_calloc( nx * ny * nz , sizeof * actnum );
+  ecl_grid_type * grid;
+  int i;
+
+  for (i = 0; i < nx * ny * nz; i++)
+    actnum[i] = (i % 9 == 4) ? 0 : 1;
+  grid = ecl_grid_alloc_rectangular( nx , ny , nz , 90 , 100 , 10 , actnum );
+
+  write_init( "CASE.INIT" , grid );
+  write_restart( "BASE.UNRST" , grid , 0 );
+  write_restart( "MONITOR.UNRST" , grid , 7 );
+  {
+    ecl_file_type * init_file    = ecl_file_open( "CASE.INIT" , 0 );
+    ecl_file_type * base_file    = ecl_file_open( "BASE.UNRST" , 0 );
+    ecl_file_type * monitor_file = ecl_file_open( "MONITOR.UNRST" , 0 );
+    ecl_grav_type * grav = ecl_grav_alloc( grid , init_file );
+    ecl_subsidence_type * subsidence = ecl_subsidence_alloc( grid , init_file );
+    ecl_region_type * region = ecl_region_alloc( grid , false );
+    util_kernel_level_enum max_level = util_kernel_get_level( );
+    int level;
+
+    ecl_region_select_i1i2( region , 2 , 7 );
+
+    ecl_grav_new_std_density( grav , ECL_OIL_PHASE , 800 );
+    ecl_grav_new_std_density( grav , ECL_GAS_PHASE , 0.8 );
+    ecl_grav_new_std_density( grav , ECL_WATER_PHASE , 1000 );
+    ecl_grav_add_std_density( grav , ECL_OIL_PHASE , 2 , 850 );
+    ecl_grav_add_survey_FIP( grav , "BASE" , base_file );
+    ecl_grav_add_survey_FIP( grav , "MONITOR" , monitor_file );
+
+    ecl_subsidence_add_survey_PRESSURE( subsidence , "BASE" , base_file );
+    ecl_subsidence_add_survey_PRESSURE( subsidence , "MONITOR" , monitor_file );
+
+    for (level = UTIL_KERNEL_SCALAR; level <= max_level; level++) {
+      util_kernel_set_level( level );
+
+      test_grav( grav , NULL , "MONITOR" , ECL_OIL_PHASE + ECL_GAS_PHASE + ECL_WATER_PHASE );
+      test_grav( grav , NULL , "MONITOR" , ECL_GAS_PHASE );
+      test_grav( grav , region , "MONITOR" , ECL_OIL_PHASE + ECL_WATER_PHASE );
+      test_grav( grav , NULL , NULL , ECL_OIL_PHASE + ECL_GAS_PHASE + ECL_WATER_PHASE );
+
+      test_subsidence( subsidence , NULL , "MONITOR" );
+      test_subsidence( subsidence , region , "MONITOR" );
+      test_subsidence( subsidence , NULL , NULL );
+    }
+
+    ecl_region_free( region );
+    ecl_subsidence_free( subsidence );
+    ecl_grav_free( grav );
+    ecl_file_close( monitor_file );
+    ecl_file_close( base_file );
+    ecl_file_close( init_file );
+  }
+
+  ecl_grid_free( grid );
+  free( actnum );
+  test_work_area_free( work_area );
+  exit(0);
+}
@@ -0,0 +1,148 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_grid_compact.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_grid.h>
+
+
+/*
+  Creates a corner point grid with sloping pillars, varying layer
+  thickness and a mapaxes transformation, and saves it as an EGRID
+  file.
+*/
+
+void create_egrid( const char * filename , int nx , int ny , int nz) {
+  ecl_grid_type * rect_grid = ecl_grid_alloc_rectangular( nx , ny , nz , 100 , 150 , 5 , NULL );
+  float * coord = util_malloc( ecl_grid_get_coord_size( rect_grid ) * sizeof * coord );
+  float * zcorn = ecl_grid_alloc_zcorn_data( rect_grid );
+  int   * actnum = util_malloc( nx * ny * nz * sizeof * actnum );
+  float mapaxes[6] = {1000 , 2100 , 1000 , 2000 , 1100 , 2000};
+  int i;
+
+  ecl_grid_init_coord_data( rect_grid , coord );
+  for (i=0; i < (nx + 1) * (ny + 1); i++) {
+    coord[6*i]     += 3 * sin( i );
+    coord[6*i + 1] += 2 * cos( i );
+    coord[6*i + 3] += 7 * cos( 0.5 * i );
+    coord[6*i + 5] += 50;
+  }
+
+  for (i=0; i < 8*nx*ny*nz; i++)
+    zcorn[i] += 2000 + 0.5 * sin( 0.1 * i );
+
+  for (i=0; i < nx*ny*nz; i++)
+    actnum[i] = (i % 7) == 0 ? 0 : 1;
+
+  {
+    ecl_grid_type * grid = ecl_grid_alloc_GRDECL_data( nx , ny , nz , zcorn , coord , actnum , true , mapaxes );
+    ecl_grid_fwrite_EGRID2( grid , filename , ERT_ECL_METRIC_UNITS );
+    ecl_grid_free( grid );
+  }
+
+  free( actnum );
+  free( zcorn );
+  free( coord );
+  ecl_grid_free( rect_grid );
+}
+
+
+void test_compare( const ecl_grid_type * grid , const ecl_grid_type * compact_grid ) {
+  int g;
+
+  test_assert_false( ecl_grid_is_compact( grid ));
+  test_assert_true( ecl_grid_is_compact( compact_grid ));
+  test_assert_true( ecl_grid_compare( grid , compact_grid , true , false , true ));
+  test_assert_int_equal( ecl_grid_get_nactive( grid ) , ecl_grid_get_nactive( compact_grid ));
+
+  for (g = 0; g < ecl_grid_get_global_size( grid ); g++) {
+    double x1,y1,z1;
+    double x2,y2,z2;
+    int c;
+
+    ecl_grid_get_xyz1( grid , g , &x1 , &y1 , &z1 );
+    ecl_grid_get_xyz1( compact_grid , g , &x2 , &y2 , &z2 );
+    test_assert_true( (x1 == x2) && (y1 == y2) && (z1 == z2) );
+
+    for (c = 0; c < 8; c++) {
+      ecl_grid_get_cell_corner_xyz1( grid , g , c , &x1 , &y1 , &z1 );
+      ecl_grid_get_cell_corner_xyz1( compact_grid , g , c , &x2 , &y2 , &z2 );
+      test_assert_true( (x1 == x2) && (y1 == y2) && (z1 == z2) );
+    }
+
+    test_assert_true( ecl_grid_get_cell_volume1( grid , g ) == ecl_grid_get_cell_volume1( compact_grid , g ));
+    test_assert_true( ecl_grid_get_top1( grid , g ) == ecl_grid_get_top1( compact_grid , g ));
+    test_assert_true( ecl_grid_get_cell_dx1( grid , g ) == ecl_grid_get_cell_dx1( compact_grid , g ));
+    test_assert_true( ecl_grid_get_cell_dy1( grid , g ) == ecl_grid_get_cell_dy1( compact_grid , g ));
+    test_assert_true( ecl_grid_get_cell_dz1( grid , g ) == ecl_grid_get_cell_dz1( compact_grid , g ));
+
+    ecl_grid_get_xyz1( grid , g , &x1 , &y1 , &z1 );
+    test_assert_true( ecl_grid_cell_contains_xyz1( grid , g , x1 , y1 , z1 ) == ecl_grid_cell_contains_xyz1( compact_grid , g , x1 , y1 , z1 ));
+  }
+
+  {
+    double x,y,z;
+    ecl_grid_get_xyz3( grid , 3 , 4 , 2 , &x , &y , &z );
+    test_assert_int_equal( ecl_grid_get_global_index_from_xyz( (ecl_grid_type *) grid , x , y , z , 0 ) ,
+                           ecl_grid_get_global_index_from_xyz( (ecl_grid_type *) compact_grid , x , y , z , 0 ));
+    test_assert_int_equal( ecl_grid_get_global_index_from_xyz( (ecl_grid_type *) compact_grid , x , y , z , 0 ) ,
+                           ecl_grid_get_global_index3( grid , 3 , 4 , 2 ));
+  }
+}
+
+
+void test_copy( const ecl_grid_type * compact_grid ) {
+  ecl_grid_type * copy = ecl_grid_alloc_copy( compact_grid );
+  test_assert_true( ecl_grid_is_compact( copy ));
+  test_assert_true( ecl_grid_compare( compact_grid , copy , true , false , true ));
+  ecl_grid_free( copy );
+}
+
+
+void test_fwrite( ecl_grid_type * compact_grid ) {
+  ecl_grid_fwrite_EGRID2( compact_grid , "COPY.EGRID" , ERT_ECL_METRIC_UNITS );
+  {
+    ecl_grid_type * grid = ecl_grid_alloc_EGRID( "COPY.EGRID" , true );
+    test_assert_true( ecl_grid_compare( grid , compact_grid , true , false , true ));
+    ecl_grid_free( grid );
+  }
+}
+
+
+int main( int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_grid_compact" );
+  create_egrid( "CASE.EGRID" , 10 , 12 , 7 );
+  {
+    ecl_grid_type * grid = ecl_grid_alloc_EGRID( "CASE.EGRID" , true );
+    ecl_grid_type * compact_grid = ecl_grid_alloc_EGRID_compact( "CASE.EGRID" , true );
+
+    test_compare( grid , compact_grid );
+    test_copy( compact_grid );
+    test_fwrite( compact_grid );
+
+    ecl_grid_free( grid );
+    ecl_grid_free( compact_grid );
+  }
+  test_work_area_free( work_area );
+  exit(0);
+}
@@ -0,0 +1,185 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_grid_search.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_grid.h>
+#include <ert/ecl/ecl_grid_search.h>
+
+
+/*
+  Creates a corner point grid with sloping pillars, varying layer
+  thickness and a mapaxes transformation, and saves it as an EGRID
+  file.
+*/
+
+void create_egrid( const char * filename , int nx , int ny , int nz) {
+  ecl_grid_type * rect_grid = ecl_grid_alloc_rectangular( nx , ny , nz , 100 , 150 , 5 , NULL );
+  float * coord = util_malloc( ecl_grid_get_coord_size( rect_grid ) * sizeof * coord );
+  float * zcorn = ecl_grid_alloc_zcorn_data( rect_grid );
+  int   * actnum = util_malloc( nx * ny * nz * sizeof * actnum );
+  float mapaxes[6] = {1000 , 2100 , 1000 , 2000 , 1100 , 2000};
+  int i;
+
+  ecl_grid_init_coord_data( rect_grid , coord );
+  for (i=0; i < (nx + 1) * (ny + 1); i++) {
+    coord[6*i]     += 3 * sin( i );
+    coord[6*i + 1] += 2 * cos( i );
+    coord[6*i + 3] += 7 * cos( 0.5 * i );
+    coord[6*i + 5] += 50;
+  }
+
+  for (i=0; i < 8*nx*ny*nz; i++)
+    zcorn[i] += 2000 + 0.5 * sin( 0.1 * i );
+
+  for (i=0; i < nx*ny*nz; i++)
+    actnum[i] = (i % 7) == 0 ? 0 : 1;
+
+  {
+    ecl_grid_type * grid = ecl_grid_alloc_GRDECL_data( nx , ny , nz , zcorn , coord , actnum , true , mapaxes );
+    ecl_grid_fwrite_EGRID2( grid , filename , ERT_ECL_METRIC_UNITS );
+    ecl_grid_free( grid );
+  }
+
+  free( actnum );
+  free( zcorn );
+  free( coord );
+  ecl_grid_free( rect_grid );
+}
+
+
+static int exhaustive_find( const ecl_grid_type * grid , double x , double y , double z) {
+  int global_index;
+  for (global_index = 0; global_index < ecl_grid_get_global_size( grid ); global_index++) {
+    if (ecl_grid_cell_contains_xyz1( grid , global_index , x , y , z ))
+      return global_index;
+  }
+  return -1;
+}
+
+
+/*
+  The test points are the cell centers, all the cell corners (which
+  are on the boundary of several cells), points on a regular lattice
+  covering and extending beyond the grid and a NaN point.
+*/
+
+static int alloc_points( const ecl_grid_type * grid , double ** x , double ** y , double ** z ) {
+  const int global_size = ecl_grid_get_global_size( grid );
+  const int lattice = 12;
+  const int num_points = 9 * global_size + lattice * lattice * lattice + 1;
+  int num = 0;
+  int g , i , j , k;
+
+  *x = util_calloc( num_points , sizeof * *x );
+  *y = util_calloc( num_points , sizeof * *y );
+  *z = util_calloc( num_points , sizeof * *z );
+
+  for (g = 0; g < global_size; g++) {
+    ecl_grid_get_xyz1( grid , g , &(*x)[num] , &(*y)[num] , &(*z)[num] );
+    num++;
+    ecl_grid_get_cell_corners_xyz1( grid , g , &(*x)[num] , &(*y)[num] , &(*z)[num] );
+    num += 8;
+  }
+
+  {
+    double xmin = (*x)[0] , xmax = (*x)[0];
+    double ymin = (*y)[0] , ymax = (*y)[0];
+    double zmin = (*z)[0] , zmax = (*z)[0];
+
+    for (g = 0; g < num; g++) {
+      xmin = util_double_min( xmin , (*x)[g] ); xmax = util_double_max( xmax , (*x)[g] );
+      ymin = util_double_min( ymin , (*y)[g] ); ymax = util_double_max( ymax , (*y)[g] );
+      zmin = util_double_min( zmin , (*z)[g] ); zmax = util_double_max( zmax , (*z)[g] );
+    }
+
+    for (k = 0; k < lattice; k++)
+      for (j = 0; j < lattice; j++)
+        for (i = 0; i < lattice; i++) {
+          (*x)[num] = xmin - 10 + (xmax - xmin + 20) * i / (lattice - 1);
+          (*y)[num] = ymin - 10 + (ymax - ymin + 20) * j / (lattice - 1);
+          (*z)[num] = zmin - 1  + (zmax - zmin + 2)  * k / (lattice - 1);
+          num++;
+        }
+  }
+
+  (*x)[num] = NAN;
+  (*y)[num] = 0;
+  (*z)[num] = 0;
+  num++;
+
+  return num;
+}
+
+
+void test_search( const ecl_grid_type * grid ) {
+  ecl_grid_search_type * grid_search = ecl_grid_search_alloc( grid );
+  double * x , * y , * z;
+  int num_points = alloc_points( grid , &x , &y , &z );
+  int * global_index = util_calloc( num_points , sizeof * global_index );
+  int num_found = 0;
+  int p;
+
+  ecl_grid_search_find_points( grid_search , num_points , x , y , z , global_index );
+  for (p = 0; p < num_points; p++) {
+    int expected = exhaustive_find( grid , x[p] , y[p] , z[p] );
+    test_assert_int_equal( global_index[p] , expected );
+    test_assert_int_equal( ecl_grid_search_find( grid_search , x[p] , y[p] , z[p] ) , expected );
+    if (expected >= 0)
+      num_found++;
+  }
+  test_assert_true( num_found > ecl_grid_get_global_size( grid ));
+  test_assert_int_equal( global_index[ num_points - 1 ] , -1 );
+
+  {
+    double xc , yc , zc;
+    int g = ecl_grid_get_global_index3( grid , 3 , 4 , 2 );
+    ecl_grid_get_xyz1( grid , g , &xc , &yc , &zc );
+    test_assert_int_equal( ecl_grid_search_find( grid_search , xc , yc , zc ) , g );
+    test_assert_int_equal( ecl_grid_get_global_index_from_xyz( (ecl_grid_type *) grid , xc , yc , zc , 0 ) , g );
+  }
+
+  free( global_index );
+  free( x );
+  free( y );
+  free( z );
+  ecl_grid_search_free( grid_search );
+}
+
+
+int main( int argc , char ** argv) {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_grid_search" );
+  create_egrid( "CASE.EGRID" , 10 , 12 , 7 );
+  {
+    ecl_grid_type * grid = ecl_grid_alloc_EGRID( "CASE.EGRID" , true );
+    ecl_grid_type * compact_grid = ecl_grid_alloc_EGRID_compact( "CASE.EGRID" , true );
+
+    test_search( grid );
+    test_search( compact_grid );
+
+    ecl_grid_free( grid );
+    ecl_grid_free( compact_grid );
+  }
+  test_work_area_free( work_area );
+  exit(0);
+}
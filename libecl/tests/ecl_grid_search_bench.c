@@ -0,0 +1,131 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_grid_search_bench.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_grid.h>
+#include <ert/ecl/ecl_grid_search.h>
+
+/*
+  Microbenchmark comparing ecl_grid_get_global_index_from_xyz() with
+  the ecl_grid_search index on a corner point grid with sloping
+  pillars and undulating layers:
+
+     ecl_grid_search_bench [nx] [num_points] [num_linear]
+
+  The grid has nx*nx*nx/4 cells. The points are located in random
+  cells; the linear search is only timed for the first 'num_linear'
+  points, and the results are compared for those points.
+*/
+
+
+static double now( ) {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC , &ts );
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+
+static ecl_grid_type * alloc_grid( int nx , int ny , int nz ) {
+  ecl_grid_type * rect_grid = ecl_grid_alloc_rectangular( nx , ny , nz , 50 , 50 , 4 , NULL );
+  float * coord = util_malloc( ecl_grid_get_coord_size( rect_grid ) * sizeof * coord );
+  float * zcorn = ecl_grid_alloc_zcorn_data( rect_grid );
+  ecl_grid_type * grid;
+  int i;
+
+  ecl_grid_init_coord_data( rect_grid , coord );
+  for (i=0; i < (nx + 1) * (ny + 1); i++) {
+    coord[6*i]     += 5 * sin( i );
+    coord[6*i + 1] += 5 * cos( i );
+    coord[6*i + 3] += 10 * cos( 0.5 * i );
+    coord[6*i + 5] += 500;
+  }
+
+  for (i=0; i < 8*nx*ny*nz; i++)
+    zcorn[i] += 2000 + 0.3 * sin( 0.01 * i );
+
+  grid = ecl_grid_alloc_GRDECL_data( nx , ny , nz , zcorn , coord , NULL , false , NULL );
+  free( zcorn );
+  free( coord );
+  ecl_grid_free( rect_grid );
+  return grid;
+}
+
+
+int main( int argc , char ** argv) {
+  int nx         = 200;
+  int num_points = 1000000;
+  int num_linear = 100;
+
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &nx );
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &num_points );
+  if (argc > 3)
+    util_sscanf_int( argv[3] , &num_linear );
+  num_linear = util_int_min( num_linear , num_points );
+
+  {
+    ecl_grid_type * grid = alloc_grid( nx , nx , nx / 4 );
+    double * x = util_calloc( num_points , sizeof * x );
+    double * y = util_calloc( num_points , sizeof * y );
+    double * z = util_calloc( num_points , sizeof * z );
+    int * global_index = util_calloc( num_points , sizeof * global_index );
+    ecl_grid_search_type * grid_search;
+    int p , mismatch = 0;
+    double start , elapsed;
+
+    srand( 1 );
+    for (p = 0; p < num_points; p++) {
+      int g = rand( ) % ecl_grid_get_global_size( grid );
+      ecl_grid_get_xyz1( grid , g , &x[p] , &y[p] , &z[p] );
+    }
+    printf("Grid: %d x %d x %d cells   points: %d\n" , nx , nx , nx / 4 , num_points);
+
+    start = now( );
+    grid_search = ecl_grid_search_alloc( grid );
+    printf("%-36s : %10.3f s\n" , "ecl_grid_search_alloc()" , now( ) - start);
+
+    start = now( );
+    ecl_grid_search_find_points( grid_search , num_points , x , y , z , global_index );
+    elapsed = now( ) - start;
+    printf("%-36s : %10.3f us/point\n" , "ecl_grid_search_find_points()" , 1e6 * elapsed / num_points);
+
+    start = now( );
+    for (p = 0; p < num_linear; p++) {
+      if (ecl_grid_get_global_index_from_xyz( grid , x[p] , y[p] , z[p] , 0 ) != global_index[p])
+        mismatch++;
+    }
+    elapsed = now( ) - start;
+    if (num_linear > 0)
+      printf("%-36s : %10.3f us/point\n" , "ecl_grid_get_global_index_from_xyz()" , 1e6 * elapsed / num_linear);
+    printf("Mismatches: %d\n" , mismatch);
+
+    ecl_grid_search_free( grid_search );
+    free( global_index );
+    free( x );
+    free( y );
+    free( z );
+    ecl_grid_free( grid );
+  }
+  exit(0);
+}
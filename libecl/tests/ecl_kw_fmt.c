@@ -0,0 +1,154 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ecl_kw_fmt.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+#include <ert/util/test_work_area.h>
+
+#include <ert/ecl/ecl_kw.h>
+#include <ert/ecl/fortio.h>
+
+
+void test_parse() {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_kw_fmt_parse" );
+  {
+    FILE * stream = util_fopen("TEST.FINIT" , "w");
+    fprintf(stream , " 'FLOAT   '           6 'REAL'\n");
+    fprintf(stream , "   0.12500000E+01  -0.25000000e-01   0.10000000-105\n");
+    fprintf(stream , "   1.5   -3   0.75000000D+02\n");
+    fprintf(stream , " 'DOUBLE  '           4 'DOUB'\n");
+    fprintf(stream , "   0.10000000000000D+01  -0.12345678901234D-02   0.5D+310 0.000000000000000000000123456789012345678901234D+03\n");
+    fprintf(stream , " 'INT     '           3 'INTE'\n");
+    fprintf(stream , "           1 -2147483648  2147483647\n");
+    fprintf(stream , " 'CHAR    '           2 'CHAR'\n");
+    fprintf(stream , " 'A B     ' 'XYZ     '\n");
+    fclose( stream );
+  }
+  {
+    fortio_type * fortio = fortio_open_reader("TEST.FINIT" , true , false );
+    ecl_kw_type * float_kw  = ecl_kw_fread_alloc( fortio );
+    ecl_kw_type * double_kw = ecl_kw_fread_alloc( fortio );
+    ecl_kw_type * int_kw    = ecl_kw_fread_alloc( fortio );
+    ecl_kw_type * char_kw   = ecl_kw_fread_alloc( fortio );
+
+    test_assert_true( ecl_kw_iget_float( float_kw , 0 ) == 1.25f );
+    test_assert_true( ecl_kw_iget_float( float_kw , 1 ) == -0.025f );
+    test_assert_true( ecl_kw_iget_float( float_kw , 2 ) == 0.0f );
+    test_assert_true( ecl_kw_iget_float( float_kw , 3 ) == 1.5f );
+    test_assert_true( ecl_kw_iget_float( float_kw , 4 ) == -3.0f );
+    test_assert_true( ecl_kw_iget_float( float_kw , 5 ) == 75.0f );
+
+    test_assert_true( ecl_kw_iget_double( double_kw , 0 ) == 1.0 );
+    test_assert_true( ecl_kw_iget_double( double_kw , 1 ) == -0.0012345678901234 );
+    test_assert_true( isinf( ecl_kw_iget_double( double_kw , 2 )));
+    test_assert_true( ecl_kw_iget_double( double_kw , 3 ) == 1.23456789012345678901234e-19 );
+
+    test_assert_int_equal( ecl_kw_iget_int( int_kw , 0 ) , 1 );
+    test_assert_int_equal( ecl_kw_iget_int( int_kw , 1 ) , -2147483647 - 1 );
+    test_assert_int_equal( ecl_kw_iget_int( int_kw , 2 ) , 2147483647 );
+
+    test_assert_string_equal( ecl_kw_iget_char_ptr( char_kw , 0 ) , "A B     " );
+    test_assert_string_equal( ecl_kw_iget_char_ptr( char_kw , 1 ) , "XYZ     " );
+
+    ecl_kw_free( float_kw );
+    ecl_kw_free( double_kw );
+    ecl_kw_free( int_kw );
+    ecl_kw_free( char_kw );
+    fortio_fclose( fortio );
+  }
+  test_work_area_free( work_area );
+}
+
+
+/*
+  The formatted writer must produce exactly the same text as the
+  printf() based formatting, and reading the file back must give the
+  correctly rounded values of that text.
+*/
+
+void test_roundtrip() {
+  test_work_area_type * work_area = test_work_area_alloc("ecl_kw_fmt_roundtrip" );
+  const int size = 2003;
+  ecl_kw_type * float_kw  = ecl_kw_alloc( "FLOAT" , size , ECL_FLOAT_TYPE );
+  ecl_kw_type * double_kw = ecl_kw_alloc( "DOUBLE" , size , ECL_DOUBLE_TYPE );
+  ecl_kw_type * bool_kw   = ecl_kw_alloc( "BOOL" , size , ECL_BOOL_TYPE );
+  int i;
+
+  for (i=0; i < size; i++) {
+    double value = sin( i ) * pow( 10 , (i % 41) - 20 );
+    ecl_kw_iset_float( float_kw , i , value );
+    ecl_kw_iset_double( double_kw , i , value );
+    ecl_kw_iset_bool( bool_kw , i , (i % 3) == 0 );
+  }
+  ecl_kw_iset_float( float_kw , 0 , 0 );
+  ecl_kw_iset_float( float_kw , 1 , 1000 );
+  ecl_kw_iset_double( double_kw , 1 , -0.999999999999999 );
+
+  {
+    fortio_type * fortio = fortio_open_writer( "TEST.FINIT" , true , false );
+    ecl_kw_fwrite( float_kw , fortio );
+    ecl_kw_fwrite( double_kw , fortio );
+    ecl_kw_fwrite( bool_kw , fortio );
+    fortio_fclose( fortio );
+  }
+
+  {
+    FILE * stream = util_fopen( "TEST.FINIT" , "r");
+    char line[128];
+    test_assert_not_NULL( fgets( line , sizeof line , stream ));
+    test_assert_string_equal( line , " 'FLOAT   '        2003 'REAL'\n" );
+
+    test_assert_not_NULL( fgets( line , sizeof line , stream ));
+    test_assert_string_equal( line , "   0.00000000E+00   0.10000000E+04   0.90929742E-18   0.14112001E-17\n" );
+    fclose( stream );
+  }
+
+  {
+    fortio_type * fortio = fortio_open_reader( "TEST.FINIT" , true , false );
+    ecl_kw_type * float_kw2  = ecl_kw_fread_alloc( fortio );
+    ecl_kw_type * double_kw2 = ecl_kw_fread_alloc( fortio );
+    ecl_kw_type * bool_kw2   = ecl_kw_fread_alloc( fortio );
+
+    for (i=0; i < size; i++) {
+      test_assert_true( fabs( ecl_kw_iget_float( float_kw2 , i ) - ecl_kw_iget_float( float_kw , i )) <= 1e-7 * fabs( ecl_kw_iget_float( float_kw , i )));
+      test_assert_true( fabs( ecl_kw_iget_double( double_kw2 , i ) - ecl_kw_iget_double( double_kw , i )) <= 1e-13 * fabs( ecl_kw_iget_double( double_kw , i )));
+    }
+    test_assert_true( ecl_kw_equal( bool_kw , bool_kw2 ));
+
+    ecl_kw_free( float_kw2 );
+    ecl_kw_free( double_kw2 );
+    ecl_kw_free( bool_kw2 );
+    fortio_fclose( fortio );
+  }
+
+  ecl_kw_free( float_kw );
+  ecl_kw_free( double_kw );
+  ecl_kw_free( bool_kw );
+  test_work_area_free( work_area );
+}
+
+
+int main(int argc , char ** argv) {
+  test_parse();
+  test_roundtrip();
+  exit(0);
+}
@@ -20,11 +20,16 @@
 
 #include <ert/util/test_util.h>
 #include <ert/util/time_t_vector.h>
+#include <ert/util/double_vector.h>
 #include <ert/util/util.h>
 #include <ert/util/test_work_area.h>
 
 #include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_sum_vector.h>
 #include <ert/ecl/ecl_grid.h>
+#include <ert/ecl/ecl_file.h>
+#include <ert/ecl/ecl_file_kw.h>
+#include <ert/ecl/ecl_kw_magic.h>
 
 
 void write_summary( const char * name , time_t start_time , int nx , int ny , int nz , int num_dates, int num_ministep, double ministep_length) {
@@ -102,8 +107,223 @@ void test_write_read( ) {
 }
 
 
+/*
+  The column store must give exactly the same values as the row
+  oriented storage; both for plain vector lookup, interpolation in
+  time and after the vectors have been scaled.
+*/
+
+void test_column_store( ) {
+  const char * name = "CASE";
+  const char * keys[3] = {"FOPT" , "BPR:567" , "WWCT:OP-1"};
+  time_t start_time = util_make_date_utc( 1,1,2010 );
+  int num_dates = 5;
+  int num_ministep = 10;
+  double ministep_length = 36000; // Seconds
+  test_work_area_type * work_area = test_work_area_alloc("sum/column_store");
+
+  write_summary( name , start_time , 10 , 11 , 12 , num_dates , num_ministep , ministep_length);
+  {
+    ecl_sum_type * ecl_sum = ecl_sum_fread_alloc_case( name , ":" );
+    ecl_sum_vector_type * keylist = ecl_sum_vector_alloc( ecl_sum );
+    double_vector_type * row_values[3];
+    double_vector_type * row_interp[3];
+    double_vector_type * interp = double_vector_alloc( 0 , 0 );
+    int num_times = 7;
+    int ikey , itime;
+
+    test_assert_false( ecl_sum_has_column_store( ecl_sum ));
+    for (ikey = 0; ikey < 3; ikey++) {
+      int index = ecl_sum_get_general_var_params_index( ecl_sum , keys[ikey] );
+      ecl_sum_vector_add_key( keylist , keys[ikey] );
+      row_values[ikey] = ecl_sum_alloc_data_vector( ecl_sum , index , false );
+      row_interp[ikey] = double_vector_alloc( 0 , 0 );
+      for (itime = 0; itime < num_times; itime++) {
+        time_t sim_time = start_time + itime * 1.5 * ministep_length;
+        double_vector_append( row_interp[ikey] , ecl_sum_get_general_var_from_sim_time( ecl_sum , sim_time , keys[ikey] ));
+      }
+    }
+
+    ecl_sum_set_column_store( ecl_sum , true );
+    test_assert_true( ecl_sum_has_column_store( ecl_sum ));
+    for (ikey = 0; ikey < 3; ikey++) {
+      int index = ecl_sum_get_general_var_params_index( ecl_sum , keys[ikey] );
+      double_vector_type * col_values = ecl_sum_alloc_data_vector( ecl_sum , index , false );
+      test_assert_true( double_vector_equal( row_values[ikey] , col_values ));
+      double_vector_free( col_values );
+
+      for (itime = 0; itime < num_times; itime++) {
+        time_t sim_time = start_time + itime * 1.5 * ministep_length;
+        test_assert_double_equal( double_vector_iget( row_interp[ikey] , itime ) ,
+                                  ecl_sum_get_general_var_from_sim_time( ecl_sum , sim_time , keys[ikey] ));
+      }
+    }
+
+    for (itime = 0; itime < num_times; itime++) {
+      time_t sim_time = start_time + itime * 1.5 * ministep_length;
+      ecl_sum_get_interp_vector( ecl_sum , sim_time , keylist , interp );
+      test_assert_int_equal( 3 , double_vector_size( interp ));
+      for (ikey = 0; ikey < 3; ikey++)
+        test_assert_double_equal( double_vector_iget( row_interp[ikey] , itime ) , double_vector_iget( interp , ikey ));
+    }
+
+    {
+      ecl_sum_vector_type * empty_keylist = ecl_sum_vector_alloc( ecl_sum );
+      ecl_sum_get_interp_vector( ecl_sum , start_time , empty_keylist , interp );
+      test_assert_int_equal( 0 , double_vector_size( interp ));
+      ecl_sum_vector_free( empty_keylist );
+    }
+
+    {
+      int index = ecl_sum_get_general_var_params_index( ecl_sum , "BPR:567" );
+      double_vector_type * scaled;
+      ecl_sum_scale_vector( ecl_sum , index , 2.0 );
+      scaled = ecl_sum_alloc_data_vector( ecl_sum , index , false );
+      /* Element zero of the data vector is the start time. */
+      for (itime = 1; itime < double_vector_size( scaled ); itime++)
+        test_assert_double_equal( 2 * double_vector_iget( row_values[1] , itime ) , double_vector_iget( scaled , itime ));
+      double_vector_free( scaled );
+    }
+
+    ecl_sum_set_column_store( ecl_sum , false );
+    test_assert_false( ecl_sum_has_column_store( ecl_sum ));
+
+    for (ikey = 0; ikey < 3; ikey++) {
+      double_vector_free( row_values[ikey] );
+      double_vector_free( row_interp[ikey] );
+    }
+    double_vector_free( interp );
+    ecl_sum_vector_free( keylist );
+    ecl_sum_free( ecl_sum );
+  }
+  test_work_area_free( work_area );
+}
+
+
+void test_selected_load( ) {
+  const char * name = "CASE";
+  time_t start_time = util_make_date_utc( 1,1,2010 );
+  test_work_area_type * work_area = test_work_area_alloc("sum/selected");
+
+  write_summary( name , start_time , 10 , 11 , 12 , 5 , 10 , 36000 );
+  {
+    ecl_sum_type * ecl_sum = ecl_sum_fread_alloc_case( name , ":" );
+    stringlist_type * key_patterns = stringlist_alloc_new();
+    ecl_sum_type * selected;
+
+    stringlist_append_ref( key_patterns , "BPR:*" );
+    stringlist_append_ref( key_patterns , "WWCT:OP-1" );
+    selected = ecl_sum_fread_alloc_case_selected( name , ":" , key_patterns );
+    test_assert_true( ecl_sum_is_instance( selected ));
+
+    test_assert_false( ecl_sum_has_key( selected , "FOPT" ));
+    test_assert_true( ecl_sum_has_key( selected , "BPR:567" ));
+    test_assert_true( ecl_sum_has_key( selected , "WWCT:OP-1" ));
+
+    test_assert_int_equal( ecl_sum_get_data_length( ecl_sum ) , ecl_sum_get_data_length( selected ));
+    test_assert_time_t_equal( ecl_sum_get_end_time( ecl_sum ) , ecl_sum_get_end_time( selected ));
+    {
+      const char * keys[2] = {"BPR:567" , "WWCT:OP-1"};
+      for (int ikey = 0; ikey < 2; ikey++) {
+        double_vector_type * full = ecl_sum_alloc_data_vector( ecl_sum , ecl_sum_get_general_var_params_index( ecl_sum , keys[ikey] ) , false );
+        double_vector_type * part = ecl_sum_alloc_data_vector( selected , ecl_sum_get_general_var_params_index( selected , keys[ikey] ) , false );
+        test_assert_true( double_vector_equal( full , part ));
+        double_vector_free( full );
+        double_vector_free( part );
+      }
+    }
+
+    stringlist_free( key_patterns );
+    ecl_sum_free( selected );
+    ecl_sum_free( ecl_sum );
+  }
+  test_work_area_free( work_area );
+}
+
+
+/*
+  Writes the first @size bytes of @content to the file @filename; used
+  to emulate a summary file which is being written by a running
+  simulation.
+*/
+
+static void write_prefix( const char * filename , const char * content , offset_type size) {
+  FILE * stream = util_fopen( filename , "w");
+  util_fwrite( content , 1 , size , stream , __func__ );
+  fclose( stream );
+}
+
+
+static offset_type kw_offset( const ecl_file_type * ecl_file , const char * kw , int index) {
+  return ecl_file_kw_get_offset( ecl_file_iget_named_file_kw( ecl_file , kw , index ));
+}
+
+
+void test_refresh( ) {
+  const char * name = "CASE";
+  time_t start_time = util_make_date_utc( 1,1,2010 );
+  test_work_area_type * work_area = test_work_area_alloc("sum/refresh");
+
+  write_summary( name , start_time , 10 , 11 , 12 , 5 , 10 , 36000 );
+  {
+    ecl_sum_type * full_sum = ecl_sum_fread_alloc_case( name , ":" );
+    ecl_file_type * full_file = ecl_file_open( "CASE.UNSMRY" , 0 );
+    int full_size;
+    char * content = util_fread_alloc_file_content( "CASE.UNSMRY" , &full_size );
+    ecl_sum_type * ecl_sum;
+
+    /* Initial load: the first 12 complete ministeps. */
+    write_prefix( "CASE.UNSMRY" , content , kw_offset( full_file , MINISTEP_KW , 12 ));
+    ecl_sum = ecl_sum_fread_alloc_case( name , ":" );
+    test_assert_int_equal( 12 , ecl_sum_get_data_length( ecl_sum ));
+    test_assert_int_equal( 0 , ecl_sum_refresh( ecl_sum ));
+
+    /* The file ends in the middle of the PARAMS keyword of ministep 20. */
+    write_prefix( "CASE.UNSMRY" , content , kw_offset( full_file , PARAMS_KW , 20 ) + 40 );
+    test_assert_int_equal( 8 , ecl_sum_refresh( ecl_sum ));
+    test_assert_int_equal( 20 , ecl_sum_get_data_length( ecl_sum ));
+
+    /* The file ends in the middle of the header of MINISTEP 33. */
+    write_prefix( "CASE.UNSMRY" , content , kw_offset( full_file , MINISTEP_KW , 33 ) + 10 );
+    test_assert_int_equal( 13 , ecl_sum_refresh( ecl_sum ));
+    test_assert_int_equal( 33 , ecl_sum_get_data_length( ecl_sum ));
+
+    write_prefix( "CASE.UNSMRY" , content , full_size );
+    test_assert_int_equal( 17 , ecl_sum_refresh( ecl_sum ));
+    test_assert_int_equal( 0 , ecl_sum_refresh( ecl_sum ));
+
+    test_assert_int_equal( ecl_sum_get_data_length( full_sum ) , ecl_sum_get_data_length( ecl_sum ));
+    test_assert_int_equal( ecl_sum_get_last_report_step( full_sum ) , ecl_sum_get_last_report_step( ecl_sum ));
+    test_assert_time_t_equal( ecl_sum_get_end_time( full_sum ) , ecl_sum_get_end_time( ecl_sum ));
+    {
+      int index = ecl_sum_get_general_var_params_index( ecl_sum , "BPR:567" );
+      double_vector_type * full = ecl_sum_alloc_data_vector( full_sum , index , false );
+      double_vector_type * refreshed = ecl_sum_alloc_data_vector( ecl_sum , index , false );
+      test_assert_true( double_vector_equal( full , refreshed ));
+      double_vector_free( full );
+      double_vector_free( refreshed );
+
+      full = ecl_sum_alloc_data_vector( full_sum , index , true );
+      refreshed = ecl_sum_alloc_data_vector( ecl_sum , index , true );
+      test_assert_true( double_vector_equal( full , refreshed ));
+      double_vector_free( full );
+      double_vector_free( refreshed );
+    }
+
+    free( content );
+    ecl_file_close( full_file );
+    ecl_sum_free( ecl_sum );
+    ecl_sum_free( full_sum );
+  }
+  test_work_area_free( work_area );
+}
+
+
 
 int main( int argc , char ** argv) {
   test_write_read();
+  test_column_store();
+  test_selected_load();
+  test_refresh();
   exit(0);
 }
@@ -18,6 +18,18 @@ add_executable( ecl_kw_fread ecl_kw_fread.c )
 target_link_libraries( ecl_kw_fread ecl test_util )
 add_test( ecl_kw_fread ${EXECUTABLE_OUTPUT_PATH}/ecl_kw_fread  )
 
+add_executable( ecl_kw_fmt ecl_kw_fmt.c )
+target_link_libraries( ecl_kw_fmt ecl test_util )
+add_test( ecl_kw_fmt ${EXECUTABLE_OUTPUT_PATH}/ecl_kw_fmt  )
+
+add_executable( ecl_file_mmap ecl_file_mmap.c )
+target_link_libraries( ecl_file_mmap ecl test_util )
+add_test( ecl_file_mmap ${EXECUTABLE_OUTPUT_PATH}/ecl_file_mmap  )
+
+add_executable( ecl_file_index ecl_file_index.c )
+target_link_libraries( ecl_file_index ecl test_util )
+add_test( ecl_file_index ${EXECUTABLE_OUTPUT_PATH}/ecl_file_index  )
+
 add_executable( ecl_valid_basename ecl_valid_basename.c )
 target_link_libraries( ecl_valid_basename ecl test_util )
 add_test( ecl_valid_basename ${EXECUTABLE_OUTPUT_PATH}/ecl_valid_basename)
@@ -88,6 +100,22 @@ add_executable( ecl_grid_copy ecl_grid_copy.c )
 target_link_libraries( ecl_grid_copy ecl test_util )
 add_test( ecl_grid_copy ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_copy )
 
+add_executable( ecl_grid_compact ecl_grid_compact.c )
+target_link_libraries( ecl_grid_compact ecl test_util )
+add_test( ecl_grid_compact ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_compact )
+
+add_executable( ecl_grid_search ecl_grid_search.c )
+target_link_libraries( ecl_grid_search ecl test_util )
+add_test( ecl_grid_search ${EXECUTABLE_OUTPUT_PATH}/ecl_grid_search )
+
+# Microbenchmark for the ecl_grid_search index; not run as a test.
+add_executable( ecl_grid_search_bench ecl_grid_search_bench.c )
+target_link_libraries( ecl_grid_search_bench ecl )
+
+add_executable( ecl_grav_stations ecl_grav_stations.c )
+target_link_libraries( ecl_grav_stations ecl test_util )
+add_test( ecl_grav_stations ${EXECUTABLE_OUTPUT_PATH}/ecl_grav_stations )
+
 add_executable( ecl_get_num_cpu ecl_get_num_cpu_test.c )
 target_link_libraries( ecl_get_num_cpu ecl test_util )
 add_test( ecl_get_num_cpu ${EXECUTABLE_OUTPUT_PATH}/ecl_get_num_cpu 
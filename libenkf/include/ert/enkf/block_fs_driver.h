@@ -25,6 +25,9 @@ extern "C" {
 #include <stdio.h>
 #include <stdbool.h>
 
+#include <ert/util/stringlist.h>
+#include <ert/util/vector.h>
+
 #include <ert/enkf/fs_types.h>  
 
   typedef struct block_fs_driver_struct block_fs_driver_type;
@@ -41,6 +44,8 @@ extern "C" {
                                                     const char * ens_path_fmt, 
                                                     const char * filename );
   void                   block_fs_driver_fskip(FILE * fstab_stream);
+  void                   block_fs_driver_save_node_batch(void * _driver , const stringlist_type * node_keys , int report_step , int iens , const vector_type * buffers);
+  void                   block_fs_driver_save_vector_batch(void * _driver , const stringlist_type * node_keys , int iens , const vector_type * buffers);
 
 #ifdef __cplusplus
 }
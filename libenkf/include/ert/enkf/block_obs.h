@@ -86,6 +86,7 @@ VOID_FREE_HEADER(block_obs);
 VOID_GET_OBS_HEADER(block_obs);
 UTIL_IS_INSTANCE_HEADER(block_obs);
 VOID_MEASURE_HEADER(block_obs);
+VOID_ADD_MEAS_BLOCK_HEADER(block_obs);
 VOID_USER_GET_OBS_HEADER(block_obs);
 VOID_CHI2_HEADER(block_obs);
 VOID_UPDATE_STD_SCALE_HEADER(block_obs);
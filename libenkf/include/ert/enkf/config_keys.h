@@ -143,6 +143,9 @@ extern "C" {
 #define  SURFACE_KEY                       "SURFACE"
 #define  UPDATE_LOG_PATH_KEY               "UPDATE_LOG_PATH"
 #define  UPDATE_PATH_KEY                   "UPDATE_PATH"
+#define  UPDATE_THREADS_KEY                "UPDATE_THREADS"
+#define  UPDATE_BLOCK_SIZE_KEY             "UPDATE_BLOCK_SIZE"
+#define  LOAD_THREADS_KEY                  "LOAD_THREADS"
 #define  SINGLE_NODE_UPDATE_KEY            "SINGLE_NODE_UPDATE"
 #define  STORE_SEED_KEY                    "STORE_SEED"
 #define  UMASK_KEY                         "UMASK"
@@ -90,6 +90,7 @@
 
 #define DEFAULT_MAX_SUBMIT           2        /* The number of times to resubmit - default value for config item: MAX_SUBMIT */
 #define DEFAULT_MAX_INTERNAL_SUBMIT  1        /** Attached to keyword : MAX_RETRY */
+#define DEFAULT_LOAD_THREADS         0        /* The number of threads used when loading results; 0: one thread per core. */
 
 
 #define DEFAULT_LOG_LEVEL 1
@@ -128,6 +129,8 @@
 #define DEFAULT_ANALYSIS_MIN_REALISATIONS  0   // 0: No lower limit
 #define DEFAULT_ANALYSIS_STOP_LONG_RUNNING false 
 #define DEFAULT_MAX_RUNTIME                0
+#define DEFAULT_UPDATE_THREADS             0   // 0: One thread per core
+#define DEFAULT_UPDATE_BLOCK_SIZE          0   // 0: Update the full dataset at once
 #define DEFAULT_ITER_RETRY_COUNT           4
 
 
@@ -28,6 +28,7 @@ extern "C" {
 #include <ert/util/type_macros.h>
 #include <ert/util/buffer.h>
 #include <ert/util/stringlist.h>
+#include <ert/util/vector.h>
 
 #include <ert/enkf/fs_driver.h>
 #include <ert/enkf/enkf_types.h>
@@ -45,6 +46,7 @@ extern "C" {
   const      char * enkf_fs_get_case_name( const enkf_fs_type * fs );
   bool              enkf_fs_is_read_only(const enkf_fs_type * fs);
   void              enkf_fs_fsync( enkf_fs_type * fs );
+  int               enkf_fs_compact( enkf_fs_type * fs , double fragmentation_limit );
   void              enkf_fs_add_index_node(enkf_fs_type *  , int , int , const char * , enkf_var_type, ert_impl_type);
   
   enkf_fs_type    * enkf_fs_get_ref( enkf_fs_type * fs );
@@ -58,11 +60,29 @@ extern "C" {
   void              enkf_fs_fwrite_node(enkf_fs_type * enkf_fs , buffer_type * buffer , const char * node_key, enkf_var_type var_type,  
                                         int report_step , int iens);
   
+  void              enkf_fs_fwrite_node_batch(enkf_fs_type * enkf_fs ,
+                                              const vector_type * buffers ,
+                                              const stringlist_type * node_keys ,
+                                              enkf_var_type var_type ,
+                                              int report_step ,
+                                              int iens);
+
   void              enkf_fs_fwrite_vector(enkf_fs_type * enkf_fs , 
                                           buffer_type * buffer , 
                                           const char * node_key, 
                                           enkf_var_type var_type,  
                                           int iens); 
+
+  void              enkf_fs_fwrite_vector_batch(enkf_fs_type * enkf_fs ,
+                                                const vector_type * buffers ,
+                                                const stringlist_type * node_keys ,
+                                                enkf_var_type var_type ,
+                                                int iens);
+
+  bool              enkf_fs_has_ensemble_vector(enkf_fs_type * enkf_fs , const char * node_key , enkf_var_type var_type);
+  bool              enkf_fs_fread_ensemble_vector(enkf_fs_type * enkf_fs , buffer_type * buffer , const char * node_key , enkf_var_type var_type);
+  bool              enkf_fs_fwrite_ensemble_vector(enkf_fs_type * enkf_fs , buffer_type * buffer , const char * node_key , enkf_var_type var_type);
+  int               enkf_fs_get_vector_write_count( enkf_fs_type * enkf_fs , enkf_var_type var_type , int iens );
   
   bool              enkf_fs_exists( const char * mount_point );
 
@@ -257,20 +257,30 @@ void prefix ## _get_observations__(const void * void_arg , obs_data_type * obs_d
 /*****************************************************************/
 
 #define VOID_MEASURE(obs_prefix, state_prefix) \
-void obs_prefix ## _measure__(const void * void_obs ,  const void * void_state , node_id_type node_id , meas_data_type * meas_data , const active_list_type * __active_list) { \
+void obs_prefix ## _measure__(const void * void_obs ,  const void * void_state , node_id_type node_id , meas_block_type * meas_block , const active_list_type * __active_list) { \
    const obs_prefix ## _type   * obs   = obs_prefix ## _safe_cast_const( void_obs );     \
    const state_prefix ## _type * state = state_prefix ## _safe_cast_const( void_state );       \
-   obs_prefix ## _measure(obs , state , node_id , meas_data , __active_list); \
+   obs_prefix ## _measure(obs , state , node_id , meas_block , __active_list); \
 }
 
 #define VOID_MEASURE_UNSAFE(obs_prefix, state_prefix) \
-void obs_prefix ## _measure__(const void * void_obs ,  const void * state , node_id_type node_id , meas_data_type * meas_data , const active_list_type * __active_list) { \
+void obs_prefix ## _measure__(const void * void_obs ,  const void * state , node_id_type node_id , meas_block_type * meas_block , const active_list_type * __active_list) { \
    const obs_prefix ## _type   * obs   = obs_prefix ## _safe_cast_const( void_obs );     \
-   obs_prefix ## _measure(obs , state , node_id , meas_data , __active_list); \
+   obs_prefix ## _measure(obs , state , node_id , meas_block , __active_list); \
 }
 
 
-#define VOID_MEASURE_HEADER(obs_prefix) void obs_prefix ## _measure__(const void * ,  const void * , node_id_type , meas_data_type * , const active_list_type *)
+#define VOID_MEASURE_HEADER(obs_prefix) void obs_prefix ## _measure__(const void * ,  const void * , node_id_type , meas_block_type * , const active_list_type *)
+
+/*****************************************************************/
+
+#define VOID_ADD_MEAS_BLOCK(obs_prefix) \
+meas_block_type * obs_prefix ## _add_meas_block__(const void * void_obs , meas_data_type * meas_data , int report_step , const active_list_type * __active_list) { \
+   const obs_prefix ## _type   * obs   = obs_prefix ## _safe_cast_const( void_obs );     \
+   return obs_prefix ## _add_meas_block(obs , meas_data , report_step , __active_list); \
+}
+
+#define VOID_ADD_MEAS_BLOCK_HEADER(obs_prefix) meas_block_type * obs_prefix ## _add_meas_block__(const void * , meas_data_type * , int , const active_list_type *)
 
 /*****************************************************************/
 
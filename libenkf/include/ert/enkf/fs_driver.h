@@ -23,6 +23,7 @@ extern "C" {
 #endif
 #include <ert/util/buffer.h>
 #include <ert/util/stringlist.h>
+#include <ert/util/vector.h>
 
 #include <ert/enkf/enkf_node.h>
 #include <ert/enkf/fs_types.h>
@@ -167,13 +168,25 @@ extern "C" {
   typedef void (save_node_ftype)    (void * driver, const char * , int , int , buffer_type * );
   typedef void (unlink_node_ftype)  (void * driver, const char * , int , int );
   typedef bool (has_node_ftype)     (void * driver, const char * , int , int );
+  typedef void (save_node_batch_ftype)    (void * driver, const stringlist_type * , int , int , const vector_type * );
   
   typedef void (load_vector_ftype)    (void * driver, const char * , int , buffer_type * );
   typedef void (save_vector_ftype)    (void * driver, const char * , int , buffer_type * );
   typedef void (unlink_vector_ftype)  (void * driver, const char * , int );
   typedef bool (has_vector_ftype)     (void * driver, const char * , int );
+  typedef void (save_vector_batch_ftype)  (void * driver, const stringlist_type * , int , const vector_type * );
+
+  /*
+    Ensemble vectors hold the vector data of one key for all the
+    realizations as one record; they are optional for the drivers.
+  */
+  typedef void (load_ensemble_vector_ftype)    (void * driver, const char * , buffer_type * );
+  typedef void (save_ensemble_vector_ftype)    (void * driver, const char * , buffer_type * );
+  typedef void (unlink_ensemble_vector_ftype)  (void * driver, const char * );
+  typedef bool (has_ensemble_vector_ftype)     (void * driver, const char * );
   
   typedef void (fsync_driver_ftype) (void * driver);
+  typedef int  (compact_driver_ftype) (void * driver , double fragmentation_limit);
   typedef void (free_driver_ftype)  (void * driver);
 
 
@@ -198,18 +211,25 @@ extern "C" {
 
    
 
-#define FS_DRIVER_FIELDS                   \
-load_node_ftype           * load_node;     \
-save_node_ftype           * save_node;     \
-has_node_ftype            * has_node;      \
-unlink_node_ftype         * unlink_node;   \
-load_vector_ftype         * load_vector;   \
-save_vector_ftype         * save_vector;   \
-has_vector_ftype          * has_vector;    \
-unlink_vector_ftype       * unlink_vector; \
-free_driver_ftype         * free_driver;   \
-fsync_driver_ftype        * fsync_driver;  \
-int                         type_id
+#define FS_DRIVER_FIELDS                                     \
+load_node_ftype              * load_node;                \
+save_node_ftype              * save_node;                \
+has_node_ftype               * has_node;                 \
+unlink_node_ftype            * unlink_node;              \
+save_node_batch_ftype        * save_node_batch;          \
+load_vector_ftype            * load_vector;              \
+save_vector_ftype            * save_vector;              \
+has_vector_ftype             * has_vector;               \
+unlink_vector_ftype          * unlink_vector;            \
+save_vector_batch_ftype      * save_vector_batch;        \
+load_ensemble_vector_ftype   * load_ensemble_vector;     \
+save_ensemble_vector_ftype   * save_ensemble_vector;     \
+has_ensemble_vector_ftype    * has_ensemble_vector;      \
+unlink_ensemble_vector_ftype * unlink_ensemble_vector;   \
+free_driver_ftype            * free_driver;              \
+fsync_driver_ftype           * fsync_driver;             \
+compact_driver_ftype         * compact_driver;           \
+int                            type_id
 
 
 
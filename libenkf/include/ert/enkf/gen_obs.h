@@ -50,6 +50,7 @@ UTIL_IS_INSTANCE_HEADER(gen_obs);
 VOID_FREE_HEADER(gen_obs);
 VOID_GET_OBS_HEADER(gen_obs);
 VOID_MEASURE_HEADER(gen_obs);
+VOID_ADD_MEAS_BLOCK_HEADER(gen_obs);
 VOID_USER_GET_OBS_HEADER(gen_obs);
 VOID_UPDATE_STD_SCALE_HEADER(gen_obs);
 
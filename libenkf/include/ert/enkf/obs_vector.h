@@ -48,7 +48,8 @@ extern "C" {
 
   typedef void   (obs_free_ftype)                (void *);
   typedef void   (obs_get_ftype)                 (const void * , obs_data_type * , enkf_fs_type *, int , const active_list_type * );
-  typedef void   (obs_meas_ftype)                (const void * , const void *, node_id_type , meas_data_type * , const active_list_type * );
+  typedef void   (obs_meas_ftype)                (const void * , const void *, node_id_type , meas_block_type * , const active_list_type * );
+  typedef meas_block_type * (obs_add_meas_block_ftype) (const void * , meas_data_type * , int , const active_list_type * );
   typedef void   (obs_user_get_ftype)            (void * , const char * , double * , double * , bool *);
   typedef void   (obs_update_std_scale_ftype)    (void * , double , const active_list_type * );
   typedef double (obs_chi2_ftype)                (const void * , const void *, node_id_type );
@@ -68,6 +69,8 @@ extern "C" {
   void                 obs_vector_iget_observations(const obs_vector_type *  , int  , obs_data_type * , const active_list_type * active_list, enkf_fs_type * fs);
   bool                 obs_vector_has_data( const obs_vector_type * obs_vector , const bool_vector_type * active_mask , enkf_fs_type * fs);
   void                 obs_vector_measure(const obs_vector_type *  , enkf_fs_type * fs, int report_step , const int_vector_type * ens_active_list , meas_data_type * , const active_list_type * active_list);
+  meas_block_type    * obs_vector_add_meas_block(const obs_vector_type * obs_vector , int report_step , meas_data_type * meas_data , const active_list_type * active_list);
+  void                 obs_vector_measure_block(const obs_vector_type * obs_vector , enkf_fs_type * fs , int report_step , const int_vector_type * ens_active_list , meas_block_type * meas_block , const active_list_type * active_list);
   const char         * obs_vector_get_state_kw(const obs_vector_type * );
   const char         * obs_vector_get_key(const obs_vector_type * );
   obs_impl_type        obs_vector_get_impl_type(const obs_vector_type * );
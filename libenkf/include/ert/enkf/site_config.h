@@ -91,6 +91,8 @@ typedef struct site_config_struct site_config_type;
 
   void                     site_config_set_max_submit( site_config_type * site_config , int max_submit );
   int                      site_config_get_max_submit(const site_config_type * site_config );
+  void                     site_config_set_load_threads( site_config_type * site_config , int load_threads );
+  int                      site_config_get_load_threads(const site_config_type * site_config );
 
   bool                     site_config_queue_is_running( const site_config_type * site_config );
   int                      site_config_install_job(site_config_type * site_config , const char * job_name , const char * install_file);
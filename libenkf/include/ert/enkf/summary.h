@@ -27,6 +27,8 @@
 #include <ert/enkf/enkf_util.h>
 #include <ert/enkf/summary_config.h>
 
+#define SUMMARY_UNDEF -9999
+
 
 
 
@@ -0,0 +1,53 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'summary_block.h' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_SUMMARY_BLOCK_H
+#define ERT_SUMMARY_BLOCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdbool.h>
+
+#include <ert/util/type_macros.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/double_vector.h>
+
+#include <ert/enkf/enkf_fs.h>
+#include <ert/enkf/enkf_config_node.h>
+
+  typedef struct summary_block_struct summary_block_type;
+
+  summary_block_type * summary_block_alloc_load( enkf_fs_type * fs , const enkf_config_node_type * config_node , int ens_size , const int_vector_type * ens_active_list );
+  bool                 summary_block_update_fs( enkf_fs_type * fs , const enkf_config_node_type * config_node , int ens_size , const int_vector_type * ens_active_list );
+  void                 summary_block_free( summary_block_type * block );
+  int                  summary_block_get_ens_size( const summary_block_type * block );
+  int                  summary_block_get_num_steps( const summary_block_type * block );
+  bool                 summary_block_has_member( const summary_block_type * block , int iens );
+  int                  summary_block_get_member_num_steps( const summary_block_type * block , int iens );
+  double               summary_block_iget( const summary_block_type * block , int iens , int step );
+  const double       * summary_block_iget_member_data( const summary_block_type * block , int iens );
+  void                 summary_block_get_member_vector( const summary_block_type * block , int iens , double_vector_type * values );
+
+  UTIL_IS_INSTANCE_HEADER( summary_block );
+
+#ifdef __cplusplus
+}
+#endif
+#endif
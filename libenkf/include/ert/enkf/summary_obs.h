@@ -86,6 +86,7 @@ void summary_obs_update_std_scale(summary_obs_type * summary_obs, double std_mul
 VOID_FREE_HEADER(summary_obs);
 VOID_GET_OBS_HEADER(summary_obs);
 VOID_MEASURE_HEADER(summary_obs);
+VOID_ADD_MEAS_BLOCK_HEADER(summary_obs);
 UTIL_IS_INSTANCE_HEADER(summary_obs);
 VOID_USER_GET_OBS_HEADER(summary_obs);
 VOID_CHI2_HEADER(summary_obs);
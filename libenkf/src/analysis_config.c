@@ -62,6 +62,8 @@ struct analysis_config_struct {
   bool                            stop_long_running;
   bool                            std_scale_correlated_obs;
   int                             max_runtime;
+  int                             update_threads;              /* The number of threads used to (de)serialize and multiply during the update; 0 => one per core. */
+  int                             update_block_size;           /* Max number of rows in the A matrix when updating in row blocks; 0 => the full dataset at once. */
   double                          global_std_scaling;
 };
 
@@ -167,6 +169,35 @@ void analysis_config_set_max_runtime( analysis_config_type * config, int max_run
   config->max_runtime = max_runtime;
 }
 
+/**
+   The update_threads setting is the value from the config file; the
+   getter will return the number of threads to actually use, i.e. the
+   number of cores when update_threads has not been set.
+*/
+
+void analysis_config_set_update_threads( analysis_config_type * config, int update_threads ) {
+  if (update_threads < 0)
+    util_abort("%s: invalid number of update threads:%d \n",__func__ , update_threads);
+  config->update_threads = update_threads;
+}
+
+int analysis_config_get_update_threads( const analysis_config_type * config ) {
+  if (config->update_threads > 0)
+    return config->update_threads;
+  else
+    return util_get_num_cpu( );
+}
+
+void analysis_config_set_update_block_size( analysis_config_type * config, int update_block_size ) {
+  if (update_block_size < 0)
+    util_abort("%s: invalid update block size:%d \n",__func__ , update_block_size);
+  config->update_block_size = update_block_size;
+}
+
+int analysis_config_get_update_block_size( const analysis_config_type * config ) {
+  return config->update_block_size;
+}
+
 static void analysis_config_set_min_realisations( analysis_config_type * config , int min_realisations) {
   config->min_realisations = min_realisations;
 }
@@ -502,6 +533,14 @@ void analysis_config_init( analysis_config_type * analysis , const config_conten
     analysis_config_set_max_runtime( analysis, config_content_get_value_as_int( config, MAX_RUNTIME_KEY ));
   }
 
+  if (config_content_has_item( config, UPDATE_THREADS_KEY)) {
+    analysis_config_set_update_threads( analysis, config_content_get_value_as_int( config, UPDATE_THREADS_KEY ));
+  }
+
+  if (config_content_has_item( config, UPDATE_BLOCK_SIZE_KEY)) {
+    analysis_config_set_update_block_size( analysis, config_content_get_value_as_int( config, UPDATE_BLOCK_SIZE_KEY ));
+  }
+
 
   /* Loading external modules */
   analysis_config_load_all_external_modules_from_config(analysis, config);
@@ -603,6 +642,8 @@ analysis_config_type * analysis_config_alloc( rng_type * rng ) {
   analysis_config_set_min_realisations( config         , DEFAULT_ANALYSIS_MIN_REALISATIONS );
   analysis_config_set_stop_long_running( config        , DEFAULT_ANALYSIS_STOP_LONG_RUNNING );
   analysis_config_set_max_runtime( config              , DEFAULT_MAX_RUNTIME );
+  analysis_config_set_update_threads( config           , DEFAULT_UPDATE_THREADS );
+  analysis_config_set_update_block_size( config        , DEFAULT_UPDATE_BLOCK_SIZE );
 
   config->analysis_module      = NULL;
   config->analysis_modules     = hash_alloc();
@@ -643,6 +684,8 @@ void analysis_config_add_config_items( config_parser_type * config ) {
   config_add_key_value( config , UPDATE_LOG_PATH_KEY         , false , CONFIG_STRING);
   config_add_key_value( config , MIN_REALIZATIONS_KEY        , false , CONFIG_STRING );
   config_add_key_value( config , MAX_RUNTIME_KEY             , false , CONFIG_INT );
+  config_add_key_value( config , UPDATE_THREADS_KEY          , false , CONFIG_INT );
+  config_add_key_value( config , UPDATE_BLOCK_SIZE_KEY       , false , CONFIG_INT );
   config_add_key_value( config , STD_SCALE_CORRELATED_OBS_KEY, false , CONFIG_BOOL );
 
   item = config_add_key_value( config , STOP_LONG_RUNNING_KEY, false,  CONFIG_BOOL );
@@ -695,6 +738,18 @@ void analysis_config_fprintf_config( analysis_config_type * config , FILE * stre
     fprintf( stream , CONFIG_ENDVALUE_FORMAT   , CONFIG_BOOL_STRING( config->single_node_update ));
   }
 
+  if (config->update_threads != DEFAULT_UPDATE_THREADS) {
+    fprintf( stream , CONFIG_KEY_FORMAT   , UPDATE_THREADS_KEY );
+    fprintf( stream , CONFIG_INT_FORMAT   , config->update_threads );
+    fprintf( stream , "\n");
+  }
+
+  if (config->update_block_size != DEFAULT_UPDATE_BLOCK_SIZE) {
+    fprintf( stream , CONFIG_KEY_FORMAT   , UPDATE_BLOCK_SIZE_KEY );
+    fprintf( stream , CONFIG_INT_FORMAT   , config->update_block_size );
+    fprintf( stream , "\n");
+  }
+
   if (config->rerun) {
     fprintf( stream , CONFIG_KEY_FORMAT        , ENKF_RERUN_KEY);
     fprintf( stream , CONFIG_ENDVALUE_FORMAT   , CONFIG_BOOL_STRING( config->rerun ));
@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <ert/util/util.h>
 #include <ert/util/path_fmt.h>
@@ -26,6 +27,8 @@
 #include <ert/util/buffer.h>
 #include <ert/util/timer.h>
 #include <ert/util/thread_pool.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/vector.h>
 
 #include <ert/enkf/fs_types.h>
 #include <ert/enkf/fs_driver.h>
@@ -44,17 +47,43 @@ struct bfs_config_struct {
   int             block_size;
   int             max_cache_size;
   bool            bfs_lock;
+  bool            mmap_read;
+  int             compression_level;   /* zlib level for the stored nodes; 0: no compression. */
 };
 
 
 #define  BFS_TYPE_ID  5510643
 
+/*
+  The node format of each block_fs instance is recorded in the file
+  BFS_FORMAT_KEY, which is written when a new (empty) block_fs
+  instance is mounted read-write. The key does not parse as a node
+  key, see block_fs_sscanf_key().
+
+  BFS_FORMAT_NODE_HEADER: every node starts with an int of flags. If
+  the BFS_NODE_COMPRESSED flag is set the flags are followed by the
+  uncompressed size (int) and the zlib compressed data, otherwise by
+  the raw data.
+
+  block_fs instances without the format file were written before the
+  node header was introduced; their nodes are read and written raw,
+  without compression.
+*/
+
+#define  BFS_FORMAT_KEY           "BFS_FORMAT"
+#define  BFS_FORMAT_RAW           0
+#define  BFS_FORMAT_NODE_HEADER   1
+
+#define  BFS_NODE_COMPRESSED      1
+#define  BFS_COMPRESS_MIN_SIZE    512     /* Nodes smaller than this are never compressed. */
+
 struct bfs_struct  {
   UTIL_TYPE_ID_DECLARATION;
   /*-----------------------------------------------------------------*/
   /* New variables */
   block_fs_type * block_fs;
   char          * mountfile;  // The full path to the file mounted by the block_fs layer - including extension. 
+  int             format;     // BFS_FORMAT_RAW | BFS_FORMAT_NODE_HEADER
 
   const bfs_config_type * config;
 };
@@ -82,6 +111,21 @@ bfs_config_type * bfs_config_alloc( fs_driver_enum driver_type , bool read_only,
   const bool DYNAMIC_preload       = true;
   const bool DEFAULT_preload       = false;
 
+  /* FIELD and SURFACE parameters dominate the storage; they are compressed with the fast zlib level 1. */
+  const int PARAMETER_compression  = 1;
+  const int DYNAMIC_compression    = 0;
+  const int DEFAULT_compression    = 0;
+
+  /*
+    The parameters and the dynamic results are read concurrently by
+    many threads during loading and updating; they are served from a
+    memory mapping of the data file. The small index filesystems are
+    read with the stream based code.
+  */
+  const bool PARAMETER_mmap_read   = true;
+  const bool DYNAMIC_mmap_read     = true;
+  const bool DEFAULT_mmap_read     = false;
+
   const int max_cache_size         = 512; 
   const int fsync_interval         =  10;     /* An fsync() call is issued for every 10'th write. */
   const double fragmentation_limit = 1.0;     /* 1.0 => NO defrag is run. */
@@ -98,15 +142,24 @@ bfs_config_type * bfs_config_alloc( fs_driver_enum driver_type , bool read_only,
     case( DRIVER_PARAMETER ):
       config->block_size = PARAMETER_blocksize;
       config->preload = PARAMETER_preload;
+      config->compression_level = PARAMETER_compression;
+      config->mmap_read = PARAMETER_mmap_read;
       break;
     case(DRIVER_DYNAMIC_FORECAST):
       config->block_size = DYNAMIC_blocksize;
       config->preload = DYNAMIC_preload;
+      config->compression_level = DYNAMIC_compression;
+      config->mmap_read = DYNAMIC_mmap_read;
       break;
     default:
       config->block_size = DEFAULT_blocksize;
       config->preload = DEFAULT_preload;
+      config->compression_level = DEFAULT_compression;
+      config->mmap_read = DEFAULT_mmap_read;
     }
+#ifndef ERT_HAVE_ZLIB
+    config->compression_level = 0;
+#endif
     return config;
   }
 }
@@ -141,6 +194,7 @@ static bfs_type * bfs_alloc( const bfs_config_type * config ) {
   
   // New init
   fs->mountfile = NULL;
+  fs->format    = BFS_FORMAT_RAW;
   
   return fs;
 }
@@ -164,6 +218,17 @@ static void bfs_mount( bfs_type * bfs) {
                                   config->preload , 
                                   config->read_only,
                                   config->bfs_lock);
+  if (config->mmap_read)
+    block_fs_set_mmap_read( bfs->block_fs , true );
+
+  if (block_fs_has_file( bfs->block_fs , BFS_FORMAT_KEY ))
+    block_fs_fread_file( bfs->block_fs , BFS_FORMAT_KEY , &bfs->format );
+  else if (!block_fs_is_readonly( bfs->block_fs ) && (block_fs_get_num_files( bfs->block_fs ) == 0)) {
+    bfs->format = BFS_FORMAT_NODE_HEADER;
+    block_fs_fwrite_file( bfs->block_fs , BFS_FORMAT_KEY , &bfs->format , sizeof bfs->format );
+    block_fs_fsync( bfs->block_fs );
+  } else
+    bfs->format = BFS_FORMAT_RAW;
 }
 
 
@@ -178,11 +243,115 @@ static void * bfs_mount__( void * arg ) {
 
 
 
+static void buffer_free__( void * arg ) {
+  buffer_free( (buffer_type *) arg );
+}
+
+
+/**
+   Returns a new buffer with the content of buffer as it should be
+   stored, i.e. with the node header and possibly compressed, or NULL
+   if buffer should be stored as it is.
+*/
+
+static buffer_type * bfs_alloc_stored_buffer( const bfs_type * bfs , const buffer_type * buffer ) {
+  if (bfs->format == BFS_FORMAT_NODE_HEADER) {
+    size_t size = buffer_get_size( buffer );
+    buffer_type * stored;
+#ifdef ERT_HAVE_ZLIB
+    if ((bfs->config->compression_level > 0) && (size >= BFS_COMPRESS_MIN_SIZE)) {
+      stored = buffer_alloc( size / 2 );
+      buffer_fwrite_int( stored , BFS_NODE_COMPRESSED );
+      buffer_fwrite_int( stored , size );
+      buffer_fwrite_compressed_level( stored , buffer_get_data( buffer ) , size , bfs->config->compression_level );
+
+      if (buffer_get_size( stored ) < size)
+        return stored;
+
+      buffer_free( stored );
+    }
+#endif
+    stored = buffer_alloc( size + sizeof(int) );
+    buffer_fwrite_int( stored , 0 );
+    buffer_fwrite( stored , buffer_get_data( buffer ) , 1 , size );
+    return stored;
+  } else
+    return NULL;
+}
+
+
+static void bfs_fwrite_buffer( bfs_type * bfs , const char * key , const buffer_type * buffer ) {
+  buffer_type * stored = bfs_alloc_stored_buffer( bfs , buffer );
+  if (stored != NULL) {
+    block_fs_fwrite_buffer( bfs->block_fs , key , stored );
+    buffer_free( stored );
+  } else
+    block_fs_fwrite_buffer( bfs->block_fs , key , buffer );
+}
+
+
+static void bfs_fread_buffer( bfs_type * bfs , const char * key , buffer_type * buffer ) {
+  block_fs_fread_realloc_buffer( bfs->block_fs , key , buffer );
+  if (bfs->format == BFS_FORMAT_NODE_HEADER) {
+    int flags = buffer_fread_int( buffer );
+    if (flags & BFS_NODE_COMPRESSED) {
+#ifdef ERT_HAVE_ZLIB
+      size_t uncompressed_size = buffer_fread_int( buffer );
+      void * data = util_malloc( uncompressed_size );
+
+      buffer_fread_compressed( buffer , buffer_get_remaining_size( buffer ) , data , uncompressed_size );
+      buffer_clear( buffer );
+      buffer_fwrite( buffer , data , 1 , uncompressed_size );
+      free( data );
+#else
+      util_abort("%s: the node:%s is compressed - and this ert version is built without zlib support.\n",__func__ , key);
+#endif
+    } else
+      buffer_memshift( buffer , sizeof(int) , -(ssize_t) sizeof(int) );   /* Remove the node header. */
+
+    buffer_rewind( buffer );
+  }
+}
+
+
+/**
+   Writes all the buffers with one block_fs_fwrite_batch() call; the
+   buffers get the node header, and are compressed when compression is
+   enabled, first.
+*/
+
+static void bfs_fwrite_batch( bfs_type * bfs , const stringlist_type * keys , const vector_type * buffers ) {
+  vector_type * write_buffers = vector_alloc_new( );
+  for (int i=0; i < vector_get_size( buffers ); i++) {
+    const buffer_type * buffer = vector_iget_const( buffers , i );
+    buffer_type * stored = bfs_alloc_stored_buffer( bfs , buffer );
+    if (stored != NULL)
+      vector_append_owned_ref( write_buffers , stored , buffer_free__ );
+    else
+      vector_append_ref( write_buffers , buffer );
+  }
+  block_fs_fwrite_batch( bfs->block_fs , keys , write_buffers );
+  vector_free( write_buffers );
+}
+
+
 static void bfs_fsync( bfs_type * bfs ) {
   block_fs_fsync( bfs->block_fs );
 }
 
 
+/*
+  The compaction copies at most slice_size bytes at a time while
+  holding the block_fs lock, so other threads can continue to read
+  and write while the compaction is running.
+*/
+
+static bool bfs_compact( bfs_type * bfs , double fragmentation_limit ) {
+  const size_t slice_size = 16 * 1024 * 1024;
+  return block_fs_compact( bfs->block_fs , fragmentation_limit , slice_size );
+}
+
+
 
 /*****************************************************************/
 
@@ -210,6 +379,17 @@ static char * block_fs_driver_alloc_vector_key( const block_fs_driver_type * dri
   return key;
 }
 
+
+/*
+  The ensemble vectors are stored with the suffix ".ens"; that can
+  not be confused with the vector keys which end with an integer.
+*/
+
+static char * block_fs_driver_alloc_ensemble_vector_key( const block_fs_driver_type * driver , const char * node_key ) {
+  char * key = util_alloc_sprintf("%s.ens" , node_key );
+  return key;
+}
+
 /**
    This function will take an input string, and try to to parse it as
    string.int.int, where string is the normal enkf key, and the two
@@ -256,13 +436,27 @@ static bfs_type * block_fs_driver_get_fs( block_fs_driver_type * driver , int ie
 
 
 
+/*
+  The ensemble vectors are not tied to one realization; they are
+  spread over the block_fs instances based on a hash of the key.
+*/
+
+static bfs_type * block_fs_driver_get_ensemble_fs( block_fs_driver_type * driver , const char * node_key ) {
+  unsigned int hash = 0;
+  for (const char * c = node_key; *c != '\0'; c++)
+    hash = 31 * hash + (unsigned char) *c;
+
+  return driver->fs_list[ hash % driver->num_fs ];
+}
+
+
 static void block_fs_driver_load_node(void * _driver , const char * node_key , int report_step , int iens ,  buffer_type * buffer) {
   block_fs_driver_type * driver = block_fs_driver_safe_cast( _driver );
   {
     char * key          = block_fs_driver_alloc_node_key( driver , node_key , report_step , iens );
     bfs_type      * bfs = block_fs_driver_get_fs( driver , iens );
     
-    block_fs_fread_realloc_buffer( bfs->block_fs , key , buffer);
+    bfs_fread_buffer( bfs , key , buffer);
     
     free( key );
   }
@@ -275,7 +469,19 @@ static void block_fs_driver_load_vector(void * _driver , const char * node_key ,
     char * key          = block_fs_driver_alloc_vector_key( driver , node_key , iens );
     bfs_type      * bfs = block_fs_driver_get_fs( driver , iens );
     
-    block_fs_fread_realloc_buffer( bfs->block_fs , key , buffer);
+    bfs_fread_buffer( bfs , key , buffer);
+    free( key );
+  }
+}
+
+
+static void block_fs_driver_load_ensemble_vector(void * _driver , const char * node_key , buffer_type * buffer) {
+  block_fs_driver_type * driver = block_fs_driver_safe_cast( _driver );
+  {
+    char * key          = block_fs_driver_alloc_ensemble_vector_key( driver , node_key );
+    bfs_type      * bfs = block_fs_driver_get_ensemble_fs( driver , node_key );
+
+    bfs_fread_buffer( bfs , key , buffer);
     free( key );
   }
 }
@@ -288,7 +494,7 @@ static void block_fs_driver_save_node(void * _driver , const char * node_key , i
   {
     char * key     = block_fs_driver_alloc_node_key( driver , node_key , report_step , iens );
     bfs_type * bfs = block_fs_driver_get_fs( driver , iens );
-    block_fs_fwrite_buffer( bfs->block_fs , key , buffer);
+    bfs_fwrite_buffer( bfs , key , buffer);
     free( key );
   }
 }
@@ -300,11 +506,56 @@ static void block_fs_driver_save_vector(void * _driver , const char * node_key ,
   {
     char * key     = block_fs_driver_alloc_vector_key( driver , node_key , iens );
     bfs_type * bfs = block_fs_driver_get_fs( driver , iens );
-    block_fs_fwrite_buffer( bfs->block_fs , key , buffer);
+    bfs_fwrite_buffer( bfs , key , buffer);
+    free( key );
+  }
+}
+
+
+static void block_fs_driver_save_ensemble_vector(void * _driver , const char * node_key , buffer_type * buffer) {
+  block_fs_driver_type * driver = block_fs_driver_safe_cast( _driver );
+  {
+    char * key     = block_fs_driver_alloc_ensemble_vector_key( driver , node_key );
+    bfs_type * bfs = block_fs_driver_get_ensemble_fs( driver , node_key );
+    bfs_fwrite_buffer( bfs , key , buffer);
     free( key );
   }
 }
 
+/**
+   Saves many nodes for the same realization in one batch; see
+   block_fs_fwrite_batch().
+*/
+
+void block_fs_driver_save_node_batch(void * _driver , const stringlist_type * node_keys , int report_step , int iens , const vector_type * buffers) {
+  block_fs_driver_type * driver = block_fs_driver_safe_cast( _driver );
+  {
+    bfs_type * bfs = block_fs_driver_get_fs( driver , iens );
+    stringlist_type * keys = stringlist_alloc_new( );
+
+    for (int i=0; i < stringlist_get_size( node_keys ); i++)
+      stringlist_append_owned_ref( keys , block_fs_driver_alloc_node_key( driver , stringlist_iget( node_keys , i ) , report_step , iens ));
+
+    bfs_fwrite_batch( bfs , keys , buffers );
+    stringlist_free( keys );
+  }
+}
+
+
+void block_fs_driver_save_vector_batch(void * _driver , const stringlist_type * node_keys , int iens , const vector_type * buffers) {
+  block_fs_driver_type * driver = block_fs_driver_safe_cast( _driver );
+  {
+    bfs_type * bfs = block_fs_driver_get_fs( driver , iens );
+    stringlist_type * keys = stringlist_alloc_new( );
+
+    for (int i=0; i < stringlist_get_size( node_keys ); i++)
+      stringlist_append_owned_ref( keys , block_fs_driver_alloc_vector_key( driver , stringlist_iget( node_keys , i ) , iens ));
+
+    bfs_fwrite_batch( bfs , keys , buffers );
+    stringlist_free( keys );
+  }
+}
+
 /*****************************************************************/
 
 void block_fs_driver_unlink_node(void * _driver , const char * node_key , int report_step , int iens ) {
@@ -329,6 +580,16 @@ void block_fs_driver_unlink_vector(void * _driver , const char * node_key , int
   }
 }
 
+static void block_fs_driver_unlink_ensemble_vector(void * _driver , const char * node_key ) {
+  block_fs_driver_type * driver = block_fs_driver_safe_cast( _driver );
+  {
+    char * key     = block_fs_driver_alloc_ensemble_vector_key( driver , node_key );
+    bfs_type * bfs = block_fs_driver_get_ensemble_fs( driver , node_key );
+    block_fs_unlink_file( bfs->block_fs , key );
+    free( key );
+  }
+}
+
 
 /*****************************************************************/
 
@@ -357,6 +618,18 @@ bool block_fs_driver_has_vector(void * _driver , const char * node_key , int ien
   }
 }
 
+
+static bool block_fs_driver_has_ensemble_vector(void * _driver , const char * node_key ) {
+  block_fs_driver_type * driver = block_fs_driver_safe_cast( _driver );
+  {
+    char * key      = block_fs_driver_alloc_ensemble_vector_key( driver , node_key );
+    bfs_type  * bfs = block_fs_driver_get_ensemble_fs( driver , node_key );
+    bool has_vector = block_fs_has_file( bfs->block_fs , key );
+    free( key );
+    return has_vector;
+  }
+}
+
 /*****************************************************************/
 
 
@@ -398,6 +671,22 @@ static void block_fs_driver_fsync( void * _driver ) {
 }
 
 
+/**
+   Will compact all the block_fs instances with fragmentation above
+   fragmentation_limit; returns the number of compacted instances.
+*/
+
+static int block_fs_driver_compact( void * _driver , double fragmentation_limit ) {
+  block_fs_driver_type * driver = block_fs_driver_safe_cast(_driver);
+  int num_compacted = 0;
+  for (int driver_nr = 0; driver_nr < driver->num_fs; driver_nr++)
+    if (bfs_compact( driver->fs_list[driver_nr] , fragmentation_limit ))
+      num_compacted++;
+
+  return num_compacted;
+}
+
+
 static block_fs_driver_type * block_fs_driver_alloc(int num_fs) {
   block_fs_driver_type * driver = util_malloc(sizeof * driver );
   {
@@ -408,14 +697,22 @@ static block_fs_driver_type * block_fs_driver_alloc(int num_fs) {
   driver->save_node     = block_fs_driver_save_node;
   driver->unlink_node   = block_fs_driver_unlink_node;
   driver->has_node      = block_fs_driver_has_node;
+  driver->save_node_batch = block_fs_driver_save_node_batch;
 
   driver->load_vector   = block_fs_driver_load_vector;
   driver->save_vector   = block_fs_driver_save_vector;
   driver->unlink_vector = block_fs_driver_unlink_vector;
   driver->has_vector    = block_fs_driver_has_vector;
+  driver->save_vector_batch = block_fs_driver_save_vector_batch;
+
+  driver->load_ensemble_vector   = block_fs_driver_load_ensemble_vector;
+  driver->save_ensemble_vector   = block_fs_driver_save_ensemble_vector;
+  driver->has_ensemble_vector    = block_fs_driver_has_ensemble_vector;
+  driver->unlink_ensemble_vector = block_fs_driver_unlink_ensemble_vector;
 
   driver->free_driver   = block_fs_driver_free;
   driver->fsync_driver  = block_fs_driver_fsync;
+  driver->compact_driver = block_fs_driver_compact;
   driver->__id          = BLOCK_FS_DRIVER_ID;
   driver->num_fs        = num_fs;
 
@@ -301,12 +301,16 @@ double block_obs_iget_data( const block_obs_type * block_obs, const void * state
 
 
 
-void block_obs_measure(const block_obs_type * block_obs, const void * state , node_id_type node_id , meas_data_type * meas_data , const active_list_type * __active_list) {
+meas_block_type * block_obs_add_meas_block(const block_obs_type * block_obs , meas_data_type * meas_data , int report_step , const active_list_type * __active_list) {
+  return meas_data_add_block( meas_data , block_obs->obs_key , report_step , block_obs_get_size( block_obs ));
+}
+
+
+void block_obs_measure(const block_obs_type * block_obs, const void * state , node_id_type node_id , meas_block_type * meas_block , const active_list_type * __active_list) {
   block_obs_assert_data( block_obs , state );
   {
     int obs_size    = block_obs_get_size( block_obs );
     int active_size = active_list_get_active_size( __active_list , obs_size );
-    meas_block_type * meas_block = meas_data_add_block( meas_data , block_obs->obs_key , node_id.report_step , obs_size );
     int iobs;
 
     active_mode_type active_mode = active_list_get_mode( __active_list );
@@ -460,6 +464,7 @@ void block_obs_update_std_scale(block_obs_type * block_obs, double scale_factor,
 
 VOID_FREE(block_obs)
 VOID_GET_OBS(block_obs)
+VOID_ADD_MEAS_BLOCK(block_obs)
 VOID_MEASURE_UNSAFE(block_obs , data)  // The cast of data field is not checked - that is done in block_obs_measure().
 VOID_USER_GET_OBS(block_obs)
 VOID_CHI2(block_obs , field)
@@ -33,6 +33,8 @@
 #include <ert/util/arg_pack.h>
 #include <ert/util/stringlist.h>
 #include <ert/util/arg_pack.h>
+#include <ert/util/vector.h>
+#include <ert/util/int_vector.h>
 
 #include <ert/enkf/block_fs_driver.h>
 #include <ert/enkf/enkf_fs.h>
@@ -209,6 +211,7 @@
 #define SUMMARY_KEY_SET_FILE      "summary-key-set"
 #define TIME_MAP_FILE             "time-map"
 #define STATE_MAP_FILE            "state-map"
+#define VECTOR_WRITE_COUNT_KEY    "VECTOR-WRITE-COUNT"     /* Stored as vector data; can not be confused with a summary key. */
 #define MISFIT_ENSEMBLE_FILE      "misfit-ensemble"
 #define CASE_CONFIG_FILE          "case_config"
 #define CUSTOM_KW_CONFIG_SET_FILE "custom_kw_config_set"
@@ -244,6 +247,10 @@ struct enkf_fs_struct {
 
   int                         refcount;
   int                         writecount;
+
+  pthread_mutex_t             write_count_lock;
+  int_vector_type           * parameter_write_count;   /* Cache of the vector write counts of the parameter driver; -1: not loaded. */
+  int_vector_type           * dynamic_write_count;     /* Cache of the vector write counts of the dynamic_forecast driver. */
 };
 
 
@@ -303,6 +310,9 @@ static enkf_fs_type * enkf_fs_alloc_empty( const char * mount_point ) {
   fs->mount_point            = util_alloc_string_copy( mount_point );
   fs->refcount               = 0;
   fs->writecount             = 0;
+  fs->parameter_write_count  = int_vector_alloc( 0 , -1 );
+  fs->dynamic_write_count    = int_vector_alloc( 0 , -1 );
+  pthread_mutex_init( &fs->write_count_lock , NULL );
   fs->lock_fd                = 0;
 
   if (mount_point == NULL)
@@ -741,6 +751,9 @@ static void enkf_fs_umount( enkf_fs_type * fs ) {
       time_map_free( fs->time_map );
       cases_config_free( fs->cases_config );
       misfit_ensemble_free( fs->misfit_ensemble );
+      int_vector_free( fs->parameter_write_count );
+      int_vector_free( fs->dynamic_write_count );
+      pthread_mutex_destroy( &fs->write_count_lock );
       free( fs );
     } else
       util_abort("%s: internal fuckup - tried to umount a filesystem with refcount:%d\n",__func__ , refcount);
@@ -782,6 +795,34 @@ static void enkf_fs_fsync_driver( fs_driver_type * driver ) {
 
 
 
+static int enkf_fs_compact_driver( fs_driver_type * driver , double fragmentation_limit ) {
+  if (driver->compact_driver != NULL)
+    return driver->compact_driver( driver , fragmentation_limit );
+  else
+    return 0;
+}
+
+
+/**
+   Will run an online compaction of the storage files with
+   fragmentation (fraction of unused space) above
+   fragmentation_limit. The filesystem can be used from other threads
+   while the compaction is running. Returns the number of storage
+   files which were compacted.
+*/
+
+int enkf_fs_compact( enkf_fs_type * fs , double fragmentation_limit ) {
+  int num_compacted = 0;
+  if (!fs->read_only) {
+    num_compacted += enkf_fs_compact_driver( fs->parameter , fragmentation_limit );
+    num_compacted += enkf_fs_compact_driver( fs->dynamic_forecast , fragmentation_limit );
+    num_compacted += enkf_fs_compact_driver( fs->index , fragmentation_limit );
+  }
+  return num_compacted;
+}
+
+
+
 void enkf_fs_fsync( enkf_fs_type * fs ) {
   enkf_fs_fsync_driver( fs->parameter );
   enkf_fs_fsync_driver( fs->dynamic_forecast );
@@ -855,6 +896,104 @@ void enkf_fs_fwrite_node(enkf_fs_type * enkf_fs , buffer_type * buffer , const c
 }
 
 
+/**
+   Writes many nodes for the same report_step and realization; with
+   the block_fs driver all the buffers are written in one batch. All
+   the nodes must have the same var_type.
+*/
+
+void enkf_fs_fwrite_node_batch(enkf_fs_type * enkf_fs , const vector_type * buffers , const stringlist_type * node_keys , enkf_var_type var_type ,
+                               int report_step , int iens) {
+  if (enkf_fs->read_only)
+    util_abort("%s: attempt to write to read_only filesystem mounted at:%s - aborting. \n",__func__ , enkf_fs->mount_point);
+
+  if (stringlist_get_size( node_keys ) != vector_get_size( buffers ))
+    util_abort("%s: size mismatch: %d keys and %d buffers \n",__func__ , stringlist_get_size( node_keys ) , vector_get_size( buffers ));
+
+  if ((var_type == PARAMETER) && (report_step > 0))
+    util_abort("%s: Parameters can only be saved for report_step = 0 \n", __func__ );
+
+  if (stringlist_get_size( node_keys ) > 0) {
+    fs_driver_type * driver = fs_driver_safe_cast( enkf_fs_select_driver( enkf_fs , var_type , stringlist_iget( node_keys , 0 )));
+
+    if (driver->save_node_batch != NULL)
+      driver->save_node_batch( driver , node_keys , report_step , iens , buffers );
+    else {
+      for (int i=0; i < stringlist_get_size( node_keys ); i++)
+        driver->save_node( driver , stringlist_iget( node_keys , i ) , report_step , iens , vector_iget( buffers , i ));
+    }
+  }
+}
+
+
+/*
+  The ensemble vectors are derived from the vector data of the
+  individual realizations. To detect that an ensemble vector is stale
+  the number of vector writes is counted for each realization; the
+  count is stored as vector data with the key VECTOR_WRITE_COUNT_KEY,
+  next to the vectors it counts, and cached in enkf_fs. An ensemble
+  vector records the write count of each realization it has been
+  assembled from, see summary_block.c.
+
+  The count is increased *after* the vector data has been written,
+  and it must be read *before* the vector data is read; then an
+  ensemble vector which is assembled concurrently with a write can
+  only record a count which is too low, i.e. it is stale and will
+  not be used.
+*/
+
+static int_vector_type * enkf_fs_get_write_count_cache( enkf_fs_type * enkf_fs , const fs_driver_type * driver ) {
+  if (driver == enkf_fs->parameter)
+    return enkf_fs->parameter_write_count;
+  else
+    return enkf_fs->dynamic_write_count;
+}
+
+
+/* Must be called with the write_count_lock held. */
+static int enkf_fs_get_vector_write_count__( enkf_fs_type * enkf_fs , fs_driver_type * driver , int iens ) {
+  int_vector_type * cache = enkf_fs_get_write_count_cache( enkf_fs , driver );
+  int write_count = int_vector_safe_iget( cache , iens );
+
+  if (write_count < 0) {
+    write_count = 0;
+    if (driver->has_vector( driver , VECTOR_WRITE_COUNT_KEY , iens )) {
+      buffer_type * buffer = buffer_alloc( 16 );
+      driver->load_vector( driver , VECTOR_WRITE_COUNT_KEY , iens , buffer );
+      buffer_rewind( buffer );
+      write_count = buffer_fread_int( buffer );
+      buffer_free( buffer );
+    }
+    int_vector_iset( cache , iens , write_count );
+  }
+  return write_count;
+}
+
+
+static buffer_type * enkf_fs_alloc_write_count_buffer( int write_count ) {
+  buffer_type * buffer = buffer_alloc( 16 );
+  buffer_fwrite_int( buffer , write_count );
+  return buffer;
+}
+
+
+/* Must be called with the write_count_lock held, after the vector data has been written. */
+static void enkf_fs_set_vector_write_count__( enkf_fs_type * enkf_fs , fs_driver_type * driver , int iens , int write_count ) {
+  int_vector_iset( enkf_fs_get_write_count_cache( enkf_fs , driver ) , iens , write_count );
+}
+
+
+int enkf_fs_get_vector_write_count( enkf_fs_type * enkf_fs , enkf_var_type var_type , int iens ) {
+  fs_driver_type * driver = fs_driver_safe_cast( enkf_fs_select_driver( enkf_fs , var_type , VECTOR_WRITE_COUNT_KEY ));
+  int write_count;
+
+  pthread_mutex_lock( &enkf_fs->write_count_lock );
+  write_count = enkf_fs_get_vector_write_count__( enkf_fs , driver , iens );
+  pthread_mutex_unlock( &enkf_fs->write_count_lock );
+  return write_count;
+}
+
+
 void enkf_fs_fwrite_vector(enkf_fs_type * enkf_fs , buffer_type * buffer , const char * node_key, enkf_var_type var_type,
                            int iens ) {
   if (enkf_fs->read_only)
@@ -864,10 +1003,138 @@ void enkf_fs_fwrite_vector(enkf_fs_type * enkf_fs , buffer_type * buffer , const
     {
       fs_driver_type * driver = fs_driver_safe_cast(_driver);
       driver->save_vector(driver , node_key  , iens , buffer);
+
+      pthread_mutex_lock( &enkf_fs->write_count_lock );
+      {
+        int write_count = enkf_fs_get_vector_write_count__( enkf_fs , driver , iens ) + 1;
+        buffer_type * count_buffer = enkf_fs_alloc_write_count_buffer( write_count );
+
+        driver->save_vector( driver , VECTOR_WRITE_COUNT_KEY , iens , count_buffer );
+        enkf_fs_set_vector_write_count__( enkf_fs , driver , iens , write_count );
+        buffer_free( count_buffer );
+      }
+      pthread_mutex_unlock( &enkf_fs->write_count_lock );
+    }
+  }
+}
+
+
+/**
+   Writes the vector data of many keys for one realization; with the
+   block_fs driver all the buffers, and the new write count of the
+   realization, are written in one batch. The buffers should be
+   prepared as for enkf_fs_fwrite_vector().
+*/
+
+void enkf_fs_fwrite_vector_batch(enkf_fs_type * enkf_fs , const vector_type * buffers , const stringlist_type * node_keys , enkf_var_type var_type , int iens) {
+  if (enkf_fs->read_only)
+    util_abort("%s: attempt to write to read_only filesystem mounted at:%s - aborting. \n",__func__ , enkf_fs->mount_point);
+
+  if (stringlist_get_size( node_keys ) != vector_get_size( buffers ))
+    util_abort("%s: size mismatch: %d keys and %d buffers \n",__func__ , stringlist_get_size( node_keys ) , vector_get_size( buffers ));
+
+  if (stringlist_get_size( node_keys ) > 0) {
+    fs_driver_type * driver = fs_driver_safe_cast( enkf_fs_select_driver( enkf_fs , var_type , stringlist_iget( node_keys , 0 )));
+    stringlist_type * batch_keys = stringlist_alloc_deep_copy( node_keys );
+    vector_type * batch_buffers = vector_alloc_new( );
+    buffer_type * count_buffer;
+    int write_count;
+
+    for (int i=0; i < vector_get_size( buffers ); i++)
+      vector_append_ref( batch_buffers , vector_iget_const( buffers , i ));
+
+    /*
+      Only this thread writes vector data for realization iens, so the
+      count can not change between the read and the write below.
+    */
+    pthread_mutex_lock( &enkf_fs->write_count_lock );
+    write_count = enkf_fs_get_vector_write_count__( enkf_fs , driver , iens ) + 1;
+    pthread_mutex_unlock( &enkf_fs->write_count_lock );
+
+    count_buffer = enkf_fs_alloc_write_count_buffer( write_count );
+    stringlist_append_ref( batch_keys , VECTOR_WRITE_COUNT_KEY );
+    vector_append_ref( batch_buffers , count_buffer );
+
+    if (driver->save_vector_batch != NULL)
+      driver->save_vector_batch( driver , batch_keys , iens , batch_buffers );
+    else {
+      for (int i=0; i < stringlist_get_size( batch_keys ); i++)
+        driver->save_vector( driver , stringlist_iget( batch_keys , i ) , iens , vector_iget( batch_buffers , i ));
     }
+
+    pthread_mutex_lock( &enkf_fs->write_count_lock );
+    enkf_fs_set_vector_write_count__( enkf_fs , driver , iens , write_count );
+    pthread_mutex_unlock( &enkf_fs->write_count_lock );
+
+    buffer_free( count_buffer );
+    vector_free( batch_buffers );
+    stringlist_free( batch_keys );
   }
 }
 
+/*****************************************************************/
+
+/**
+   The ensemble vectors store the vector data of one key for all the
+   realizations in one record, so that the data for the full ensemble
+   can be read with one read. The content of the buffer is managed by
+   the calling scope, see summary_block.c.
+
+   The storage of ensemble vectors is optional for the drivers; for a
+   driver without ensemble vector support enkf_fs_has_ensemble_vector()
+   will always return false.
+*/
+
+bool enkf_fs_has_ensemble_vector(enkf_fs_type * enkf_fs , const char * node_key , enkf_var_type var_type) {
+  fs_driver_type * driver = fs_driver_safe_cast( enkf_fs_select_driver( enkf_fs , var_type , node_key ));
+  bool has_vector = false;
+
+  if (driver->has_ensemble_vector != NULL)
+    has_vector = driver->has_ensemble_vector( driver , node_key );
+
+  return has_vector;
+}
+
+
+/**
+   Will load the ensemble vector into the buffer; returns false if the
+   ensemble vector does not exist.
+*/
+
+bool enkf_fs_fread_ensemble_vector(enkf_fs_type * enkf_fs , buffer_type * buffer , const char * node_key , enkf_var_type var_type) {
+  fs_driver_type * driver = fs_driver_safe_cast( enkf_fs_select_driver( enkf_fs , var_type , node_key ));
+  bool loaded = false;
+
+  if (driver->has_ensemble_vector != NULL) {
+    if (driver->has_ensemble_vector( driver , node_key )) {
+      buffer_rewind( buffer );
+      driver->load_ensemble_vector( driver , node_key , buffer );
+      loaded = true;
+    }
+  }
+  return loaded;
+}
+
+
+/**
+   Stores an ensemble vector which has been assembled from the vector
+   data of the realizations; returns false if the filesystem is read
+   only, or the driver does not support ensemble vectors. The ensemble
+   vector must contain the write counts of the realizations, see
+   enkf_fs_get_vector_write_count(), so that the reader can check if
+   it is stale.
+*/
+
+bool enkf_fs_fwrite_ensemble_vector(enkf_fs_type * enkf_fs , buffer_type * buffer , const char * node_key , enkf_var_type var_type) {
+  fs_driver_type * driver = fs_driver_safe_cast( enkf_fs_select_driver( enkf_fs , var_type , node_key ));
+
+  if (enkf_fs->read_only || driver->save_ensemble_vector == NULL)
+    return false;
+
+  driver->save_ensemble_vector( driver , node_key , buffer );
+  return true;
+}
+
 
 
 
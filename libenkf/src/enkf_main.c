@@ -40,9 +40,11 @@
 #include <ert/util/hash.h>
 #include <ert/util/path_fmt.h>
 #include <ert/util/thread_pool.h>
+#include <ert/util/parallel_for.h>
 #include <ert/util/arg_pack.h>
 #include <ert/util/msg.h>
 #include <ert/util/stringlist.h>
+#include <ert/util/vector.h>
 #include <ert/util/set.h>
 #include <ert/util/node_ctype.h>
 #include <ert/util/string_util.h>
@@ -95,6 +97,7 @@
 #include <ert/enkf/ert_template.h>
 #include <ert/enkf/rng_config.h>
 #include <ert/enkf/enkf_plot_data.h>
+#include <ert/enkf/summary_block.h>
 #include <ert/enkf/ranking_table.h>
 #include <ert/enkf/enkf_defaults.h>
 #include <ert/enkf/config_keys.h>
@@ -649,52 +652,62 @@ typedef struct {
   enkf_fs_type            * src_fs;
   enkf_fs_type            * target_fs;
   enkf_state_type        ** ensemble;
-  int                       iens1;    /* Inclusive lower limit. */
-  int                       iens2;    /* NOT inclusive upper limit. */
   const char              * key;
   int                       report_step;
   int                       target_step;
   run_mode_type             run_mode;
   int                       row_offset;
   const active_list_type  * active_list;
+  bool                      load;     /* Load the nodes from src_fs before serializing? */
+  bool                      store;    /* Store the nodes in target_fs after deserializing? */
+  enkf_node_type         ** nodes;    /* The nodes to update, indexed by iens; NULL: the nodes of the ensemble. */
   matrix_type             * A;
   const int_vector_type   * iens_active_index;
 } serialize_info_type;
 
 
+static enkf_node_type * serialize_info_get_node( const serialize_info_type * info , int iens ) {
+  if (info->nodes != NULL)
+    return info->nodes[iens];
+  else
+    return enkf_state_get_node( info->ensemble[iens] , info->key );
+}
+
+
 static void serialize_node( enkf_fs_type * fs ,
-                            enkf_state_type ** ensemble ,
-                            const char * key ,
+                            enkf_node_type * node ,
                             int iens ,
                             int report_step ,
                             int row_offset ,
                             int column,
                             const active_list_type * active_list,
+                            bool load,
                             matrix_type * A) {
 
-  enkf_node_type * node = enkf_state_get_node( ensemble[iens] , key);
   node_id_type node_id = {.report_step = report_step, .iens = iens  };
-  enkf_node_serialize( node , fs , node_id , active_list , A , row_offset , column);
+  if (load)
+    enkf_node_serialize( node , fs , node_id , active_list , A , row_offset , column);
+  else
+    enkf_node_serialize_loaded( node , node_id , active_list , A , row_offset , column);
 }
 
 
-static void * serialize_nodes_mt( void * arg ) {
+static void serialize_nodes_mt( int iens1 , int iens2 , void * arg ) {
   serialize_info_type * info = (serialize_info_type *) arg;
   int iens;
-  for (iens = info->iens1; iens < info->iens2; iens++) {
+  for (iens = iens1; iens < iens2; iens++) {
     int column = int_vector_iget( info->iens_active_index , iens);
     if (column >= 0)
       serialize_node( info->src_fs ,
-                      info->ensemble ,
-                      info->key ,
+                      serialize_info_get_node( info , iens ) ,
                       iens ,
                       info->report_step ,
                       info->row_offset ,
                       column,
                       info->active_list ,
+                      info->load ,
                       info->A );
   }
-  return NULL;
 }
 
 
@@ -704,19 +717,12 @@ static void enkf_main_serialize_node( const char * node_key ,
                                       thread_pool_type * work_pool ,
                                       serialize_info_type * serialize_info) {
 
-  /* Multithreaded serializing*/
-  const int num_cpu_threads = thread_pool_get_max_running( work_pool );
-  int icpu;
-
-  thread_pool_restart( work_pool );
-  for (icpu = 0; icpu < num_cpu_threads; icpu++) {
-    serialize_info[icpu].key         = node_key;
-    serialize_info[icpu].active_list = active_list;
-    serialize_info[icpu].row_offset  = row_offset;
+  /* Multithreaded serializing; one realization per task. */
+  serialize_info->key         = node_key;
+  serialize_info->active_list = active_list;
+  serialize_info->row_offset  = row_offset;
 
-    thread_pool_add_job( work_pool , serialize_nodes_mt , &serialize_info[icpu]);
-  }
-  thread_pool_join( work_pool );
+  parallel_for( work_pool , 0 , int_vector_size( serialize_info->iens_active_index ) , 1 , serialize_nodes_mt , serialize_info );
 }
 
 
@@ -744,7 +750,7 @@ static int enkf_main_serialize_dataset( const ensemble_config_type * ens_config
   for (int ikw=0; ikw < num_kw; ikw++) {
     const char             * key         = stringlist_iget(update_keys , ikw);
     enkf_config_node_type * config_node  = ensemble_config_get_node( ens_config , key );
-    if ((serialize_info[0].run_mode == SMOOTHER_UPDATE) && (enkf_config_node_get_var_type( config_node ) != PARAMETER)) {
+    if ((serialize_info->run_mode == SMOOTHER_UPDATE) && (enkf_config_node_get_var_type( config_node ) != PARAMETER)) {
       /* We have tried to serialize a dynamic node when we are
          smoother update mode; that does not make sense and we just
          continue. */
@@ -774,32 +780,48 @@ static int enkf_main_serialize_dataset( const ensemble_config_type * ens_config
 }
 
 static void deserialize_node( enkf_fs_type            * fs,
-                              enkf_state_type ** ensemble ,
-                              const char * key ,
+                              enkf_node_type * node ,
                               int iens,
                               int target_step ,
                               int row_offset ,
                               int column,
                               const active_list_type * active_list,
+                              bool store,
                               matrix_type * A) {
 
-  enkf_node_type * node = enkf_state_get_node( ensemble[iens] , key);
   node_id_type node_id = { .report_step = target_step , .iens = iens };
-  enkf_node_deserialize(node , fs , node_id , active_list , A , row_offset , column);
-  state_map_update_undefined(enkf_fs_get_state_map(fs) , iens , STATE_INITIALIZED);
+  if (store) {
+    enkf_node_deserialize(node , fs , node_id , active_list , A , row_offset , column);
+    state_map_update_undefined(enkf_fs_get_state_map(fs) , iens , STATE_INITIALIZED);
+  } else
+    enkf_node_deserialize_unstored(node , node_id , active_list , A , row_offset , column);
 }
 
 
 
-static void * deserialize_nodes_mt( void * arg ) {
+static void deserialize_nodes_mt( int iens1 , int iens2 , void * arg ) {
   serialize_info_type * info = (serialize_info_type *) arg;
   int iens;
-  for (iens = info->iens1; iens < info->iens2; iens++) {
+  for (iens = iens1; iens < iens2; iens++) {
     int column = int_vector_iget( info->iens_active_index , iens );
     if (column >= 0)
-      deserialize_node( info->target_fs , info->ensemble , info->key , iens , info->target_step , info->row_offset , column, info->active_list , info->A );
+      deserialize_node( info->target_fs , serialize_info_get_node( info , iens ) , iens , info->target_step , info->row_offset , column, info->active_list , info->store , info->A );
   }
-  return NULL;
+}
+
+
+static void enkf_main_deserialize_node( const char * node_key ,
+                                        const active_list_type * active_list ,
+                                        int row_offset ,
+                                        thread_pool_type * work_pool ,
+                                        serialize_info_type * serialize_info) {
+
+  /* Multithreaded; one realization per task. */
+  serialize_info->key         = node_key;
+  serialize_info->active_list = active_list;
+  serialize_info->row_offset  = row_offset;
+
+  parallel_for( work_pool , 0 , int_vector_size( serialize_info->iens_active_index ) , 1 , deserialize_nodes_mt , serialize_info );
 }
 
 
@@ -810,12 +832,11 @@ static void enkf_main_deserialize_dataset( ensemble_config_type * ensemble_confi
                                            serialize_info_type * serialize_info ,
                                            thread_pool_type * work_pool ) {
 
-  int num_cpu_threads = thread_pool_get_max_running( work_pool );
   stringlist_type * update_keys = local_dataset_alloc_keys( dataset );
   for (int i = 0; i < stringlist_get_size( update_keys ); i++) {
     const char             * key         = stringlist_iget(update_keys , i);
     enkf_config_node_type * config_node  = ensemble_config_get_node( ensemble_config , key );
-    if ((serialize_info[0].run_mode == SMOOTHER_UPDATE) && (enkf_config_node_get_var_type( config_node ) != PARAMETER))
+    if ((serialize_info->run_mode == SMOOTHER_UPDATE) && (enkf_config_node_get_var_type( config_node ) != PARAMETER))
       /*
          We have tried to serialize a dynamic node when we are in
          smoother update mode; that does not make sense and we just
@@ -825,23 +846,184 @@ static void enkf_main_deserialize_dataset( ensemble_config_type * ensemble_confi
     else {
       if (active_size[i] > 0) {
         const active_list_type * active_list      = local_dataset_get_node_active_list( dataset , key );
+        enkf_main_deserialize_node( key , active_list , row_offset[i] , work_pool , serialize_info );
+      }
+    }
+  }
+  stringlist_free( update_keys );
+}
 
-        {
-          /* Multithreaded */
-          int icpu;
-          thread_pool_restart( work_pool );
-          for (icpu = 0; icpu < num_cpu_threads; icpu++) {
-            serialize_info[icpu].key         = key;
-            serialize_info[icpu].active_list = active_list;
-            serialize_info[icpu].row_offset  = row_offset[i];
 
-            thread_pool_add_job( work_pool , deserialize_nodes_mt , &serialize_info[icpu]);
-          }
-          thread_pool_join( work_pool );
-        }
+/*****************************************************************/
+/*
+   Streaming update: when the analysis module does not need the A
+   matrix itself, the update A -> A*X is row by row independent, and
+   the dataset can be updated in blocks of at most block_size rows;
+   then the size of A is given by the block size and not by the size
+   of the dataset. The keys of the dataset are packed into blocks; a
+   key which is larger than the remaining space in a block is split
+   over several blocks with an active_list for each segment.
+
+   The streaming update does not use the nodes of the ensemble; each
+   key is loaded into a set of nodes which is allocated when the first
+   segment of the key is serialized, and stored and freed when the
+   last segment has been deserialized. That way only the nodes of the
+   keys in the current block hold data. When a key is split, the later
+   segments are serialized from these nodes, which already hold the
+   updated values of the earlier segments.
+*/
+
+typedef struct {
+  enkf_node_type   ** nodes;          /* Indexed by iens; NULL for the inactive realizations. */
+  int                 ens_size;
+} update_nodes_type;
+
+
+static update_nodes_type * update_nodes_alloc( const enkf_config_node_type * config_node , const int_vector_type * iens_active_index ) {
+  update_nodes_type * update_nodes = util_malloc( sizeof * update_nodes );
+  update_nodes->ens_size = int_vector_size( iens_active_index );
+  update_nodes->nodes    = util_calloc( update_nodes->ens_size , sizeof * update_nodes->nodes );
+  for (int iens = 0; iens < update_nodes->ens_size; iens++) {
+    if (int_vector_iget( iens_active_index , iens ) >= 0)
+      update_nodes->nodes[iens] = enkf_node_deep_alloc( config_node );
+    else
+      update_nodes->nodes[iens] = NULL;
+  }
+  return update_nodes;
+}
+
+
+static void update_nodes_free( update_nodes_type * update_nodes ) {
+  for (int iens = 0; iens < update_nodes->ens_size; iens++) {
+    if (update_nodes->nodes[iens] != NULL)
+      enkf_node_free( update_nodes->nodes[iens] );
+  }
+  free( update_nodes->nodes );
+  free( update_nodes );
+}
+
+
+static void update_nodes_free__( void * arg ) {
+  update_nodes_free( (update_nodes_type *) arg );
+}
+
+
+typedef struct {
+  stringlist_type   * keys;           /* The key of each segment in the current block. */
+  vector_type       * active_lists;   /* The active_list of each segment. */
+  vector_type       * nodes;          /* The update_nodes of each segment; owned by the last segment of the key. */
+  bool_vector_type  * last_segment;   /* Is this the last segment of the key? */
+  int_vector_type   * row_offset;     /* The row in A where each segment starts. */
+  int                 rows;           /* The number of rows in use in A. */
+} update_block_type;
+
+
+static void enkf_main_update_block_flush( update_block_type * block ,
+                                          const matrix_type * X ,
+                                          thread_pool_type * work_pool ,
+                                          serialize_info_type * serialize_info ) {
+  if (block->rows > 0) {
+    matrix_type * A = matrix_alloc_shared( serialize_info->A , 0 , 0 , block->rows , matrix_get_columns( serialize_info->A ));
+    matrix_inplace_matmul_mt2( A , X , work_pool );
+    matrix_free( A );
+
+    for (int iseg = 0; iseg < stringlist_get_size( block->keys ); iseg++) {
+      const update_nodes_type * update_nodes = vector_iget_const( block->nodes , iseg );
+
+      serialize_info->nodes = update_nodes->nodes;
+      serialize_info->store = bool_vector_iget( block->last_segment , iseg );
+      enkf_main_deserialize_node( stringlist_iget( block->keys , iseg ) ,
+                                  vector_iget_const( block->active_lists , iseg ) ,
+                                  int_vector_iget( block->row_offset , iseg ) ,
+                                  work_pool ,
+                                  serialize_info );
+    }
+    serialize_info->nodes = NULL;
+    serialize_info->store = true;
+  }
+
+  stringlist_clear( block->keys );
+  vector_clear( block->active_lists );
+  vector_clear( block->nodes );      /* Frees the nodes of the keys which are complete. */
+  bool_vector_reset( block->last_segment );
+  int_vector_reset( block->row_offset );
+  block->rows = 0;
+}
+
+
+static void enkf_main_stream_update_dataset( const ensemble_config_type * ens_config ,
+                                             const local_dataset_type * dataset ,
+                                             int report_step ,
+                                             const matrix_type * X ,
+                                             thread_pool_type * work_pool ,
+                                             serialize_info_type * serialize_info) {
+
+  const int block_size = matrix_get_rows( serialize_info->A );
+  stringlist_type * update_keys = local_dataset_alloc_keys( dataset );
+  update_block_type block = { .keys         = stringlist_alloc_new( ) ,
+                              .active_lists = vector_alloc_new( ) ,
+                              .nodes        = vector_alloc_new( ) ,
+                              .last_segment = bool_vector_alloc( 0 , false ) ,
+                              .row_offset   = int_vector_alloc( 0 , 0 ) ,
+                              .rows         = 0 };
+
+  for (int ikw=0; ikw < stringlist_get_size( update_keys ); ikw++) {
+    const char * key = stringlist_iget( update_keys , ikw );
+    const enkf_config_node_type * config_node = ensemble_config_get_node( ens_config , key );
+
+    if ((serialize_info->run_mode == SMOOTHER_UPDATE) && (enkf_config_node_get_var_type( config_node ) != PARAMETER))
+      continue;
+
+    {
+      const active_list_type * active_list = local_dataset_get_node_active_list( dataset , key );
+      const int * active_index = NULL;
+      int active_size = __get_active_size( ens_config , serialize_info->src_fs , key , report_step , active_list );
+      int offset = 0;
+      update_nodes_type * update_nodes = NULL;
+
+      if (active_list_get_mode( active_list ) == PARTLY_ACTIVE)
+        active_index = active_list_get_active( active_list );
+
+      while (offset < active_size) {
+        int segment_size = util_int_min( active_size - offset , block_size - block.rows );
+        active_list_type * segment_list = active_list_alloc( );
+
+        for (int i = 0; i < segment_size; i++)
+          active_list_add_index( segment_list , active_index ? active_index[offset + i] : offset + i );
+
+        if (offset == 0)
+          update_nodes = update_nodes_alloc( config_node , serialize_info->iens_active_index );
+
+        serialize_info->load  = (offset == 0);
+        serialize_info->nodes = update_nodes->nodes;
+        enkf_main_serialize_node( key , segment_list , block.rows , work_pool , serialize_info );
+        serialize_info->nodes = NULL;
+
+        stringlist_append_ref( block.keys , key );
+        vector_append_owned_ref( block.active_lists , segment_list , active_list_free__ );
+        int_vector_append( block.row_offset , block.rows );
+        block.rows += segment_size;
+        offset     += segment_size;
+
+        bool_vector_append( block.last_segment , offset == active_size );
+        if (offset == active_size)
+          vector_append_owned_ref( block.nodes , update_nodes , update_nodes_free__ );
+        else
+          vector_append_ref( block.nodes , update_nodes );
+
+        if (block.rows == block_size)
+          enkf_main_update_block_flush( &block , X , work_pool , serialize_info );
       }
     }
   }
+  enkf_main_update_block_flush( &block , X , work_pool , serialize_info );
+  serialize_info->load = true;
+
+  int_vector_free( block.row_offset );
+  bool_vector_free( block.last_segment );
+  vector_free( block.nodes );
+  vector_free( block.active_lists );
+  stringlist_free( block.keys );
   stringlist_free( update_keys );
 }
 
@@ -857,27 +1039,23 @@ static serialize_info_type * serialize_info_alloc( enkf_fs_type * src_fs,
                                                    enkf_state_type ** ensemble ,
                                                    run_mode_type run_mode ,
                                                    int report_step ,
-                                                   matrix_type * A ,
-                                                   int num_cpu_threads ) {
-
-  serialize_info_type * serialize_info = util_calloc( num_cpu_threads , sizeof * serialize_info );
-  int ens_size = int_vector_size(iens_active_index);
-  int icpu;
-  int iens_offset = 0;
-  for (icpu = 0; icpu < num_cpu_threads; icpu++) {
-    serialize_info[icpu].iens_active_index = iens_active_index;
-    serialize_info[icpu].run_mode    = run_mode;
-    serialize_info[icpu].src_fs      = src_fs;
-    serialize_info[icpu].target_fs   = target_fs;
-    serialize_info[icpu].target_step = target_step;
-    serialize_info[icpu].ensemble    = ensemble;
-    serialize_info[icpu].report_step = report_step;
-    serialize_info[icpu].A           = A;
-    serialize_info[icpu].iens1       = iens_offset;
-    serialize_info[icpu].iens2       = iens_offset + (ens_size - iens_offset) / (num_cpu_threads - icpu);
-    iens_offset = serialize_info[icpu].iens2;
-  }
-  serialize_info[num_cpu_threads - 1].iens2 = ens_size;
+                                                   matrix_type * A ) {
+
+  serialize_info_type * serialize_info = util_malloc( sizeof * serialize_info );
+  serialize_info->iens_active_index = iens_active_index;
+  serialize_info->run_mode    = run_mode;
+  serialize_info->src_fs      = src_fs;
+  serialize_info->target_fs   = target_fs;
+  serialize_info->target_step = target_step;
+  serialize_info->ensemble    = ensemble;
+  serialize_info->report_step = report_step;
+  serialize_info->A           = A;
+  serialize_info->key         = NULL;
+  serialize_info->active_list = NULL;
+  serialize_info->row_offset  = 0;
+  serialize_info->load        = true;
+  serialize_info->store       = true;
+  serialize_info->nodes       = NULL;
   return serialize_info;
 }
 
@@ -994,8 +1172,9 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
                                        const meas_data_type * forecast ,
                                        obs_data_type * obs_data) {
 
-  const int cpu_threads       = 4;
+  const int cpu_threads       = analysis_config_get_update_threads( enkf_main->analysis_config );
   const int matrix_start_size = 250000;
+  const int block_size        = analysis_config_get_update_block_size( enkf_main->analysis_config );
   thread_pool_type * tp       = thread_pool_alloc( cpu_threads , false );
   int active_ens_size   = meas_data_get_active_ens_size( forecast );
   int active_size       = obs_data_get_active_size( obs_data );
@@ -1003,16 +1182,30 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
   matrix_type * S       = meas_data_allocS( forecast );
   matrix_type * R       = obs_data_allocR( obs_data );
   matrix_type * dObs    = obs_data_allocdObs( obs_data );
-  matrix_type * A       = matrix_alloc( matrix_start_size , active_ens_size );
+  matrix_type * A;
   matrix_type * E       = NULL;
   matrix_type * D       = NULL;
   matrix_type * localA  = NULL;
   int_vector_type * iens_active_index = bool_vector_alloc_active_index_list(ens_mask , -1);
+  bool stream_update;
 
   analysis_module_type * module = analysis_config_get_active_module( enkf_main->analysis_config );
   if ( local_ministep_has_analysis_module (ministep))
     module = local_ministep_get_analysis_module (ministep);
 
+  /*
+    Modules which need the full A matrix can not be updated in row
+    blocks; for all other modules the update is done in blocks of
+    block_size rows if UPDATE_BLOCK_SIZE has been set.
+  */
+  stream_update = (block_size > 0) &&
+                  !analysis_module_check_option( module , ANALYSIS_USE_A) &&
+                  !analysis_module_check_option( module , ANALYSIS_UPDATE_A);
+  if (stream_update)
+    A = matrix_alloc( block_size , active_ens_size );
+  else
+    A = matrix_alloc( matrix_start_size , active_ens_size );
+
   assert_matrix_size(X , "X" , active_ens_size , active_ens_size);
   assert_matrix_size(S , "S" , active_size , active_ens_size);
   assert_matrix_size(R , "R" , active_size , active_size);
@@ -1044,8 +1237,7 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
                                                                  enkf_main_get_ensemble( enkf_main ) ,
                                                                  run_mode ,
                                                                  step2 ,
-                                                                 A ,
-                                                                 cpu_threads);
+                                                                 A );
 
 
     // Store PC:
@@ -1080,7 +1272,9 @@ static void enkf_main_analysis_update( enkf_main_type * enkf_main ,
     while (!hash_iter_is_complete( dataset_iter )) {
       const char * dataset_name = hash_iter_get_next_key( dataset_iter );
       const local_dataset_type * dataset = local_ministep_get_dataset( ministep , dataset_name );
-      if (local_dataset_get_size( dataset )) {
+      if (stream_update)
+        enkf_main_stream_update_dataset( enkf_main->ensemble_config , dataset , step2 , X , tp , serialize_info );
+      else if (local_dataset_get_size( dataset )) {
         int * active_size = util_calloc( local_dataset_get_size( dataset ) , sizeof * active_size );
         int * row_offset  = util_calloc( local_dataset_get_size( dataset ) , sizeof * row_offset  );
         local_obsdata_type   * local_obsdata = local_ministep_get_obsdata( ministep );
@@ -1176,6 +1370,7 @@ bool enkf_main_UPDATE(enkf_main_type * enkf_main , const int_vector_type * step_
       const local_updatestep_type * updatestep    = local_config_get_updatestep( local_config );
       hash_type                   * use_count     = hash_alloc();
       const char                  * log_path      = analysis_config_get_log_path( enkf_main->analysis_config );
+      thread_pool_type            * measure_pool  = thread_pool_alloc( analysis_config_get_update_threads( analysis_config ) , false );
       FILE                        * log_stream;
 
 
@@ -1240,12 +1435,13 @@ bool enkf_main_UPDATE(enkf_main_type * enkf_main , const int_vector_type * step_
           ert_log_add_fmt_message(1, NULL, "Scaling standard deviation in obdsata set:%s with %g", local_obsdata_get_name(obsdata) , scale_factor);
         }
 
-        enkf_obs_get_obs_and_measure_data( enkf_main->obs,
-                                           source_fs ,
-                                           obsdata,
-                                           ens_active_list ,
-                                           meas_data,
-                                           obs_data);
+        enkf_obs_get_obs_and_measure_data_mt( enkf_main->obs,
+                                              source_fs ,
+                                              obsdata,
+                                              ens_active_list ,
+                                              meas_data,
+                                              obs_data,
+                                              measure_pool);
 
 
 
@@ -1271,6 +1467,7 @@ bool enkf_main_UPDATE(enkf_main_type * enkf_main , const int_vector_type * step_
           ert_log_add_fmt_message( 1 , stderr , "No active observations/parameters for MINISTEP: %s." , local_ministep_get_name(ministep));
       }
       fclose( log_stream );
+      thread_pool_free( measure_pool );
 
       obs_data_free( obs_data );
       meas_data_free( meas_data );
@@ -1531,6 +1728,59 @@ void enkf_main_submit_jobs( enkf_main_type * enkf_main ,
 
 
 
+typedef struct {
+  enkf_fs_type               * fs;
+  const ensemble_config_type * ensemble_config;
+  const stringlist_type      * keys;
+  const int_vector_type      * active_list;
+  int                          ens_size;
+} summary_block_update_info_type;
+
+
+static void enkf_main_update_summary_blocks_mt( int begin , int end , void * arg ) {
+  summary_block_update_info_type * info = arg;
+  for (int ikey = begin; ikey < end; ikey++) {
+    const enkf_config_node_type * config_node = ensemble_config_get_node( info->ensemble_config , stringlist_iget( info->keys , ikey ));
+    if (enkf_config_node_vector_storage( config_node ))
+      summary_block_update_fs( info->fs , config_node , info->ens_size , info->active_list );
+  }
+}
+
+
+/**
+   Stores the summary blocks of the members which have data in fs;
+   called when the simulation results have been loaded, so that the
+   later read only loads of plotting and updating find valid blocks.
+*/
+
+static void enkf_main_update_summary_blocks( enkf_main_type * enkf_main , enkf_fs_type * fs ) {
+  if (!enkf_fs_is_read_only( fs )) {
+    state_map_type * state_map = enkf_fs_get_state_map( fs );
+    const int ens_size = enkf_main_get_ensemble_size( enkf_main );
+    bool_vector_type * mask = bool_vector_alloc( ens_size , false );
+    stringlist_type * keys = ensemble_config_alloc_keylist_from_impl_type( enkf_main_get_ensemble_config( enkf_main ) , SUMMARY );
+
+    state_map_select_matching( state_map , mask , STATE_HAS_DATA );
+    if (stringlist_get_size( keys ) > 0) {
+      int_vector_type * active_list = bool_vector_alloc_active_list( mask );
+      thread_pool_type * tp = thread_pool_alloc( site_config_get_load_threads( enkf_main->site_config ) , false );
+      summary_block_update_info_type info = { .fs              = fs ,
+                                              .ensemble_config = enkf_main_get_ensemble_config( enkf_main ),
+                                              .keys            = keys ,
+                                              .active_list     = active_list ,
+                                              .ens_size        = ens_size };
+
+      parallel_for( tp , 0 , stringlist_get_size( keys ) , 1 , enkf_main_update_summary_blocks_mt , &info );
+      thread_pool_free( tp );
+      int_vector_free( active_list );
+    }
+    stringlist_free( keys );
+    bool_vector_free( mask );
+  }
+}
+
+
+
 /**
   The function will return number of non-failing jobs.
 */
@@ -1600,6 +1850,7 @@ static int enkf_main_run_step(enkf_main_type * enkf_main       ,
       }
     }
     
+    enkf_main_update_summary_blocks( enkf_main , ert_run_context_get_result_fs( run_context ));
     enkf_fs_fsync( ert_run_context_get_result_fs( run_context ) );
     if (totalFailed == 0)
       ert_log_add_fmt_message( 1 , NULL , "All jobs complete and data loaded.");
@@ -3061,7 +3312,7 @@ void enkf_main_load_from_forward_model_with_fs(enkf_main_type * enkf_main, int i
 
   ert_run_context_type * run_context = ert_run_context_alloc_ENSEMBLE_EXPERIMENT( fs , iactive , model_config_get_runpath_fmt( model_config ) , enkf_main->subst_list , iter );
   arg_pack_type ** arg_list = util_calloc( ens_size , sizeof * arg_list );
-  thread_pool_type * tp     = thread_pool_alloc( 4 , true );  /* num_cpu - HARD coded. */
+  thread_pool_type * tp     = thread_pool_alloc( site_config_get_load_threads( enkf_main->site_config ) , true );
 
   int iens = 0;
   for (; iens < ens_size; ++iens) {
@@ -3094,6 +3345,7 @@ void enkf_main_load_from_forward_model_with_fs(enkf_main_type * enkf_main, int i
     arg_pack_free(arg_list[iens]);
   }
   free( arg_list );
+  enkf_main_update_summary_blocks( enkf_main , fs );
   ert_run_context_free( run_context );
 }
 
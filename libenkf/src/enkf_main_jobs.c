@@ -153,6 +153,27 @@ void * enkf_main_scale_obs_std_JOB(void * self, const stringlist_type * args ) {
   return NULL;
 }
 
+
+/*
+   Compacts the storage of the current case; the optional argument is
+   the fragmentation limit, i.e. the fraction of unused space which
+   must be exceeded before a storage file is compacted.
+*/
+void * enkf_main_compact_storage_JOB(void * self, const stringlist_type * args ) {
+  enkf_main_type * enkf_main = enkf_main_safe_cast( self );
+  double fragmentation_limit = 0.10;
+
+  if (stringlist_get_size( args ) > 0) {
+    if (!util_sscanf_double( stringlist_iget( args , 0 ) , &fragmentation_limit )) {
+      fprintf(stderr,"** Warning: Function %s : could not interpret \"%s\" as a fragmentation limit - job not started\n", __func__ , stringlist_iget( args , 0 ));
+      return NULL;
+    }
+  }
+
+  enkf_fs_compact( enkf_main_get_fs( enkf_main ) , fragmentation_limit );
+  return NULL;
+}
+
 /*****************************************************************/
 
 /*
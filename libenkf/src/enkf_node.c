@@ -443,14 +443,19 @@ bool enkf_node_forward_load_vector(enkf_node_type *enkf_node , const forward_loa
 
 
 
-static bool enkf_node_store_buffer( enkf_node_type * enkf_node , enkf_fs_type * fs , int report_step , int iens) {
+static bool enkf_node_write_buffer( enkf_node_type * enkf_node , buffer_type * buffer , int report_step) {
   FUNC_ASSERT(enkf_node->write_to_buffer);
+  buffer_fwrite_time_t( buffer , time(NULL));
+  return enkf_node->write_to_buffer(enkf_node->data , buffer , report_step );
+}
+
+
+static bool enkf_node_store_buffer( enkf_node_type * enkf_node , enkf_fs_type * fs , int report_step , int iens) {
   {
     bool data_written;
     buffer_type * buffer = buffer_alloc( 100 );
     const enkf_config_node_type * config_node = enkf_node_get_config( enkf_node );
-    buffer_fwrite_time_t( buffer , time(NULL));
-    data_written = enkf_node->write_to_buffer(enkf_node->data , buffer , report_step );
+    data_written = enkf_node_write_buffer( enkf_node , buffer , report_step );
     if (data_written) {
       const char * node_key = enkf_config_node_get_key( config_node );
       enkf_var_type var_type = enkf_config_node_get_var_type( config_node );
@@ -471,6 +476,46 @@ bool enkf_node_store_vector(enkf_node_type *enkf_node , enkf_fs_type * fs , int
 }
 
 
+static void buffer_free__( void * arg ) {
+  buffer_free( (buffer_type *) arg );
+}
+
+
+/**
+   Stores the vectors of all the nodes in node_list for realization
+   iens with one batched write, see enkf_fs_fwrite_vector_batch(). All
+   the nodes must have vector storage and the same var_type.
+*/
+
+void enkf_node_store_vector_batch( const vector_type * node_list , enkf_fs_type * fs , int iens ) {
+  if (vector_get_size( node_list ) > 0) {
+    stringlist_type * node_keys = stringlist_alloc_new( );
+    vector_type * buffers = vector_alloc_new( );
+    enkf_var_type var_type = enkf_config_node_get_var_type( enkf_node_get_config( vector_iget( node_list , 0 )));
+
+    for (int inode = 0; inode < vector_get_size( node_list ); inode++) {
+      enkf_node_type * enkf_node = vector_iget( node_list , inode );
+      const enkf_config_node_type * config_node = enkf_node_get_config( enkf_node );
+
+      if (!enkf_node->vector_storage || (enkf_config_node_get_var_type( config_node ) != var_type))
+        util_abort("%s: all nodes must have vector storage and the same var_type - %s does not.\n",__func__ , enkf_config_node_get_key( config_node ));
+      {
+        buffer_type * buffer = buffer_alloc( 100 );
+        if (enkf_node_write_buffer( enkf_node , buffer , -1 )) {
+          stringlist_append_ref( node_keys , enkf_config_node_get_key( config_node ));
+          vector_append_owned_ref( buffers , buffer , buffer_free__ );
+        } else
+          buffer_free( buffer );
+      }
+    }
+
+    enkf_fs_fwrite_vector_batch( fs , buffers , node_keys , var_type , iens );
+    vector_free( buffers );
+    stringlist_free( node_keys );
+  }
+}
+
+
 
 bool enkf_node_store(enkf_node_type * enkf_node , enkf_fs_type * fs , bool force_vectors , node_id_type node_id) {
   if (enkf_node->vector_storage) {
@@ -701,10 +746,23 @@ enkf_node_type ** enkf_node_load_alloc_ensemble( const enkf_config_node_type * c
 void enkf_node_serialize(enkf_node_type *enkf_node , enkf_fs_type * fs, node_id_type node_id ,
                          const active_list_type * active_list , matrix_type * A , int row_offset , int column) {
 
-  FUNC_ASSERT(enkf_node->serialize);
   enkf_node_load( enkf_node , fs , node_id);
-  enkf_node->serialize(enkf_node->data , node_id , active_list , A , row_offset , column);
+  enkf_node_serialize_loaded( enkf_node , node_id , active_list , A , row_offset , column );
+}
+
 
+/**
+   Serializes the data currently held by the node, without loading
+   from the filesystem first; used when the node is updated in
+   several row blocks and the node already contains the result of the
+   previous blocks.
+*/
+
+void enkf_node_serialize_loaded(enkf_node_type *enkf_node , node_id_type node_id ,
+                                const active_list_type * active_list , matrix_type * A , int row_offset , int column) {
+
+  FUNC_ASSERT(enkf_node->serialize);
+  enkf_node->serialize(enkf_node->data , node_id , active_list , A , row_offset , column);
 }
 
 
@@ -712,9 +770,22 @@ void enkf_node_serialize(enkf_node_type *enkf_node , enkf_fs_type * fs, node_id_
 void enkf_node_deserialize(enkf_node_type *enkf_node , enkf_fs_type * fs , node_id_type node_id,
                            const active_list_type * active_list , const matrix_type * A , int row_offset , int column) {
 
+  enkf_node_deserialize_unstored( enkf_node , node_id , active_list , A , row_offset , column );
+  enkf_node_store( enkf_node , fs , true , node_id );
+}
+
+
+/**
+   Deserializes into the data held by the node, without storing the
+   node afterwards; used when the node is updated in several row
+   blocks and should only be stored after the last block.
+*/
+
+void enkf_node_deserialize_unstored(enkf_node_type *enkf_node , node_id_type node_id,
+                                    const active_list_type * active_list , const matrix_type * A , int row_offset , int column) {
+
   FUNC_ASSERT(enkf_node->deserialize);
   enkf_node->deserialize(enkf_node->data , node_id , active_list , A , row_offset , column);
-  enkf_node_store( enkf_node , fs , true , node_id );
 }
 
 
@@ -25,6 +25,8 @@
 #include <ert/util/msg.h>
 #include <ert/util/vector.h>
 #include <ert/util/type_vector_functions.h>
+#include <ert/util/thread_pool.h>
+#include <ert/util/parallel_for.h>
 
 #include <ert/config/conf.h>
 
@@ -47,6 +49,9 @@
 #include <ert/enkf/config_keys.h>
 #include <ert/enkf/local_obsdata_node.h>
 #include <ert/enkf/local_obsdata.h>
+#include <ert/enkf/state_map.h>
+#include <ert/enkf/summary.h>
+#include <ert/enkf/summary_block.h>
 
 /*
 
@@ -330,6 +335,148 @@ int enkf_obs_get_size( const enkf_obs_type * obs ) {
 
 
 
+/*****************************************************************/
+/*
+  The observations and simulated values are collected in two phases:
+
+   1. The local_obsdata is traversed serially, the observed values
+      are collected and all the obs_block and meas_block instances
+      are added with their final size. The order of the blocks
+      determines the row order of the S, D and R matrices, and is
+      therefor fixed in this phase. For every meas_block an
+      obs_measure instance is created.
+
+   2. The obs_measure instances are run in parallel, in the thread
+      pool given to enkf_obs_get_obs_and_measure_data_mt(); each of them
+      loads the simulated data and fills its own meas_block, without
+      touching the meas_data instance.
+
+  A time aggregated summary observation loads the summary vector of
+  the active realizations once with summary_block_alloc_load() and
+  scatters all the observed report steps into the meas_block. The
+  GEN_OBS observations are measured immediately in phase 1, because
+  the forward model active mask is loaded into the shared
+  gen_data_config instance by gen_obs_get_observations().
+*/
+
+typedef struct {
+  enkf_fs_type                  * fs;
+  const obs_vector_type         * obs_vector;
+  const active_list_type        * active_list;
+  const int_vector_type         * ens_active_list;
+  meas_block_type               * meas_block;
+  int_vector_type               * report_steps;   /* Row i of a summary meas_block holds the values from report_steps[i]. */
+} obs_measure_type;
+
+
+static obs_measure_type * obs_measure_alloc( enkf_fs_type * fs ,
+                                             const obs_vector_type * obs_vector ,
+                                             const active_list_type * active_list ,
+                                             const int_vector_type * ens_active_list ,
+                                             meas_block_type * meas_block) {
+  obs_measure_type * measure = util_malloc( sizeof * measure );
+  measure->fs              = fs;
+  measure->obs_vector      = obs_vector;
+  measure->active_list     = active_list;
+  measure->ens_active_list = ens_active_list;
+  measure->meas_block      = meas_block;
+  measure->report_steps    = int_vector_alloc( 0 , 0 );
+  return measure;
+}
+
+
+static void obs_measure_free( obs_measure_type * measure ) {
+  int_vector_free( measure->report_steps );
+  free( measure );
+}
+
+
+static void obs_measure_free__( void * arg ) {
+  obs_measure_free( (obs_measure_type *) arg );
+}
+
+
+static void enkf_obs_measure_summary( const obs_measure_type * measure ) {
+  const enkf_config_node_type * config_node = obs_vector_get_config_node( measure->obs_vector );
+  const int num_steps = int_vector_size( measure->report_steps );
+  int ens_size = state_map_get_size( enkf_fs_get_state_map( measure->fs ));
+  summary_block_type * block;
+
+  if (int_vector_size( measure->ens_active_list ) > 0)
+    ens_size = util_int_max( ens_size , int_vector_get_max( measure->ens_active_list ) + 1 );
+
+  block = summary_block_alloc_load( measure->fs , config_node , ens_size , measure->ens_active_list );
+  for (int iens_index = 0; iens_index < int_vector_size( measure->ens_active_list ); iens_index++) {
+    const int iens = int_vector_iget( measure->ens_active_list , iens_index );
+    const double * member_data;
+
+    if (!summary_block_has_member( block , iens ))
+      util_abort("%s: no data for %s in realization:%d \n",__func__ , enkf_config_node_get_key( config_node ) , iens );
+
+    member_data = summary_block_iget_member_data( block , iens );
+    for (int i = 0; i < num_steps; i++) {
+      const int report_step = int_vector_iget( measure->report_steps , i );
+      if (report_step >= summary_block_get_member_num_steps( block , iens ))
+        util_abort("%s: no data for %s in realization:%d at report step:%d \n",__func__ , enkf_config_node_get_key( config_node ) , iens , report_step);
+
+      meas_block_iset( measure->meas_block , iens , i , member_data[ report_step ] );
+    }
+  }
+  summary_block_free( block );
+}
+
+
+static void enkf_obs_measure( const obs_measure_type * measure ) {
+  if (obs_vector_get_impl_type( measure->obs_vector ) == SUMMARY_OBS)
+    enkf_obs_measure_summary( measure );
+  else
+    obs_vector_measure_block( measure->obs_vector ,
+                              measure->fs ,
+                              int_vector_iget( measure->report_steps , 0 ) ,
+                              measure->ens_active_list ,
+                              measure->meas_block ,
+                              measure->active_list );
+}
+
+
+static void enkf_obs_measure_mt( int index1 , int index2 , void * arg ) {
+  const vector_type * measures = (const vector_type *) arg;
+  for (int index = index1; index < index2; index++)
+    enkf_obs_measure( vector_iget_const( measures , index ));
+}
+
+
+/*
+  If measures is NULL the meas_block is filled immediately, otherwise
+  the obs_measure instance is appended to the measures vector, and
+  the calling scope must run it.
+*/
+
+static void enkf_obs_add_measure( vector_type * measures , obs_measure_type * measure ) {
+  if (measures != NULL)
+    vector_append_owned_ref( measures , measure , obs_measure_free__ );
+  else {
+    enkf_obs_measure( measure );
+    obs_measure_free( measure );
+  }
+}
+
+
+/*
+  The measures are run in the thread pool tp of the calling scope; if
+  tp is NULL they are run in the calling thread.
+*/
+
+static void enkf_obs_run_measures( const vector_type * measures , thread_pool_type * tp ) {
+  if ((tp != NULL) && (vector_get_size( measures ) > 1))
+    parallel_for( tp , 0 , vector_get_size( measures ) , 1 , enkf_obs_measure_mt , (void *) measures );
+  else {
+    for (int index = 0; index < vector_get_size( measures ); index++)
+      enkf_obs_measure( vector_iget_const( measures , index ));
+  }
+}
+
+
 static void enkf_obs_get_obs_and_measure_summary(const enkf_obs_type      * enkf_obs,
                                                  obs_vector_type          * obs_vector ,
                                                  enkf_fs_type             * fs,
@@ -338,8 +485,8 @@ static void enkf_obs_get_obs_and_measure_summary(const enkf_obs_type      * enkf
                                                  meas_data_type             *   meas_data,
                                                  obs_data_type              * obs_data,
                                                  double_vector_type         * obs_value ,
-                                                 double_vector_type         * obs_std) {
-
+                                                 double_vector_type         * obs_std ,
+                                                 vector_type                * measures) {
   const active_list_type * active_list = local_obsdata_node_get_active_list( obs_node );
 
   matrix_type * error_covar = NULL;
@@ -407,12 +554,11 @@ static void enkf_obs_get_obs_and_measure_summary(const enkf_obs_type      * enkf
     {
       obs_block_type  * obs_block  = obs_data_add_block( obs_data , obs_vector_get_obs_key( obs_vector ) , active_count , error_covar , true);
       meas_block_type * meas_block = meas_data_add_block( meas_data, obs_vector_get_obs_key( obs_vector ) , last_step , active_count );
-      enkf_node_type * work_node = enkf_node_alloc( obs_vector_get_config_node( obs_vector ));
+      obs_measure_type * measure = obs_measure_alloc( fs , obs_vector , active_list , ens_active_list , meas_block );
 
       for (int i=0; i < active_count; i++)
         obs_block_iset( obs_block , i , double_vector_iget( obs_value , i) , double_vector_iget( obs_std , i ));
 
-      active_count = 0;
       step = -1;
       while (true) {
         step = obs_vector_get_next_active_step( obs_vector , step );
@@ -420,35 +566,23 @@ static void enkf_obs_get_obs_and_measure_summary(const enkf_obs_type      * enkf
           break;
 
         if (local_obsdata_node_tstep_active(obs_node, step)) {
-          if (obs_vector_iget_active( obs_vector , step ) && active_list_iget( active_list , 0 /* Index into the scalar summary observation */)) {
-            for (int iens_index = 0; iens_index < int_vector_size( ens_active_list ); iens_index++) {
-
-              const int iens = int_vector_iget( ens_active_list , iens_index );
-              node_id_type node_id = {.report_step = step,
-                                      .iens        = iens};
-
-              enkf_node_load( work_node , fs , node_id );
-
-              meas_block_iset(meas_block ,
-                              iens , active_count ,
-                              summary_get( enkf_node_value_ptr( work_node ) , node_id.report_step ));
-
-            }
-            active_count++;
-          }
+          if (obs_vector_iget_active( obs_vector , step ) && active_list_iget( active_list , 0 /* Index into the scalar summary observation */))
+            int_vector_append( measure->report_steps , step );
         }
       }
-      enkf_node_free( work_node );
+
+      enkf_obs_add_measure( measures , measure );
     }
   }
 }
 
-void enkf_obs_get_obs_and_measure_node( const enkf_obs_type      * enkf_obs,
-                                        enkf_fs_type             * fs,
-                                        const local_obsdata_node_type * obs_node ,
-                                        const int_vector_type    * ens_active_list ,
-                                        meas_data_type           * meas_data,
-                                        obs_data_type            * obs_data) {
+static void enkf_obs_get_obs_and_measure_node__( const enkf_obs_type      * enkf_obs,
+                                                 enkf_fs_type             * fs,
+                                                 const local_obsdata_node_type * obs_node ,
+                                                 const int_vector_type    * ens_active_list ,
+                                                 meas_data_type           * meas_data,
+                                                 obs_data_type            * obs_data,
+                                                 vector_type              * measures) {
 
   const char * obs_key         = local_obsdata_node_get_key( obs_node );
   obs_vector_type * obs_vector = hash_get( enkf_obs->obs_hash , obs_key );
@@ -466,7 +600,8 @@ void enkf_obs_get_obs_and_measure_node( const enkf_obs_type      * enkf_obs,
                                           meas_data ,
                                           obs_data ,
                                           work_value,
-                                          work_std);
+                                          work_std,
+                                          measures);
 
     double_vector_free( work_value );
     double_vector_free( work_std   );
@@ -481,7 +616,14 @@ void enkf_obs_get_obs_and_measure_node( const enkf_obs_type      * enkf_obs,
         if (obs_vector_iget_active(obs_vector , report_step)) {                             /* The observation is active for this report step.     */
           const active_list_type * active_list = local_obsdata_node_get_active_list( obs_node );
           obs_vector_iget_observations(obs_vector , report_step , obs_data , active_list, fs);  /* Collect the observed data in the obs_data instance. */
-          obs_vector_measure(obs_vector , fs , report_step , ens_active_list , meas_data , active_list);
+          {
+            meas_block_type * meas_block = obs_vector_add_meas_block( obs_vector , report_step , meas_data , active_list );
+            if (meas_block != NULL) {
+              obs_measure_type * measure = obs_measure_alloc( fs , obs_vector , active_list , ens_active_list , meas_block );
+              int_vector_append( measure->report_steps , report_step );
+              enkf_obs_add_measure( (obs_type == GEN_OBS) ? NULL : measures , measure );
+            }
+          }
         }
       }
     }
@@ -489,6 +631,16 @@ void enkf_obs_get_obs_and_measure_node( const enkf_obs_type      * enkf_obs,
 }
 
 
+void enkf_obs_get_obs_and_measure_node( const enkf_obs_type      * enkf_obs,
+                                        enkf_fs_type             * fs,
+                                        const local_obsdata_node_type * obs_node ,
+                                        const int_vector_type    * ens_active_list ,
+                                        meas_data_type           * meas_data,
+                                        obs_data_type            * obs_data) {
+  enkf_obs_get_obs_and_measure_node__( enkf_obs , fs , obs_node , ens_active_list , meas_data , obs_data , NULL );
+}
+
+
 
 /*
   This will append observations and simulated responses from
@@ -497,24 +649,40 @@ void enkf_obs_get_obs_and_measure_node( const enkf_obs_type      * enkf_obs,
   if you want to use fresh instances.
 */
 
-void enkf_obs_get_obs_and_measure_data(const enkf_obs_type      * enkf_obs,
-                                       enkf_fs_type             * fs,
-                                       const local_obsdata_type * local_obsdata ,
-                                       const int_vector_type    * ens_active_list ,
-                                       meas_data_type           * meas_data,
-                                       obs_data_type            * obs_data) {
+void enkf_obs_get_obs_and_measure_data_mt(const enkf_obs_type      * enkf_obs,
+                                          enkf_fs_type             * fs,
+                                          const local_obsdata_type * local_obsdata ,
+                                          const int_vector_type    * ens_active_list ,
+                                          meas_data_type           * meas_data,
+                                          obs_data_type            * obs_data,
+                                          thread_pool_type         * tp) {
 
 
+  vector_type * measures = vector_alloc_new();
   int iobs;
   for (iobs = 0; iobs < local_obsdata_get_size( local_obsdata ); iobs++) {
     const local_obsdata_node_type * obs_node = local_obsdata_iget( local_obsdata , iobs );
-    enkf_obs_get_obs_and_measure_node( enkf_obs ,
-                                       fs ,
-                                       obs_node ,
-                                       ens_active_list ,
-                                       meas_data ,
-                                       obs_data);
+    enkf_obs_get_obs_and_measure_node__( enkf_obs ,
+                                         fs ,
+                                         obs_node ,
+                                         ens_active_list ,
+                                         meas_data ,
+                                         obs_data ,
+                                         measures);
   }
+
+  enkf_obs_run_measures( measures , tp );
+  vector_free( measures );
+}
+
+
+void enkf_obs_get_obs_and_measure_data(const enkf_obs_type      * enkf_obs,
+                                       enkf_fs_type             * fs,
+                                       const local_obsdata_type * local_obsdata ,
+                                       const int_vector_type    * ens_active_list ,
+                                       meas_data_type           * meas_data,
+                                       obs_data_type            * obs_data) {
+  enkf_obs_get_obs_and_measure_data_mt( enkf_obs , fs , local_obsdata , ens_active_list , meas_data , obs_data , NULL );
 }
 
 
@@ -19,6 +19,8 @@
 #include <stdbool.h>
 
 #include <ert/util/double_vector.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/type_vector_functions.h>
 #include <ert/util/vector.h>
 #include <ert/util/thread_pool.h>
 #include <ert/util/type_macros.h>
@@ -27,6 +29,7 @@
 #include <ert/enkf/enkf_plot_tvector.h>
 #include <ert/enkf/enkf_plot_data.h>
 #include <ert/enkf/state_map.h>
+#include <ert/enkf/summary_block.h>
 
 
 #define ENKF_PLOT_DATA_TYPE_ID 3331063
@@ -127,7 +130,17 @@ void enkf_plot_data_load( enkf_plot_data_type * plot_data ,
 
   enkf_plot_data_resize( plot_data , ens_size );
   enkf_plot_data_reset( plot_data );
-  {
+  if (enkf_config_node_vector_storage( plot_data->config_node )) {
+    /* Vector storage: the vectors of the selected members are loaded as one block. */
+    int_vector_type * active_list = bool_vector_alloc_active_list( mask );
+    summary_block_type * block = summary_block_alloc_load( fs , plot_data->config_node , ens_size , active_list );
+    for (int i = 0; i < int_vector_size( active_list ); i++) {
+      int iens = int_vector_iget( active_list , i );
+      enkf_plot_tvector_load_summary_block( enkf_plot_data_iget( plot_data , iens ) , fs , block );
+    }
+    summary_block_free( block );
+    int_vector_free( active_list );
+  } else {
     const int num_cpu = 4;
     thread_pool_type * tp = thread_pool_alloc( num_cpu , true );
     for (int iens = 0; iens < ens_size ; iens++) {
@@ -24,6 +24,7 @@
 #include <ert/enkf/enkf_config_node.h>
 #include <ert/enkf/enkf_node.h>
 #include <ert/enkf/summary.h>
+#include <ert/enkf/summary_block.h>
 
 #define ENKF_PLOT_TVECTOR_ID 6111861
 
@@ -169,6 +170,26 @@ void enkf_plot_tvector_load( enkf_plot_tvector_type * plot_tvector ,
 }
 
 
+/**
+   Loads the vector of this member from a summary_block which has been
+   loaded for the whole ensemble.
+*/
+
+void enkf_plot_tvector_load_summary_block( enkf_plot_tvector_type * plot_tvector ,
+                                           enkf_fs_type * fs ,
+                                           const summary_block_type * block) {
+  time_map_type * time_map = enkf_fs_get_time_map( fs );
+
+  if (summary_block_has_member( block , plot_tvector->iens )) {
+    for (int step = 0; step < time_map_get_size(time_map); step++)
+      enkf_plot_tvector_iset( plot_tvector ,
+                              step ,
+                              time_map_iget( time_map , step ) ,
+                              summary_block_iget( block , plot_tvector->iens , step ));
+  }
+}
+
+
 void * enkf_plot_tvector_load__( void * arg ) {
   arg_pack_type * arg_pack = arg_pack_safe_cast( arg );
   enkf_plot_tvector_type * tvector = arg_pack_iget_ptr( arg_pack , 0 );
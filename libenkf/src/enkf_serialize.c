@@ -18,8 +18,10 @@
 
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <ert/util/util.h>
+#include <ert/util/util_kernels.h>
 
 #include <ert/enkf/enkf_serialize.h>
 #include <ert/enkf/enkf_types.h>
@@ -178,28 +180,45 @@ vector (marked with X2 above)). Now - that was clear ehhh?
 
 
 
-/* 
+/*
    It will be very costly to make it thread-safe if we manipulate the
    shape of the A matrix from here.
+
+   The node data is moved to / from one column of A with the bulk
+   kernels from util_kernels.h, i.e. one pass over the active part of
+   the node; for partially active nodes the active_list is used as
+   gather / scatter index. The element by element fallback is only
+   used if the rows of A are not contiguous.
 */
-   
 
-void enkf_matrix_serialize(const void * __node_data               , 
-                           int node_size                          ,      
-                           ecl_type_enum node_type                ,           
-                           const active_list_type * __active_list , 
+
+static double * enkf_matrix_get_column_data( const matrix_type * A , int row_offset , int column) {
+  if (matrix_get_row_stride( A ) == 1)
+    return &matrix_get_data( A )[ row_offset + column * matrix_get_column_stride( A ) ];
+  else
+    return NULL;
+}
+
+
+void enkf_matrix_serialize(const void * __node_data               ,
+                           int node_size                          ,
+                           ecl_type_enum node_type                ,
+                           const active_list_type * __active_list ,
                            matrix_type * A                        ,
                            int row_offset,
                            int column) {
-  
+
   int active_size;
-  const int   * active_list    = active_list_get_active( __active_list ); 
+  const int   * active_list    = active_list_get_active( __active_list );
+  double      * column_data    = enkf_matrix_get_column_data( A , row_offset , column );
   active_size = active_list_get_active_size( __active_list , node_size);
 
   if (node_type == ECL_DOUBLE_TYPE) {
     const double * node_data = (const double *) __node_data;
     if (active_size == node_size) /** All elements active */
       matrix_set_many_on_column( A , row_offset , node_size , node_data , column);
+    else if (column_data != NULL)
+      util_kernel_gather_double( column_data , node_data , active_list , active_size );
     else {
       int row_index;
       int node_index;
@@ -210,67 +229,70 @@ void enkf_matrix_serialize(const void * __node_data               ,
     }
   } else if (node_type == ECL_FLOAT_TYPE) {
     const float * node_data = (const float *) __node_data;
-    int row_index;
-    if (active_size == node_size) {/** All elements active */
-      for (row_index = 0; row_index < node_size; row_index++)
-        matrix_iset( A , row_index + row_offset , column , node_data[ row_index ]);  /* Must have float -> double conversion; can not use memcpy() based approach */
+    if (column_data != NULL) {
+      if (active_size == node_size) /** All elements active */
+        util_kernel_float_to_double( column_data , node_data , node_size );
+      else
+        util_kernel_gather_float_to_double( column_data , node_data , active_list , active_size );
     } else {
       int row_index;
       int node_index;
       for (row_index = 0; row_index < active_size; row_index++) {
-        node_index = active_list[ row_index ];
+        node_index = (active_size == node_size) ? row_index : active_list[ row_index ];
         matrix_iset( A , row_index + row_offset , column , node_data[node_index] );
       }
-    }      
-  } else 
+    }
+  } else
       util_abort("%s: internal error: trying to serialize unserializable type:%s \n",__func__ , ecl_util_get_type_name( node_type ));
 }
 
 
-void enkf_matrix_deserialize(void * __node_data                 , 
-                             int node_size                      ,      
-                             ecl_type_enum node_type            ,           
-                             const active_list_type * __active_list , 
+void enkf_matrix_deserialize(void * __node_data                 ,
+                             int node_size                      ,
+                             ecl_type_enum node_type            ,
+                             const active_list_type * __active_list ,
                              const matrix_type * A,
                              int row_offset,
                              int column) {
-  
+
   int active_size;
-  const int   * active_list    = active_list_get_active( __active_list ); 
+  const int    * active_list    = active_list_get_active( __active_list );
+  const double * column_data    = enkf_matrix_get_column_data( A , row_offset , column );
   active_size = active_list_get_active_size( __active_list , node_size );
-    
+
   if (node_type == ECL_DOUBLE_TYPE) {
     double * node_data = (double *) __node_data;
 
-    if (active_size == node_size) { /** All elements active */
-      int row_index;
-      for (row_index = 0; row_index < active_size; row_index++) 
-        node_data[row_index] = matrix_iget( A , row_index + row_offset , column);
+    if (column_data != NULL) {
+      if (active_size == node_size) /** All elements active */
+        memcpy( node_data , column_data , active_size * sizeof * node_data );
+      else
+        util_kernel_scatter_double( node_data , active_list , column_data , active_size );
     } else {
       int row_index;
       int node_index;
       for (row_index = 0; row_index < active_size; row_index++) {
-        node_index = active_list[ row_index ];
+        node_index = (active_size == node_size) ? row_index : active_list[ row_index ];
         node_data[node_index] = matrix_iget( A , row_index + row_offset , column);
       }
     }
-    
+
   } else if (node_type == ECL_FLOAT_TYPE) {
     float * node_data = (float *) __node_data;
-    
-    if (active_size == node_size) { /** All elements active */
-      int row_index;
-      for (row_index = 0; row_index < active_size; row_index++) 
-        node_data[row_index] = matrix_iget( A , row_index + row_offset , column);
+
+    if (column_data != NULL) {
+      if (active_size == node_size) /** All elements active */
+        util_kernel_double_to_float( node_data , column_data , active_size );
+      else
+        util_kernel_scatter_double_to_float( node_data , active_list , column_data , active_size );
     } else {
       int row_index;
       int node_index;
       for (row_index = 0; row_index < active_size; row_index++) {
-        node_index = active_list[ row_index ];
+        node_index = (active_size == node_size) ? row_index : active_list[ row_index ];
         node_data[node_index] = matrix_iget( A , row_index + row_offset , column);
       }
     }
-  } else 
+  } else
     util_abort("%s: internal error: trying to serialize unserializable type:%s \n",__func__ , ecl_util_get_type_name( node_type ));
 }
-                           
@@ -32,6 +32,7 @@
 #include <ert/util/util.h>
 #include <ert/util/arg_pack.h>
 #include <ert/util/stringlist.h>
+#include <ert/util/vector.h>
 #include <ert/util/node_ctype.h>
 #include <ert/util/subst_list.h>
 #include <ert/util/timer.h>
@@ -604,24 +605,31 @@ static bool enkf_state_internalize_dynamic_eclipse_results(enkf_state_type * enk
 
         const ecl_smspec_type * smspec = ecl_sum_get_smspec(summary);
 
-        for(int i = 0; i < ecl_smspec_num_nodes(smspec); i++) {
-            const smspec_node_type * smspec_node = ecl_smspec_iget_node(smspec, i);
+        /* The matching nodes are resolved once for each distinct SMSPEC layout. */
+        int_vector_type * index_list = summary_key_matcher_alloc_smspec_index_list(matcher, smspec);
+        vector_type * node_list = vector_alloc_new();
+
+        for(int i = 0; i < int_vector_size(index_list); i++) {
+            const smspec_node_type * smspec_node = ecl_smspec_iget_node(smspec, int_vector_iget(index_list, i));
             const char * key = smspec_node_get_gen_key1(smspec_node);
 
-            if(summary_key_matcher_match_summary_key(matcher, key)) {
-                summary_key_set_type * key_set = enkf_fs_get_summary_key_set(result_fs);
-                summary_key_set_add_summary_key(key_set, key);
+            summary_key_set_type * key_set = enkf_fs_get_summary_key_set(result_fs);
+            summary_key_set_add_summary_key(key_set, key);
 
-                enkf_config_node_type * config_node = ensemble_config_get_or_create_summary_node(enkf_state->ensemble_config, key);
-                enkf_node_type * node = enkf_state_get_or_create_node(enkf_state, config_node);
+            enkf_config_node_type * config_node = ensemble_config_get_or_create_summary_node(enkf_state->ensemble_config, key);
+            enkf_node_type * node = enkf_state_get_or_create_node(enkf_state, config_node);
 
-                enkf_node_try_load_vector( node , result_fs , iens );  // Ensure that what is currently on file is loaded before we update.
+            enkf_node_try_load_vector( node , result_fs , iens );  // Ensure that what is currently on file is loaded before we update.
 
-                enkf_node_forward_load_vector( node , load_context , time_index);
-                enkf_node_store_vector( node , result_fs , iens );
-            }
+            enkf_node_forward_load_vector( node , load_context , time_index);
+            vector_append_ref( node_list , node );
         }
 
+        /* All the summary vectors of this realization are stored with one batched write. */
+        enkf_node_store_vector_batch( node_list , result_fs , iens );
+        vector_free( node_list );
+        int_vector_free( index_list );
+
         int_vector_free( time_index );
 
         /*
@@ -826,11 +834,30 @@ static forward_load_context_type * enkf_state_alloc_load_context( const enkf_sta
     const ecl_config_type * ecl_config = state->shared_info->ecl_config;
     const char * eclbase = enkf_state_get_eclbase( state );
 
-    load_context = forward_load_context_alloc( run_arg,
-                                               load_summary,
-                                               ecl_config ,
-                                               eclbase,
-                                               messages );
+    /*
+      Only the summary vectors which will be internalized are loaded
+      from the summary files; i.e. the keys of the summary key matcher
+      and the keys of the SUMMARY nodes.
+    */
+    stringlist_type * summary_keys = NULL;
+    if (load_summary) {
+      const summary_key_matcher_type * matcher = ensemble_config_get_summary_key_matcher(state->ensemble_config);
+      stringlist_type * node_keys = ensemble_config_alloc_keylist_from_impl_type(state->ensemble_config , SUMMARY);
+
+      summary_keys = summary_key_matcher_get_keys(matcher);
+      stringlist_append_stringlist_copy( summary_keys , node_keys );
+      stringlist_free( node_keys );
+    }
+
+    load_context = forward_load_context_alloc_selected( run_arg,
+                                                        load_summary,
+                                                        ecl_config ,
+                                                        eclbase,
+                                                        messages ,
+                                                        summary_keys );
+    if (summary_keys != NULL)
+      stringlist_free( summary_keys );
+
     return load_context;
   }
 }
@@ -36,6 +36,7 @@ struct forward_load_context_struct {
   const run_arg_type  * run_arg;
   char                * eclbase;
   const ecl_config_type * ecl_config;   // Can be NULL
+  const stringlist_type * summary_keys; // Can be NULL - only used while loading the summary.
 
   int step1;
   int step2;
@@ -91,7 +92,7 @@ static void forward_load_context_load_ecl_sum(forward_load_context_type * load_c
     }
 
     if ((header_file != NULL) && (stringlist_get_size(data_files) > 0)) {
-      summary = ecl_sum_fread_alloc(header_file , data_files , SUMMARY_KEY_JOIN_STRING );
+      summary = ecl_sum_fread_alloc_selected(header_file , data_files , SUMMARY_KEY_JOIN_STRING , load_context->summary_keys );
       {
         time_t end_time = ecl_config_get_end_date( load_context->ecl_config );
         if (end_time > 0) {
@@ -134,7 +135,7 @@ static void forward_load_context_load_ecl_sum(forward_load_context_type * load_c
 
 
 
-forward_load_context_type * forward_load_context_alloc( const run_arg_type * run_arg , bool load_summary , const ecl_config_type * ecl_config , const char * eclbase , stringlist_type * messages) {
+static forward_load_context_type * forward_load_context_alloc__( const run_arg_type * run_arg , bool load_summary , const ecl_config_type * ecl_config , const char * eclbase , stringlist_type * messages , const stringlist_type * summary_keys) {
   forward_load_context_type * load_context = util_malloc( sizeof * load_context );
   UTIL_TYPE_ID_INIT( load_context , FORWARD_LOAD_CONTEXT_TYPE_ID );
 
@@ -146,14 +147,32 @@ forward_load_context_type * forward_load_context_alloc( const run_arg_type * run
   load_context->messages = messages;
   load_context->ecl_config = ecl_config;
   load_context->eclbase = util_alloc_string_copy( eclbase );
+  load_context->summary_keys = summary_keys;
 
   if (load_summary)
     forward_load_context_load_ecl_sum(load_context);
 
+  load_context->summary_keys = NULL;
   return load_context;
 }
 
 
+forward_load_context_type * forward_load_context_alloc( const run_arg_type * run_arg , bool load_summary , const ecl_config_type * ecl_config , const char * eclbase , stringlist_type * messages) {
+  return forward_load_context_alloc__( run_arg , load_summary , ecl_config , eclbase , messages , NULL );
+}
+
+
+/*
+  As forward_load_context_alloc(), but only the summary vectors
+  matching one of the patterns in @summary_keys are loaded from the
+  summary files.
+*/
+
+forward_load_context_type * forward_load_context_alloc_selected( const run_arg_type * run_arg , bool load_summary , const ecl_config_type * ecl_config , const char * eclbase , stringlist_type * messages , const stringlist_type * summary_keys) {
+  return forward_load_context_alloc__( run_arg , load_summary , ecl_config , eclbase , messages , summary_keys );
+}
+
+
 
 bool forward_load_context_accept_messages( const forward_load_context_type * load_context ) {
   if (load_context->messages)
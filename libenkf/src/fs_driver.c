@@ -41,14 +41,22 @@ void fs_driver_init(fs_driver_type * driver) {
   driver->save_node   = NULL;
   driver->has_node    = NULL;
   driver->unlink_node = NULL;
+  driver->save_node_batch = NULL;
 
   driver->load_vector   = NULL;
   driver->save_vector   = NULL;
   driver->has_vector    = NULL;
   driver->unlink_vector = NULL;
+  driver->save_vector_batch = NULL;
+
+  driver->load_ensemble_vector   = NULL;
+  driver->save_ensemble_vector   = NULL;
+  driver->has_ensemble_vector    = NULL;
+  driver->unlink_ensemble_vector = NULL;
   
   driver->free_driver   = NULL;
   driver->fsync_driver  = NULL;
+  driver->compact_driver = NULL;
 }
 
 void fs_driver_assert_cast(const fs_driver_type * driver) {
@@ -288,11 +288,16 @@ double gen_obs_chi2(const gen_obs_type * gen_obs , const gen_data_type * gen_dat
 
 
 
-void gen_obs_measure(const gen_obs_type * gen_obs , const gen_data_type * gen_data , node_id_type node_id , meas_data_type * meas_data, const active_list_type * __active_list) {
+meas_block_type * gen_obs_add_meas_block(const gen_obs_type * gen_obs , meas_data_type * meas_data , int report_step , const active_list_type * __active_list) {
+  int active_size = active_list_get_active_size( __active_list , gen_obs->obs_size );
+  return meas_data_add_block( meas_data , gen_obs->obs_key , report_step , active_size );
+}
+
+
+void gen_obs_measure(const gen_obs_type * gen_obs , const gen_data_type * gen_data , node_id_type node_id , meas_block_type * meas_block, const active_list_type * __active_list) {
   gen_obs_assert_data_size(gen_obs , gen_data);
   {
     int active_size                               = active_list_get_active_size( __active_list , gen_obs->obs_size );
-    meas_block_type * meas_block                  = meas_data_add_block( meas_data , gen_obs->obs_key , node_id.report_step , active_size );
     active_mode_type active_mode                  = active_list_get_mode( __active_list );
     const bool_vector_type * forward_model_active = gen_data_config_get_active_mask( gen_obs->data_config );
 
@@ -505,6 +510,7 @@ UTIL_IS_INSTANCE_FUNCTION(gen_obs , GEN_OBS_TYPE_ID)
 VOID_FREE(gen_obs)
 VOID_GET_OBS(gen_obs)
 VOID_MEASURE(gen_obs , gen_data)
+VOID_ADD_MEAS_BLOCK(gen_obs)
 VOID_USER_GET_OBS(gen_obs)
 VOID_CHI2(gen_obs , gen_data)
 VOID_UPDATE_STD_SCALE(gen_obs)
@@ -78,6 +78,11 @@ UTIL_SAFE_CAST_FUNCTION( meas_block , MEAS_BLOCK_TYPE_ID )
    of the observation; if parts of the observation have been excluded
    due to local analysis it should still be included in the @obs_size
    value.
+
+   The data is stored with the observations of one realization
+   contiguous, i.e. the storage of a realization is a column segment
+   of the S matrix; the ensemble mean and std are stored as two extra
+   'realizations' at the end.
 */
 
 meas_block_type * meas_block_alloc( const char * obs_key , const bool_vector_type * ens_mask , int obs_size) {
@@ -89,8 +94,8 @@ meas_block_type * meas_block_alloc( const char * obs_key , const bool_vector_typ
   meas_block->obs_key     = util_alloc_string_copy( obs_key );
   meas_block->data        = util_calloc( (meas_block->active_ens_size + 2)     * obs_size , sizeof * meas_block->data   );
   meas_block->active      = util_calloc(                                  obs_size , sizeof * meas_block->active );
-  meas_block->ens_stride  = 1;
-  meas_block->obs_stride  = meas_block->active_ens_size + 2;
+  meas_block->ens_stride  = obs_size;
+  meas_block->obs_stride  = 1;
   meas_block->data_size   = (meas_block->active_ens_size + 2) * obs_size;
   meas_block->index_map   = bool_vector_alloc_active_index_list( meas_block->ens_mask , -1);
   {
@@ -131,19 +136,61 @@ static void meas_block_free__( void * arg ) {
 
 
 
+static int meas_block_get_active_obs_size( const meas_block_type * meas_block ) {
+  int obs_size = 0;
+  int i;
+
+  for (i=0; i < meas_block->obs_size; i++)
+    if (meas_block->active[i])
+      obs_size++;
+
+  return obs_size;
+}
+
+
+/*
+  The active observations of one realization are copied into one
+  column segment of S; when all the observations in the block are
+  active that is one memcpy() per realization.
+*/
+
 static void meas_block_initS( const meas_block_type * meas_block , matrix_type * S, int * __obs_offset) {
-  int obs_offset = *__obs_offset;
-  for (int iobs =0; iobs < meas_block->obs_size; iobs++) {
-    if (meas_block->active[iobs]) {
-      for (int iens =0; iens < meas_block->active_ens_size; iens++) {
-        int obs_index = iens * meas_block->ens_stride + iobs* meas_block->obs_stride;
+  const int obs_offset      = *__obs_offset;
+  const int active_obs_size = meas_block_get_active_obs_size( meas_block );
+
+  if (active_obs_size > 0) {
+    int * active_index = util_calloc( active_obs_size , sizeof * active_index );
+    {
+      int iactive = 0;
+      for (int iobs = 0; iobs < meas_block->obs_size; iobs++)
+        if (meas_block->active[iobs])
+          active_index[iactive++] = iobs;
+    }
 
-        matrix_iset( S , obs_offset, iens , meas_block->data[ obs_index ]);
+    if (matrix_get_row_stride( S ) == 1) {
+      double * S_data         = matrix_get_data( S );
+      const int column_stride = matrix_get_column_stride( S );
+
+      for (int iens = 0; iens < meas_block->active_ens_size; iens++) {
+        const double * src = &meas_block->data[ iens * meas_block->ens_stride ];
+        double * target    = &S_data[ obs_offset + iens * column_stride ];
+
+        if (active_obs_size == meas_block->obs_size)
+          memcpy( target , src , active_obs_size * sizeof * target );
+        else {
+          for (int iactive = 0; iactive < active_obs_size; iactive++)
+            target[iactive] = src[ active_index[iactive] ];
+        }
       }
-      obs_offset++;
+    } else {
+      for (int iens = 0; iens < meas_block->active_ens_size; iens++)
+        for (int iactive = 0; iactive < active_obs_size; iactive++)
+          matrix_iset( S , obs_offset + iactive , iens , meas_block->data[ iens * meas_block->ens_stride + active_index[iactive] * meas_block->obs_stride ]);
     }
+
+    free( active_index );
   }
-  *__obs_offset = obs_offset;
+  *__obs_offset = obs_offset + active_obs_size;
 }
 
 bool meas_block_iens_active( const meas_block_type * meas_block , int iens) {
@@ -225,18 +272,6 @@ double meas_block_iget( const meas_block_type * meas_block , int iens , int iobs
 }
 
 
-static int meas_block_get_active_obs_size( const meas_block_type * meas_block ) {
-  int obs_size = 0;
-  int i;
-
-  for (i=0; i < meas_block->obs_size; i++)
-    if (meas_block->active[i])
-      obs_size++;
-
-  return obs_size;
-}
-
-
 double meas_block_iget_ens_std( meas_block_type * meas_block , int iobs) {
   meas_block_assert_ens_stat( meas_block );
   {
@@ -328,22 +363,29 @@ static char * meas_data_alloc_key( const char * obs_key , int report_step) {
 }
 
 /**
-   The code actually adding new blocks to the vector must be run in single-thread mode.
+   Adding blocks is protected by a mutex, and the function can be
+   called concurrently from several threads; observe however that the
+   order of the blocks, which is the row order of the S matrix, is
+   then the order in which the blocks are added. If a block with the
+   same obs_key and report_step already exists that block is
+   returned.
 */
 
 meas_block_type * meas_data_add_block( meas_data_type * matrix , const char * obs_key , int report_step , int obs_size) {
   char * lookup_key = meas_data_alloc_key( obs_key , report_step );
+  meas_block_type * block;
   pthread_mutex_lock( &matrix->data_mutex );
   {
     if (!hash_has_key( matrix->blocks , lookup_key )) {
-      meas_block_type  * new_block = meas_block_alloc(obs_key , matrix->ens_mask , obs_size);
-      vector_append_owned_ref( matrix->data , new_block , meas_block_free__ );
-      hash_insert_ref( matrix->blocks , lookup_key , new_block );
-    }
+      block = meas_block_alloc(obs_key , matrix->ens_mask , obs_size);
+      vector_append_owned_ref( matrix->data , block , meas_block_free__ );
+      hash_insert_ref( matrix->blocks , lookup_key , block );
+    } else
+      block = hash_get( matrix->blocks , lookup_key );
   }
   pthread_mutex_unlock( &matrix->data_mutex );
   free( lookup_key );
-  return vector_get_last( matrix->data );
+  return block;
 }
 
 
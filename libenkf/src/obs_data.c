@@ -62,6 +62,7 @@ Matrices: S, D, E and various internal variables.
 
 
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include <stdio.h>
 #include <pthread.h>
@@ -94,8 +95,9 @@ struct obs_block_struct {
 
 
 struct obs_data_struct {
-  vector_type   * data;            /* vector with obs_block instances. */
-  double          global_std_scaling;
+  vector_type     * data;            /* vector with obs_block instances. */
+  double            global_std_scaling;
+  pthread_mutex_t   data_mutex;      /* Protects the data vector when blocks are added concurrently. */
 };
 
 
@@ -233,12 +235,20 @@ static void obs_block_init_innov( const obs_block_type * obs_block , const meas_
 
 static void obs_block_initdObs( const obs_block_type * obs_block , matrix_type * dObs , int * __obs_offset) {
   int obs_offset = *__obs_offset;
-  int iobs;
-  for (iobs =0; iobs < obs_block->size; iobs++) {
-    if (obs_block->active_mode[iobs] == ACTIVE) {
-      matrix_iset( dObs , obs_offset , 0 , obs_block->value[ iobs ]);
-      matrix_iset( dObs , obs_offset , 1 , obs_block->std[ iobs ]);
-      obs_offset++;
+  if ((obs_block->active_size == obs_block->size) && (matrix_get_row_stride( dObs ) == 1)) {
+    /* All observations are active - the block is copied in one go. */
+    double * dObs_data = matrix_get_data( dObs );
+    memcpy( &dObs_data[ obs_offset ] , obs_block->value , obs_block->size * sizeof * obs_block->value );
+    memcpy( &dObs_data[ obs_offset + matrix_get_column_stride( dObs ) ] , obs_block->std , obs_block->size * sizeof * obs_block->std );
+    obs_offset += obs_block->size;
+  } else {
+    int iobs;
+    for (iobs =0; iobs < obs_block->size; iobs++) {
+      if (obs_block->active_mode[iobs] == ACTIVE) {
+        matrix_iset( dObs , obs_offset , 0 , obs_block->value[ iobs ]);
+        matrix_iset( dObs , obs_offset , 1 , obs_block->std[ iobs ]);
+        obs_offset++;
+      }
     }
   }
   *__obs_offset = obs_offset;
@@ -261,6 +271,15 @@ static void obs_block_initR( const obs_block_type * obs_block , matrix_type * R,
         iactive++;
       }
     }
+  } else if ((obs_block->active_size == obs_block->size) && (matrix_get_row_stride( R ) == 1) && (matrix_get_row_stride( obs_block->error_covar ) == 1)) {
+    /* We have a covar matrix, and all observations are active - copy it column by column. */
+    double * R_data              = matrix_get_data( R );
+    const double * covar_data    = matrix_get_data( obs_block->error_covar );
+    const int R_stride           = matrix_get_column_stride( R );
+    const int covar_stride       = matrix_get_column_stride( obs_block->error_covar );
+
+    for (int col = 0; col < obs_block->size; col++)
+      memcpy( &R_data[ obs_offset + (obs_offset + col) * R_stride ] , &covar_data[ col * covar_stride ] , obs_block->size * sizeof * R_data );
   } else {
     int row_active = 0;   /* We have a covar matrix */
     for (int row = 0; row < obs_block->size; row++) {
@@ -345,6 +364,7 @@ obs_data_type * obs_data_alloc(double global_std_scaling) {
   obs_data_type * obs_data = util_malloc(sizeof * obs_data );
   obs_data->data = vector_alloc_new();
   obs_data->global_std_scaling = global_std_scaling;
+  pthread_mutex_init( &obs_data->data_mutex , NULL );
   obs_data_reset(obs_data);
   return obs_data;
 }
@@ -356,9 +376,16 @@ void obs_data_reset(obs_data_type * obs_data) {
 }
 
 
+/**
+   Can be called concurrently from several threads; the blocks are
+   ordered in the order they are added.
+*/
+
 obs_block_type * obs_data_add_block( obs_data_type * obs_data , const char * obs_key , int obs_size , matrix_type * error_covar, bool error_covar_owner) {
   obs_block_type * new_block = obs_block_alloc( obs_key , obs_size , error_covar , error_covar_owner, obs_data->global_std_scaling);
+  pthread_mutex_lock( &obs_data->data_mutex );
   vector_append_owned_ref( obs_data->data , new_block , obs_block_free__ );
+  pthread_mutex_unlock( &obs_data->data_mutex );
   return new_block;
 }
 
@@ -375,6 +402,7 @@ const obs_block_type * obs_data_iget_block_const( const obs_data_type * obs_data
 
 void obs_data_free(obs_data_type * obs_data) {
   vector_free( obs_data->data );
+  pthread_mutex_destroy( &obs_data->data_mutex );
   free(obs_data);
 }
 
@@ -57,6 +57,7 @@ struct obs_vector_struct {
   obs_free_ftype       	     *freef;        	  /* Function used to free an observation node. */
   obs_get_ftype        	     *get_obs;      	  /* Function used to build the 'd' vector. */
   obs_meas_ftype       	     *measure;      	  /* Function used to measure on the state, and add to to the S matrix. */
+  obs_add_meas_block_ftype   *add_meas_block;     /* Function used to add the meas_block which is filled by measure(). */
   obs_user_get_ftype   	     *user_get;     	  /* Function to get an observation based on KEY:INDEX input from user.*/
   obs_chi2_ftype       	     *chi2;         	  /* Function to evaluate chi-squared for an observation. */
   obs_update_std_scale_ftype *update_std_scale;   /* Function to scale the standard deviation with a given factor */
@@ -148,6 +149,7 @@ obs_vector_type * obs_vector_alloc(obs_impl_type obs_type , const char * obs_key
   vector->freef      = NULL;
   vector->measure    = NULL;
   vector->get_obs    = NULL;
+  vector->add_meas_block = NULL;
   vector->user_get   = NULL;
   vector->chi2       = NULL;
   vector->update_std_scale  = NULL;
@@ -157,6 +159,7 @@ obs_vector_type * obs_vector_alloc(obs_impl_type obs_type , const char * obs_key
   case(SUMMARY_OBS):
     vector->freef      	      = summary_obs_free__;
     vector->measure    	      = summary_obs_measure__;
+    vector->add_meas_block    = summary_obs_add_meas_block__;
     vector->get_obs    	      = summary_obs_get_observations__;
     vector->user_get   	      = summary_obs_user_get__;
     vector->chi2       	      = summary_obs_chi2__;
@@ -165,6 +168,7 @@ obs_vector_type * obs_vector_alloc(obs_impl_type obs_type , const char * obs_key
   case(BLOCK_OBS):
     vector->freef      	      = block_obs_free__;
     vector->measure    	      = block_obs_measure__;
+    vector->add_meas_block    = block_obs_add_meas_block__;
     vector->get_obs    	      = block_obs_get_observations__;
     vector->user_get   	      = block_obs_user_get__;
     vector->chi2       	      = block_obs_chi2__;
@@ -173,6 +177,7 @@ obs_vector_type * obs_vector_alloc(obs_impl_type obs_type , const char * obs_key
   case(GEN_OBS):
     vector->freef      	      = gen_obs_free__;
     vector->measure    	      = gen_obs_measure__;
+    vector->add_meas_block    = gen_obs_add_meas_block__;
     vector->get_obs    	      = gen_obs_get_observations__;
     vector->user_get   	      = gen_obs_user_get__;
     vector->chi2       	      = gen_obs_chi2__;
@@ -835,12 +840,36 @@ void obs_vector_iget_observations(const obs_vector_type * obs_vector, int report
 }
 
 
-void obs_vector_measure(const obs_vector_type * obs_vector ,
-                        enkf_fs_type * fs ,
-                        int report_step ,
-                        const int_vector_type * ens_active_list ,
-                        meas_data_type * meas_data ,
-                        const active_list_type * active_list) {
+/**
+   Adds the meas_block which will hold the simulated values of the
+   observation at report_step; the block is added in the same order as
+   obs_vector_iget_observations() adds the obs_block. Will return NULL
+   if there is no observation, or if the observation does not
+   contribute at this report step.
+*/
+
+meas_block_type * obs_vector_add_meas_block(const obs_vector_type * obs_vector , int report_step , meas_data_type * meas_data , const active_list_type * active_list) {
+  void * obs_node = vector_iget( obs_vector->nodes , report_step );
+  if ( obs_node != NULL )
+    return obs_vector->add_meas_block( obs_node , meas_data , report_step , active_list );
+  else
+    return NULL;
+}
+
+
+/**
+   Fills the meas_block (which must have been created with
+   obs_vector_add_meas_block()) with the simulated values from all
+   the realizations in ens_active_list. The function only writes to
+   the meas_block, and can run concurrently for different blocks.
+*/
+
+void obs_vector_measure_block(const obs_vector_type * obs_vector ,
+                              enkf_fs_type * fs ,
+                              int report_step ,
+                              const int_vector_type * ens_active_list ,
+                              meas_block_type * meas_block ,
+                              const active_list_type * active_list) {
 
   void * obs_node = vector_iget( obs_vector->nodes , report_step );
   if ( obs_node != NULL ) {
@@ -853,7 +882,7 @@ void obs_vector_measure(const obs_vector_type * obs_vector ,
       node_id.iens = int_vector_iget( ens_active_list , active_iens_index );
 
       enkf_node_load(enkf_node , fs , node_id);
-      obs_vector->measure(obs_node , enkf_node_value_ptr(enkf_node) , node_id , meas_data , active_list);
+      obs_vector->measure(obs_node , enkf_node_value_ptr(enkf_node) , node_id , meas_block , active_list);
     }
 
     enkf_node_free( enkf_node );
@@ -861,6 +890,19 @@ void obs_vector_measure(const obs_vector_type * obs_vector ,
 }
 
 
+void obs_vector_measure(const obs_vector_type * obs_vector ,
+                        enkf_fs_type * fs ,
+                        int report_step ,
+                        const int_vector_type * ens_active_list ,
+                        meas_data_type * meas_data ,
+                        const active_list_type * active_list) {
+
+  meas_block_type * meas_block = obs_vector_add_meas_block( obs_vector , report_step , meas_data , active_list );
+  if (meas_block != NULL)
+    obs_vector_measure_block( obs_vector , fs , report_step , ens_active_list , meas_block , active_list );
+}
+
+
 static bool obs_vector_has_data_at_report_step( const obs_vector_type * obs_vector , const bool_vector_type * active_mask , enkf_fs_type * fs, int report_step) {
   void * obs_node = vector_iget( obs_vector->nodes , report_step );
   if ( obs_node ) {
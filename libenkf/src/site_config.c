@@ -115,6 +115,7 @@ struct site_config_struct {
   job_driver_type driver_type_site;
   int max_submit;
   int max_submit_site;
+  int load_threads; /* The number of threads used when loading results from the forward model; 0 => one per core. */
   char * job_script;
   char * job_script_site;
 
@@ -202,6 +203,7 @@ site_config_type * site_config_alloc_empty() {
   site_config_set_manual_url(site_config, DEFAULT_MANUAL_URL);
   site_config_set_default_browser(site_config, DEFAULT_BROWSER);
   site_config_set_max_submit(site_config, DEFAULT_MAX_SUBMIT);
+  site_config_set_load_threads(site_config, DEFAULT_LOAD_THREADS);
   site_config->search_path = false;
   return site_config;
 }
@@ -637,6 +639,24 @@ int site_config_get_max_submit(const site_config_type * site_config) {
   return job_queue_get_max_submit(site_config->job_queue);
 }
 
+void site_config_set_load_threads(site_config_type * site_config, int load_threads) {
+  if (load_threads < 0)
+    util_abort("%s: invalid number of load threads:%d \n", __func__, load_threads);
+  site_config->load_threads = load_threads;
+}
+
+/*
+  Returns the number of threads to use when loading, i.e. the number
+  of cores if LOAD_THREADS has not been set.
+*/
+
+int site_config_get_load_threads(const site_config_type * site_config) {
+  if (site_config->load_threads > 0)
+    return site_config->load_threads;
+  else
+    return util_get_num_cpu();
+}
+
 static void site_config_install_job_queue(site_config_type * site_config) {
   /*
      All the various driver options are set, unconditionally of which
@@ -719,6 +739,9 @@ bool site_config_init(site_config_type * site_config, const config_content_type
   if (config_content_has_item(config, MAX_SUBMIT_KEY))
     site_config_set_max_submit(site_config, config_content_get_value_as_int(config, MAX_SUBMIT_KEY));
 
+  if (config_content_has_item(config, LOAD_THREADS_KEY))
+    site_config_set_load_threads(site_config, config_content_get_value_as_int(config, LOAD_THREADS_KEY));
+
 
   /* LSF options */
   {
@@ -920,6 +943,10 @@ void site_config_add_config_items(config_parser_type * config, bool site_mode) {
   item = config_add_schema_item(config, UMASK_KEY, false);
   config_schema_item_set_argc_minmax(item, 1, 1);
 
+  item = config_add_schema_item(config, LOAD_THREADS_KEY, false);
+  config_schema_item_set_argc_minmax(item, 1, 1);
+  config_schema_item_iset_type(item, 0, CONFIG_INT);
+
   /**
      UPDATE_PATH   LD_LIBRARY_PATH   /path/to/some/funky/lib
 
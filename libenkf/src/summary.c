@@ -39,8 +39,6 @@
 
 /*****************************************************************/
 
-#define SUMMARY_UNDEF -9999
-
 struct summary_struct {
   int                          __type_id;         /* Only used for run_time checking. */
   bool                         vector_storage; 
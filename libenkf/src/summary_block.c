@@ -0,0 +1,353 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'summary_block.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/util.h>
+#include <ert/util/buffer.h>
+#include <ert/util/bool_vector.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/type_macros.h>
+
+#include <ert/enkf/enkf_fs.h>
+#include <ert/enkf/enkf_node.h>
+#include <ert/enkf/enkf_config_node.h>
+#include <ert/enkf/summary.h>
+#include <ert/enkf/summary_block.h>
+
+/*
+  The summary_block holds the summary vector of one key for all the
+  realizations in the ensemble as one contiguous time x member block;
+  the time series of each member is contiguous:
+
+     data[ iens * num_steps + step ]
+
+  num_steps is the length of the longest member vector, the length of
+  the vector of each member is recorded in member_num_steps. Members
+  without data, and the steps beyond the end of the vector of a
+  member, are set to SUMMARY_UNDEF.
+
+  Loading a block is read only: summary_block_alloc_load() assembles
+  the block from the vectors of the requested members, unless a
+  stored block which is valid for all those members is found. The
+  blocks are stored by summary_block_update_fs(), which is called
+  when the simulation results of an ensemble have been loaded.
+
+  The stored block is a second copy of the summary data; that is
+  acceptable because the summary data is small compared to the
+  parameters and the dynamic state, and the block is read many times -
+  for plotting and for every update - while it is only written once
+  for each load of the results. The stored block records the vector
+  write count of each member it has been assembled from, see
+  enkf_fs_get_vector_write_count(), and it is only used for a member
+  when the count is still the same. The stored format is:
+
+     int          : SUMMARY_BLOCK_ID
+     int          : ens_size
+     int          : num_steps
+     bool_vector  : has_member
+     int_vector   : write_count     (-1 for the members not assembled)
+     int_vector   : member_num_steps
+     double[]     : data
+*/
+
+#define SUMMARY_BLOCK_ID  6671033
+
+struct summary_block_struct {
+  UTIL_TYPE_ID_DECLARATION;
+  int                ens_size;
+  int                num_steps;
+  bool_vector_type * has_member;
+  int_vector_type  * write_count;
+  int_vector_type  * member_num_steps;
+  double           * data;
+};
+
+
+UTIL_IS_INSTANCE_FUNCTION( summary_block , SUMMARY_BLOCK_ID )
+
+
+static summary_block_type * summary_block_alloc( int ens_size , int num_steps ) {
+  summary_block_type * block = util_malloc( sizeof * block );
+  UTIL_TYPE_ID_INIT( block , SUMMARY_BLOCK_ID );
+  block->ens_size = ens_size;
+  block->num_steps = num_steps;
+  block->has_member = bool_vector_alloc( ens_size , false );
+  block->write_count = int_vector_alloc( ens_size , -1 );
+  block->member_num_steps = int_vector_alloc( ens_size , 0 );
+  block->data = util_calloc( util_int_max( 1 , ens_size * num_steps ) , sizeof * block->data );
+  for (int i = 0; i < ens_size * num_steps; i++)
+    block->data[i] = SUMMARY_UNDEF;
+  return block;
+}
+
+
+void summary_block_free( summary_block_type * block ) {
+  bool_vector_free( block->has_member );
+  int_vector_free( block->write_count );
+  int_vector_free( block->member_num_steps );
+  free( block->data );
+  free( block );
+}
+
+
+static void summary_block_buffer_fwrite( const summary_block_type * block , buffer_type * buffer ) {
+  buffer_fwrite_int( buffer , SUMMARY_BLOCK_ID );
+  buffer_fwrite_int( buffer , block->ens_size );
+  buffer_fwrite_int( buffer , block->num_steps );
+  bool_vector_buffer_fwrite( block->has_member , buffer );
+  int_vector_buffer_fwrite( block->write_count , buffer );
+  int_vector_buffer_fwrite( block->member_num_steps , buffer );
+  buffer_fwrite( buffer , block->data , sizeof * block->data , block->ens_size * block->num_steps );
+}
+
+
+static summary_block_type * summary_block_buffer_fread_alloc( buffer_type * buffer ) {
+  if (buffer_fread_int( buffer ) != SUMMARY_BLOCK_ID)
+    return NULL;
+  {
+    int ens_size = buffer_fread_int( buffer );
+    int num_steps = buffer_fread_int( buffer );
+    summary_block_type * block = summary_block_alloc( ens_size , num_steps );
+
+    bool_vector_buffer_fread( block->has_member , buffer );
+    int_vector_buffer_fread( block->write_count , buffer );
+    int_vector_buffer_fread( block->member_num_steps , buffer );
+    buffer_fread( buffer , block->data , sizeof * block->data , ens_size * num_steps );
+    return block;
+  }
+}
+
+
+/*
+  The member list used when the calling scope does not give one: all
+  the members [0,ens_size).
+*/
+
+static int_vector_type * summary_block_alloc_member_list( int ens_size , const int_vector_type * ens_active_list ) {
+  if (ens_active_list != NULL)
+    return int_vector_alloc_copy( ens_active_list );
+  else {
+    int_vector_type * member_list = int_vector_alloc( 0 , 0 );
+    int_vector_init_range( member_list , 0 , ens_size , 1 );
+    return member_list;
+  }
+}
+
+
+/*
+  Assembles the block from the vectors of the members in member_list;
+  the write count of each member is read before the vector.
+*/
+
+static summary_block_type * summary_block_alloc_assemble( enkf_fs_type * fs , const enkf_config_node_type * config_node , int ens_size , const int_vector_type * member_list ) {
+  const char * key = enkf_config_node_get_key( config_node );
+  enkf_var_type var_type = enkf_config_node_get_var_type( config_node );
+  enkf_node_type * work_node = enkf_node_alloc( config_node );
+  double_vector_type ** member_vectors = util_calloc( ens_size , sizeof * member_vectors );
+  int_vector_type * write_count = int_vector_alloc( ens_size , -1 );
+  summary_block_type * block;
+  int num_steps = 0;
+
+  for (int iens = 0; iens < ens_size; iens++)
+    member_vectors[iens] = NULL;
+
+  for (int i = 0; i < int_vector_size( member_list ); i++) {
+    const int iens = int_vector_iget( member_list , i );
+    double_vector_type * values = double_vector_alloc( 0 , SUMMARY_UNDEF );
+
+    int_vector_iset( write_count , iens , enkf_fs_get_vector_write_count( fs , var_type , iens ));
+    if (enkf_node_user_get_vector( work_node , fs , key , iens , values )) {
+      member_vectors[iens] = values;
+      num_steps = util_int_max( num_steps , double_vector_size( values ));
+    } else
+      double_vector_free( values );
+  }
+
+  block = summary_block_alloc( ens_size , num_steps );
+  int_vector_memcpy( block->write_count , write_count );
+  for (int iens = 0; iens < ens_size; iens++) {
+    const double_vector_type * values = member_vectors[iens];
+    if (values != NULL) {
+      double * member_data = &block->data[ iens * num_steps ];
+      bool_vector_iset( block->has_member , iens , true );
+      int_vector_iset( block->member_num_steps , iens , double_vector_size( values ));
+      for (int step = 0; step < double_vector_size( values ); step++)
+        member_data[step] = double_vector_iget( values , step );
+
+      double_vector_free( member_vectors[iens] );
+    }
+  }
+
+  int_vector_free( write_count );
+  free( member_vectors );
+  enkf_node_free( work_node );
+  return block;
+}
+
+
+/*
+  Loads the stored block; returns NULL if there is no stored block, or
+  if it is stale for one of the members in member_list.
+*/
+
+static summary_block_type * summary_block_fread_alloc( enkf_fs_type * fs , const enkf_config_node_type * config_node , int ens_size , const int_vector_type * member_list ) {
+  const char * key = enkf_config_node_get_key( config_node );
+  enkf_var_type var_type = enkf_config_node_get_var_type( config_node );
+  summary_block_type * block = NULL;
+  buffer_type * buffer = buffer_alloc( 1024 );
+
+  if (enkf_fs_fread_ensemble_vector( fs , buffer , key , var_type )) {
+    block = summary_block_buffer_fread_alloc( buffer );
+    if ((block != NULL) && (block->ens_size == ens_size)) {
+      for (int i = 0; i < int_vector_size( member_list ); i++) {
+        const int iens = int_vector_iget( member_list , i );
+        if (int_vector_iget( block->write_count , iens ) != enkf_fs_get_vector_write_count( fs , var_type , iens )) {
+          summary_block_free( block );
+          block = NULL;
+          break;
+        }
+      }
+    } else if (block != NULL) {
+      summary_block_free( block );
+      block = NULL;
+    }
+  }
+
+  buffer_free( buffer );
+  return block;
+}
+
+
+static void summary_block_assert_vector_storage( const enkf_config_node_type * config_node ) {
+  if (!enkf_config_node_vector_storage( config_node ))
+    util_abort("%s: the node:%s does not have vector storage.\n",__func__ , enkf_config_node_get_key( config_node ));
+}
+
+
+/**
+   Will load the summary vector of config_node for the members in
+   ens_active_list - or all the members [0,ens_size) if ens_active_list
+   is NULL. The filesystem is not modified; the data of members which
+   are not in ens_active_list is undefined.
+*/
+
+summary_block_type * summary_block_alloc_load( enkf_fs_type * fs , const enkf_config_node_type * config_node , int ens_size , const int_vector_type * ens_active_list ) {
+  int_vector_type * member_list = summary_block_alloc_member_list( ens_size , ens_active_list );
+  summary_block_type * block;
+
+  summary_block_assert_vector_storage( config_node );
+  block = summary_block_fread_alloc( fs , config_node , ens_size , member_list );
+  if (block == NULL)
+    block = summary_block_alloc_assemble( fs , config_node , ens_size , member_list );
+
+  int_vector_free( member_list );
+  return block;
+}
+
+
+/**
+   Makes sure that the stored block of config_node is valid for the
+   members in ens_active_list (NULL: all the members); if it is not
+   the block is assembled and stored. Returns true if a new block was
+   stored.
+*/
+
+bool summary_block_update_fs( enkf_fs_type * fs , const enkf_config_node_type * config_node , int ens_size , const int_vector_type * ens_active_list ) {
+  int_vector_type * member_list = summary_block_alloc_member_list( ens_size , ens_active_list );
+  summary_block_type * block;
+  bool stored = false;
+
+  summary_block_assert_vector_storage( config_node );
+  block = summary_block_fread_alloc( fs , config_node , ens_size , member_list );
+  if (block == NULL) {
+    buffer_type * buffer = buffer_alloc( 1024 );
+
+    block = summary_block_alloc_assemble( fs , config_node , ens_size , member_list );
+    summary_block_buffer_fwrite( block , buffer );
+    stored = enkf_fs_fwrite_ensemble_vector( fs , buffer , enkf_config_node_get_key( config_node ) , enkf_config_node_get_var_type( config_node ));
+    buffer_free( buffer );
+  }
+
+  summary_block_free( block );
+  int_vector_free( member_list );
+  return stored;
+}
+
+
+int summary_block_get_ens_size( const summary_block_type * block ) {
+  return block->ens_size;
+}
+
+
+int summary_block_get_num_steps( const summary_block_type * block ) {
+  return block->num_steps;
+}
+
+
+bool summary_block_has_member( const summary_block_type * block , int iens ) {
+  return bool_vector_safe_iget( block->has_member , iens );
+}
+
+
+/**
+   Returns the length of the vector of member iens; this can be less
+   than summary_block_get_num_steps() if the member is shorter than
+   the longest member, and it is zero for members without data.
+*/
+
+int summary_block_get_member_num_steps( const summary_block_type * block , int iens ) {
+  if ((iens < 0) || (iens >= block->ens_size))
+    util_abort("%s: invalid member:%d - valid range [0,%d) \n",__func__ , iens , block->ens_size);
+
+  return int_vector_iget( block->member_num_steps , iens );
+}
+
+
+double summary_block_iget( const summary_block_type * block , int iens , int step ) {
+  if ((iens < 0) || (iens >= block->ens_size))
+    util_abort("%s: invalid member:%d - valid range [0,%d) \n",__func__ , iens , block->ens_size);
+
+  if ((step < 0) || (step >= block->num_steps))
+    return SUMMARY_UNDEF;
+
+  return block->data[ iens * block->num_steps + step ];
+}
+
+
+/**
+   Returns a pointer to the num_steps contiguous values of member iens.
+*/
+
+const double * summary_block_iget_member_data( const summary_block_type * block , int iens ) {
+  if ((iens < 0) || (iens >= block->ens_size))
+    util_abort("%s: invalid member:%d - valid range [0,%d) \n",__func__ , iens , block->ens_size);
+
+  return &block->data[ iens * block->num_steps ];
+}
+
+
+void summary_block_get_member_vector( const summary_block_type * block , int iens , double_vector_type * values ) {
+  const double * member_data = summary_block_iget_member_data( block , iens );
+  double_vector_reset( values );
+  double_vector_set_default( values , SUMMARY_UNDEF );
+  for (int step = 0; step < block->num_steps; step++)
+    double_vector_iset( values , step , member_data[step] );
+}
@@ -2,36 +2,239 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
 
 #include <ert/util/util.h>
 #include <ert/util/hash.h>
 #include <ert/util/stringlist.h>
+#include <ert/util/int_vector.h>
 #include <ert/util/type_macros.h>
 
+#include <ert/ecl/ecl_smspec.h>
+#include <ert/ecl/smspec_node.h>
+
 #include <ert/enkf/enkf_types.h>
 
 
 
 #define SUMMARY_KEY_MATCHER_TYPE_ID 700672137
 
+/*
+  The matcher is compiled as the keys are added:
+
+    1. Keys without any fnmatch() special characters can only match
+       themselves, and are found with a lookup in the key_set hash.
+
+    2. The other keys are patterns; they are stored in a trie on the
+       literal prefix of the pattern, i.e. the characters before the
+       first special character. When matching a summary key we walk
+       down the trie along the summary key, and only the patterns
+       found on that path - i.e. the patterns whose literal prefix is
+       a prefix of the summary key - are tested with util_fnmatch().
+
+  In addition the list of matching nodes for an ecl_smspec layout is
+  cached, so that the matching is only done once for all the
+  realizations which share the same SMSPEC header. The cache is
+  allocated separately from the matcher, with its own lock, so that it
+  can be updated through a const matcher from several loader threads.
+*/
+
+#define PATTERN_SPECIAL_CHARS "*?[\\"
+
+typedef struct pattern_trie_struct pattern_trie_type;
+
+struct pattern_trie_struct {
+  char                c;
+  pattern_trie_type * child;      /* First child. */
+  pattern_trie_type * sibling;    /* Next sibling. */
+  stringlist_type   * patterns;   /* The patterns with literal prefix ending at this node; NULL if none. */
+};
+
+
+typedef struct {
+  stringlist_type    * keys;              /* The gen_key1 keys of the layout; compared on every cache hit. */
+  int_vector_type    * index_list;        /* The indices of the matching smspec nodes. */
+} smspec_cache_node_type;
+
+
+typedef struct {
+  hash_type          * nodes;             /* Layout signature -> smspec_cache_node. */
+  pthread_mutex_t      lock;
+} smspec_cache_type;
+
+
 struct summary_key_matcher_struct {
   UTIL_TYPE_ID_DECLARATION;
-  hash_type        * key_set;
+  hash_type          * key_set;
+  pattern_trie_type  * pattern_root;
+  smspec_cache_type  * smspec_cache;
 };
 
 
 UTIL_IS_INSTANCE_FUNCTION( summary_key_matcher , SUMMARY_KEY_MATCHER_TYPE_ID )
 
 
+static pattern_trie_type * pattern_trie_alloc( char c ) {
+  pattern_trie_type * node = util_malloc( sizeof * node );
+  node->c = c;
+  node->child = NULL;
+  node->sibling = NULL;
+  node->patterns = NULL;
+  return node;
+}
+
+
+static void pattern_trie_free( pattern_trie_type * node ) {
+  while (node != NULL) {
+    pattern_trie_type * sibling = node->sibling;
+    pattern_trie_free( node->child );
+    if (node->patterns != NULL)
+      stringlist_free( node->patterns );
+    free( node );
+    node = sibling;
+  }
+}
+
+
+static pattern_trie_type * pattern_trie_get_child( const pattern_trie_type * node , char c ) {
+  pattern_trie_type * child = node->child;
+  while (child != NULL && child->c != c)
+    child = child->sibling;
+  return child;
+}
+
+
+static void pattern_trie_add( pattern_trie_type * root , const char * pattern ) {
+  pattern_trie_type * node = root;
+  size_t prefix_length = strcspn( pattern , PATTERN_SPECIAL_CHARS );
+
+  for (size_t i = 0; i < prefix_length; i++) {
+    pattern_trie_type * child = pattern_trie_get_child( node , pattern[i] );
+    if (child == NULL) {
+      child = pattern_trie_alloc( pattern[i] );
+      child->sibling = node->child;
+      node->child = child;
+    }
+    node = child;
+  }
+
+  if (node->patterns == NULL)
+    node->patterns = stringlist_alloc_new( );
+  stringlist_append_copy( node->patterns , pattern );
+}
+
+
+static bool pattern_trie_node_match( const pattern_trie_type * node , const char * summary_key ) {
+  if (node->patterns != NULL) {
+    for (int i = 0; i < stringlist_get_size( node->patterns ); i++)
+      if (util_fnmatch( stringlist_iget( node->patterns , i ) , summary_key ) == 0)
+        return true;
+  }
+  return false;
+}
+
+
+static bool pattern_trie_match( const pattern_trie_type * root , const char * summary_key ) {
+  const pattern_trie_type * node = root;
+  const char * c = summary_key;
+
+  while (true) {
+    if (pattern_trie_node_match( node , summary_key ))
+      return true;
+
+    if (*c == '\0')
+      return false;
+
+    node = pattern_trie_get_child( node , *c );
+    if (node == NULL)
+      return false;
+    c++;
+  }
+}
+
+
+static smspec_cache_node_type * smspec_cache_node_alloc( const ecl_smspec_type * smspec , int_vector_type * index_list ) {
+  smspec_cache_node_type * node = util_malloc( sizeof * node );
+  node->keys = stringlist_alloc_new( );
+  node->index_list = index_list;
+  for (int i = 0; i < ecl_smspec_num_nodes( smspec ); i++)
+    stringlist_append_owned_ref( node->keys , util_alloc_string_copy( smspec_node_get_gen_key1( ecl_smspec_iget_node( smspec , i ))));
+  return node;
+}
+
+
+static void smspec_cache_node_free( smspec_cache_node_type * node ) {
+  stringlist_free( node->keys );
+  int_vector_free( node->index_list );
+  free( node );
+}
+
+
+static void smspec_cache_node_free__( void * arg ) {
+  smspec_cache_node_free( (smspec_cache_node_type *) arg );
+}
+
+
+/*
+  Different layouts can have the same signature, so a cache hit is
+  only used if all the keys of the layout are equal.
+*/
+
+static bool smspec_cache_node_match( const smspec_cache_node_type * node , const ecl_smspec_type * smspec ) {
+  if (stringlist_get_size( node->keys ) != ecl_smspec_num_nodes( smspec ))
+    return false;
+
+  for (int i = 0; i < ecl_smspec_num_nodes( smspec ); i++) {
+    const char * cached_key = stringlist_iget( node->keys , i );
+    const char * key = smspec_node_get_gen_key1( ecl_smspec_iget_node( smspec , i ));
+
+    if ((cached_key == NULL) || (key == NULL)) {
+      if (cached_key != key)
+        return false;
+    } else if (strcmp( cached_key , key ) != 0)
+      return false;
+  }
+  return true;
+}
+
+
+static smspec_cache_type * smspec_cache_alloc( ) {
+  smspec_cache_type * cache = util_malloc( sizeof * cache );
+  cache->nodes = hash_alloc( );
+  pthread_mutex_init( &cache->lock , NULL );
+  return cache;
+}
+
+
+static void smspec_cache_free( smspec_cache_type * cache ) {
+  hash_free( cache->nodes );
+  pthread_mutex_destroy( &cache->lock );
+  free( cache );
+}
+
+
+static void smspec_cache_clear( smspec_cache_type * cache ) {
+  pthread_mutex_lock( &cache->lock );
+  hash_clear( cache->nodes );
+  pthread_mutex_unlock( &cache->lock );
+}
+
+
 summary_key_matcher_type * summary_key_matcher_alloc() {
   summary_key_matcher_type * matcher = util_malloc(sizeof * matcher);
   UTIL_TYPE_ID_INIT( matcher , SUMMARY_KEY_MATCHER_TYPE_ID);
   matcher->key_set = hash_alloc();
+  matcher->pattern_root = pattern_trie_alloc( '\0' );
+  matcher->smspec_cache = smspec_cache_alloc();
   return matcher;
 }
 
 void summary_key_matcher_free(summary_key_matcher_type * matcher) {
     hash_free(matcher->key_set);
+    smspec_cache_free(matcher->smspec_cache);
+    pattern_trie_free(matcher->pattern_root);
     free(matcher);
 }
 
@@ -42,24 +245,79 @@ int summary_key_matcher_get_size(const summary_key_matcher_type * matcher) {
 void summary_key_matcher_add_summary_key(summary_key_matcher_type * matcher, const char * summary_key) {
     if(!hash_has_key(matcher->key_set, summary_key)) {
         hash_insert_int(matcher->key_set, summary_key, !util_string_has_wildcard(summary_key));
+        if (summary_key[ strcspn( summary_key , PATTERN_SPECIAL_CHARS ) ] != '\0')
+            pattern_trie_add(matcher->pattern_root, summary_key);
+
+        /* The cached match lists are invalid when the set of keys changes. */
+        smspec_cache_clear(matcher->smspec_cache);
     }
 }
 
 bool summary_key_matcher_match_summary_key(const summary_key_matcher_type * matcher, const char * summary_key) {
-    stringlist_type * keys = hash_alloc_stringlist(matcher->key_set);
-    bool has_key = false;
-
-    for (int i = 0; i < stringlist_get_size(keys); i++) {
-        const char * pattern = stringlist_iget(keys, i);
-        if(util_fnmatch(pattern, summary_key) == 0) {
-            has_key = true;
-            break;
+    if (hash_has_key(matcher->key_set, summary_key))
+        return true;
+
+    return pattern_trie_match(matcher->pattern_root, summary_key);
+}
+
+
+/*
+  The signature of an smspec layout is the number of nodes and a
+  64 bit FNV-1a hash of all the gen_key1 keys.
+*/
+
+static char * summary_key_matcher_alloc_smspec_signature(const ecl_smspec_type * smspec) {
+    uint64_t hash = 14695981039346656037ULL;
+    int num_nodes = ecl_smspec_num_nodes(smspec);
+
+    for (int i = 0; i < num_nodes; i++) {
+        const char * key = smspec_node_get_gen_key1( ecl_smspec_iget_node(smspec, i) );
+        if (key != NULL) {
+            for (const char * c = key; *c != '\0'; c++) {
+                hash ^= (unsigned char) *c;
+                hash *= 1099511628211ULL;
+            }
         }
+        hash ^= 0xff;       /* Separator - so that "AB","C" differs from "A","BC". */
+        hash *= 1099511628211ULL;
     }
 
-    stringlist_free(keys);
+    return util_alloc_sprintf("%d:%016llx", num_nodes, (unsigned long long) hash);
+}
 
-    return has_key;
+
+/*
+  Returns a newly allocated list of the indices of the smspec nodes
+  which match the matcher; the calling scope must free the list. Keys
+  must not be added to the matcher while it is used for matching.
+*/
+
+int_vector_type * summary_key_matcher_alloc_smspec_index_list(const summary_key_matcher_type * matcher, const ecl_smspec_type * smspec) {
+    smspec_cache_type * cache = matcher->smspec_cache;
+    char * signature = summary_key_matcher_alloc_smspec_signature(smspec);
+    int_vector_type * index_list = NULL;
+
+    pthread_mutex_lock(&cache->lock);
+    if (hash_has_key(cache->nodes, signature)) {
+        const smspec_cache_node_type * node = hash_get(cache->nodes, signature);
+        if (smspec_cache_node_match(node, smspec))
+            index_list = int_vector_alloc_copy(node->index_list);
+    }
+
+    if (index_list == NULL) {
+        int_vector_type * cached_list = int_vector_alloc(0, 0);
+        for (int i = 0; i < ecl_smspec_num_nodes(smspec); i++) {
+            const char * key = smspec_node_get_gen_key1( ecl_smspec_iget_node(smspec, i) );
+            if (key != NULL && summary_key_matcher_match_summary_key(matcher, key))
+                int_vector_append(cached_list, i);
+        }
+        index_list = int_vector_alloc_copy(cached_list);
+        hash_insert_hash_owned_ref(cache->nodes, signature, smspec_cache_node_alloc(smspec, cached_list), smspec_cache_node_free__);
+    }
+    pthread_mutex_unlock(&cache->lock);
+
+    free(signature);
+    return index_list;
 }
 
 stringlist_type * summary_key_matcher_get_keys(const summary_key_matcher_type * matcher) {
@@ -74,4 +332,4 @@ bool summary_key_matcher_summary_key_is_required(const summary_key_matcher_type
     }
 
     return is_required;
-}
\ No newline at end of file
+}
@@ -167,12 +167,24 @@ void summary_obs_get_observations(const summary_obs_type * summary_obs,
 
 
 
-void summary_obs_measure(const summary_obs_type * obs, const summary_type * summary, node_id_type node_id , meas_data_type * meas_data , const active_list_type * __active_list) {
+/**
+   Returns NULL if the observation is not active; in that case
+   summary_obs_get_observations() has not added an obs_block either.
+*/
+
+meas_block_type * summary_obs_add_meas_block(const summary_obs_type * obs , meas_data_type * meas_data , int report_step , const active_list_type * __active_list) {
   int active_size = active_list_get_active_size( __active_list , OBS_SIZE );
-  if (active_size == 1) {
-    meas_block_type * meas_block = meas_data_add_block( meas_data , obs->obs_key , node_id.report_step , active_size );
+  if (active_size == 1)
+    return meas_data_add_block( meas_data , obs->obs_key , report_step , active_size );
+  else
+    return NULL;
+}
+
+
+void summary_obs_measure(const summary_obs_type * obs, const summary_type * summary, node_id_type node_id , meas_block_type * meas_block , const active_list_type * __active_list) {
+  int active_size = active_list_get_active_size( __active_list , OBS_SIZE );
+  if (active_size == 1)
     meas_block_iset( meas_block , node_id.iens , 0 , summary_get(summary, node_id.report_step ));
-  }
 }
 
 
@@ -224,5 +236,6 @@ VOID_FREE(summary_obs)
 VOID_GET_OBS(summary_obs)
 VOID_USER_GET_OBS(summary_obs)
 VOID_MEASURE(summary_obs , summary)
+VOID_ADD_MEAS_BLOCK(summary_obs)
 VOID_CHI2(summary_obs , summary)
 VOID_UPDATE_STD_SCALE(summary_obs);
@@ -121,6 +121,37 @@ void test_stop_long_running( ) {
   analysis_config_free( ac );
 }
 
+void test_update_threads( ) {
+  analysis_config_type * ac = create_analysis_config( );
+  test_assert_int_equal( util_get_num_cpu( ) , analysis_config_get_update_threads( ac ));
+  analysis_config_set_update_threads( ac , 7 );
+  test_assert_int_equal( 7 , analysis_config_get_update_threads( ac ));
+  analysis_config_free( ac );
+
+  {
+    test_work_area_type * work_area = test_work_area_alloc("test_update_threads");
+    FILE * config_file_stream = util_mkdir_fopen("config_file", "w");
+    fputs("UPDATE_THREADS 3\n", config_file_stream);
+    fclose(config_file_stream);
+    {
+      config_parser_type * c = config_alloc();
+      analysis_config_add_config_items( c );
+      {
+        config_content_type * content = config_parse(c , "config_file" , "--" , NULL , NULL , NULL , false , true );
+        test_assert_true(config_content_is_valid(content));
+
+        ac = create_analysis_config( );
+        analysis_config_init(ac, content);
+        test_assert_int_equal( 3 , analysis_config_get_update_threads( ac ));
+        analysis_config_free( ac );
+        config_content_free( content );
+      }
+      config_free( c );
+    }
+    test_work_area_free(work_area);
+  }
+}
+
 void test_min_realizations_percent() {
   {
     const char * num_realizations_str = "NUM_REALIZATIONS 80\n";
@@ -193,6 +224,7 @@ int main(int argc , char ** argv) {
   test_min_realizations_number();
   test_current_module_options();
   test_stop_long_running();
+  test_update_threads();
   exit(0);
 }
 
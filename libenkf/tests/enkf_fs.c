@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include <pthread.h>
@@ -77,6 +78,53 @@ void test_refcount() {
   test_work_area_free( work_area );
 }
 
+/*
+  Parameters are stored compressed; the content must survive a round
+  trip, and data which does not compress is stored unchanged.
+*/
+void test_compressed_nodes() {
+  test_work_area_type * work_area = test_work_area_alloc("enkf_fs/compressed_nodes");
+  const int size = 100000;
+  buffer_type * field = buffer_alloc( 1024 );
+  buffer_type * small = buffer_alloc( 1024 );
+  buffer_type * buffer = buffer_alloc( 1024 );
+
+  for (int i=0; i < size; i++)
+    buffer_fwrite_double( field , i % 100 );
+  buffer_fwrite_int( small , 77 );
+
+  enkf_fs_create_fs("mnt" , BLOCK_FS_DRIVER_ID , NULL , false);
+  {
+    enkf_fs_type * fs = enkf_fs_mount( "mnt" );
+    enkf_fs_fwrite_node( fs , field , "FIELD" , PARAMETER , 0 , 1 );
+    enkf_fs_fwrite_node( fs , small , "SMALL" , PARAMETER , 0 , 1 );
+    enkf_fs_fwrite_vector( fs , field , "VECTOR" , DYNAMIC_RESULT , 1 );
+    enkf_fs_decref( fs );
+  }
+  test_assert_true( util_file_size( "mnt/Ensemble/mod_1/PARAMETER.data_0" ) < size * sizeof(double) / 4 );
+  test_assert_true( util_file_size( "mnt/Ensemble/mod_1/FORECAST.data_0" ) > size * sizeof(double) );
+  {
+    enkf_fs_type * fs = enkf_fs_mount( "mnt" );
+    enkf_fs_fread_node( fs , buffer , "FIELD" , PARAMETER , 0 , 1 );
+    test_assert_size_t_equal( buffer_get_size( field ) , buffer_get_size( buffer ));
+    test_assert_int_equal( 0 , memcmp( buffer_get_data( field ) , buffer_get_data( buffer ) , buffer_get_size( field )));
+    test_assert_double_equal( 0 , buffer_fread_double( buffer ));
+
+    enkf_fs_fread_node( fs , buffer , "SMALL" , PARAMETER , 0 , 1 );
+    test_assert_int_equal( 77 , buffer_fread_int( buffer ));
+
+    enkf_fs_fread_vector( fs , buffer , "VECTOR" , DYNAMIC_RESULT , 1 );
+    test_assert_size_t_equal( buffer_get_size( field ) , buffer_get_size( buffer ));
+    test_assert_int_equal( 0 , memcmp( buffer_get_data( field ) , buffer_get_data( buffer ) , buffer_get_size( field )));
+    enkf_fs_decref( fs );
+  }
+  buffer_free( buffer );
+  buffer_free( small );
+  buffer_free( field );
+  test_work_area_free( work_area );
+}
+
+
 void createFS() {
 
  pthread_mutex_lock(&data->mutex1);
@@ -153,6 +201,7 @@ void test_read_only2() {
 int main(int argc, char ** argv) {
   test_mount();
   test_refcount();
+  test_compressed_nodes();
   test_read_only2();
   exit(0);
 }
@@ -78,8 +78,62 @@ void create_test() {
 
 
 
+/*
+  The S matrix is assembled from the active observations of all the
+  blocks, in the order the blocks were added.
+*/
+
+void allocS_test() {
+  bool_vector_type * ens_mask = bool_vector_alloc( 5 , true );
+  bool_vector_iset( ens_mask , 2 , false );
+  {
+    meas_data_type * meas_data = meas_data_alloc( ens_mask );
+    meas_block_type * block1 = meas_data_add_block( meas_data , "OBS1" , 10 , 3 );
+    meas_block_type * block2 = meas_data_add_block( meas_data , "OBS2" , 10 , 4 );
+
+    test_assert_ptr_equal( block1 , meas_data_add_block( meas_data , "OBS1" , 10 , 3 ));
+    test_assert_int_equal( 2 , meas_data_get_num_blocks( meas_data ));
+
+    for (int iens = 0; iens < 5; iens++) {
+      if (iens == 2)
+        continue;
+
+      for (int iobs = 0; iobs < 3; iobs++)
+        meas_block_iset( block1 , iens , iobs , 100 * iens + iobs );
+
+      for (int iobs = 0; iobs < 4; iobs++)
+        meas_block_iset( block2 , iens , iobs , 100 * iens + 10 + iobs );
+    }
+    meas_block_deactivate( block2 , 1 );
+
+    {
+      matrix_type * S = meas_data_allocS( meas_data );
+      const int active_iens[4] = {0 , 1 , 3 , 4};
+
+      test_assert_int_equal( 6 , matrix_get_rows( S ));
+      test_assert_int_equal( 4 , matrix_get_columns( S ));
+      for (int j = 0; j < 4; j++) {
+        int iens = active_iens[j];
+        test_assert_double_equal( 100 * iens + 0  , matrix_iget( S , 0 , j ));
+        test_assert_double_equal( 100 * iens + 1  , matrix_iget( S , 1 , j ));
+        test_assert_double_equal( 100 * iens + 2  , matrix_iget( S , 2 , j ));
+        test_assert_double_equal( 100 * iens + 10 , matrix_iget( S , 3 , j ));
+        test_assert_double_equal( 100 * iens + 12 , matrix_iget( S , 4 , j ));
+        test_assert_double_equal( 100 * iens + 13 , matrix_iget( S , 5 , j ));
+      }
+      test_assert_double_equal( (0 + 100 + 300 + 400) / 4.0 + 1 , meas_block_iget_ens_mean( block1 , 1 ));
+      matrix_free( S );
+    }
+    meas_data_free( meas_data );
+  }
+  bool_vector_free( ens_mask );
+}
+
+
+
 int main(int argc , char ** argv) {
   create_test();
+  allocS_test();
   exit(0);
 }
 
@@ -0,0 +1,102 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'enkf_serialize.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/matrix.h>
+#include <ert/util/util_kernels.h>
+
+#include <ert/enkf/active_list.h>
+#include <ert/enkf/enkf_serialize.h>
+
+#define NODE_SIZE 101
+#define ROW_OFFSET 3
+
+/*
+  Serializes float and double node data into a column of A, with all
+  elements active and with every third element active, and checks the
+  values in A and the result of deserializing back again.
+*/
+
+
+static void test_serialize( ecl_type_enum node_type , const active_list_type * active_list , int active_size ) {
+  const int sizeof_ctype = (node_type == ECL_FLOAT_TYPE) ? sizeof(float) : sizeof(double);
+  matrix_type * A   = matrix_alloc( ROW_OFFSET + NODE_SIZE , 4 );
+  char * node_data  = util_calloc( NODE_SIZE * sizeof_ctype , sizeof * node_data );
+  char * node_copy  = util_calloc( NODE_SIZE * sizeof_ctype , sizeof * node_copy );
+  int i;
+
+  memset( node_copy , 0 , NODE_SIZE * sizeof_ctype );
+  for (i = 0; i < NODE_SIZE; i++) {
+    if (node_type == ECL_FLOAT_TYPE)
+      ((float *) node_data)[i] = i * 0.37f - 11;
+    else
+      ((double *) node_data)[i] = i * 0.37 - 11;
+  }
+
+  enkf_matrix_serialize( node_data , NODE_SIZE , node_type , active_list , A , ROW_OFFSET , 2 );
+  for (i = 0; i < active_size; i++) {
+    int node_index = (active_size == NODE_SIZE) ? i : 3 * i;
+    double expected = (node_type == ECL_FLOAT_TYPE) ? ((float *) node_data)[node_index] : ((double *) node_data)[node_index];
+    test_assert_true( matrix_iget( A , ROW_OFFSET + i , 2 ) == expected );
+  }
+
+  enkf_matrix_deserialize( node_copy , NODE_SIZE , node_type , active_list , A , ROW_OFFSET , 2 );
+  for (i = 0; i < NODE_SIZE; i++) {
+    bool active = (active_size == NODE_SIZE) || (i % 3 == 0);
+    double value , expected;
+
+    if (node_type == ECL_FLOAT_TYPE) {
+      value    = ((float *) node_copy)[i];
+      expected = ((float *) node_data)[i];
+    } else {
+      value    = ((double *) node_copy)[i];
+      expected = ((double *) node_data)[i];
+    }
+    test_assert_true( value == (active ? expected : 0));
+  }
+
+  free( node_copy );
+  free( node_data );
+  matrix_free( A );
+}
+
+
+int main(int argc , char ** argv) {
+  active_list_type * all_active    = active_list_alloc( );
+  active_list_type * partly_active = active_list_alloc( );
+  util_kernel_level_enum max_level = util_kernel_get_level( );
+  int level , i;
+
+  for (i = 0; i < NODE_SIZE; i += 3)
+    active_list_add_index( partly_active , i );
+
+  for (level = UTIL_KERNEL_SCALAR; level <= max_level; level++) {
+    util_kernel_set_level( level );
+    test_serialize( ECL_FLOAT_TYPE  , all_active    , NODE_SIZE );
+    test_serialize( ECL_DOUBLE_TYPE , all_active    , NODE_SIZE );
+    test_serialize( ECL_FLOAT_TYPE  , partly_active , (NODE_SIZE + 2) / 3 );
+    test_serialize( ECL_DOUBLE_TYPE , partly_active , (NODE_SIZE + 2) / 3 );
+  }
+
+  active_list_free( partly_active );
+  active_list_free( all_active );
+  exit(0);
+}
@@ -0,0 +1,253 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'enkf_summary_block.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/test_util_abort.h>
+#include <ert/util/util.h>
+#include <ert/util/buffer.h>
+#include <ert/util/bool_vector.h>
+#include <ert/util/vector.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/double_vector.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/type_vector_functions.h>
+
+#include <ert/enkf/enkf_main.h>
+#include <ert/enkf/enkf_fs.h>
+#include <ert/enkf/enkf_node.h>
+#include <ert/enkf/ensemble_config.h>
+#include <ert/enkf/summary.h>
+#include <ert/enkf/summary_block.h>
+#include <ert/enkf/enkf_obs.h>
+#include <ert/enkf/meas_data.h>
+#include <ert/enkf/obs_data.h>
+#include <ert/enkf/local_obsdata.h>
+#include <ert/enkf/ert_test_context.h>
+
+
+static void assert_block_equal( enkf_fs_type * fs , const enkf_config_node_type * config_node , const summary_block_type * block) {
+  const char * key = enkf_config_node_get_key( config_node );
+  enkf_node_type * node = enkf_node_alloc( config_node );
+  double_vector_type * values = double_vector_alloc( 0 , 0 );
+  int num_members = 0;
+
+  for (int iens = 0; iens < summary_block_get_ens_size( block ); iens++) {
+    if (enkf_node_user_get_vector( node , fs , key , iens , values )) {
+      test_assert_true( summary_block_has_member( block , iens ));
+      for (int step = 0; step < double_vector_size( values ); step++)
+        test_assert_double_equal( double_vector_iget( values , step ) , summary_block_iget( block , iens , step ));
+      num_members++;
+    } else
+      test_assert_false( summary_block_has_member( block , iens ));
+  }
+  test_assert_true( num_members > 0 );
+
+  double_vector_free( values );
+  enkf_node_free( node );
+}
+
+
+typedef struct {
+  enkf_main_type   * enkf_main;
+  int_vector_type  * active_list;
+} measure_arg_type;
+
+
+static void measure_short_member( void * arg ) {
+  measure_arg_type * measure_arg = (measure_arg_type *) arg;
+  enkf_main_type * enkf_main = measure_arg->enkf_main;
+  bool_vector_type * ens_mask = int_vector_alloc_mask( measure_arg->active_list );
+  local_obsdata_type * obs_set = local_obsdata_alloc( "SHORT" );
+  meas_data_type * meas_data = meas_data_alloc( ens_mask );
+  obs_data_type * obs_data = obs_data_alloc( 1.0 );
+
+  local_obsdata_add_node( obs_set , local_obsdata_node_alloc( "WOPR_OP1_36" , true ));
+  enkf_obs_get_obs_and_measure_data( enkf_main_get_obs( enkf_main ) ,
+                                     enkf_main_get_fs( enkf_main ) ,
+                                     obs_set ,
+                                     measure_arg->active_list ,
+                                     meas_data ,
+                                     obs_data );
+
+  obs_data_free( obs_data );
+  meas_data_free( meas_data );
+  local_obsdata_free( obs_set );
+  bool_vector_free( ens_mask );
+}
+
+
+/*
+  Member 0 is truncated to end before the observation at report step
+  36; the other members are longer, so the block is padded for member
+  0 and the measurement must fail instead of using the padding.
+*/
+
+static void test_short_member( enkf_main_type * enkf_main ) {
+  enkf_fs_type * fs = enkf_main_get_fs( enkf_main );
+  const ensemble_config_type * ens_config = enkf_main_get_ensemble_config( enkf_main );
+  const enkf_config_node_type * config_node = ensemble_config_get_node( ens_config , "WOPR:OP1" );
+  const char * key = enkf_config_node_get_key( config_node );
+  const int ens_size = enkf_main_get_ensemble_size( enkf_main );
+  const int short_size = 20;
+  int_vector_type * active_list = int_vector_alloc( 0 , 0 );
+
+  for (int iens = 0; iens < ens_size; iens++)
+    if (enkf_config_node_has_vector( config_node , fs , iens ))
+      int_vector_append( active_list , iens );
+  test_assert_true( int_vector_size( active_list ) > 1 );
+  test_assert_int_equal( 0 , int_vector_iget( active_list , 0 ));
+  {
+    enkf_node_type * node = enkf_node_alloc( config_node );
+    double_vector_type * values = double_vector_alloc( 0 , SUMMARY_UNDEF );
+    buffer_type * buffer = buffer_alloc( 1024 );
+
+    test_assert_true( enkf_node_user_get_vector( node , fs , key , 0 , values ));
+    test_assert_true( double_vector_size( values ) > 36 );
+    double_vector_resize( values , short_size );
+    buffer_fwrite_time_t( buffer , time( NULL ));
+    buffer_fwrite_int( buffer , SUMMARY );
+    double_vector_buffer_fwrite( values , buffer );
+    enkf_fs_fwrite_vector( fs , buffer , key , enkf_config_node_get_var_type( config_node ) , 0 );
+
+    buffer_free( buffer );
+    double_vector_free( values );
+    enkf_node_free( node );
+  }
+
+  {
+    summary_block_type * block = summary_block_alloc_load( fs , config_node , ens_size , active_list );
+    test_assert_true( summary_block_has_member( block , 0 ));
+    test_assert_int_equal( short_size , summary_block_get_member_num_steps( block , 0 ));
+    test_assert_true( summary_block_get_num_steps( block ) > short_size );
+    test_assert_true( summary_block_get_member_num_steps( block , 1 ) > short_size );
+    test_assert_double_equal( SUMMARY_UNDEF , summary_block_iget( block , 0 , short_size ));
+    summary_block_free( block );
+  }
+
+  /* The same from a stored block. */
+  test_assert_true( summary_block_update_fs( fs , config_node , ens_size , NULL ));
+  {
+    summary_block_type * block = summary_block_alloc_load( fs , config_node , ens_size , active_list );
+    test_assert_int_equal( short_size , summary_block_get_member_num_steps( block , 0 ));
+    summary_block_free( block );
+  }
+
+  {
+    measure_arg_type measure_arg = { enkf_main , active_list };
+    test_assert_util_abort( "enkf_obs_measure_summary" , measure_short_member , &measure_arg );
+  }
+  int_vector_free( active_list );
+}
+
+
+int main(int argc , char ** argv) {
+  const char * config_file = argv[1];
+  ert_test_context_type * test_context = ert_test_context_alloc("SUMMARY_BLOCK" , config_file );
+  enkf_main_type * enkf_main = ert_test_context_get_main( test_context );
+  enkf_fs_type * fs = enkf_main_get_fs( enkf_main );
+  const ensemble_config_type * ens_config = enkf_main_get_ensemble_config( enkf_main );
+  const int ens_size = enkf_main_get_ensemble_size( enkf_main );
+  stringlist_type * keys = ensemble_config_alloc_keylist_from_impl_type( ens_config , SUMMARY );
+  const enkf_config_node_type * config_node = NULL;
+
+  /* Find a summary key which has been loaded for realization 0. */
+  for (int ikey = 0; ikey < stringlist_get_size( keys ); ikey++) {
+    const enkf_config_node_type * node = ensemble_config_get_node( ens_config , stringlist_iget( keys , ikey ));
+    if (enkf_config_node_has_vector( node , fs , 0 )) {
+      config_node = node;
+      break;
+    }
+  }
+  test_assert_not_NULL( config_node );
+  {
+    const char * key = enkf_config_node_get_key( config_node );
+    enkf_var_type var_type = enkf_config_node_get_var_type( config_node );
+
+    /* Loading is read only; the block is assembled from the members. */
+    {
+      summary_block_type * block = summary_block_alloc_load( fs , config_node , ens_size , NULL );
+      test_assert_true( summary_block_is_instance( block ));
+      test_assert_int_equal( ens_size , summary_block_get_ens_size( block ));
+      assert_block_equal( fs , config_node , block );
+      summary_block_free( block );
+    }
+    test_assert_false( enkf_fs_has_ensemble_vector( fs , key , var_type ));
+
+    /* Only the members in the active list are loaded. */
+    {
+      int_vector_type * active_list = int_vector_alloc( 1 , 0 );
+      summary_block_type * block = summary_block_alloc_load( fs , config_node , ens_size , active_list );
+      test_assert_true( summary_block_has_member( block , 0 ));
+      for (int iens = 1; iens < ens_size; iens++)
+        test_assert_false( summary_block_has_member( block , iens ));
+      summary_block_free( block );
+      int_vector_free( active_list );
+    }
+
+    /* The block is stored by the writer, and only when it is not valid. */
+    test_assert_true( summary_block_update_fs( fs , config_node , ens_size , NULL ));
+    test_assert_true( enkf_fs_has_ensemble_vector( fs , key , var_type ));
+    test_assert_false( summary_block_update_fs( fs , config_node , ens_size , NULL ));
+    {
+      summary_block_type * block = summary_block_alloc_load( fs , config_node , ens_size , NULL );
+      assert_block_equal( fs , config_node , block );
+      summary_block_free( block );
+    }
+
+    /* Writing the vector of one member - as a batch or alone - makes the stored block stale for that member. */
+    {
+      enkf_node_type * node = enkf_node_alloc( config_node );
+      vector_type * node_list = vector_alloc_new( );
+      int_vector_type * other_members = int_vector_alloc( 0 , 0 );
+      int iens = 0;
+      int write_count = enkf_fs_get_vector_write_count( fs , var_type , iens );
+
+      int_vector_init_range( other_members , 1 , ens_size , 1 );
+      enkf_node_load_vector( node , fs , iens );
+
+      vector_append_ref( node_list , node );
+      enkf_node_store_vector_batch( node_list , fs , iens );
+      test_assert_int_equal( write_count + 1 , enkf_fs_get_vector_write_count( fs , var_type , iens ));
+      test_assert_false( summary_block_update_fs( fs , config_node , ens_size , other_members ));
+      test_assert_true( summary_block_update_fs( fs , config_node , ens_size , NULL ));
+      {
+        summary_block_type * block = summary_block_alloc_load( fs , config_node , ens_size , NULL );
+        assert_block_equal( fs , config_node , block );
+        summary_block_free( block );
+      }
+
+      enkf_node_store_vector( node , fs , iens );
+      test_assert_int_equal( write_count + 2 , enkf_fs_get_vector_write_count( fs , var_type , iens ));
+      test_assert_true( summary_block_update_fs( fs , config_node , ens_size , NULL ));
+      test_assert_false( summary_block_update_fs( fs , config_node , ens_size , NULL ));
+
+      int_vector_free( other_members );
+      vector_free( node_list );
+      enkf_node_free( node );
+    }
+  }
+
+  test_short_member( enkf_main );
+
+  stringlist_free( keys );
+  ert_test_context_free( test_context );
+  exit(0);
+}
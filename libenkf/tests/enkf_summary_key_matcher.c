@@ -0,0 +1,140 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'enkf_summary_key_matcher.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/int_vector.h>
+#include <ert/util/util.h>
+
+#include <ert/ecl/ecl_sum.h>
+#include <ert/ecl/ecl_smspec.h>
+#include <ert/ecl/smspec_node.h>
+
+#include <ert/enkf/summary_key_matcher.h>
+
+
+static summary_key_matcher_type * alloc_matcher( ) {
+  summary_key_matcher_type * matcher = summary_key_matcher_alloc( );
+  summary_key_matcher_add_summary_key( matcher , "FOPT" );
+  summary_key_matcher_add_summary_key( matcher , "WOPR:*" );
+  summary_key_matcher_add_summary_key( matcher , "W?PT:OP_1" );
+  summary_key_matcher_add_summary_key( matcher , "*:OP_2" );
+  summary_key_matcher_add_summary_key( matcher , "RPR:[12]" );
+  return matcher;
+}
+
+
+void test_match( ) {
+  summary_key_matcher_type * matcher = alloc_matcher( );
+
+  test_assert_true( summary_key_matcher_match_summary_key( matcher , "FOPT" ));
+  test_assert_false( summary_key_matcher_match_summary_key( matcher , "FOP" ));
+  test_assert_false( summary_key_matcher_match_summary_key( matcher , "FOPTX" ));
+  test_assert_true( summary_key_matcher_match_summary_key( matcher , "WOPR:OP_1" ));
+  test_assert_true( summary_key_matcher_match_summary_key( matcher , "WOPR:" ));
+  test_assert_false( summary_key_matcher_match_summary_key( matcher , "WOPR" ));
+  test_assert_true( summary_key_matcher_match_summary_key( matcher , "WWPT:OP_1" ));
+  test_assert_true( summary_key_matcher_match_summary_key( matcher , "WGPT:OP_1" ));
+  test_assert_false( summary_key_matcher_match_summary_key( matcher , "WGPT:OP_3" ));
+  test_assert_true( summary_key_matcher_match_summary_key( matcher , "WGOR:OP_2" ));
+  test_assert_true( summary_key_matcher_match_summary_key( matcher , "RPR:2" ));
+  test_assert_false( summary_key_matcher_match_summary_key( matcher , "RPR:3" ));
+  test_assert_false( summary_key_matcher_match_summary_key( matcher , "GOPR:GROUP" ));
+
+  test_assert_int_equal( 5 , summary_key_matcher_get_size( matcher ));
+  test_assert_true( summary_key_matcher_summary_key_is_required( matcher , "FOPT" ));
+  test_assert_false( summary_key_matcher_summary_key_is_required( matcher , "WOPR:*" ));
+
+  summary_key_matcher_free( matcher );
+}
+
+
+static ecl_sum_type * alloc_ecl_sum( bool with_group ) {
+  ecl_sum_type * ecl_sum = ecl_sum_alloc_writer( "CASE" , false , true , ":" , 0 , true , 10 , 10 , 10 );
+  ecl_sum_add_var( ecl_sum , "FOPT" , NULL , 0 , "SM3" , 0 );
+  ecl_sum_add_var( ecl_sum , "WOPR" , "OP_1" , 0 , "SM3/DAY" , 0 );
+  ecl_sum_add_var( ecl_sum , "WOPR" , "OP_2" , 0 , "SM3/DAY" , 0 );
+  if (with_group)
+    ecl_sum_add_var( ecl_sum , "GOPR" , "GROUP" , 0 , "SM3/DAY" , 0 );
+  ecl_sum_add_var( ecl_sum , "WWPT" , "OP_1" , 0 , "SM3" , 0 );
+  ecl_sum_add_var( ecl_sum , "WWPT" , "OP_3" , 0 , "SM3" , 0 );
+  return ecl_sum;
+}
+
+
+static void assert_index_list( const ecl_smspec_type * smspec , const int_vector_type * index_list , const summary_key_matcher_type * matcher) {
+  int num_match = 0;
+  for (int i = 0; i < ecl_smspec_num_nodes( smspec ); i++) {
+    const char * key = smspec_node_get_gen_key1( ecl_smspec_iget_node( smspec , i ));
+    if (key != NULL && summary_key_matcher_match_summary_key( matcher , key )) {
+      test_assert_int_equal( i , int_vector_iget( index_list , num_match ));
+      num_match++;
+    }
+  }
+  test_assert_int_equal( num_match , int_vector_size( index_list ));
+}
+
+
+void test_smspec_cache( ) {
+  summary_key_matcher_type * matcher = alloc_matcher( );
+  ecl_sum_type * ecl_sum1 = alloc_ecl_sum( false );
+  ecl_sum_type * ecl_sum2 = alloc_ecl_sum( false );
+  ecl_sum_type * ecl_sum3 = alloc_ecl_sum( true );
+  const ecl_smspec_type * smspec1 = ecl_sum_get_smspec( ecl_sum1 );
+  const ecl_smspec_type * smspec2 = ecl_sum_get_smspec( ecl_sum2 );
+  const ecl_smspec_type * smspec3 = ecl_sum_get_smspec( ecl_sum3 );
+
+  {
+    int_vector_type * list1 = summary_key_matcher_alloc_smspec_index_list( matcher , smspec1 );
+    int_vector_type * list2 = summary_key_matcher_alloc_smspec_index_list( matcher , smspec2 );
+    int_vector_type * list3 = summary_key_matcher_alloc_smspec_index_list( matcher , smspec3 );
+
+    test_assert_true( int_vector_equal( list1 , list2 ));
+    test_assert_false( int_vector_equal( list1 , list3 ));
+    test_assert_int_equal( 4 , int_vector_size( list1 ));
+    assert_index_list( smspec1 , list1 , matcher );
+    assert_index_list( smspec3 , list3 , matcher );
+
+    /* The lists are owned by the caller, and survive changes to the matcher. */
+    summary_key_matcher_add_summary_key( matcher , "GOPR:*" );
+    test_assert_int_equal( 4 , int_vector_size( list1 ));
+
+    int_vector_free( list1 );
+    int_vector_free( list2 );
+    int_vector_free( list3 );
+  }
+
+  {
+    int_vector_type * list3 = summary_key_matcher_alloc_smspec_index_list( matcher , smspec3 );
+    assert_index_list( smspec3 , list3 , matcher );
+    int_vector_free( list3 );
+  }
+
+  ecl_sum_free( ecl_sum1 );
+  ecl_sum_free( ecl_sum2 );
+  ecl_sum_free( ecl_sum3 );
+  summary_key_matcher_free( matcher );
+}
+
+
+int main(int argc , char ** argv) {
+  test_match( );
+  test_smspec_cache( );
+  exit(0);
+}
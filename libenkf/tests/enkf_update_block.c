@@ -0,0 +1,88 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'enkf_update_block.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <math.h>
+
+#include <ert/util/test_util.h>
+#include <ert/util/util.h>
+
+#include <ert/enkf/enkf_main.h>
+#include <ert/enkf/enkf_node.h>
+#include <ert/enkf/gen_kw.h>
+#include <ert/enkf/ensemble_config.h>
+#include <ert/enkf/analysis_config.h>
+#include <ert/enkf/ert_test_context.h>
+
+/*
+  Runs the smoother update with and without UPDATE_BLOCK_SIZE and
+  checks that the updated parameters are equal; with a block size of
+  3 the GEN_KW parameter is split over several blocks.
+*/
+
+static enkf_fs_type * smoother_update( enkf_main_type * enkf_main , enkf_fs_type * source_fs , const char * target_case , int block_size) {
+  enkf_fs_type * target_fs = enkf_main_mount_alt_fs( enkf_main , target_case , true );
+  analysis_config_set_update_block_size( enkf_main_get_analysis_config( enkf_main ) , block_size );
+  enkf_main_rng_init( enkf_main );
+  test_assert_true( enkf_main_smoother_update( enkf_main , source_fs , target_fs ));
+  return target_fs;
+}
+
+
+static double gen_kw_max_diff( enkf_main_type * enkf_main , const char * key , enkf_fs_type * fs1 , enkf_fs_type * fs2) {
+  const enkf_config_node_type * config_node = ensemble_config_get_node( enkf_main_get_ensemble_config( enkf_main ) , key );
+  enkf_node_type * node1 = enkf_node_alloc( config_node );
+  enkf_node_type * node2 = enkf_node_alloc( config_node );
+  double max_diff = 0;
+
+  for (int iens = 0; iens < enkf_main_get_ensemble_size( enkf_main ); iens++) {
+    node_id_type node_id = { .report_step = 0 , .iens = iens };
+    enkf_node_load( node1 , fs1 , node_id );
+    enkf_node_load( node2 , fs2 , node_id );
+    {
+      gen_kw_type * gen_kw1 = enkf_node_value_ptr( node1 );
+      gen_kw_type * gen_kw2 = enkf_node_value_ptr( node2 );
+      test_assert_int_equal( gen_kw_data_size( gen_kw1 ) , gen_kw_data_size( gen_kw2 ));
+      for (int i = 0; i < gen_kw_data_size( gen_kw1 ); i++)
+        max_diff = util_double_max( max_diff , fabs( gen_kw_data_iget( gen_kw1 , i , false ) - gen_kw_data_iget( gen_kw2 , i , false )));
+    }
+  }
+
+  enkf_node_free( node1 );
+  enkf_node_free( node2 );
+  return max_diff;
+}
+
+
+int main(int argc , char ** argv) {
+  const char * config_file = argv[1];
+  ert_test_context_type * test_context = ert_test_context_alloc("UPDATE_BLOCK" , config_file );
+  enkf_main_type * enkf_main = ert_test_context_get_main( test_context );
+  enkf_fs_type * source_fs = enkf_main_get_fs( enkf_main );
+  enkf_fs_type * full_fs   = smoother_update( enkf_main , source_fs , "update_full" , 0 );
+  enkf_fs_type * block_fs  = smoother_update( enkf_main , source_fs , "update_block" , 3 );
+
+  test_assert_true( gen_kw_max_diff( enkf_main , "SNAKE_OIL_PARAM" , source_fs , full_fs ) > 0 );
+  test_assert_true( gen_kw_max_diff( enkf_main , "SNAKE_OIL_PARAM" , full_fs , block_fs ) < 1e-10 );
+
+  enkf_fs_decref( full_fs );
+  enkf_fs_decref( block_fs );
+  ert_test_context_free( test_context );
+  exit(0);
+}
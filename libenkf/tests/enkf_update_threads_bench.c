@@ -0,0 +1,180 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'enkf_update_threads_bench.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <ert/util/util.h>
+#include <ert/util/rng.h>
+#include <ert/util/thread_pool.h>
+#define HAVE_THREAD_POOL 1
+#include <ert/util/matrix.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/bool_vector.h>
+#include <ert/util/parallel_for.h>
+
+#include <ert/enkf/enkf_main.h>
+#include <ert/enkf/enkf_node.h>
+#include <ert/enkf/enkf_fs.h>
+#include <ert/enkf/active_list.h>
+#include <ert/enkf/ensemble_config.h>
+#include <ert/enkf/enkf_config_node.h>
+#include <ert/enkf/site_config.h>
+#include <ert/enkf/ert_test_context.h>
+
+/*
+  Scaling benchmark for the thread count used in the update and when
+  loading results:
+
+     enkf_update_threads_bench  config_file  [max_threads]
+
+  For 1, 2, 4, ... max_threads (default 64) threads the benchmark
+  times:
+
+    serialize: serializing all the parameters of the current case
+               into the A matrix, one realization per task.
+
+    matmul:    A = A * X with a random X, as in the update.
+
+    load:      loading the results from the forward model of the
+               current case. This is only meaningful if the runpaths
+               of the configuration contain simulation results.
+
+  The benchmark is not run as part of the test suite.
+*/
+
+
+static double bench_now( ) {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC , &ts );
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+
+typedef struct {
+  enkf_fs_type            * fs;
+  const stringlist_type   * keys;
+  enkf_node_type        *** nodes;       /* nodes[ikey][iens] */
+  const int               * row_offset;
+  const active_list_type  * active_list;
+  matrix_type             * A;
+} serialize_arg_type;
+
+
+static void serialize_range( int iens1 , int iens2 , void * arg ) {
+  serialize_arg_type * serialize_arg = arg;
+  for (int iens = iens1; iens < iens2; iens++) {
+    node_id_type node_id = { .report_step = 0 , .iens = iens };
+    for (int ikey = 0; ikey < stringlist_get_size( serialize_arg->keys ); ikey++)
+      enkf_node_serialize( serialize_arg->nodes[ikey][iens] ,
+                           serialize_arg->fs ,
+                           node_id ,
+                           serialize_arg->active_list ,
+                           serialize_arg->A ,
+                           serialize_arg->row_offset[ikey] ,
+                           iens );
+  }
+}
+
+
+int main(int argc , char ** argv) {
+  const char * config_file = argv[1];
+  int max_threads = 64;
+
+  if (argc < 2) {
+    fprintf(stderr,"Usage: %s config_file [max_threads]\n", argv[0]);
+    exit(1);
+  }
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &max_threads );
+
+  enkf_main_install_SIGNALS();
+  {
+    ert_test_context_type * test_context = ert_test_context_alloc("UPDATE_THREADS_BENCH" , config_file );
+    enkf_main_type * enkf_main = ert_test_context_get_main( test_context );
+    enkf_fs_type * fs = enkf_main_get_fs( enkf_main );
+    const ensemble_config_type * ens_config = enkf_main_get_ensemble_config( enkf_main );
+    const int ens_size = enkf_main_get_ensemble_size( enkf_main );
+    stringlist_type * keys = ensemble_config_alloc_keylist_from_var_type( ens_config , PARAMETER );
+    const int num_keys = stringlist_get_size( keys );
+    int * row_offset = util_calloc( num_keys , sizeof * row_offset );
+    enkf_node_type *** nodes = util_calloc( num_keys , sizeof * nodes );
+    active_list_type * active_list = active_list_alloc( );
+    int rows = 0;
+
+    for (int ikey = 0; ikey < num_keys; ikey++) {
+      const enkf_config_node_type * config_node = ensemble_config_get_node( ens_config , stringlist_iget( keys , ikey ));
+      row_offset[ikey] = rows;
+      nodes[ikey] = enkf_main_get_node_ensemble( enkf_main , fs , stringlist_iget( keys , ikey ) , 0 );
+      rows += enkf_config_node_get_data_size( config_node , 0 );
+    }
+
+    printf("Ensemble size: %d   Parameters: %d   Rows: %d   Cores: %d\n", ens_size , num_keys , rows , util_get_num_cpu( ));
+    printf("%8s  %12s  %12s  %12s\n", "Threads" , "Serialize" , "Matmul" , "Load");
+    {
+      rng_type * rng = rng_alloc( MZRAN , INIT_DEFAULT );
+      matrix_type * A = matrix_alloc( util_int_max( 1 , rows ) , ens_size );
+      matrix_type * X = matrix_alloc( ens_size , ens_size );
+      bool_vector_type * iactive = bool_vector_alloc( ens_size , true );
+      serialize_arg_type serialize_arg = { .fs = fs , .keys = keys , .nodes = nodes , .row_offset = row_offset , .active_list = active_list , .A = A };
+
+      matrix_random_init( X , rng );
+      for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+        thread_pool_type * tp = thread_pool_alloc( num_threads , false );
+        double serialize_time , matmul_time , load_time;
+
+        {
+          double start = bench_now( );
+          parallel_for( tp , 0 , ens_size , 1 , serialize_range , &serialize_arg );
+          serialize_time = bench_now( ) - start;
+        }
+
+        {
+          double start = bench_now( );
+          matrix_inplace_matmul_mt2( A , X , tp );
+          matmul_time = bench_now( ) - start;
+        }
+
+        {
+          double start = bench_now( );
+          site_config_set_load_threads( enkf_main_get_site_config( enkf_main ) , num_threads );
+          enkf_main_load_from_forward_model_from_gui( enkf_main , 0 , iactive , fs );
+          load_time = bench_now( ) - start;
+        }
+
+        printf("%8d  %12.4f  %12.4f  %12.4f\n", num_threads , serialize_time , matmul_time , load_time );
+        thread_pool_free( tp );
+      }
+
+      bool_vector_free( iactive );
+      matrix_free( X );
+      matrix_free( A );
+      rng_free( rng );
+    }
+
+    for (int ikey = 0; ikey < num_keys; ikey++)
+      free( nodes[ikey] );
+    free( nodes );
+    free( row_offset );
+    active_list_free( active_list );
+    stringlist_free( keys );
+    ert_test_context_free( test_context );
+  }
+  exit(0);
+}
@@ -59,6 +59,23 @@ add_executable( enkf_analysis_config enkf_analysis_config.c )
 target_link_libraries( enkf_analysis_config enkf test_util )
 add_test( enkf_analysis_config  ${EXECUTABLE_OUTPUT_PATH}/enkf_analysis_config)
 
+add_executable( enkf_summary_key_matcher enkf_summary_key_matcher.c )
+target_link_libraries( enkf_summary_key_matcher enkf test_util )
+add_test( enkf_summary_key_matcher  ${EXECUTABLE_OUTPUT_PATH}/enkf_summary_key_matcher)
+
+add_executable( enkf_summary_block enkf_summary_block.c )
+target_link_libraries( enkf_summary_block enkf test_util )
+add_test( enkf_summary_block ${EXECUTABLE_OUTPUT_PATH}/enkf_summary_block ${PROJECT_SOURCE_DIR}/test-data/local/snake_oil/snake_oil.ert )
+
+add_executable( enkf_update_block enkf_update_block.c )
+target_link_libraries( enkf_update_block enkf test_util )
+add_test( enkf_update_block ${EXECUTABLE_OUTPUT_PATH}/enkf_update_block ${PROJECT_SOURCE_DIR}/test-data/local/snake_oil/snake_oil.ert )
+
+# Scaling benchmark for UPDATE_THREADS / LOAD_THREADS; not run as a test:
+#   enkf_update_threads_bench test-data/local/snake_oil/snake_oil.ert 64
+add_executable( enkf_update_threads_bench enkf_update_threads_bench.c )
+target_link_libraries( enkf_update_threads_bench enkf )
+
 add_executable( enkf_analysis_config_ext_module enkf_analysis_config_ext_module.c )
 target_link_libraries( enkf_analysis_config_ext_module enkf test_util )
 
@@ -245,6 +262,10 @@ add_executable( enkf_meas_data enkf_meas_data.c )
 target_link_libraries( enkf_meas_data enkf test_util )
 add_test( enkf_meas_data  ${EXECUTABLE_OUTPUT_PATH}/enkf_meas_data )
 
+add_executable( enkf_serialize enkf_serialize.c )
+target_link_libraries( enkf_serialize enkf test_util )
+add_test( enkf_serialize  ${EXECUTABLE_OUTPUT_PATH}/enkf_serialize )
+
 add_executable( enkf_ensemble_GEN_PARAM enkf_ensemble_GEN_PARAM.c )
 target_link_libraries( enkf_ensemble_GEN_PARAM enkf test_util )
 add_test( enkf_ensemble_GEN_PARAM  ${EXECUTABLE_OUTPUT_PATH}/enkf_ensemble_GEN_PARAM ${CMAKE_CURRENT_SOURCE_DIR}/data/ensemble/GEN_PARAM )
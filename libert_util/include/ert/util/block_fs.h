@@ -20,6 +20,7 @@
 #define ERT_BLOCK_FS
 #include <ert/util/buffer.h>
 #include <ert/util/vector.h>
+#include <ert/util/stringlist.h>
 #include <ert/util/type_macros.h>
 
 #ifdef __cplusplus
@@ -37,10 +38,22 @@ extern "C" {
   
   size_t          block_fs_get_cache_usage( const block_fs_type * block_fs );
   double          block_fs_get_fragmentation( const block_fs_type * block_fs );
+  int             block_fs_get_num_free_nodes( const block_fs_type * block_fs );
+  long int        block_fs_get_free_size( const block_fs_type * block_fs );
+  int             block_fs_get_num_reused_nodes( const block_fs_type * block_fs );
+  int             block_fs_get_num_new_nodes( const block_fs_type * block_fs );
+  long int        block_fs_get_num_free_scanned( const block_fs_type * block_fs );
   bool            block_fs_rotate( block_fs_type * block_fs , double fragmentation_limit);
+  bool            block_fs_compact( block_fs_type * block_fs , double fragmentation_limit , size_t slice_size);
+  bool            block_fs_compact_begin( block_fs_type * block_fs );
+  bool            block_fs_compact_step( block_fs_type * block_fs , size_t max_bytes);
+  void            block_fs_compact_finish( block_fs_type * block_fs );
+  bool            block_fs_is_compacting( const block_fs_type * block_fs );
   void            block_fs_fsync( block_fs_type * block_fs );
   bool            block_fs_is_mount( const char * mount_file );
   bool            block_fs_is_readonly( const block_fs_type * block_fs);
+  void            block_fs_set_mmap_read( block_fs_type * block_fs , bool mmap_read);
+  bool            block_fs_has_mmap_read( const block_fs_type * block_fs );
   block_fs_type * block_fs_mount( const char * mount_file , 
                                   int block_size , 
                                   int max_cache_size , 
@@ -52,12 +65,14 @@ extern "C" {
   void            block_fs_close( block_fs_type * block_fs , bool unlink_empty);
   void            block_fs_fwrite_file(block_fs_type * block_fs , const char * filename , const void * ptr , size_t byte_size);
   void            block_fs_fwrite_buffer(block_fs_type * block_fs , const char * filename , const buffer_type * buffer);
+  void            block_fs_fwrite_batch( block_fs_type * block_fs , const stringlist_type * filenames , const vector_type * buffers);
   void            block_fs_fread_file( block_fs_type * block_fs , const char * filename , void * ptr);
   int             block_fs_get_filesize( block_fs_type * block_fs , const char * filename);
   void            block_fs_fread_realloc_buffer( block_fs_type * block_fs , const char * filename , buffer_type * buffer);
   void            block_fs_sync( block_fs_type * block_fs );
   void            block_fs_unlink_file( block_fs_type * block_fs , const char * filename);
   bool            block_fs_has_file( block_fs_type * block_fs , const char * filename);
+  int             block_fs_get_num_files( block_fs_type * block_fs );
   vector_type   * block_fs_alloc_filelist( block_fs_type * block_fs  , const char * pattern , block_fs_sort_type sort_mode , bool include_free_nodes );
   void            block_fs_defrag( block_fs_type * block_fs );
   
@@ -96,6 +96,7 @@ extern "C" {
 
 #ifdef ERT_HAVE_ZLIB
   size_t             buffer_fwrite_compressed(buffer_type * buffer, const void * ptr , size_t byte_size);
+  size_t             buffer_fwrite_compressed_level(buffer_type * buffer, const void * ptr , size_t byte_size , int level);
   size_t             buffer_fread_compressed(buffer_type * buffer , size_t compressed_size , void * target_ptr , size_t target_size);
 #endif
 
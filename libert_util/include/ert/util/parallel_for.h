@@ -0,0 +1,53 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'parallel_for.h' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_PARALLEL_FOR_H
+#define ERT_PARALLEL_FOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdio.h>
+
+#include <ert/util/thread_pool.h>
+
+  typedef void (parallel_for_ftype) (int begin , int end , void * arg);
+
+  typedef struct     parallel_for_stats_struct parallel_for_stats_type;
+
+  void                      parallel_for( thread_pool_type * tp , int begin , int end , int grain , parallel_for_ftype * func , void * arg);
+  void                      parallel_for_timed( thread_pool_type * tp , int begin , int end , int grain , parallel_for_ftype * func , void * arg , parallel_for_stats_type * stats);
+
+  parallel_for_stats_type * parallel_for_stats_alloc( );
+  void                      parallel_for_stats_free( parallel_for_stats_type * stats );
+  void                      parallel_for_stats_reset( parallel_for_stats_type * stats );
+  int                       parallel_for_stats_get_num_threads( const parallel_for_stats_type * stats );
+  double                    parallel_for_stats_get_wall_time( const parallel_for_stats_type * stats );
+  double                    parallel_for_stats_iget_busy_time( const parallel_for_stats_type * stats , int thread );
+  double                    parallel_for_stats_iget_max_task_time( const parallel_for_stats_type * stats , int thread );
+  int                       parallel_for_stats_iget_num_tasks( const parallel_for_stats_type * stats , int thread );
+  int                       parallel_for_stats_iget_num_steals( const parallel_for_stats_type * stats , int thread );
+  double                    parallel_for_stats_get_imbalance( const parallel_for_stats_type * stats );
+  void                      parallel_for_stats_fprintf( const parallel_for_stats_type * stats , FILE * stream );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
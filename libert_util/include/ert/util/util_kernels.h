@@ -0,0 +1,53 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'util_kernels.h' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#ifndef ERT_UTIL_KERNELS_H
+#define ERT_UTIL_KERNELS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdlib.h>
+
+typedef enum {
+  UTIL_KERNEL_SCALAR = 0,
+  UTIL_KERNEL_SSE2   = 1,
+  UTIL_KERNEL_AVX2   = 2
+} util_kernel_level_enum;
+
+
+  util_kernel_level_enum util_kernel_get_level( void );
+  util_kernel_level_enum util_kernel_set_level( util_kernel_level_enum level );
+  const char *           util_kernel_level_name( util_kernel_level_enum level );
+
+  void util_kernel_bswap32_copy( void * target , const void * src , size_t count );
+  void util_kernel_bswap64_copy( void * target , const void * src , size_t count );
+  void util_kernel_float_to_double( double * target , const float * src , size_t count );
+  void util_kernel_double_to_float( float * target , const double * src , size_t count );
+  void util_kernel_gather_double( double * target , const double * src , const int * index , size_t count );
+  void util_kernel_gather_float_to_double( double * target , const float * src , const int * index , size_t count );
+  void util_kernel_scatter_double( double * target , const int * index , const double * src , size_t count );
+  void util_kernel_scatter_double_to_float( float * target , const int * index , const double * src , size_t count );
+  void util_kernel_scale_shift_float( float * data , size_t count , float scale , float shift );
+  void util_kernel_scale_shift_double( double * data , size_t count , double scale , double shift );
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -23,9 +23,22 @@
 #include <stdio.h>
 #include <errno.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <pthread.h>
 #include <time.h>
 #include <fnmatch.h>
+#include <stdint.h>
+
+#include "ert/util/build_config.h"
+
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif
+
+#ifdef HAVE_PWRITEV
+#include <sys/uio.h>
+#endif
 
 #include <ert/util/hash.h>
 #include <ert/util/util.h>
@@ -33,12 +46,14 @@
 #include <ert/util/vector.h>
 #include <ert/util/buffer.h>
 #include <ert/util/long_vector.h>
+#include <ert/util/stringlist.h>
 
 
 #define MOUNT_MAP_MAGIC_INT  8861290
 #define BLOCK_FS_TYPE_ID     7100652
 #define INDEX_MAGIC_INT      1213775
 #define INDEX_FORMAT_VERSION       1
+#define HASH_INDEX_FORMAT_VERSION  3
 
 // #define ENABLE_CACHE
 
@@ -58,6 +73,18 @@
 #define DEFAULT_INDEX_SIZE 2048
 
 
+/*
+  When the data file is memory mapped for reading the mapping covers
+  the data file as it was when the mapping was created; nodes which
+  are appended later are read with the stream based code. The data
+  file is only remapped when it has grown by more than
+  1/MAP_GROWTH_DIVISOR of the mapped size, so a growing data file is
+  remapped a logarithmic number of times.
+*/
+
+#define MAP_GROWTH_DIVISOR  4
+
+
 
 /**
    These should be bitwise "smart" - so it is possible
@@ -82,9 +109,27 @@ typedef enum {
 
 
 /**
-   The free_node_struct is used to implement a doubly linked list of
+   The free_node_struct is used to implement doubly linked lists of
    free nodes; i.e. holes in the file which are available for other use. 
+
+   The free nodes are kept in segregated lists based on the node size;
+   the size classes have two levels:
+
+     1. The first level is the power of two of the node size.
+     2. The second level divides each power of two range in
+        FREE_SL_COUNT linear ranges.
+
+   Two bitmaps keep track of which lists are non empty, so finding a
+   list with nodes of at least a certain size does not require a scan
+   through all the free nodes. The nodes in one list differ by at most
+   1/FREE_SL_COUNT in size. In addition the free nodes are indexed by
+   node offset in the free_index hash.
 */
+
+#define FREE_FL_COUNT   32
+#define FREE_SL_LOG2     4
+#define FREE_SL_COUNT   (1 << FREE_SL_LOG2)
+
 typedef struct file_node_struct file_node_type;
 typedef struct free_node_struct free_node_type;
 
@@ -116,6 +161,69 @@ struct file_node_struct{
 };
 
 
+/**
+   The hashed index (HASH_INDEX_FORMAT_VERSION) is an open addressing
+   hash table which is written to disk when the filesystem is closed,
+   and used directly from the mapped index file when the filesystem is
+   mounted again. The file_node instances are only created when a file
+   is looked up, so mounting does not depend on the number of files in
+   the filesystem.
+
+   |<header><slot 0><slot 1>...<slot num_slots-1><free 0>...<free num_free-1><key table>|
+
+   The header and the slots are serialized field by field with fixed
+   width integers in native byte order, so the file format does not
+   depend on struct layout and padding:
+
+     header (INDEX_HEADER_SIZE bytes):
+        int32 id , int32 version , int64 data_mtime , int64 data_file_size ,
+        int32 num_active , int32 num_slots , int32 num_free , int32 key_size
+
+     slot (INDEX_SLOT_SIZE bytes):
+        int64 node_offset , int32 node_size , int32 data_offset , int32 data_size ,
+        int32 status , uint32 key_hash , int32 key_offset
+
+   The slots use linear probing, an empty slot has status == 0. The
+   free nodes are stored with the same slot layout, and the key table
+   is a list of \0 terminated keys referenced by key_offset. The first
+   three fields in the header coincide with the header of the
+   INDEX_FORMAT_VERSION index on platforms with 64 bit time_t.
+
+   All the slots are validated when the index is loaded; if one of
+   them is inconsistent the index is discarded, and the index is
+   rebuilt from the data file.
+
+   The index_header_type and index_slot_type structs are only the
+   decoded in-memory representation.
+*/
+
+#define INDEX_HEADER_SIZE   40
+#define INDEX_SLOT_SIZE     32
+#define INDEX_STATUS_OFFSET 20    /* Offset of the status field in a slot. */
+
+typedef struct {
+  int        id;
+  int        version;
+  time_t     data_mtime;
+  long int   data_file_size;
+  int        num_active;
+  int        num_slots;       /* Always a power of two. */
+  int        num_free;
+  int        key_size;
+} index_header_type;
+
+
+typedef struct {
+  long int   node_offset;
+  int        node_size;
+  int        data_offset;
+  int        data_size;
+  int        status;          /* NODE_IN_USE | NODE_FREE on disk; 0 for empty slots, NODE_INVALID when the node has been loaded. */
+  unsigned   key_hash;
+  int        key_offset;
+} index_slot_type;
+
+
 /**
    data_size   : manipulated in block_fs_fwrite__() and block_fs_insert_free_node().
    status      : manipulated in block_fs_fwrite__() and block_fs_unlink_file__();
@@ -127,6 +235,33 @@ struct file_node_struct{
 
 
 
+/**
+   State of an online compaction; the live nodes are copied to the
+   data file of the next version in slices, and the new data file
+   replaces the current one when all nodes have been copied. Files
+   which are written or unlinked while the compaction is running are
+   registered in the dirty hash, and copied again (or dropped) when
+   the compaction is finished.
+*/
+
+typedef struct {
+  int               version;          /* The version number of the new data file. */
+  char            * data_file;
+  FILE            * data_stream;
+  long int          data_file_size;
+  hash_type       * index;            /* filename -> file_node in the new data file. */
+  vector_type     * file_nodes;       /* Owns the file_node instances of the new data file. */
+  vector_type     * free_nodes;       /* Nodes in the new data file which have been invalidated while compacting. */
+  stringlist_type * keys;             /* The files which were present when the compaction started. */
+  int               next_key;
+  hash_type       * dirty;            /* Files which have been written/unlinked since the compaction started. */
+  void            * copy_buffer;
+  size_t            copy_buffer_size;
+  pthread_mutex_t   lock;             /* Held while copying nodes - only one thread copies at a time. */
+} compact_state_type;
+
+
+
 struct block_fs_struct {
   UTIL_TYPE_ID_DECLARATION;
   char           * mount_file;    /* The full path to a file with some mount information - input to the mount routine. */
@@ -149,10 +284,21 @@ struct block_fs_struct {
   
   pthread_mutex_t  io_lock;         /* Lock held during fread of the data file. */
   pthread_rwlock_t rw_lock;         /* Read-write lock during all access to the fs. */
+  pthread_mutex_t  index_lock;      /* Lock held during lookup in the index - readers can load nodes from the disk_index. */
   
   int              num_free_nodes;   
+  free_node_type * free_lists[FREE_FL_COUNT][FREE_SL_COUNT];
+  unsigned         free_fl_bitmap;                   /* Bit fl is set if any of the free_lists[fl][] lists are non empty. */
+  unsigned         free_sl_bitmap[FREE_FL_COUNT];    /* Bit sl in free_sl_bitmap[fl] is set if free_lists[fl][sl] is non empty. */
+  hash_type      * free_index;                       /* The free nodes keyed by node offset, see free_index_key(). */
+  int              num_reused_nodes;  /* Counters for the free node allocator: number of allocations from the free lists, */
+  int              num_new_nodes;     /* the number of allocations at the end of the data file, */
+  long int         num_free_scanned;  /* and the number of free nodes inspected while looking for a node. */
   hash_type      * index;           /* THE HASH table of all the nodes/files which have been stored. */
-  free_node_type * free_nodes;
+  char           * disk_index;      /* The hashed index loaded at mount; nodes not in index are looked up here. NULL when all nodes are in index. */
+  size_t           disk_index_size;
+  index_header_type disk_header;    /* The decoded header of disk_index. */
+  bool             index_dirty;     /* Has the filesystem changed since the index was loaded from disk? */
   vector_type    * file_nodes;      /* This vector owns all the file_node instances - the index and free_nodes structures
                                        only contain pointers to the objects stored in this vector. */
   int              write_count;     /* This just counts the number of writes since the file system was mounted. */
@@ -164,11 +310,18 @@ struct block_fs_struct {
                                             fragmentation_limit == 0.0 : Rotate when one byte is wasted. */
   bool             data_owner;
   int              fsync_interval;  /* 0: never  n: every nth iteration. */
+
+  bool             mmap_read;       /* Should reads be served from a memory mapping of the data file? */
+  char           * data_map;        /* The current read-only mapping of the data file - NULL if not mapped. */
+  size_t           data_map_size;   /* The size of the mapping; can be larger than the data file. */
+
+  compact_state_type * compact;     /* Non NULL while an online compaction is running. */
 };
 
 /*****************************************************************/
 
 static void block_fs_rotate__( block_fs_type * block_fs );
+static void block_fs_compact_abort__( block_fs_type * block_fs );
 
 UTIL_SAFE_CAST_FUNCTION( block_fs , BLOCK_FS_TYPE_ID )
 
@@ -414,12 +567,12 @@ static void file_node_set_data_offset( file_node_type * file_node, const char *
 
 
 
-static void file_node_dump_index( const file_node_type * file_node , FILE * index_stream) {
-  util_fwrite_int( file_node->status , index_stream );
-  util_fwrite_long( file_node->node_offset , index_stream );
-  util_fwrite_int( file_node->node_size   , index_stream );
-  util_fwrite_int( file_node->data_offset , index_stream );
-  util_fwrite_int( file_node->data_size   , index_stream );
+static void file_node_dump_slot( const file_node_type * file_node , index_slot_type * slot) {
+  slot->status      = file_node->status;
+  slot->node_offset = file_node->node_offset;
+  slot->node_size   = file_node->node_size;
+  slot->data_offset = file_node->data_offset;
+  slot->data_size   = file_node->data_size;
 }
 
 
@@ -482,6 +635,35 @@ static void free_node_free_list( free_node_type * head ) {
 }
 
 
+static int floor_log2( unsigned value ) {
+  int log2 = 0;
+  while (value >>= 1)
+    log2++;
+  return log2;
+}
+
+
+static void free_node_size_class( int node_size , int * fl , int * sl) {
+  if (node_size < FREE_SL_COUNT) {
+    *fl = 0;
+    *sl = node_size;
+  } else {
+    int log2 = floor_log2( node_size );
+    *fl = log2 - FREE_SL_LOG2 + 1;
+    *sl = (node_size >> (log2 - FREE_SL_LOG2)) - FREE_SL_COUNT;
+  }
+}
+
+
+/* The smallest node size in the size class (fl,sl). */
+static size_t free_node_class_size( int fl , int sl ) {
+  if (fl == 0)
+    return sl;
+  else
+    return ((size_t) (FREE_SL_COUNT + sl)) << (fl - 1);
+}
+
+
 
 /*****************************************************************/
 static inline void block_fs_aquire_wlock( block_fs_type * block_fs ) {
@@ -507,86 +689,104 @@ static inline void block_fs_aquire_rlock( block_fs_type * block_fs ) {
 }
 
 
+/**
+   Must be called (with the write lock held) whenever a file is
+   written or unlinked, so that a running compaction will refresh its
+   copy of the file.
+*/
+
+static void block_fs_compact_touch( block_fs_type * block_fs , const char * filename ) {
+  if (block_fs->compact != NULL)
+    hash_insert_int( block_fs->compact->dirty , filename , 1 );
+}
+
+
 
 static void block_fs_insert_index_node( block_fs_type * block_fs , const char * filename , const file_node_type * file_node) {
   hash_insert_ref( block_fs->index , filename , file_node);
 }
 
 
+#define FREE_INDEX_KEY_SIZE 32
+
+static const char * free_index_key( long int node_offset , char * key ) {
+  snprintf( key , FREE_INDEX_KEY_SIZE , "%ld" , node_offset );
+  return key;
+}
+
+
 /**
-   Looks through the list of free nodes - looking for a node with
-   offset 'node_offset'. If no such node can be found, NULL will be
-   returned.
+   Looks up the free node with offset 'node_offset'. If no such node
+   can be found, NULL will be returned.
 */
 
 static file_node_type * block_fs_lookup_free_node( const block_fs_type * block_fs , long int node_offset) {
-  free_node_type * current = block_fs->free_nodes;
-  while (current != NULL && (current->file_node->node_offset != node_offset)) 
-    current = current->next;
-  
-  if (current == NULL)
-    return NULL;
+  char key[FREE_INDEX_KEY_SIZE];
+  free_node_type * free_node = hash_safe_get( block_fs->free_index , free_index_key( node_offset , key ));
+  if (free_node != NULL)
+    return free_node->file_node;
   else
-    return current->file_node;
+    return NULL;
 }
 
 
+/**
+   Returns a vector with (references to) all the free file_node instances.
+*/
 
+static vector_type * block_fs_alloc_free_file_nodes( const block_fs_type * block_fs ) {
+  vector_type * free_nodes = vector_alloc_new( );
+  for (int fl = 0; fl < FREE_FL_COUNT; fl++) {
+    for (int sl = 0; sl < FREE_SL_COUNT; sl++) {
+      free_node_type * current = block_fs->free_lists[fl][sl];
+      while (current != NULL) {
+        vector_append_ref( free_nodes , current->file_node );
+        current = current->next;
+      }
+    }
+  }
+  return free_nodes;
+}
 
 
-
-
+static void block_fs_free_free_lists( block_fs_type * block_fs ) {
+  for (int fl = 0; fl < FREE_FL_COUNT; fl++) {
+    for (int sl = 0; sl < FREE_SL_COUNT; sl++) {
+      free_node_free_list( block_fs->free_lists[fl][sl] );
+      block_fs->free_lists[fl][sl] = NULL;
+    }
+    block_fs->free_sl_bitmap[fl] = 0;
+  }
+  hash_clear( block_fs->free_index );
+  block_fs->free_fl_bitmap = 0;
+  block_fs->num_free_nodes = 0;
+  block_fs->free_size      = 0;
+}
 
 
 /**
-   Inserts a file_node instance in the linked list of free nodes. The
-   list is sorted in order of increasing node size.
+   Inserts a file_node instance at the head of the free list for the
+   size class of the node.
 */
 
 static void block_fs_insert_free_node( block_fs_type * block_fs , file_node_type * file_node ) {
   free_node_type * new = free_node_alloc( file_node );
-  
-  /* Special case: starting with a empty list. */
-  if (block_fs->free_nodes == NULL) {
-    new->next = NULL;
-    new->prev = NULL;
-    block_fs->free_nodes = new;
-  } else {
-    free_node_type * current = block_fs->free_nodes;
-    free_node_type * prev    = NULL;
-    
-    while ( current != NULL && (current->file_node->node_size < file_node->node_size)) {
-      prev = current;
-      current = current->next;
-    }
-    
-    if (current == NULL) {
-      /* 
-         The new node should be added at the end of the list - i.e. it
-         will not have a next node.
-      */
-      new->next = NULL;
-      new->prev = prev;
-      prev->next = new;
-    } else {
-      /*
-        The new node should be placed BEFORE the current node.
-      */
-      if (prev == NULL) {
-        /* The new node should become the new list head. */
-        block_fs->free_nodes = new;
-        new->prev = NULL;
-      } else {
-        prev->next = new;
-        new->prev  = prev;
-      }
-      current->prev = new;
-      new->next  = current;
-    }
-    if (new != NULL)     if (new->next == new) util_abort("%s: broken LIST1 \n",__func__);
-    if (prev != NULL)    if (prev->next == prev) util_abort("%s: broken LIST2 \n",__func__);
-    if (current != NULL) if (current->next == current) util_abort("%s: Broken LIST3 \n",__func__);
+  int fl , sl;
+
+  free_node_size_class( file_node->node_size , &fl , &sl );
+  new->prev = NULL;
+  new->next = block_fs->free_lists[fl][sl];
+  if (new->next != NULL)
+    new->next->prev = new;
+
+  block_fs->free_lists[fl][sl] = new;
+  block_fs->free_sl_bitmap[fl] |= (1u << sl);
+  block_fs->free_fl_bitmap     |= (1u << fl);
+  {
+    char key[FREE_INDEX_KEY_SIZE];
+    hash_insert_ref( block_fs->free_index , free_index_key( file_node->node_offset , key ) , new );
   }
+
   block_fs->num_free_nodes++;
   block_fs->free_size += new->file_node->node_size;
 }
@@ -602,6 +802,257 @@ static void block_fs_install_node(block_fs_type * block_fs , file_node_type * no
 }
 
 
+/*****************************************************************/
+/* Functions for the hashed disk index. */
+
+static unsigned index_key_hash( const char * key ) {
+  /* FNV-1a */
+  unsigned hash = 2166136261u;
+  for (const unsigned char * c = (const unsigned char *) key; *c != '\0'; c++) {
+    hash ^= *c;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+
+static int32_t index_get_int32( const char * ptr ) {
+  int32_t value;
+  memcpy( &value , ptr , sizeof value );
+  return value;
+}
+
+static int64_t index_get_int64( const char * ptr ) {
+  int64_t value;
+  memcpy( &value , ptr , sizeof value );
+  return value;
+}
+
+static char * index_put_int32( char * ptr , int32_t value ) {
+  memcpy( ptr , &value , sizeof value );
+  return ptr + sizeof value;
+}
+
+static char * index_put_int64( char * ptr , int64_t value ) {
+  memcpy( ptr , &value , sizeof value );
+  return ptr + sizeof value;
+}
+
+
+static void index_header_decode( const char * ptr , index_header_type * header ) {
+  header->id             = index_get_int32( &ptr[0] );
+  header->version        = index_get_int32( &ptr[4] );
+  header->data_mtime     = (time_t) index_get_int64( &ptr[8] );
+  header->data_file_size = (long int) index_get_int64( &ptr[16] );
+  header->num_active     = index_get_int32( &ptr[24] );
+  header->num_slots      = index_get_int32( &ptr[28] );
+  header->num_free       = index_get_int32( &ptr[32] );
+  header->key_size       = index_get_int32( &ptr[36] );
+}
+
+
+static void index_header_encode( const index_header_type * header , char * ptr ) {
+  ptr = index_put_int32( ptr , header->id );
+  ptr = index_put_int32( ptr , header->version );
+  ptr = index_put_int64( ptr , header->data_mtime );
+  ptr = index_put_int64( ptr , header->data_file_size );
+  ptr = index_put_int32( ptr , header->num_active );
+  ptr = index_put_int32( ptr , header->num_slots );
+  ptr = index_put_int32( ptr , header->num_free );
+  ptr = index_put_int32( ptr , header->key_size );
+}
+
+
+static void index_slot_decode( const char * ptr , index_slot_type * slot ) {
+  slot->node_offset = (long int) index_get_int64( &ptr[0] );
+  slot->node_size   = index_get_int32( &ptr[8] );
+  slot->data_offset = index_get_int32( &ptr[12] );
+  slot->data_size   = index_get_int32( &ptr[16] );
+  slot->status      = index_get_int32( &ptr[INDEX_STATUS_OFFSET] );
+  slot->key_hash    = (unsigned) index_get_int32( &ptr[24] );
+  slot->key_offset  = index_get_int32( &ptr[28] );
+}
+
+
+static void index_slot_encode( const index_slot_type * slot , char * ptr ) {
+  ptr = index_put_int64( ptr , slot->node_offset );
+  ptr = index_put_int32( ptr , slot->node_size );
+  ptr = index_put_int32( ptr , slot->data_offset );
+  ptr = index_put_int32( ptr , slot->data_size );
+  ptr = index_put_int32( ptr , slot->status );
+  ptr = index_put_int32( ptr , (int32_t) slot->key_hash );
+  ptr = index_put_int32( ptr , slot->key_offset );
+}
+
+
+static const index_header_type * block_fs_get_index_header( const block_fs_type * block_fs ) {
+  return &block_fs->disk_header;
+}
+
+
+static char * block_fs_get_index_slot( const block_fs_type * block_fs , int islot ) {
+  return &block_fs->disk_index[ INDEX_HEADER_SIZE + (size_t) islot * INDEX_SLOT_SIZE ];
+}
+
+
+static int block_fs_get_index_slot_status( const block_fs_type * block_fs , int islot ) {
+  return index_get_int32( &block_fs_get_index_slot( block_fs , islot )[ INDEX_STATUS_OFFSET ] );
+}
+
+
+static const char * block_fs_get_index_keys( const block_fs_type * block_fs ) {
+  const index_header_type * header = block_fs_get_index_header( block_fs );
+  return &block_fs->disk_index[ INDEX_HEADER_SIZE + (size_t) (header->num_slots + header->num_free) * INDEX_SLOT_SIZE ];
+}
+
+
+static void block_fs_free_disk_index( block_fs_type * block_fs ) {
+  if (block_fs->disk_index != NULL) {
+#ifdef HAVE_MMAP
+    munmap( block_fs->disk_index , block_fs->disk_index_size );
+#else
+    free( block_fs->disk_index );
+#endif
+    block_fs->disk_index      = NULL;
+    block_fs->disk_index_size = 0;
+  }
+}
+
+
+static file_node_type * file_node_alloc_from_slot( const index_slot_type * slot ) {
+  file_node_type * file_node = file_node_alloc( slot->status , slot->node_offset , slot->node_size );
+  file_node->data_offset = slot->data_offset;
+  file_node->data_size   = slot->data_size;
+  return file_node;
+}
+
+
+/**
+   Creates a file_node for the slot and adds it to the index hash. The
+   slot is marked as loaded in the (private) mapping; from then on the
+   index hash is the authoritative source of information for this key.
+*/
+
+static file_node_type * block_fs_load_index_slot( block_fs_type * block_fs , int islot , const index_slot_type * slot) {
+  const char * key = &block_fs_get_index_keys( block_fs )[ slot->key_offset ];
+  file_node_type * file_node = file_node_alloc_from_slot( slot );
+
+  block_fs_install_node( block_fs , file_node );
+  block_fs_insert_index_node( block_fs , key , file_node );
+  index_put_int32( &block_fs_get_index_slot( block_fs , islot )[ INDEX_STATUS_OFFSET ] , NODE_INVALID );
+  return file_node;
+}
+
+
+/**
+   Returns the slot number of filename in the disk index, or -1 if
+   filename is not in the disk index. Observe that the slot might
+   already have been loaded into the index hash.
+*/
+
+static int block_fs_find_index_slot( const block_fs_type * block_fs , const char * filename) {
+  const index_header_type * header = block_fs_get_index_header( block_fs );
+  const char * keys       = block_fs_get_index_keys( block_fs );
+  unsigned key_hash       = index_key_hash( filename );
+  unsigned mask           = header->num_slots - 1;
+  unsigned islot          = key_hash & mask;
+
+  for (int probe = 0; probe < header->num_slots; probe++) {
+    index_slot_type slot;
+
+    if (block_fs_get_index_slot_status( block_fs , islot ) == 0)
+      break;
+
+    index_slot_decode( block_fs_get_index_slot( block_fs , islot ) , &slot );
+    if ((slot.key_hash == key_hash) && (strcmp( &keys[ slot.key_offset ] , filename) == 0))
+      return islot;
+    islot = (islot + 1) & mask;
+  }
+  return -1;
+}
+
+
+static file_node_type * block_fs_disk_index_lookup( block_fs_type * block_fs , const char * filename) {
+  int islot = block_fs_find_index_slot( block_fs , filename );
+  if (islot >= 0) {
+    index_slot_type slot;
+    index_slot_decode( block_fs_get_index_slot( block_fs , islot ) , &slot );
+    if (slot.status == NODE_IN_USE)
+      return block_fs_load_index_slot( block_fs , islot , &slot );
+  }
+  return NULL;   /* Not in the disk index; or has already been loaded and then later unlinked. */
+}
+
+
+/**
+   Will load all the nodes which are still only in the disk index into
+   the index hash, and then discard the disk index. This must be called
+   before operations which need to traverse all the nodes. The calling
+   scope must hold the write lock, or alternatively the index_lock.
+*/
+
+static void block_fs_load_disk_index( block_fs_type * block_fs ) {
+  if (block_fs->disk_index != NULL) {
+    const index_header_type * header = block_fs_get_index_header( block_fs );
+
+    for (int islot = 0; islot < header->num_slots; islot++) {
+      if (block_fs_get_index_slot_status( block_fs , islot ) == NODE_IN_USE) {
+        index_slot_type slot;
+        index_slot_decode( block_fs_get_index_slot( block_fs , islot ) , &slot );
+        block_fs_load_index_slot( block_fs , islot , &slot );
+      }
+    }
+    block_fs_free_disk_index( block_fs );
+  }
+}
+
+
+/**
+   Returns the file_node for filename, or NULL if the file does not
+   exist. If the file has not been looked up since the filesystem was
+   mounted it is loaded from the disk index.
+*/
+
+static file_node_type * block_fs_lookup_node( block_fs_type * block_fs , const char * filename) {
+  file_node_type * file_node = NULL;
+
+  pthread_mutex_lock( &block_fs->index_lock );
+  {
+    file_node = hash_safe_get( block_fs->index , filename );
+    if ((file_node == NULL) && (block_fs->disk_index != NULL))
+      file_node = block_fs_disk_index_lookup( block_fs , filename );
+  }
+  pthread_mutex_unlock( &block_fs->index_lock );
+
+  return file_node;
+}
+
+
+static file_node_type * block_fs_get_node( block_fs_type * block_fs , const char * filename) {
+  file_node_type * file_node = block_fs_lookup_node( block_fs , filename );
+  if (file_node == NULL)
+    util_abort("%s: could not find file:%s in filesystem:%s \n",__func__ , filename , block_fs->mount_file);
+
+  return file_node;
+}
+
+
+static int block_fs_get_num_files__( const block_fs_type * block_fs ) {
+  int num_files = hash_get_size( block_fs->index );
+  if (block_fs->disk_index != NULL) {
+    const index_header_type * header = block_fs_get_index_header( block_fs );
+
+    for (int islot = 0; islot < header->num_slots; islot++) {
+      if (block_fs_get_index_slot_status( block_fs , islot ) == NODE_IN_USE)
+        num_files++;
+    }
+  }
+  return num_files;
+}
+
+/*****************************************************************/
+
+
 static void block_fs_set_filenames( block_fs_type * block_fs ) {
   char * data_ext  = util_alloc_sprintf("data_%d" , block_fs->version );
   char * lock_ext  = util_alloc_sprintf("lock_%d" , block_fs->version );
@@ -629,9 +1080,20 @@ static void block_fs_set_filenames( block_fs_type * block_fs ) {
 
 static void block_fs_reinit( block_fs_type * block_fs ) {
   block_fs->index               = hash_alloc_unlocked();
+  block_fs->disk_index          = NULL;
+  block_fs->disk_index_size     = 0;
+  block_fs->index_dirty         = true;
   block_fs->file_nodes          = vector_alloc_new();
-  block_fs->free_nodes          = NULL;
   block_fs->num_free_nodes      = 0;
+  block_fs->free_fl_bitmap      = 0;
+  block_fs->num_reused_nodes    = 0;
+  block_fs->num_new_nodes       = 0;
+  block_fs->num_free_scanned    = 0;
+  for (int fl = 0; fl < FREE_FL_COUNT; fl++) {
+    for (int sl = 0; sl < FREE_SL_COUNT; sl++)
+      block_fs->free_lists[fl][sl] = NULL;
+    block_fs->free_sl_bitmap[fl] = 0;
+  }
   block_fs->write_count         = 0;
   block_fs->data_file_size      = 0;
   block_fs->free_size           = 0; 
@@ -660,8 +1122,14 @@ static block_fs_type * block_fs_alloc_empty( const char * mount_file ,
   block_fs->max_total_cache_size = 512 * 1024 * 1024;  /* 512 MB */
   
   block_fs->fragmentation_limit = fragmentation_limit;   
+  block_fs->mmap_read           = false;
+  block_fs->data_map            = NULL;
+  block_fs->data_map_size       = 0;
+  block_fs->compact             = NULL;
+  block_fs->free_index          = hash_alloc_unlocked();
   util_alloc_file_components( mount_file , &block_fs->path , &block_fs->base_name, NULL );
   pthread_mutex_init( &block_fs->io_lock  , NULL);
+  pthread_mutex_init( &block_fs->index_lock , NULL);
   pthread_rwlock_init( &block_fs->rw_lock , NULL);
   {
     FILE * stream            = util_fopen( mount_file , "r");
@@ -701,12 +1169,24 @@ static block_fs_type * block_fs_alloc_empty( const char * mount_file ,
 UTIL_IS_INSTANCE_FUNCTION(block_fs , BLOCK_FS_TYPE_ID);
 
 
+/**
+   The mount file is written to a temporary file which is renamed in
+   place, so the version number in the mount file is updated
+   atomically.
+*/
+
 static void block_fs_fwrite_mount_info__( const char * mount_file , int version) {
-  FILE * stream = util_fopen( mount_file , "w");
+  char * tmp_file = util_alloc_sprintf("%s.tmp" , mount_file );
+  FILE * stream = util_fopen( tmp_file , "w");
   util_fwrite_int( MOUNT_MAP_MAGIC_INT , stream );
   util_fwrite_int( version , stream );
+  fflush( stream );
+  fsync( fileno( stream ));
   fclose( stream );
- }
+  if (rename( tmp_file , mount_file ) != 0)
+    util_abort("%s: failed to rename %s -> %s: %s \n",__func__ , tmp_file , mount_file , strerror( errno ));
+  free( tmp_file );
+}
 
 
 /**
@@ -810,6 +1290,98 @@ static void block_fs_open_data( block_fs_type * block_fs , bool read_write) {
     block_fs->data_fd = fileno( block_fs->data_stream );
 }
 
+
+/**
+   The data file can be memory mapped read-only, and the read
+   functions will then copy directly from the mapping, without taking
+   the io_lock. That way many threads can read concurrently from the
+   same data file.
+
+   The mapping is only modified when the caller holds the write lock
+   (or during mount/close), so readers holding the read lock can
+   safely use it. The mapping is exactly as large as the data file
+   when it was created; nodes which extend beyond the mapping are read
+   with the normal stream based code. When a node inside the mapping
+   is rewritten the data_stream is flushed, so the new content is
+   visible through the mapping.
+*/
+
+#ifdef HAVE_MMAP
+
+static void block_fs_unmap_data( block_fs_type * block_fs ) {
+  if (block_fs->data_map != NULL) {
+    munmap( block_fs->data_map , block_fs->data_map_size );
+    block_fs->data_map      = NULL;
+    block_fs->data_map_size = 0;
+  }
+}
+
+
+static void block_fs_map_data( block_fs_type * block_fs ) {
+  block_fs_unmap_data( block_fs );
+  if (block_fs->mmap_read && (block_fs->data_stream != NULL)) {
+    stat_type data_stat;
+
+    fflush( block_fs->data_stream );
+    if (fstat( block_fs->data_fd , &data_stat ) == 0) {
+      size_t map_size = data_stat.st_size;
+
+      if (map_size > 0) {
+        void * map = mmap( NULL , map_size , PROT_READ , MAP_SHARED , block_fs->data_fd , 0 );
+        if (map != MAP_FAILED) {
+          block_fs->data_map      = map;
+          block_fs->data_map_size = map_size;
+        }
+        /* If the mmap() call fails we just continue with stream based reads. */
+      }
+    }
+  }
+}
+
+#else
+
+static void block_fs_unmap_data( block_fs_type * block_fs ) { return; }
+static void block_fs_map_data( block_fs_type * block_fs ) { return; }
+
+#endif
+
+
+/**
+   Returns a pointer to the data of file_node in the mapping, or NULL
+   if the node data must be read from the data_stream.
+*/
+
+static const char * block_fs_get_mapped_data( const block_fs_type * block_fs , const file_node_type * file_node) {
+  if (block_fs->data_map != NULL) {
+    size_t data_end = file_node->node_offset + file_node->data_offset + file_node->data_size;
+    if (data_end <= block_fs->data_map_size)
+      return &block_fs->data_map[ file_node->node_offset + file_node->data_offset ];
+  }
+  return NULL;
+}
+
+
+/**
+   Called by the writers after file_node has been written. If the node
+   is served from the mapping the data_stream is flushed so the new
+   content is visible through the mapping; nodes beyond the end of the
+   mapping are read through the data_stream, and need no flush. When
+   the data file has grown sufficiently beyond the current mapping a
+   new mapping is created. The file_node argument can be NULL when the
+   data has been written directly to the file descriptor.
+*/
+
+static void block_fs_update_map( block_fs_type * block_fs , const file_node_type * file_node) {
+  if (block_fs->mmap_read) {
+    if ((file_node != NULL) && (block_fs_get_mapped_data( block_fs , file_node ) != NULL))
+      fflush( block_fs->data_stream );
+
+    if (block_fs->data_file_size > block_fs->data_map_size + block_fs->data_map_size / MAP_GROWTH_DIVISOR)
+      block_fs_map_data( block_fs );
+  }
+}
+
+
 #ifdef ENABLE_CACHE
 
 static void block_fs_clear_cache_node( block_fs_type * block_fs , file_node_type * node ) {
@@ -842,7 +1414,10 @@ static void block_fs_update_cache_node( block_fs_type * block_fs, file_node_type
 static void block_fs_preload( block_fs_type * block_fs ) {
   if ((block_fs->max_cache_size > 0) && (block_fs->data_stream != NULL) && (block_fs->max_total_cache_size > 0)) {
     void * buffer = util_malloc( block_fs->max_cache_size );
-    hash_iter_type * index_iter = hash_iter_alloc( block_fs->index );
+    hash_iter_type * index_iter;
+
+    block_fs_load_disk_index( block_fs );
+    index_iter = hash_iter_alloc( block_fs->index );
     
     while (!hash_iter_is_complete( index_iter )) {
       file_node_type * node = hash_iter_get_next_value( index_iter );
@@ -975,60 +1550,197 @@ static void block_fs_build_index( block_fs_type * block_fs , long_vector_type *
 
 
 /**
-   Load an index for (slightly) faster mounting of the filesystem. The
-   function starts be reading a header and check if the current index
-   file is applicable.
-
-   Will return true of the loading succedeed, and false if no index
-   was loaded.  
+   Checks that a slot from the disk index describes a node inside the
+   data file; for the hashed slots (check_key == true) the key must
+   also be a NUL terminated string inside the key table.
 */
 
+static bool block_fs_index_slot_valid( const block_fs_type * block_fs , const index_slot_type * slot , bool check_key ) {
+  const index_header_type * header = block_fs_get_index_header( block_fs );
 
-static bool block_fs_load_index( block_fs_type * block_fs ) {
-  stat_type data_stat;
-  if (fstat( block_fs->data_fd , &data_stat) == 0) {
-    FILE * stream = fopen( block_fs->index_file , "r");
-    if (stream != NULL) {
-      int    id          = util_fread_int( stream );
-      int    version     = util_fread_int( stream );
-      time_t index_mtime = util_fread_time_t( stream );
+  if ((slot->node_offset < 0) ||
+      (slot->node_size <= 0) ||
+      (slot->node_offset + slot->node_size > header->data_file_size) ||
+      (slot->data_offset < 0) ||
+      (slot->data_size < 0) ||
+      ((long int) slot->data_offset + slot->data_size > slot->node_size))
+    return false;
 
-      time_t data_mtime  = data_stat.st_mtime;
-      fclose( stream );
+  if (check_key) {
+    const char * keys = block_fs_get_index_keys( block_fs );
+    if ((slot->key_offset < 0) || (slot->key_offset >= header->key_size))
+      return false;
 
-      if ((id == INDEX_MAGIC_INT) &&               /* This is indeed an index file. */ 
-          (version == INDEX_FORMAT_VERSION) &&     /* The version on disk agrees with this version. */
-          (index_mtime == data_mtime)) {           /* The time stamp agrees with the time stamp of the data. */
-        
-        /* Read the whole index file in one single read operation. */
-        buffer_type * buffer = buffer_fread_alloc( block_fs->index_file );
-        
-        buffer_fskip( buffer , sizeof( time_t ) + 2 * sizeof( int ));
-        /*1: Loading all the active nodes. */
-        {
-          int num_active_nodes = buffer_fread_int( buffer );
-          hash_resize( block_fs->index , num_active_nodes * 2 + 64);
-          
-          for (int i=0; i < num_active_nodes; i++) {
-            const char * filename = buffer_fread_string( buffer );
-            file_node_type * file_node = file_node_index_buffer_fread_alloc( buffer );
-            block_fs_install_node( block_fs , file_node);
-            block_fs_insert_index_node(block_fs , filename , file_node);
-          }
-        }
-        
-        /*2: Loading all the free nodes. */
-        {
-          int num_free_nodes = buffer_fread_int( buffer );
-          for (int i=0; i < num_free_nodes; i++) {
-            file_node_type * file_node = file_node_index_buffer_fread_alloc( buffer );
-            block_fs_install_node( block_fs , file_node);
-            block_fs_insert_free_node(block_fs , file_node);
-          }
-        }
-        buffer_free( buffer );
+    if (memchr( &keys[ slot->key_offset ] , '\0' , header->key_size - slot->key_offset ) == NULL)
+      return false;
+  }
+  return true;
+}
+
+
+/**
+   Validates all the slots of the disk index before it is used; the
+   lookups in the disk index trust the slots, and the probing needs at
+   least one empty slot to terminate.
+*/
+
+static bool block_fs_index_valid( const block_fs_type * block_fs ) {
+  const index_header_type * header = block_fs_get_index_header( block_fs );
+  int num_empty = 0;
+
+  if ((header->data_file_size < 0) || (header->data_file_size > util_file_size( block_fs->data_file )))
+    return false;
+
+  for (int islot = 0; islot < header->num_slots + header->num_free; islot++) {
+    index_slot_type slot;
+    bool hashed_slot = (islot < header->num_slots);
+
+    index_slot_decode( block_fs_get_index_slot( block_fs , islot ) , &slot );
+    if (hashed_slot && (slot.status == 0))
+      num_empty++;
+    else if (!block_fs_index_slot_valid( block_fs , &slot , hashed_slot ))
+      return false;
+  }
+  return (num_empty > 0);
+}
+
+
+/**
+   Will load the hashed index file; the index file is mapped (or read)
+   into memory, but the only nodes which are instantiated immediately
+   are the free nodes. The active nodes are loaded from the disk index
+   by block_fs_lookup_node() when they are needed.
+*/
+
+static bool block_fs_load_hash_index( block_fs_type * block_fs , time_t data_mtime ) {
+  size_t index_size = util_file_size( block_fs->index_file );
+  char * disk_index = NULL;
+
+  if (index_size < INDEX_HEADER_SIZE)
+    return false;
+
+#ifdef HAVE_MMAP
+  {
+    int fd = open( block_fs->index_file , O_RDONLY );
+    if (fd != -1) {
+      /* Private writable mapping - the slots are marked as loaded in memory, that is never written back. */
+      void * map = mmap( NULL , index_size , PROT_READ | PROT_WRITE , MAP_PRIVATE , fd , 0 );
+      if (map != MAP_FAILED)
+        disk_index = map;
+      close( fd );
+    }
+  }
+#else
+  {
+    FILE * stream = util_fopen( block_fs->index_file , "r");
+    disk_index = util_malloc( index_size );
+    util_fread( disk_index , 1 , index_size , stream , __func__ );
+    fclose( stream );
+  }
+#endif
+  if (disk_index == NULL)
+    return false;
+
+  block_fs->disk_index      = disk_index;
+  block_fs->disk_index_size = index_size;
+  index_header_decode( disk_index , &block_fs->disk_header );
+  {
+    const index_header_type * header = block_fs_get_index_header( block_fs );
+
+    if (header->data_mtime != data_mtime) {
+      block_fs_free_disk_index( block_fs );
+      return false;
+    }
+
+    if ((header->num_slots <= 0) ||
+        ((header->num_slots & (header->num_slots - 1)) != 0) ||     /* Must be a power of two. */
+        (header->num_free < 0) ||
+        (header->key_size < 0) ||
+        (INDEX_HEADER_SIZE + (size_t) (header->num_slots + header->num_free) * INDEX_SLOT_SIZE + header->key_size != index_size) ||
+        (!block_fs_index_valid( block_fs ))) {
+      fprintf(stderr,"** Warning: the index file:%s is corrupt - will rebuild index from the data file.\n", block_fs->index_file);
+      block_fs_free_disk_index( block_fs );
+      return false;
+    }
+
+    block_fs->data_file_size = header->data_file_size;
+    for (int ifree = 0; ifree < header->num_free; ifree++) {
+      index_slot_type slot;
+      file_node_type * file_node;
+
+      index_slot_decode( block_fs_get_index_slot( block_fs , header->num_slots + ifree ) , &slot );
+      file_node = file_node_alloc_from_slot( &slot );
+      block_fs_install_node( block_fs , file_node );
+      block_fs_insert_free_node( block_fs , file_node );
+    }
+  }
+  block_fs->index_dirty = false;
+  return true;
+}
+
+
+/**
+   Load an index for (slightly) faster mounting of the filesystem. The
+   function starts be reading a header and check if the current index
+   file is applicable.
+
+   Will return true of the loading succedeed, and false if no index
+   was loaded.  
+*/
+
+
+static bool block_fs_load_index( block_fs_type * block_fs ) {
+  stat_type data_stat;
+  if (fstat( block_fs->data_fd , &data_stat) == 0) {
+    FILE * stream = fopen( block_fs->index_file , "r");
+    if (stream != NULL) {
+      int    id          = util_fread_int( stream );
+      int    version     = util_fread_int( stream );
+      time_t data_mtime  = data_stat.st_mtime;
+
+      if ((id == INDEX_MAGIC_INT) && (version == HASH_INDEX_FORMAT_VERSION)) {
+        fclose( stream );
+        return block_fs_load_hash_index( block_fs , data_mtime );
+      }
+
+      {
+        time_t index_mtime = util_fread_time_t( stream );
+        fclose( stream );
+
+        if ((id == INDEX_MAGIC_INT) &&               /* This is indeed an index file. */ 
+            (version == INDEX_FORMAT_VERSION) &&     /* The version on disk agrees with this version. */
+            (index_mtime == data_mtime)) {           /* The time stamp agrees with the time stamp of the data. */
+        
+          /* Read the whole index file in one single read operation. */
+          buffer_type * buffer = buffer_fread_alloc( block_fs->index_file );
+        
+          buffer_fskip( buffer , sizeof( time_t ) + 2 * sizeof( int ));
+          /*1: Loading all the active nodes. */
+          {
+            int num_active_nodes = buffer_fread_int( buffer );
+            hash_resize( block_fs->index , num_active_nodes * 2 + 64);
+          
+            for (int i=0; i < num_active_nodes; i++) {
+              const char * filename = buffer_fread_string( buffer );
+              file_node_type * file_node = file_node_index_buffer_fread_alloc( buffer );
+              block_fs_install_node( block_fs , file_node);
+              block_fs_insert_index_node(block_fs , filename , file_node);
+            }
+          }
+        
+          /*2: Loading all the free nodes. */
+          {
+            int num_free_nodes = buffer_fread_int( buffer );
+            for (int i=0; i < num_free_nodes; i++) {
+              file_node_type * file_node = file_node_index_buffer_fread_alloc( buffer );
+              block_fs_install_node( block_fs , file_node);
+              block_fs_insert_free_node(block_fs , file_node);
+            }
+          }
+          buffer_free( buffer );
         
-        return true;
+          return true;
+        }
       }
     } 
   }
@@ -1061,6 +1773,34 @@ bool block_fs_is_readonly( const block_fs_type * bfs ) {
 }
 
 
+/**
+   Will enable or disable memory mapped reads of the data file. If the
+   platform does not support mmap() this is a noop; the same applies
+   if the mmap() call itself fails - the filesystem will then silently
+   continue with the stream based reads.
+*/
+
+void block_fs_set_mmap_read( block_fs_type * block_fs , bool mmap_read) {
+  pthread_rwlock_wrlock( &block_fs->rw_lock );
+  {
+    block_fs->mmap_read = mmap_read;
+    if (mmap_read)
+      block_fs_map_data( block_fs );
+    else
+      block_fs_unmap_data( block_fs );
+  }
+  block_fs_release_rwlock( block_fs );
+}
+
+
+bool block_fs_has_mmap_read( const block_fs_type * block_fs ) {
+  if (block_fs->data_map != NULL)
+    return true;
+  else
+    return false;
+}
+
+
 
 block_fs_type * block_fs_mount( const char * mount_file ,
                                 int block_size ,
@@ -1102,22 +1842,103 @@ block_fs_type * block_fs_mount( const char * mount_file ,
 static void block_fs_unlink_free_node( block_fs_type * block_fs , free_node_type * node) {
   free_node_type * prev = node->prev;
   free_node_type * next = node->next;
-  
-  if (prev == NULL)
+  int fl , sl;
+
+  free_node_size_class( node->file_node->node_size , &fl , &sl );
+  if (prev == NULL) {
     /* Special case: popping off the head of the list. */
-    block_fs->free_nodes = next;
-  else
+    block_fs->free_lists[fl][sl] = next;
+    if (next == NULL) {
+      block_fs->free_sl_bitmap[fl] &= ~(1u << sl);
+      if (block_fs->free_sl_bitmap[fl] == 0)
+        block_fs->free_fl_bitmap &= ~(1u << fl);
+    }
+  } else
     prev->next = next;
   
   if (next != NULL)
     next->prev = prev;
 
+  {
+    char key[FREE_INDEX_KEY_SIZE];
+    hash_del( block_fs->free_index , free_index_key( node->file_node->node_offset , key ));
+  }
   block_fs->num_free_nodes--;
   block_fs->free_size -= node->file_node->node_size;
   free_node_free( node );
 }
 
 
+/**
+   Returns the index of the lowest set bit in mask, which must be
+   nonzero.
+*/
+
+static int lowest_bit( unsigned mask ) {
+  int bit = 0;
+  while ((mask & 1u) == 0) {
+    mask >>= 1;
+    bit++;
+  }
+  return bit;
+}
+
+
+/**
+   Finds a free node with node_size >= min_size. All the nodes in the
+   size classes above the class of min_size are large enough, so the
+   head of the first non empty list among those is used; that is found
+   with the bitmaps without scanning any nodes. If min_size is the
+   lower bound of its own class all the nodes of that class are large
+   enough as well, and that class is tried first.
+
+   Only when there are no free nodes in the larger classes is the list
+   of the class of min_size searched for a node which is large enough.
+*/
+
+static free_node_type * block_fs_find_free_node( block_fs_type * block_fs , size_t min_size) {
+  int fl , sl;
+
+  if (min_size > INT_MAX)
+    return NULL;
+
+  free_node_size_class( min_size , &fl , &sl );
+  if ((min_size == free_node_class_size( fl , sl )) && (block_fs->free_lists[fl][sl] != NULL)) {
+    block_fs->num_free_scanned++;
+    return block_fs->free_lists[fl][sl];
+  }
+
+  {
+    unsigned sl_mask = (sl + 1 < FREE_SL_COUNT) ? (block_fs->free_sl_bitmap[fl] & (~0u << (sl + 1))) : 0;
+    int next_fl = fl;
+
+    if (sl_mask == 0) {
+      unsigned fl_mask = (fl + 1 < FREE_FL_COUNT) ? (block_fs->free_fl_bitmap & (~0u << (fl + 1))) : 0;
+      if (fl_mask != 0) {
+        next_fl = lowest_bit( fl_mask );
+        sl_mask = block_fs->free_sl_bitmap[next_fl];
+      }
+    }
+
+    if (sl_mask != 0) {
+      block_fs->num_free_scanned++;
+      return block_fs->free_lists[next_fl][ lowest_bit( sl_mask ) ];
+    }
+  }
+
+  {
+    free_node_type * current = block_fs->free_lists[fl][sl];
+    while (current != NULL) {
+      block_fs->num_free_scanned++;
+      if (current->file_node->node_size >= min_size)
+        return current;
+      current = current->next;
+    }
+  }
+  return NULL;
+}
+
+
 
 /**
    This function first checks the free nodes if any of them can be
@@ -1126,11 +1947,7 @@ static void block_fs_unlink_free_node( block_fs_type * block_fs , free_node_type
 
 static file_node_type * block_fs_get_new_node( block_fs_type * block_fs , const char * filename , size_t min_size) {
   
-  free_node_type * current = block_fs->free_nodes;
-  
-  while (current != NULL && (current->file_node->node_size < min_size)) {
-    current = current->next;
-  }
+  free_node_type * current = block_fs_find_free_node( block_fs , min_size );
   if (current != NULL) {
     /* 
        Current points to a file_node which can be used. Before we return current we must:
@@ -1141,6 +1958,7 @@ static file_node_type * block_fs_get_new_node( block_fs_type * block_fs , const
     */
     file_node_type * file_node = current->file_node;
     block_fs_unlink_free_node( block_fs , current );
+    block_fs->num_reused_nodes++;
 
     return file_node;
   } else {
@@ -1161,6 +1979,7 @@ static file_node_type * block_fs_get_new_node( block_fs_type * block_fs , const
     offset = block_fs->data_file_size;
     new_node = file_node_alloc(NODE_IN_USE , offset , node_size);  
     block_fs_install_node( block_fs , new_node );                   /* <- This will update the total file size. */
+    block_fs->num_new_nodes++;
     
     return new_node;
   }
@@ -1170,18 +1989,47 @@ static file_node_type * block_fs_get_new_node( block_fs_type * block_fs , const
 
 
 
+/**
+   Checks whether filename exists without loading it from the disk
+   index. The calling scope must hold the write lock, or the
+   index_lock.
+*/
+
 bool block_fs_has_file__( const block_fs_type * block_fs , const char * filename) {
-  return hash_has_key( block_fs->index , filename );
+  if (hash_has_key( block_fs->index , filename ))
+    return true;
+
+  if (block_fs->disk_index != NULL) {
+    int islot = block_fs_find_index_slot( block_fs , filename );
+    if ((islot >= 0) && (block_fs_get_index_slot_status( block_fs , islot ) == NODE_IN_USE))
+      return true;
+  }
+  return false;
 }
 
 
 
+int block_fs_get_num_files( block_fs_type * block_fs ) {
+  int num_files;
+  block_fs_aquire_rlock( block_fs );
+  pthread_mutex_lock( &block_fs->index_lock );
+  {
+    num_files = block_fs_get_num_files__( block_fs );
+  }
+  pthread_mutex_unlock( &block_fs->index_lock );
+  block_fs_release_rwlock( block_fs );
+  return num_files;
+}
+
+
 bool block_fs_has_file( block_fs_type * block_fs , const char * filename) {
   bool has_file;
   block_fs_aquire_rlock( block_fs );
+  pthread_mutex_lock( &block_fs->index_lock );
   {
     has_file = block_fs_has_file__( block_fs , filename );
   }
+  pthread_mutex_unlock( &block_fs->index_lock );
   block_fs_release_rwlock( block_fs );
   return has_file;
 }
@@ -1190,8 +2038,11 @@ bool block_fs_has_file( block_fs_type * block_fs , const char * filename) {
 
 
 static void block_fs_unlink_file__( block_fs_type * block_fs , const char * filename ) {
-  file_node_type * node = hash_pop( block_fs->index , filename );
+  file_node_type * node = block_fs_get_node( block_fs , filename );
+  block_fs_compact_touch( block_fs , filename );
+  hash_del( block_fs->index , filename );
   block_fs_clear_cache_node( block_fs , node );
+  block_fs->index_dirty = true;
 
   node->status      = NODE_FREE;
   node->data_offset = 0;
@@ -1213,6 +2064,33 @@ double block_fs_get_fragmentation( const block_fs_type * block_fs ) {
 }
 
 
+/**
+   Counters for the free node allocator. The num_reused_nodes,
+   num_new_nodes and num_free_scanned counters count allocations since
+   the filesystem was mounted, or last rotated.
+*/
+
+int block_fs_get_num_free_nodes( const block_fs_type * block_fs ) {
+  return block_fs->num_free_nodes;
+}
+
+long int block_fs_get_free_size( const block_fs_type * block_fs ) {
+  return block_fs->free_size;
+}
+
+int block_fs_get_num_reused_nodes( const block_fs_type * block_fs ) {
+  return block_fs->num_reused_nodes;
+}
+
+int block_fs_get_num_new_nodes( const block_fs_type * block_fs ) {
+  return block_fs->num_new_nodes;
+}
+
+long int block_fs_get_num_free_scanned( const block_fs_type * block_fs ) {
+  return block_fs->num_free_scanned;
+}
+
+
 void block_fs_unlink_file( block_fs_type * block_fs , const char * filename) {
   block_fs_aquire_wlock( block_fs );
 
@@ -1320,6 +2198,8 @@ static void block_fs_fwrite__(block_fs_type * block_fs , const char * filename ,
     file_node_fwrite( node , filename , block_fs->data_stream );
 
     block_fs_update_cache_node( block_fs , node , data_size , ptr);
+    block_fs_update_map( block_fs , node );
+    block_fs->index_dirty = true;
     block_fs->write_count++;
     if (block_fs->fsync_interval && ((block_fs->write_count % block_fs->fsync_interval) == 0)) 
       block_fs_fsync( block_fs );
@@ -1329,13 +2209,21 @@ static void block_fs_fwrite__(block_fs_type * block_fs , const char * filename ,
 
 
 
-static void block_fs_fwrite_file_unlocked(block_fs_type * block_fs , const char * filename , const void * ptr , size_t data_size) {
-  file_node_type * file_node;
+/**
+   Will find a node which is large enough to hold data_size bytes of
+   data for filename; either the current node of filename, or a new
+   node. If a new node is returned *new_node is set to true, and the
+   calling scope must insert it in the index after the write.
+*/
+
+static file_node_type * block_fs_get_write_node( block_fs_type * block_fs , const char * filename , size_t data_size , bool * __new_node) {
+  file_node_type * file_node = block_fs_lookup_node( block_fs , filename );
   bool   new_node = true;   
   size_t min_size = data_size + file_node_header_size( filename );
+
+  block_fs_compact_touch( block_fs , filename );
   
-  if (block_fs_has_file__( block_fs , filename )) {
-    file_node = hash_get( block_fs->index , filename );
+  if (file_node != NULL) {
     if (file_node->node_size < min_size) {
       /* 
          The current node is too small for the new content:
@@ -1352,7 +2240,15 @@ static void block_fs_fwrite_file_unlocked(block_fs_type * block_fs , const char
       new_node = false;  /* We are reusing the existing node. */
   } else 
     file_node = block_fs_get_new_node( block_fs , filename , min_size );
-  
+
+  *__new_node = new_node;
+  return file_node;
+}
+
+
+static void block_fs_fwrite_file_unlocked(block_fs_type * block_fs , const char * filename , const void * ptr , size_t data_size) {
+  bool new_node;
+  file_node_type * file_node = block_fs_get_write_node( block_fs , filename , data_size , &new_node );
   
   /* The actual writing ... */
   block_fs_fwrite__( block_fs , filename , file_node , ptr , data_size);
@@ -1388,6 +2284,222 @@ void block_fs_fwrite_buffer(block_fs_type * block_fs , const char * filename , c
 }
 
 
+/*****************************************************************/
+/* Batch writes */
+
+#ifdef IOV_MAX
+#define BATCH_IOV_MAX  IOV_MAX
+#else
+#define BATCH_IOV_MAX  16
+#endif
+
+#define BATCH_ZERO_PAD_SIZE 4096
+
+static const int  NODE_IN_USE_TAG = NODE_IN_USE;
+static const char BATCH_ZERO_PAD[BATCH_ZERO_PAD_SIZE] = {0};
+
+
+typedef struct {
+  file_node_type * file_node;
+  const char     * filename;
+  const void     * data;
+  size_t           header_offset;   /* Offset of the header image in the headers buffer. */
+} batch_node_type;
+
+
+typedef struct {
+  long int         offset;
+  const void     * ptr;
+  size_t           size;
+} write_segment_type;
+
+
+static int batch_node_cmp( const void * arg1 , const void * arg2 ) {
+  const batch_node_type * node1 = (const batch_node_type *) arg1;
+  const batch_node_type * node2 = (const batch_node_type *) arg2;
+
+  if (node1->file_node->node_offset > node2->file_node->node_offset)
+    return 1;
+  else if (node1->file_node->node_offset < node2->file_node->node_offset)
+    return -1;
+  else
+    return 0;
+}
+
+
+static void write_segment_set( write_segment_type * segment , long int offset , const void * ptr , size_t size) {
+  segment->offset = offset;
+  segment->ptr    = ptr;
+  segment->size   = size;
+}
+
+
+/**
+   Writes the segments directly to the data file descriptor. The
+   segments should be sorted on offset; segments which are adjacent in
+   the file are combined in one pwritev() call.
+*/
+
+static void block_fs_pwrite_segments( block_fs_type * block_fs , const write_segment_type * segments , int num_segments) {
+  int iseg = 0;
+  while (iseg < num_segments) {
+    long int offset = segments[iseg].offset;
+    long int next   = offset;
+    size_t   total  = 0;
+    ssize_t  written;
+#ifdef HAVE_PWRITEV
+    struct iovec iov[ BATCH_IOV_MAX ];
+    int niov = 0;
+
+    while ((iseg < num_segments) && (niov < BATCH_IOV_MAX) && (segments[iseg].offset == next)) {
+      iov[niov].iov_base = (void *) segments[iseg].ptr;
+      iov[niov].iov_len  = segments[iseg].size;
+      next  += segments[iseg].size;
+      total += segments[iseg].size;
+      niov++;
+      iseg++;
+    }
+    written = pwritev( block_fs->data_fd , iov , niov , offset );
+#else
+    total   = segments[iseg].size;
+    written = pwrite( block_fs->data_fd , segments[iseg].ptr , segments[iseg].size , offset );
+    iseg++;
+#endif
+    if ((written < 0) || ((size_t) written != total))
+      util_abort("%s: failed to write %zu bytes at offset:%ld to %s - %s \n",__func__ , total , offset , block_fs->data_file , strerror( errno ));
+  }
+}
+
+
+/**
+   The data file has been written directly through the file
+   descriptor; flushing the data_stream discards any stale content in
+   the stdio read buffer, and the next fseek() will reposition the
+   underlying file descriptor.
+*/
+
+static void block_fs_sync_stream( block_fs_type * block_fs ) {
+  fflush( block_fs->data_stream );
+}
+
+
+/**
+   Will write all the buffers in one batch; the nodes for all the files
+   are reserved first, and then written to the data file with as few
+   (vectored) write calls as possible. The NODE_WRITE_ACTIVE protocol
+   is the same as for block_fs_fwrite_file():
+
+     1. All the nodes are written with NODE_WRITE_ACTIVE_START and
+        NODE_WRITE_ACTIVE_END tags, along with the data.
+
+     2. The tags are replaced with NODE_IN_USE and NODE_END_TAG.
+
+   Finally one fsync() is issued for the whole batch, unless the
+   filesystem has been mounted with fsync_interval == 0. The filenames
+   in one batch must be unique; this is checked before any nodes are
+   reserved.
+*/
+
+void block_fs_fwrite_batch( block_fs_type * block_fs , const stringlist_type * filenames , const vector_type * buffers) {
+  int num_files = stringlist_get_size( filenames );
+  if (vector_get_size( buffers ) != num_files)
+    util_abort("%s: size mismatch between filenames:%d and buffers:%d \n",__func__ , num_files , vector_get_size( buffers ));
+
+  {
+    hash_type * batch_files = hash_alloc_unlocked( );
+    for (int i=0; i < num_files; i++) {
+      const char * filename = stringlist_iget( filenames , i );
+      if (hash_has_key( batch_files , filename ))
+        util_abort("%s: the file:%s occurs more than once in the batch \n",__func__ , filename);
+      hash_insert_int( batch_files , filename , i );
+    }
+    hash_free( batch_files );
+  }
+
+  block_fs_aquire_wlock( block_fs );
+  if (num_files > 0) {
+    batch_node_type    * nodes    = util_calloc( num_files , sizeof * nodes );
+    write_segment_type * segments = util_calloc( 4 * num_files , sizeof * segments );
+    buffer_type        * headers  = buffer_alloc( 1024 );
+    int num_segments;
+
+    /* 1: Reserve nodes for all the files, and create the header images. */
+    for (int i=0; i < num_files; i++) {
+      const char * filename      = stringlist_iget( filenames , i );
+      const buffer_type * buffer = vector_iget_const( buffers , i );
+      size_t data_size           = buffer_get_size( buffer );
+      bool new_node;
+      file_node_type * file_node = block_fs_get_write_node( block_fs , filename , data_size , &new_node );
+
+      file_node->status    = NODE_IN_USE;
+      file_node->data_size = data_size;
+      file_node_set_data_offset( file_node , filename );
+      if (new_node)
+        block_fs_insert_index_node( block_fs , filename , file_node );
+
+      nodes[i].file_node     = file_node;
+      nodes[i].filename      = filename;
+      nodes[i].data          = buffer_get_data( buffer );
+      nodes[i].header_offset = buffer_get_size( headers );
+
+      buffer_fwrite_int( headers , NODE_WRITE_ACTIVE_START );
+      buffer_fwrite_int( headers , strlen( filename ));
+      buffer_fwrite( headers , filename , 1 , strlen( filename ) + 1);
+      buffer_fwrite_int( headers , file_node->node_size );
+      buffer_fwrite_int( headers , file_node->data_size );
+    }
+    qsort( nodes , num_files , sizeof * nodes , batch_node_cmp );
+
+    /* Pending writes in the data_stream must reach the file before the direct writes. */
+    fflush( block_fs->data_stream );
+
+    /* 2: Write headers with NODE_WRITE_ACTIVE_START, data and NODE_WRITE_ACTIVE_END tags. */
+    num_segments = 0;
+    for (int i=0; i < num_files; i++) {
+      const file_node_type * file_node = nodes[i].file_node;
+      long int data_end = file_node->node_offset + file_node->data_offset + file_node->data_size;
+      long int tail     = file_node->node_offset + file_node->node_size - sizeof NODE_END_TAG;
+      const char * header = buffer_get_data( headers );
+
+      write_segment_set( &segments[num_segments++] , file_node->node_offset , &header[ nodes[i].header_offset ] , file_node->data_offset );
+      write_segment_set( &segments[num_segments++] , file_node->node_offset + file_node->data_offset , nodes[i].data , file_node->data_size );
+      if ((tail > data_end) && ((tail - data_end) <= BATCH_ZERO_PAD_SIZE))
+        write_segment_set( &segments[num_segments++] , data_end , BATCH_ZERO_PAD , tail - data_end );
+      write_segment_set( &segments[num_segments++] , tail , &NODE_WRITE_ACTIVE_END , sizeof NODE_WRITE_ACTIVE_END );
+    }
+    block_fs_pwrite_segments( block_fs , segments , num_segments );
+
+    /* 3: Replace the tags with NODE_IN_USE and NODE_END_TAG. */
+    num_segments = 0;
+    for (int i=0; i < num_files; i++) {
+      const file_node_type * file_node = nodes[i].file_node;
+      write_segment_set( &segments[num_segments++] , file_node->node_offset , &NODE_IN_USE_TAG , sizeof NODE_IN_USE_TAG );
+      write_segment_set( &segments[num_segments++] , file_node->node_offset + file_node->node_size - sizeof NODE_END_TAG , &NODE_END_TAG , sizeof NODE_END_TAG );
+    }
+    block_fs_pwrite_segments( block_fs , segments , num_segments );
+    block_fs_sync_stream( block_fs );
+
+    for (int i=0; i < num_files; i++)
+      block_fs_update_cache_node( block_fs , nodes[i].file_node , nodes[i].file_node->data_size , nodes[i].data );
+
+    block_fs_update_map( block_fs , NULL );
+    block_fs->index_dirty  = true;
+    block_fs->write_count += num_files;
+    if (block_fs->fsync_interval)
+      block_fs_fsync( block_fs );
+
+    if (block_fs_get_fragmentation( block_fs ) > block_fs->fragmentation_limit)
+      block_fs_rotate__( block_fs );
+
+    buffer_free( headers );
+    free( segments );
+    free( nodes );
+  }
+  block_fs_release_rwlock( block_fs );
+}
+
+
+
 /**
    Need extra locking here - because the global rwlock allows many
    concurrent readers.
@@ -1403,11 +2515,16 @@ static void block_fs_fread__(block_fs_type * block_fs , const file_node_type * f
 #endif
 
   {
-    pthread_mutex_lock( &block_fs->io_lock );
-    block_fs_fseek_node_data( block_fs , file_node );
-    util_fread( ptr , 1 , read_bytes , block_fs->data_stream , __func__);
-    //file_node_verify_end_tag( file_node , block_fs->data_stream );
-    pthread_mutex_unlock( &block_fs->io_lock );
+    const char * mapped_data = block_fs_get_mapped_data( block_fs , file_node );
+    if (mapped_data != NULL)
+      memcpy( ptr , mapped_data , read_bytes );
+    else {
+      pthread_mutex_lock( &block_fs->io_lock );
+      block_fs_fseek_node_data( block_fs , file_node );
+      util_fread( ptr , 1 , read_bytes , block_fs->data_stream , __func__);
+      //file_node_verify_end_tag( file_node , block_fs->data_stream );
+      pthread_mutex_unlock( &block_fs->io_lock );
+    }
   }
 }
 
@@ -1419,7 +2536,7 @@ static void block_fs_fread__(block_fs_type * block_fs , const file_node_type * f
 void block_fs_fread_realloc_buffer( block_fs_type * block_fs , const char * filename , buffer_type * buffer) {
   block_fs_aquire_rlock( block_fs );
   {
-    file_node_type * node = hash_get( block_fs->index , filename);
+    file_node_type * node = block_fs_get_node( block_fs , filename );
     
     buffer_clear( buffer );   /* Setting: content_size = 0; pos = 0;  */
     {
@@ -1437,11 +2554,16 @@ void block_fs_fread_realloc_buffer( block_fs_type * block_fs , const char * file
 #endif
 
       {
-        pthread_mutex_lock( &block_fs->io_lock );
-        block_fs_fseek_node_data(block_fs , node );
-        buffer_stream_fread( buffer , node->data_size , block_fs->data_stream );
-        //file_node_verify_end_tag( node , block_fs->data_stream );
-        pthread_mutex_unlock( &block_fs->io_lock );
+        const char * mapped_data = block_fs_get_mapped_data( block_fs , node );
+        if (mapped_data != NULL)
+          buffer_fwrite( buffer , mapped_data , 1 , node->data_size );
+        else {
+          pthread_mutex_lock( &block_fs->io_lock );
+          block_fs_fseek_node_data(block_fs , node );
+          buffer_stream_fread( buffer , node->data_size , block_fs->data_stream );
+          //file_node_verify_end_tag( node , block_fs->data_stream );
+          pthread_mutex_unlock( &block_fs->io_lock );
+        }
       }
       
     }
@@ -1467,7 +2589,7 @@ void block_fs_fread_realloc_buffer( block_fs_type * block_fs , const char * file
 void block_fs_fread_file( block_fs_type * block_fs , const char * filename , void * ptr) {
   block_fs_aquire_rlock( block_fs );
   {
-    file_node_type * node = hash_get( block_fs->index , filename);
+    file_node_type * node = block_fs_get_node( block_fs , filename );
     block_fs_fread__( block_fs , node , ptr , node->data_size);
   }
   block_fs_release_rwlock( block_fs );
@@ -1479,7 +2601,7 @@ int block_fs_get_filesize( block_fs_type * block_fs , const char * filename) {
   int data_size;
   block_fs_aquire_rlock( block_fs );
   {
-    file_node_type * node = hash_get( block_fs->index , filename );
+    file_node_type * node = block_fs_get_node( block_fs , filename );
     data_size = node->data_size;
   }
   block_fs_release_rwlock( block_fs );
@@ -1487,45 +2609,88 @@ int block_fs_get_filesize( block_fs_type * block_fs , const char * filename) {
 }
 
 
+/**
+   Writes the index in the HASH_INDEX_FORMAT_VERSION format. If the
+   index was loaded from disk, and the filesystem has not been
+   modified, the index file on disk is still valid and nothing is
+   written.
+*/
+
 static void block_fs_dump_index( block_fs_type * block_fs ) {
-  if (block_fs->data_owner) {
+  if (block_fs->data_owner && block_fs->index_dirty) {
     struct stat stat_buffer;
     int stat_return = stat(block_fs->data_file , &stat_buffer);
     if (stat_return != 0)
       return;
-    {
-      time_t data_mtime = stat_buffer.st_mtime;
-      FILE * index_stream = util_fopen( block_fs->index_file , "w");
-      util_fwrite_int( INDEX_MAGIC_INT , index_stream );
-      util_fwrite_int( INDEX_FORMAT_VERSION , index_stream );
-      util_fwrite_time_t( data_mtime , index_stream );
 
-      /* 1: Dumping the hash table of active nodes. */
+    block_fs_load_disk_index( block_fs );
+    {
+      index_header_type header;
+      char * index;
+      size_t index_size;
+      buffer_type * keys = buffer_alloc( 1024 );
+      vector_type * free_nodes = block_fs_alloc_free_file_nodes( block_fs );
+
+      header.id             = INDEX_MAGIC_INT;
+      header.version        = HASH_INDEX_FORMAT_VERSION;
+      header.data_mtime     = stat_buffer.st_mtime;
+      header.data_file_size = block_fs->data_file_size;
+      header.num_active     = hash_get_size( block_fs->index );
+      header.num_free       = vector_get_size( free_nodes );
+      header.num_slots      = 64;
+      while (header.num_slots < 2 * header.num_active)
+        header.num_slots *= 2;
+
+      /* The key table is appended when the size is known. */
+      index_size = INDEX_HEADER_SIZE + (size_t) (header.num_slots + header.num_free) * INDEX_SLOT_SIZE;
+      index = util_malloc( index_size );
+      memset( index , 0 , index_size );   /* status == 0 => empty slot. */
+
+      /* 1: The hash table of active nodes. */
       {
+        unsigned mask = header.num_slots - 1;
         hash_iter_type * index_iter = hash_iter_alloc( block_fs->index );
-        
-        util_fwrite_int( hash_get_size( block_fs->index ) , index_stream);
         while (!hash_iter_is_complete( index_iter )) {
           const char * key = hash_iter_get_next_key( index_iter );
           const file_node_type * file_node = hash_get( block_fs->index , key );
-          
-          util_fwrite_string( key , index_stream);
-          file_node_dump_index( file_node , index_stream );
+          index_slot_type slot;
+          unsigned islot;
+
+          file_node_dump_slot( file_node , &slot );
+          slot.key_hash   = index_key_hash( key );
+          slot.key_offset = buffer_get_size( keys );
+          buffer_fwrite( keys , key , 1 , strlen( key ) + 1 );
+
+          islot = slot.key_hash & mask;
+          while (index_get_int32( &index[ INDEX_HEADER_SIZE + (size_t) islot * INDEX_SLOT_SIZE + INDEX_STATUS_OFFSET ]) != 0)
+            islot = (islot + 1) & mask;
+
+          index_slot_encode( &slot , &index[ INDEX_HEADER_SIZE + (size_t) islot * INDEX_SLOT_SIZE ] );
         }
         hash_iter_free( index_iter );
       }
-      
-      /* 2: Dumping information about empty slots in the datafile. */
-      util_fwrite_int( block_fs->num_free_nodes , index_stream );
+
+      /* 2: The empty slots in the datafile. */
+      for (int ifree = 0; ifree < header.num_free; ifree++) {
+        index_slot_type slot;
+        file_node_dump_slot( vector_iget_const( free_nodes , ifree ) , &slot );
+        slot.key_hash   = 0;
+        slot.key_offset = 0;
+        index_slot_encode( &slot , &index[ INDEX_HEADER_SIZE + (size_t) (header.num_slots + ifree) * INDEX_SLOT_SIZE ] );
+      }
+      vector_free( free_nodes );
+
+      header.key_size = buffer_get_size( keys );
+      index_header_encode( &header , index );
       {
-        free_node_type * current = block_fs->free_nodes;
-        while ( current != NULL) {
-          file_node_dump_index( current->file_node , index_stream );
-          current = current->next;
-        }
+        FILE * index_stream = util_fopen( block_fs->index_file , "w");
+        util_fwrite( index , 1 , index_size , index_stream , __func__ );
+        util_fwrite( buffer_get_data( keys ) , 1 , header.key_size , index_stream , __func__ );
+        fclose( index_stream );
       }
-      
-      fclose( index_stream );
+
+      free( index );
+      buffer_free( keys );
     }
   }
 }
@@ -1545,6 +2710,8 @@ void block_fs_close( block_fs_type * block_fs , bool unlink_empty) {
   if (block_fs->data_owner) 
     block_fs_aquire_wlock( block_fs );
 
+  block_fs_compact_abort__( block_fs );
+  block_fs_unmap_data( block_fs );
   if (block_fs->data_stream != NULL) 
     fclose( block_fs->data_stream );
 
@@ -1557,7 +2724,7 @@ void block_fs_close( block_fs_type * block_fs , bool unlink_empty) {
   }
 
   if (block_fs->data_owner) {
-    if ( unlink_empty && (hash_get_size( block_fs->index) == 0)) {
+    if ( unlink_empty && (block_fs_get_num_files__( block_fs ) == 0)) {
       util_unlink_existing( block_fs->data_file );
       util_unlink_existing( block_fs->index_file );
       util_unlink_existing( block_fs->mount_file );
@@ -1572,7 +2739,9 @@ void block_fs_close( block_fs_type * block_fs , bool unlink_empty) {
   free( block_fs->path );
   free( block_fs->mount_file );
   
-  free_node_free_list( block_fs->free_nodes );
+  block_fs_free_free_lists( block_fs );
+  block_fs_free_disk_index( block_fs );
+  hash_free( block_fs->free_index );
   hash_free( block_fs->index );
   vector_free( block_fs->file_nodes );
   free( block_fs );
@@ -1582,6 +2751,317 @@ void block_fs_close( block_fs_type * block_fs , bool unlink_empty) {
 
 
 
+/*****************************************************************/
+/* Online compaction */
+
+/**
+   Online compaction copies the live nodes over to the data file of
+   the next version, in the same way as block_fs_rotate__(), but the
+   copying is split in slices of bounded size:
+
+     1. block_fs_compact_begin() records the files currently present
+        and creates the new data file (write lock).
+
+     2. block_fs_compact_step() copies files until approximately
+        max_bytes of data have been copied. The step only holds the
+        read lock, i.e. other threads can read from the filesystem
+        while copying; between the steps the filesystem can also be
+        written to.
+
+     3. block_fs_compact_finish() copies the remaining files, along
+        with all files which have been written or unlinked since the
+        compaction started, and then swaps in the new data file by
+        updating the version number in the mount file (write lock).
+
+   If the application goes down before the mount file has been
+   updated the filesystem will just continue to use the old data
+   file.
+*/
+
+static void compact_state_free( compact_state_type * state , bool unlink_data ) {
+  if (state->data_stream != NULL)
+    fclose( state->data_stream );
+
+  if (unlink_data)
+    unlink( state->data_file );
+
+  free( state->data_file );
+  util_safe_free( state->copy_buffer );
+  if (state->index != NULL)
+    hash_free( state->index );
+  if (state->file_nodes != NULL)
+    vector_free( state->file_nodes );
+  vector_free( state->free_nodes );
+  stringlist_free( state->keys );
+  hash_free( state->dirty );
+  pthread_mutex_destroy( &state->lock );
+  free( state );
+}
+
+
+static void block_fs_compact_abort__( block_fs_type * block_fs ) {
+  if (block_fs->compact != NULL) {
+    compact_state_free( block_fs->compact , true );
+    block_fs->compact = NULL;
+  }
+}
+
+
+static void compact_state_free_node( compact_state_type * state , file_node_type * node ) {
+  node->status      = NODE_FREE;
+  node->data_offset = 0;
+  node->data_size   = 0;
+  file_node_fwrite( node , NULL , state->data_stream );
+  vector_append_ref( state->free_nodes , node );
+}
+
+
+/**
+   Copies the current content of filename to the new data file, and
+   returns the number of bytes copied. If the file has already been
+   copied the existing node in the new data file is reused if it is
+   large enough.
+*/
+
+static size_t block_fs_compact_copy_node( block_fs_type * block_fs , compact_state_type * state , const char * filename ) {
+  const file_node_type * old_node = hash_get( block_fs->index , filename );
+  file_node_type * new_node = NULL;
+  size_t min_size = old_node->data_size + file_node_header_size( filename );
+
+  if (hash_has_key( state->index , filename )) {
+    new_node = hash_get( state->index , filename );
+    if (new_node->node_size < min_size) {
+      compact_state_free_node( state , new_node );
+      hash_del( state->index , filename );
+      new_node = NULL;
+    }
+  }
+
+  if (new_node == NULL) {
+    div_t d   = div( min_size , block_fs->block_size );
+    int node_size = d.quot * block_fs->block_size;
+    if (d.rem)
+      node_size += block_fs->block_size;
+
+    new_node = file_node_alloc( NODE_IN_USE , state->data_file_size , node_size );
+    vector_append_owned_ref( state->file_nodes , new_node , file_node_free__ );
+    hash_insert_ref( state->index , filename , new_node );
+    state->data_file_size += node_size;
+  }
+
+  if (state->copy_buffer_size < old_node->data_size) {
+    state->copy_buffer_size = old_node->data_size;
+    state->copy_buffer = util_realloc( state->copy_buffer , state->copy_buffer_size );
+  }
+  block_fs_fread__( block_fs , old_node , state->copy_buffer , old_node->data_size );
+
+  new_node->status    = NODE_IN_USE;
+  new_node->data_size = old_node->data_size;
+  file_node_set_data_offset( new_node , filename );
+  fseek__( state->data_stream , new_node->node_offset + new_node->data_offset , SEEK_SET );
+  util_fwrite( state->copy_buffer , 1 , new_node->data_size , state->data_stream , __func__ );
+  file_node_fwrite( new_node , filename , state->data_stream );
+
+  return new_node->data_size;
+}
+
+
+/**
+   Will start an online compaction; returns false if the filesystem is
+   read-only, or if a compaction is already running.
+*/
+
+bool block_fs_compact_begin( block_fs_type * block_fs ) {
+  if (!block_fs->data_owner)
+    return false;
+
+  block_fs_aquire_wlock( block_fs );
+  if (block_fs->compact != NULL) {
+    block_fs_release_rwlock( block_fs );
+    return false;
+  }
+
+  block_fs_load_disk_index( block_fs );
+  {
+    compact_state_type * state = util_malloc( sizeof * state );
+    char * data_ext = util_alloc_sprintf("data_%d" , block_fs->version + 1);
+
+    state->version          = block_fs->version + 1;
+    state->data_file        = util_alloc_filename( block_fs->path , block_fs->base_name , data_ext );
+    state->data_stream      = util_fopen( state->data_file , "w+");
+    state->data_file_size   = 0;
+    state->index            = hash_alloc_unlocked();
+    state->file_nodes       = vector_alloc_new();
+    state->free_nodes       = vector_alloc_new();
+    state->keys             = hash_alloc_stringlist( block_fs->index );
+    state->next_key         = 0;
+    state->dirty            = hash_alloc_unlocked();
+    state->copy_buffer      = NULL;
+    state->copy_buffer_size = 0;
+    pthread_mutex_init( &state->lock , NULL );
+
+    block_fs->compact = state;
+    free( data_ext );
+  }
+  block_fs_release_rwlock( block_fs );
+  return true;
+}
+
+
+bool block_fs_is_compacting( const block_fs_type * block_fs ) {
+  return (block_fs->compact != NULL);
+}
+
+
+/**
+   Copies files to the new data file until max_bytes of data have been
+   copied. Returns true when all the files present at the start of the
+   compaction have been visited, and the compaction is ready to be
+   finished.
+*/
+
+bool block_fs_compact_step( block_fs_type * block_fs , size_t max_bytes) {
+  bool complete = true;
+  block_fs_aquire_rlock( block_fs );
+  {
+    compact_state_type * state = block_fs->compact;
+    if (state != NULL) {
+      size_t copied = 0;
+
+      pthread_mutex_lock( &state->lock );
+      while ((state->next_key < stringlist_get_size( state->keys )) && (copied < max_bytes)) {
+        const char * filename = stringlist_iget( state->keys , state->next_key );
+
+        /* Files which have been modified will be handled in block_fs_compact_finish(). */
+        if (!hash_has_key( state->dirty , filename ))
+          copied += block_fs_compact_copy_node( block_fs , state , filename );
+
+        state->next_key++;
+      }
+      complete = (state->next_key == stringlist_get_size( state->keys ));
+      pthread_mutex_unlock( &state->lock );
+    }
+  }
+  block_fs_release_rwlock( block_fs );
+  return complete;
+}
+
+
+static void block_fs_compact_finish__( block_fs_type * block_fs ) {
+  compact_state_type * state = block_fs->compact;
+
+  /* 1: Copy the files which remain, and refresh the modified files. */
+  for (; state->next_key < stringlist_get_size( state->keys ); state->next_key++) {
+    const char * filename = stringlist_iget( state->keys , state->next_key );
+    if (!hash_has_key( state->dirty , filename ))
+      block_fs_compact_copy_node( block_fs , state , filename );
+  }
+
+  {
+    hash_iter_type * iter = hash_iter_alloc( state->dirty );
+    while (!hash_iter_is_complete( iter )) {
+      const char * filename = hash_iter_get_next_key( iter );
+      if (hash_has_key( block_fs->index , filename ))
+        block_fs_compact_copy_node( block_fs , state , filename );
+      else if (hash_has_key( state->index , filename )) {
+        compact_state_free_node( state , hash_get( state->index , filename ));
+        hash_del( state->index , filename );
+      }
+    }
+    hash_iter_free( iter );
+  }
+
+  /* 2: Make sure the new data file is complete on disk before it is referenced from the mount file. */
+  fflush( state->data_stream );
+  fsync( fileno( state->data_stream ));
+  block_fs_fwrite_mount_info__( block_fs->mount_file , state->version );
+
+  /* 3: Discard the old data file, and install the new. */
+  {
+    char * old_data_file = util_alloc_string_copy( block_fs->data_file );
+    char * old_lock_file = util_alloc_string_copy( block_fs->lock_file );
+
+    block_fs_unmap_data( block_fs );
+    fclose( block_fs->data_stream );
+    block_fs_free_free_lists( block_fs );
+    hash_free( block_fs->index );
+    vector_free( block_fs->file_nodes );
+
+    block_fs->version          = state->version;
+    block_fs->index            = state->index;
+    block_fs->file_nodes       = state->file_nodes;
+    block_fs->data_file_size   = state->data_file_size;
+    block_fs->data_stream      = state->data_stream;
+    block_fs->data_fd          = fileno( block_fs->data_stream );
+    block_fs->total_cache_size = 0;
+    block_fs->index_dirty      = true;
+    for (int i = 0; i < vector_get_size( state->free_nodes ); i++)
+      block_fs_insert_free_node( block_fs , vector_iget( state->free_nodes , i ));
+
+    state->index       = NULL;
+    state->file_nodes  = NULL;
+    state->data_stream = NULL;
+
+    block_fs_set_filenames( block_fs );
+    block_fs_map_data( block_fs );
+
+    unlink( old_data_file );
+    /* The lock is held on the open file descriptor; it follows the lock file when renamed. */
+    if (util_file_exists( old_lock_file ))
+      rename( old_lock_file , block_fs->lock_file );
+
+    free( old_data_file );
+    free( old_lock_file );
+  }
+
+  compact_state_free( state , false );
+  block_fs->compact = NULL;
+}
+
+
+/**
+   Finishes a compaction started with block_fs_compact_begin(); this
+   can be called before block_fs_compact_step() has returned true, in
+   which case the remaining files are copied while holding the write
+   lock.
+*/
+
+void block_fs_compact_finish( block_fs_type * block_fs ) {
+  block_fs_aquire_wlock( block_fs );
+  if (block_fs->compact != NULL)
+    block_fs_compact_finish__( block_fs );
+  block_fs_release_rwlock( block_fs );
+}
+
+
+/**
+   Runs a complete online compaction if the fragmentation is above
+   fragmentation_limit, copying at most slice_size bytes between each
+   time the locks are released. Returns true if the filesystem was
+   compacted.
+*/
+
+bool block_fs_compact( block_fs_type * block_fs , double fragmentation_limit , size_t slice_size) {
+  if (!block_fs->data_owner)
+    return false;
+
+  if (!(block_fs_get_fragmentation( block_fs ) > fragmentation_limit))
+    return false;
+
+  if (!block_fs_compact_begin( block_fs ))
+    return false;
+
+  while (!block_fs_compact_step( block_fs , slice_size ))
+    ;
+
+  block_fs_compact_finish( block_fs );
+  return true;
+}
+
+
+
+
+
 /**
    This function will 'rotate' the datafile to a new version which has
    been defragmented, i.e. with no 'holes' in it. In the process the
@@ -1593,6 +3073,8 @@ void block_fs_close( block_fs_type * block_fs , bool unlink_empty) {
 */
 
 static void block_fs_rotate__( block_fs_type * block_fs ) {
+  block_fs_compact_abort__( block_fs );
+  block_fs_load_disk_index( block_fs );
   /* 
      Write a updated mount map where the version info has been bumped
      up with one; the new_fs will mount based on this mount_file.
@@ -1603,16 +3085,18 @@ static void block_fs_rotate__( block_fs_type * block_fs ) {
     vector_type    * old_nodes         = block_fs->file_nodes;
     hash_type      * old_index         = block_fs->index;
     FILE           * old_data_stream   = block_fs->data_stream;
-    free_node_type * old_free_nodes    = block_fs->free_nodes;
     char           * old_data_file     = util_alloc_string_copy( block_fs->data_file );
     char           * old_lock_file     = util_alloc_string_copy( block_fs->lock_file );
 
+    block_fs_unmap_data( block_fs );
+    block_fs_free_free_lists( block_fs );     /* The free nodes in the old file are not needed. */
     block_fs_reinit( block_fs );
     /** 
         Now the block_fs pointers point to the new copy. Must use the
         old_xxx pointers to access the existing.
     */
     block_fs_open_data( block_fs , block_fs->data_owner );
+    block_fs_map_data( block_fs );
     {
       hash_iter_type * iter = hash_iter_alloc( old_index );
       buffer_type * buffer  = buffer_alloc(1024);
@@ -1638,8 +3122,7 @@ static void block_fs_rotate__( block_fs_type * block_fs ) {
         1. Close the old data stream.
         2. Unlink the old lockfile.
         3. Delete the old data file.
-        4. Delete the old list of free nodes.
-        5. free()
+        4. free()
 
     */
     fclose( old_data_stream );
@@ -1648,7 +3131,6 @@ static void block_fs_rotate__( block_fs_type * block_fs ) {
     free( old_lock_file );
     free( old_data_file );
     
-    free_node_free_list( old_free_nodes );
     hash_free( old_index );
     vector_free( old_nodes );
   }
@@ -1772,7 +3254,13 @@ vector_type * block_fs_alloc_filelist( block_fs_type * block_fs  , const char *
   /* Inserting the nodes from the index. */
   block_fs_aquire_rlock( block_fs );
   {
-    hash_iter_type * iter        = hash_iter_alloc( block_fs->index );
+    hash_iter_type * iter;
+
+    pthread_mutex_lock( &block_fs->index_lock );
+    block_fs_load_disk_index( block_fs );
+    pthread_mutex_unlock( &block_fs->index_lock );
+
+    iter = hash_iter_alloc( block_fs->index );
     while ( !hash_iter_is_complete( iter )) {
       const char * key            = hash_iter_get_next_key( iter );
       file_node_type * node = hash_get( block_fs->index , key );
@@ -1790,12 +3278,12 @@ vector_type * block_fs_alloc_filelist( block_fs_type * block_fs  , const char *
   
   /* Inserting the free nodes - the holes. */
   if (include_free_nodes) {
-    free_node_type * current = block_fs->free_nodes;
-    while (current != NULL) {
-      user_file_node_type * unode = user_file_node_alloc( NULL , current->file_node );
+    vector_type * free_nodes = block_fs_alloc_free_file_nodes( block_fs );
+    for (int i = 0; i < vector_get_size( free_nodes ); i++) {
+      user_file_node_type * unode = user_file_node_alloc( NULL , vector_iget_const( free_nodes , i ));
       vector_append_owned_ref( sort_vector , unode , user_file_node_free__ );
-      current = current->next;
     }
+    vector_free( free_nodes );
   }
 
   switch( sort_mode ) {
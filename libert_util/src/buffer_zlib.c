@@ -19,29 +19,49 @@ static size_t __compress_bound (size_t sourceLen)
 
 
 /**
+   Compresses byte_size bytes from ptr into the buffer with zlib
+   compression level 'level'; in the range [1,9] or
+   Z_DEFAULT_COMPRESSION. Level 1 is several times faster than the
+   default level, with a modest loss of compression.
+
    Return value is the size (in bytes) of the compressed buffer.
 */
-size_t buffer_fwrite_compressed(buffer_type * buffer, const void * ptr , size_t byte_size) {
+size_t buffer_fwrite_compressed_level(buffer_type * buffer, const void * ptr , size_t byte_size , int level) {
   size_t compressed_size = 0;
   bool abort_on_error    = true;
   buffer->content_size   = buffer->pos;   /* Invalidating possible buffer content coming after the compressed content; that is uninterpretable anyway. */
 
   if (byte_size > 0) {
     size_t remaining_size = buffer->alloc_size - buffer->pos;
-    size_t compress_bound = __compress_bound( byte_size );  
+    size_t compress_bound = __compress_bound( byte_size );
+    uLongf zlib_size;
+    int compress_result;
+
     if (compress_bound > remaining_size)
-      buffer_resize__(buffer , remaining_size + compress_bound , abort_on_error); 
-    
-    compressed_size = buffer->alloc_size - buffer->pos;
-    util_compress_buffer( ptr , byte_size , &buffer->data[buffer->pos] , &compressed_size);
+      buffer_resize__(buffer , remaining_size + compress_bound , abort_on_error);
+
+    zlib_size = buffer->alloc_size - buffer->pos;
+    compress_result = compress2( (Bytef *) &buffer->data[buffer->pos] , &zlib_size , ptr , byte_size , level );
+    if (compress_result != Z_OK)
+      util_abort("%s: compress2() failed with error:%d \n",__func__ , compress_result);
+
+    compressed_size       = zlib_size;
     buffer->pos          += compressed_size;
     buffer->content_size += compressed_size;
   }
-  
+
   return compressed_size;
 }
 
 
+/**
+   Return value is the size (in bytes) of the compressed buffer.
+*/
+size_t buffer_fwrite_compressed(buffer_type * buffer, const void * ptr , size_t byte_size) {
+  return buffer_fwrite_compressed_level( buffer , ptr , byte_size , Z_DEFAULT_COMPRESSION );
+}
+
+
 /**
    Return value is the size of the uncompressed buffer.
 */
@@ -24,9 +24,9 @@
 
 #include <ert/util/ert_api_config.h>
 #include <ert/util/thread_pool.h>
+#include <ert/util/parallel_for.h>
 #include <ert/util/util.h>
 #include <ert/util/matrix.h>
-#include <ert/util/arg_pack.h>
 #include <ert/util/rng.h>
 
 /**
@@ -1095,18 +1095,17 @@ void matrix_inplace_matmul(matrix_type * A, const matrix_type * B) {
 
 #ifdef ERT_HAVE_THREAD_POOL
 
-static void * matrix_inplace_matmul_mt__(void * arg) {
+typedef struct {
+  matrix_type       * A;
+  const matrix_type * B;
+} matmul_range_arg_type;
 
-  arg_pack_type * arg_pack = arg_pack_safe_cast( arg );
-  int row_offset         = arg_pack_iget_int( arg_pack , 0 );
-  int rows               = arg_pack_iget_int( arg_pack , 1 );
-  matrix_type * A        = arg_pack_iget_ptr( arg_pack , 2 );
-  const matrix_type * B  = arg_pack_iget_const_ptr( arg_pack , 3 );
 
-  matrix_type * A_view = matrix_alloc_shared( A , row_offset , 0 , rows , matrix_get_columns( A ));
-  matrix_inplace_matmul( A_view , B );
+static void matrix_inplace_matmul_mt__(int row_begin , int row_end , void * arg) {
+  matmul_range_arg_type * range_arg = arg;
+  matrix_type * A_view = matrix_alloc_shared( range_arg->A , row_begin , 0 , row_end - row_begin , matrix_get_columns( range_arg->A ));
+  matrix_inplace_matmul( A_view , range_arg->B );
   matrix_free( A_view );
-  return NULL;
 }
 
 /**
@@ -1122,39 +1121,18 @@ static void * matrix_inplace_matmul_mt__(void * arg) {
 
    If the thread_pool has not been correctly prepared, according to
    this specification, it will be crash and burn.
+
+   The rows of A are distributed with parallel_for() in blocks of
+   roughly 1/4 of an even split, so that threads which finish early
+   can steal rows from the slower threads.
 */
 
 void matrix_inplace_matmul_mt2(matrix_type * A, const matrix_type * B , thread_pool_type * thread_pool){
-  int num_threads  = thread_pool_get_max_running( thread_pool );
-  arg_pack_type    ** arglist = util_malloc( num_threads * sizeof * arglist );
-  int it;
-  thread_pool_restart( thread_pool );
-  {
-    int rows       = matrix_get_rows( A ) / num_threads;
-    int rows_mod   = matrix_get_rows( A ) % num_threads;
-    int row_offset = 0;
-
-    for (it = 0; it < num_threads; it++) {
-      int row_size;
-      arglist[it] = arg_pack_alloc();
-      row_size = rows;
-      if (it < rows_mod)
-        row_size += 1;
-
-      arg_pack_append_int(arglist[it] , row_offset );
-      arg_pack_append_int(arglist[it] , row_size   );
-      arg_pack_append_ptr(arglist[it] , A );
-      arg_pack_append_const_ptr(arglist[it] , B );
-
-      thread_pool_add_job( thread_pool , matrix_inplace_matmul_mt__ , arglist[it]);
-      row_offset += row_size;
-    }
-  }
-  thread_pool_join( thread_pool );
+  int num_threads = util_int_max( 1 , thread_pool_get_max_running( thread_pool ));
+  int grain       = util_int_max( 1 , matrix_get_rows( A ) / (4 * num_threads));
+  matmul_range_arg_type range_arg = { .A = A , .B = B };
 
-  for (it = 0; it < num_threads; it++)
-    arg_pack_free( arglist[it] );
-  free( arglist );
+  parallel_for( thread_pool , 0 , matrix_get_rows( A ) , grain , matrix_inplace_matmul_mt__ , &range_arg );
 }
 
 void matrix_inplace_matmul_mt1(matrix_type * A, const matrix_type * B , int num_threads){
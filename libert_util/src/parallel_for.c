@@ -0,0 +1,388 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'parallel_for.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#define  _GNU_SOURCE
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include <ert/util/util.h>
+#include <ert/util/type_macros.h>
+#include <ert/util/thread_pool.h>
+#include <ert/util/parallel_for.h>
+
+
+/**
+   This file implements a parallel for loop over an integer range on
+   top of the thread_pool:
+
+      parallel_for( tp , begin , end , grain , func , arg );
+
+   will call func( b , e , arg ) for consecutive subranges [b,e) of
+   [begin,end) until the whole range has been covered; each subrange
+   has at most grain elements.
+
+   The range is initially split in one contiguous part for each of
+   the threads in the thread pool. Each thread consumes its own part
+   from the front, in chunks of grain elements. When a thread has
+   exhausted its own part it steals the upper half of the remaining
+   range from the thread with most work left. That way a thread which
+   gets the expensive elements does not become a straggler, while the
+   elements handled by one thread are still mostly contiguous.
+
+   The thread pool must be in the same state as for
+   matrix_inplace_matmul_mt2(), i.e. newly allocated with
+   start_queue == false, or joined. The parallel_for() function will
+   restart and join the thread pool.
+
+   The parallel_for_timed() variant will also record how much time
+   each of the threads has spent in func(), how many tasks (calls to
+   func) each thread has run and how many times it has stolen work;
+   that can be used to measure load imbalance.
+*/
+
+
+#define PARALLEL_FOR_STATS_TYPE_ID 77651903
+
+struct parallel_for_stats_struct {
+  UTIL_TYPE_ID_DECLARATION;
+  int       num_threads;
+  double    wall_time;
+  double  * busy_time;      /* Total time spent in func() for each thread. */
+  double  * max_task_time;  /* The longest single call to func() for each thread. */
+  int     * num_tasks;
+  int     * num_steals;
+};
+
+
+typedef struct {
+  pthread_mutex_t           lock;
+  int                       begin;        /* The remaining range owned by this thread is [begin,end). */
+  int                       end;
+  double                    busy_time;
+  double                    max_task_time;
+  int                       num_tasks;
+  int                       num_steals;
+} parallel_for_range_type;
+
+
+typedef struct {
+  parallel_for_range_type * ranges;
+  int                       num_threads;
+  int                       grain;
+  parallel_for_ftype      * func;
+  void                    * arg;
+} parallel_for_context_type;
+
+
+typedef struct {
+  parallel_for_context_type * context;
+  int                         thread;
+} parallel_for_worker_type;
+
+
+static double parallel_for_now( ) {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC , &ts );
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+
+/**
+   Takes the next chunk of at most grain elements from the front of
+   the range; returns false if the range is empty.
+*/
+
+static bool parallel_for_range_pop( parallel_for_range_type * range , int grain , int * begin , int * end) {
+  bool found = false;
+  pthread_mutex_lock( &range->lock );
+  if (range->begin < range->end) {
+    *begin = range->begin;
+    *end   = util_int_min( range->begin + grain , range->end );
+    range->begin = *end;
+    found = true;
+  }
+  pthread_mutex_unlock( &range->lock );
+  return found;
+}
+
+
+static int parallel_for_range_remaining( parallel_for_range_type * range ) {
+  int remaining;
+  pthread_mutex_lock( &range->lock );
+  remaining = range->end - range->begin;
+  pthread_mutex_unlock( &range->lock );
+  return remaining;
+}
+
+
+/**
+   Steals the upper half of the remaining range of the thread with
+   most work left, and installs it as the range of @thread. Returns
+   false when there is no more work to steal.
+*/
+
+static bool parallel_for_steal( parallel_for_context_type * context , int thread ) {
+  while (true) {
+    int victim = -1;
+    int max_remaining = 0;
+
+    /*
+      The sizes can change as soon as the lock is released, so the
+      victim is only a hint; the steal itself is done with the lock of
+      the victim held.
+    */
+    for (int i = 1; i < context->num_threads; i++) {
+      int other = (thread + i) % context->num_threads;
+      int remaining = parallel_for_range_remaining( &context->ranges[other] );
+      if (remaining > max_remaining) {
+        max_remaining = remaining;
+        victim = other;
+      }
+    }
+
+    if (victim < 0)
+      return false;
+
+    {
+      parallel_for_range_type * victim_range = &context->ranges[victim];
+      int begin = 0;
+      int end = 0;
+
+      pthread_mutex_lock( &victim_range->lock );
+      {
+        int remaining = victim_range->end - victim_range->begin;
+        if (remaining > 0) {
+          end   = victim_range->end;
+          begin = victim_range->begin + remaining / 2;
+          victim_range->end = begin;
+        }
+      }
+      pthread_mutex_unlock( &victim_range->lock );
+
+      if (end > begin) {
+        parallel_for_range_type * range = &context->ranges[thread];
+        pthread_mutex_lock( &range->lock );
+        range->begin = begin;
+        range->end   = end;
+        range->num_steals++;
+        pthread_mutex_unlock( &range->lock );
+        return true;
+      }
+    }
+    /* Somebody else emptied the victim before we got the lock - try again. */
+  }
+}
+
+
+static void * parallel_for_worker( void * arg ) {
+  parallel_for_worker_type * worker   = arg;
+  parallel_for_context_type * context = worker->context;
+  parallel_for_range_type * range     = &context->ranges[ worker->thread ];
+
+  do {
+    int begin , end;
+    while (parallel_for_range_pop( range , context->grain , &begin , &end )) {
+      double start = parallel_for_now( );
+      double task_time;
+
+      context->func( begin , end , context->arg );
+
+      task_time = parallel_for_now( ) - start;
+      range->busy_time += task_time;
+      range->max_task_time = util_double_max( range->max_task_time , task_time );
+      range->num_tasks++;
+    }
+  } while (parallel_for_steal( context , worker->thread ));
+
+  return NULL;
+}
+
+
+static void parallel_for_stats_resize( parallel_for_stats_type * stats , int num_threads ) {
+  if (num_threads > stats->num_threads) {
+    stats->busy_time     = util_realloc( stats->busy_time     , num_threads * sizeof * stats->busy_time );
+    stats->max_task_time = util_realloc( stats->max_task_time , num_threads * sizeof * stats->max_task_time );
+    stats->num_tasks     = util_realloc( stats->num_tasks     , num_threads * sizeof * stats->num_tasks );
+    stats->num_steals    = util_realloc( stats->num_steals    , num_threads * sizeof * stats->num_steals );
+    for (int i = stats->num_threads; i < num_threads; i++) {
+      stats->busy_time[i]     = 0;
+      stats->max_task_time[i] = 0;
+      stats->num_tasks[i]     = 0;
+      stats->num_steals[i]    = 0;
+    }
+    stats->num_threads = num_threads;
+  }
+}
+
+
+static void parallel_for_stats_add( parallel_for_stats_type * stats , const parallel_for_context_type * context , double wall_time) {
+  parallel_for_stats_resize( stats , context->num_threads );
+  stats->wall_time += wall_time;
+  for (int i = 0; i < context->num_threads; i++) {
+    const parallel_for_range_type * range = &context->ranges[i];
+    stats->busy_time[i]     += range->busy_time;
+    stats->max_task_time[i]  = util_double_max( stats->max_task_time[i] , range->max_task_time );
+    stats->num_tasks[i]     += range->num_tasks;
+    stats->num_steals[i]    += range->num_steals;
+  }
+}
+
+
+void parallel_for_timed( thread_pool_type * tp , int begin , int end , int grain , parallel_for_ftype * func , void * arg , parallel_for_stats_type * stats) {
+  double start = parallel_for_now( );
+  parallel_for_context_type context;
+
+  context.num_threads = util_int_max( 1 , thread_pool_get_max_running( tp ));
+  context.grain       = util_int_max( 1 , grain );
+  context.func        = func;
+  context.arg         = arg;
+  context.ranges      = util_calloc( context.num_threads , sizeof * context.ranges );
+
+  {
+    int size   = util_int_max( 0 , end - begin );
+    int offset = begin;
+    for (int i = 0; i < context.num_threads; i++) {
+      parallel_for_range_type * range = &context.ranges[i];
+      int range_size = size / context.num_threads + ((i < size % context.num_threads) ? 1 : 0);
+
+      pthread_mutex_init( &range->lock , NULL );
+      range->begin         = offset;
+      range->end           = offset + range_size;
+      range->busy_time     = 0;
+      range->max_task_time = 0;
+      range->num_tasks     = 0;
+      range->num_steals    = 0;
+      offset += range_size;
+    }
+  }
+
+  {
+    parallel_for_worker_type * workers = util_calloc( context.num_threads , sizeof * workers );
+    thread_pool_restart( tp );
+    for (int i = 0; i < context.num_threads; i++) {
+      workers[i].context = &context;
+      workers[i].thread  = i;
+      thread_pool_add_job( tp , parallel_for_worker , &workers[i] );
+    }
+    thread_pool_join( tp );
+    free( workers );
+  }
+
+  if (stats != NULL)
+    parallel_for_stats_add( stats , &context , parallel_for_now( ) - start );
+
+  for (int i = 0; i < context.num_threads; i++)
+    pthread_mutex_destroy( &context.ranges[i].lock );
+  free( context.ranges );
+}
+
+
+void parallel_for( thread_pool_type * tp , int begin , int end , int grain , parallel_for_ftype * func , void * arg) {
+  parallel_for_timed( tp , begin , end , grain , func , arg , NULL );
+}
+
+/*****************************************************************/
+
+
+parallel_for_stats_type * parallel_for_stats_alloc( ) {
+  parallel_for_stats_type * stats = util_malloc( sizeof * stats );
+  UTIL_TYPE_ID_INIT( stats , PARALLEL_FOR_STATS_TYPE_ID );
+  stats->num_threads   = 0;
+  stats->wall_time     = 0;
+  stats->busy_time     = NULL;
+  stats->max_task_time = NULL;
+  stats->num_tasks     = NULL;
+  stats->num_steals    = NULL;
+  return stats;
+}
+
+
+void parallel_for_stats_free( parallel_for_stats_type * stats ) {
+  util_safe_free( stats->busy_time );
+  util_safe_free( stats->max_task_time );
+  util_safe_free( stats->num_tasks );
+  util_safe_free( stats->num_steals );
+  free( stats );
+}
+
+
+void parallel_for_stats_reset( parallel_for_stats_type * stats ) {
+  stats->wall_time = 0;
+  for (int i = 0; i < stats->num_threads; i++) {
+    stats->busy_time[i]     = 0;
+    stats->max_task_time[i] = 0;
+    stats->num_tasks[i]     = 0;
+    stats->num_steals[i]    = 0;
+  }
+}
+
+
+int parallel_for_stats_get_num_threads( const parallel_for_stats_type * stats ) {
+  return stats->num_threads;
+}
+
+double parallel_for_stats_get_wall_time( const parallel_for_stats_type * stats ) {
+  return stats->wall_time;
+}
+
+double parallel_for_stats_iget_busy_time( const parallel_for_stats_type * stats , int thread ) {
+  return stats->busy_time[thread];
+}
+
+double parallel_for_stats_iget_max_task_time( const parallel_for_stats_type * stats , int thread ) {
+  return stats->max_task_time[thread];
+}
+
+int parallel_for_stats_iget_num_tasks( const parallel_for_stats_type * stats , int thread ) {
+  return stats->num_tasks[thread];
+}
+
+int parallel_for_stats_iget_num_steals( const parallel_for_stats_type * stats , int thread ) {
+  return stats->num_steals[thread];
+}
+
+
+/**
+   The load imbalance is the ratio between the busy time of the most
+   loaded thread and the average busy time; 1.0 is perfect balance.
+*/
+
+double parallel_for_stats_get_imbalance( const parallel_for_stats_type * stats ) {
+  double max_busy = 0;
+  double sum_busy = 0;
+  for (int i = 0; i < stats->num_threads; i++) {
+    max_busy = util_double_max( max_busy , stats->busy_time[i] );
+    sum_busy += stats->busy_time[i];
+  }
+
+  if (sum_busy > 0)
+    return max_busy * stats->num_threads / sum_busy;
+  else
+    return 1.0;
+}
+
+
+void parallel_for_stats_fprintf( const parallel_for_stats_type * stats , FILE * stream ) {
+  fprintf(stream , "Thread      Busy time    Max task   Tasks  Steals\n");
+  for (int i = 0; i < stats->num_threads; i++)
+    fprintf(stream , "%6d  %11.4f  %11.4f  %6d  %6d\n" , i , stats->busy_time[i] , stats->max_task_time[i] , stats->num_tasks[i] , stats->num_steals[i]);
+  fprintf(stream , "Wall time: %.4f   Imbalance: %.3f\n" , stats->wall_time , parallel_for_stats_get_imbalance( stats ));
+}
@@ -20,7 +20,6 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
-#include <signal.h>
 #include <pthread.h>
 #include <unistd.h>
 
@@ -36,11 +35,13 @@
    pthread_create() function calls. The characetristics of this
    implementation is as follows:
 
-    1. The jobs are mangaged by a separate thread - dispatch_thread.
-    2. The new jobs are just appended to the queue, the
-       dispatch_thread sees them in the queue and dispatches them.
-    3. The dispatch thread manages a list of thread_pool_job_slot_type
-       instances - one slot for each actually running job.
+    1. A fixed set of max_running worker threads is started when the
+       pool is (re)started; the workers run until the pool is joined.
+    2. The new jobs are appended to the queue, and one idle worker is
+       woken up through the job_available condition variable.
+    3. The workers take the jobs from the queue in the order they
+       were added; a worker which finds the queue empty sleeps on
+       the condition variable - there is no polling.
 
    Example
    -------
@@ -100,9 +101,6 @@ typedef void * (start_func_ftype) (void *) ;
    Internal struct which is used as queue node.
 */
 typedef struct {
-  thread_pool_type * pool;                /* A back-reference to the thread_pool holding the queue. */
-  int                slot_index;          /* The index in the space [0,max_running) of the job slot where this job is running. */
-  int                queue_index;         /* The index of the current tp_arg in the queue. */
   void             * func_arg;            /* The arguments to this job - supplied by the calling scope. */
   start_func_ftype * func;                /* The function to call - supplied by the calling scope. */
   void             * return_value;
@@ -110,33 +108,24 @@ typedef struct {
 
 
 
-/**
-   Internal struct used to keep track of the job slots.
-*/
-typedef struct {
-  pthread_t  thread;                /* The thread variable currently (or more correct:last) running. */
-  int        run_count;             /* The number of times this slot has been used - just to check whether the slot has been used AT ALL when/if joining. */
-  bool       running;               /* Is the job_slot running now?? */
-} thread_pool_job_slot_type;
-
-
-
 
 #define THREAD_POOL_TYPE_ID 71443207
 struct thread_pool_struct {
   UTIL_TYPE_ID_DECLARATION;
   thread_pool_arg_type      * queue;              /* The jobs to be executed are appended in this vector. */
   int                         queue_index;        /* The index of the next job to run. */
-  int                         queue_size;         /* The number of jobs in the queue - including those which are complete. [Should be protected / atomic / ... ] */
+  int                         queue_size;         /* The number of jobs in the queue - including those which are complete. */
   int                         queue_alloc_size;   /* The allocated size of the queue. */
+  int                         num_complete;       /* The number of jobs which have run to completion. */
 
   int                         max_running;        /* The max number of concurrently running jobs. */
-  bool                        join;               /* Flag set by the main thread to inform the dispatch thread that joining should start. */
-  bool                        accepting_jobs;     /* True|False whether the dispatch thread is running. */
+  bool                        join;               /* Flag set by the main thread to inform the workers that they should exit when the queue is empty. */
+  bool                        accepting_jobs;     /* True|False whether the worker threads are running. */
 
-  thread_pool_job_slot_type * job_slots;          /* A vector to @max_running job slots, each slot can be reused several times.*/
-  pthread_t                   dispatch_thread;
-  pthread_rwlock_t            queue_lock;
+  pthread_t                 * workers;            /* The max_running worker threads. */
+  pthread_mutex_t             queue_mutex;        /* Protects all the fields above, after the pool has been started. */
+  pthread_cond_t              job_available;      /* Signalled when a job is added to the queue, and when join starts. */
+  pthread_cond_t              jobs_complete;      /* Signalled when the last job in the queue is complete. */
 };
 
 
@@ -145,36 +134,13 @@ static UTIL_SAFE_CAST_FUNCTION( thread_pool , THREAD_POOL_TYPE_ID )
 
 /**
    This function will grow the queue. It is called by the main thread
-   (i.e. the context of the calling scope), and the queue is read by
-   the dispatch_thread - i.e. access to the queue must be protected by
-   rwlock.
+   (i.e. the context of the calling scope) with the queue_mutex held;
+   the worker threads only access the queue when holding the mutex.
 */
 
 static void thread_pool_resize_queue( thread_pool_type * pool, int queue_length ) {
-  pthread_rwlock_wrlock( &pool->queue_lock );
-  {
-    pool->queue            = util_realloc( pool->queue , queue_length * sizeof * pool->queue );
-    pool->queue_alloc_size = queue_length;
-  }
-  pthread_rwlock_unlock( &pool->queue_lock );
-}
-
-
-/**
-   This function updates an element in the queue, the function is
-   called by the executing threads, on the same time the main thread
-   might be resizing the thread, we therefor take a read lock during
-   execution of this function. (Write lock is not necessary because we
-   will not change the queue pointer itself, only something it points
-   to.)
-*/
-
-static void thread_pool_iset_return_value( thread_pool_type * pool , int index , void * return_value) {
-  pthread_rwlock_rdlock( &pool->queue_lock );
-  {
-    pool->queue[ index ].return_value = return_value;
-  }
-  pthread_rwlock_unlock( &pool->queue_lock );
+  pool->queue            = util_realloc( pool->queue , queue_length * sizeof * pool->queue );
+  pool->queue_alloc_size = queue_length;
 }
 
 
@@ -184,121 +150,37 @@ void * thread_pool_iget_return_value( const thread_pool_type * pool , int queue_
 
 
 /**
-   The pthread_create() call which this is all about, does not start
-   the user supplied function. Instead it will start an instance of
-   this function, which will do some housekeeping before calling the
-   user supplied function.
+   This function is run by each of the worker threads. The worker
+   takes jobs from the queue until the queue is empty and join has
+   been signalled; when the queue is empty, but join has not been
+   signalled, it waits on the job_available condition variable.
 */
 
-static void * thread_pool_start_job( void * arg ) {
-  thread_pool_arg_type * tp_arg = (thread_pool_arg_type * ) arg;
-  thread_pool_type * tp         =  tp_arg->pool;
-  int slot_index                =  tp_arg->slot_index;
-  void * func_arg               =  tp_arg->func_arg;
-  start_func_ftype * func       =  tp_arg->func;
-  void * return_value;
-
-
-  return_value = func( func_arg );                  /* Starting the real external function */
-  tp->job_slots[ slot_index ].running = false;      /* We mark the job as completed. */
-  free( arg );
-
-  if (return_value != NULL)
-    thread_pool_iset_return_value( tp , tp_arg->queue_index , return_value);
-
-  return NULL;
-}
-
-
-
-/**
-   This function is run by the dispatch_thread. The thread will keep
-   an eye on the queue, and dispatch new jobs when there are free
-   slots available.
-*/
-
-static void * thread_pool_main_loop( void * arg ) {
+static void * thread_pool_worker( void * arg ) {
   thread_pool_type * tp = thread_pool_safe_cast( arg );
-  {
-    const int usleep_init = 1000;  /* The sleep time when there are free slots available - but no jobs wanting to run. */
-    int internal_offset   = 0;     /* Keep track of the (index of) the last job slot fired off - minor time saving. */
-    while (true) {
-      if (tp->queue_size > tp->queue_index) {
-        /*
-           There are jobs in the queue which would like to run -
-           let us see if we can find a slot for them.
-        */
-        int counter     = 0;
-        bool slot_found = false;
-        do {
-          int slot_index = (counter + internal_offset) % tp->max_running;
-          thread_pool_job_slot_type * job_slot = &tp->job_slots[ slot_index ];
-          if (!job_slot->running) {
-            /* OK thread[slot_index] is ready to take this job.*/
-            thread_pool_arg_type * tp_arg;
-
-            /*
-               The queue might be updated by the main thread - we must
-               take a copy of the node we are interested in.
-            */
-            pthread_rwlock_rdlock( &tp->queue_lock );
-            tp_arg = util_alloc_copy( &tp->queue[ tp->queue_index ] , sizeof * tp_arg );
-            pthread_rwlock_unlock( &tp->queue_lock );
-
-            tp_arg->slot_index = slot_index;
-            job_slot->running = true;
-            /*
-               Here is the actual pthread_create() call creating an
-               additional running thread.
-            */
-
-            /*Cleanup of previous run threads. Needed to avoid memory leak*/
-            if (job_slot->run_count > 0)
-              pthread_join(job_slot->thread, NULL);
-
-            pthread_create( &job_slot->thread , NULL , thread_pool_start_job , tp_arg );
-            job_slot->run_count += 1;
-            tp->queue_index++;
-            internal_offset += (counter + 1);
-            slot_found = true;
-          } else
-            counter++;
-        } while (!slot_found && (counter < tp->max_running));
-
-        if (!slot_found) {
-            util_yield();
-        }
-      } else
-        util_usleep(usleep_init);    /* There are no jobs wanting to run. */
-
-      /*****************************************************************/
-      /*
-        We exit explicitly from this loop when both conditions apply:
 
-         1. tp->join       == true              :  The calling scope has signaled that it will not submit more jobs.
-         2. tp->queue_size == tp->queue_index   :  This function has submitted all the jobs in the queue.
-      */
-      if ((tp->join) && (tp->queue_size == tp->queue_index))
-        break;
-    } /* End of while() loop */
-  }
-
-  /*
-     There are no more jobs in the queue, and the main scope has
-     signaled that join should start. Observe that we join only the
-     jobs corresponding to explicitly running job_slots; when a job
-     slot is used multiple times the first jobs run in the job_slot
-     will not be explicitly joined.
-  */
-  {
-    int i;
-    for (i=0; i < tp->max_running; i++) {
-      thread_pool_job_slot_type job_slot = tp->job_slots[i];
-      if (job_slot.run_count > 0)
-        pthread_join( job_slot.thread , NULL );
-    }
+  pthread_mutex_lock( &tp->queue_mutex );
+  while (true) {
+    if (tp->queue_index < tp->queue_size) {
+      int queue_index               = tp->queue_index++;
+      start_func_ftype * func       = tp->queue[ queue_index ].func;
+      void * func_arg               = tp->queue[ queue_index ].func_arg;
+      void * return_value;
+
+      pthread_mutex_unlock( &tp->queue_mutex );
+      return_value = func( func_arg );              /* Starting the real external function */
+      pthread_mutex_lock( &tp->queue_mutex );
+
+      tp->queue[ queue_index ].return_value = return_value;
+      tp->num_complete++;
+      if (tp->num_complete == tp->queue_size)
+        pthread_cond_broadcast( &tp->jobs_complete );
+    } else if (tp->join)
+      break;
+    else
+      pthread_cond_wait( &tp->job_available , &tp->queue_mutex );
   }
-  /* When we are here all the jobs have completed. */
+  pthread_mutex_unlock( &tp->queue_mutex );
   return NULL;
 }
 
@@ -307,7 +189,7 @@ static void * thread_pool_main_loop( void * arg ) {
 
 /**
    This function initializes a couple of counters, and starts up the
-   dispatch thread. If the thread_pool should be reused after a join,
+   worker threads. If the thread_pool should be reused after a join,
    this function must be called before adding new jobs.
 
    The functions thread_pool_restart() and thread_pool_join() should
@@ -321,50 +203,62 @@ void thread_pool_restart( thread_pool_type * tp ) {
     tp->join           = false;
     tp->queue_index    = 0;
     tp->queue_size     = 0;
-    {
-      int i;
-      for (i=0; i < tp->max_running; i++) {
-        tp->job_slots[i].run_count = 0;
-        tp->job_slots[i].running   = false;
-      }
-    }
+    tp->num_complete   = 0;
 
-    /* Starting the dispatch thread. */
-    pthread_create( &tp->dispatch_thread , NULL , thread_pool_main_loop , tp );
+    /* Starting the worker threads. */
+    for (int i=0; i < tp->max_running; i++)
+      pthread_create( &tp->workers[i] , NULL , thread_pool_worker , tp );
     tp->accepting_jobs = true;
   }
 }
 
 
 
+static void thread_pool_join_workers( thread_pool_type * pool ) {
+  if (!pool->accepting_jobs) {
+    pool->join = true;
+    return;
+  }
+
+  pthread_mutex_lock( &pool->queue_mutex );
+  pool->join = true;                               /* Signals to the workers that they can exit when the queue is empty. */
+  pthread_cond_broadcast( &pool->job_available );
+  pthread_mutex_unlock( &pool->queue_mutex );
+
+  for (int i=0; i < pool->max_running; i++)
+    pthread_join( pool->workers[i] , NULL );
+
+  pool->accepting_jobs = false;
+}
+
+
 /**
    This function is called by the calling scope when all the jobs have
    been submitted, and we just wait for them to complete.
 
-   This function just sets the join switch to true - this again tells
-   the dispatch_thread to start the join process on the worker
-   threads.
+   This function sets the join switch to true - this tells the
+   worker threads to exit when there are no more jobs in the queue.
 */
 
 void thread_pool_join(thread_pool_type * pool) {
-  pool->join = true;                               /* Signals to the main thread that joining can start. */
-  if (pool->max_running > 0) {
-    pthread_join( pool->dispatch_thread , NULL );  /* Wait for the main thread to complete. */
+  if (pool->max_running > 0)
+    thread_pool_join_workers( pool );
+  else {
+    pool->join = true;
     pool->accepting_jobs = false;
   }
 }
 
 /*
-  This will try to join the thread; if the manager thread has not
-  completed within @timeout_seconds the function will return false. If
-  the join fails the queue will be reset in a non-joining state and it
-  will be open for more jobs. Probably not in a 100% sane state.
+  This will try to join the thread pool; if the jobs have not
+  completed within @timeout_seconds the function will return false.
+  If the join fails the queue is still running, and it will be open
+  for more jobs.
 */
 
 bool thread_pool_try_join(thread_pool_type * pool, int timeout_seconds) {
   bool join_ok = true;
 
-  pool->join = true;                               /* Signals to the main thread that joining can start. */
   if (pool->max_running > 0) {
     struct timespec ts;
     time_t timeout_time = time( NULL );
@@ -373,42 +267,22 @@ bool thread_pool_try_join(thread_pool_type * pool, int timeout_seconds) {
     ts.tv_sec = timeout_time;
     ts.tv_nsec = 0;
 
-#ifdef HAVE_TIMEDJOIN
-
-    {
-      int join_return = pthread_timedjoin_np( pool->dispatch_thread , NULL , &ts);  /* Wait for the main thread to complete. */
-      if (join_return == 0)
-        pool->accepting_jobs = false;
-      else {
-        pool->join = false;
-        join_ok = false;
+    pthread_mutex_lock( &pool->queue_mutex );
+    while (pool->num_complete < pool->queue_size) {
+      if (pthread_cond_timedwait( &pool->jobs_complete , &pool->queue_mutex , &ts ) != 0) {
+        join_ok = (pool->num_complete == pool->queue_size);
+        break;
       }
     }
+    pthread_mutex_unlock( &pool->queue_mutex );
 
-#else
-
-    while(true) {
-        if (pthread_kill(pool->dispatch_thread, 0) == 0){
-            util_yield();
-        } else {
-            pthread_join(pool->dispatch_thread, NULL);
-            pool->accepting_jobs = false;
-            break;
-        }
-
-        time_t now = time(NULL);
-
-        if(util_difftime_seconds(now, timeout_time) <= 0) {
-            join_ok = false;
-            break;
-        }
-    }
-
-#endif
-
-
-
+    if (join_ok)
+      thread_pool_join_workers( pool );
+  } else {
+    pool->join = true;
+    pool->accepting_jobs = false;
   }
+
   return join_ok;
 }
 
@@ -417,7 +291,7 @@ bool thread_pool_try_join(thread_pool_type * pool, int timeout_seconds) {
 
 /**
    max_running is the maximum number of concurrent threads. If
-   @start_queue is true the dispatch thread will start immediately. If
+   @start_queue is true the worker threads will start immediately. If
    the function is called with @start_queue == false you must first
    call thread_pool_restart() BEFORE you can start adding jobs.
 */
@@ -425,11 +299,13 @@ bool thread_pool_try_join(thread_pool_type * pool, int timeout_seconds) {
 thread_pool_type * thread_pool_alloc(int max_running , bool start_queue) {
   thread_pool_type * pool = util_malloc( sizeof *pool );
   UTIL_TYPE_ID_INIT( pool , THREAD_POOL_TYPE_ID );
-  pool->job_slots         = util_calloc( max_running , sizeof * pool->job_slots );
+  pool->workers           = util_calloc( max_running , sizeof * pool->workers );
   pool->max_running       = max_running;
   pool->queue             = NULL;
   pool->accepting_jobs    = false;
-  pthread_rwlock_init( &pool->queue_lock , NULL);
+  pthread_mutex_init( &pool->queue_mutex , NULL );
+  pthread_cond_init( &pool->job_available , NULL );
+  pthread_cond_init( &pool->jobs_complete , NULL );
   thread_pool_resize_queue( pool  , 32 );
   if (start_queue)
     thread_pool_restart( pool );
@@ -443,23 +319,24 @@ void thread_pool_add_job(thread_pool_type * pool , start_func_ftype * start_func
     start_func( func_arg );
   else {
     if (pool->accepting_jobs) {
+      pthread_mutex_lock( &pool->queue_mutex );
       if (pool->queue_size == pool->queue_alloc_size)
         thread_pool_resize_queue( pool , pool->queue_alloc_size * 2);
 
       /*
-         The new job is added to the queue - the main thread is watching
-         the queue and will pick up the new job.
+         The new job is added to the queue, and one of the waiting
+         workers is woken up to pick up the new job.
       */
       {
         int queue_index = pool->queue_size;
 
-        pool->queue[ queue_index ].pool         = pool;
         pool->queue[ queue_index ].func_arg     = func_arg;
         pool->queue[ queue_index ].func         = start_func;
         pool->queue[ queue_index ].return_value = NULL;
-        pool->queue[ queue_index ].queue_index = queue_index;
       }
-      pool->queue_size++;  /* <- This is shared between this thread and the dispatch thread */
+      pool->queue_size++;
+      pthread_cond_signal( &pool->job_available );
+      pthread_mutex_unlock( &pool->queue_mutex );
     } else
       util_abort("%s: thread_pool is not running - restart with thread_pool_restart()?? \n",__func__);
   }
@@ -468,14 +345,19 @@ void thread_pool_add_job(thread_pool_type * pool , start_func_ftype * start_func
 
 
 /*
-  Observe that this function does not join the worker threads,
-  i.e. you should call thread_pool_join() first (otherwise the thing
-  will go up in flames).
+  If the pool is still running the jobs in the queue are allowed to
+  complete, and the worker threads are joined, before the pool is
+  freed; you should normally call thread_pool_join() first.
 */
 
-
 void thread_pool_free(thread_pool_type * pool) {
-  util_safe_free( pool->job_slots );
+  if (pool->accepting_jobs)
+    thread_pool_join( pool );
+
+  pthread_cond_destroy( &pool->jobs_complete );
+  pthread_cond_destroy( &pool->job_available );
+  pthread_mutex_destroy( &pool->queue_mutex );
+  util_safe_free( pool->workers );
   util_safe_free( pool->queue );
   free(pool);
 }
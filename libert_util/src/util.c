@@ -83,6 +83,10 @@
 #include <execinfo.h>
 #endif
 
+#ifdef HAVE_SYSCONF
+#include <unistd.h>
+#endif
+
 #ifdef HAVE_FTRUNCATE
 #include <unistd.h>
 #include <sys/types.h>
@@ -106,6 +110,7 @@
 #endif
 
 #include <ert/util/util.h>
+#include <ert/util/util_kernels.h>
 #include <ert/util/buffer.h>
 
 
@@ -144,41 +149,6 @@ static uint16_t util_endian_convert16( uint16_t u ) {
 }
 
 
-static uint32_t util_endian_convert32( uint32_t u ) {
-  const uint32_t m8  = (uint32_t) 0x00FF00FFUL;
-  const uint32_t m16 = (uint32_t) 0x0000FFFFUL;
-
-  u = (( u >> 8U ) & m8)   | ((u & m8) << 8U);
-  u = (( u >> 16U ) & m16) | ((u & m16) << 16U);
-  return u;
-}
-
-
-static uint64_t util_endian_convert64( uint64_t u ) {
-  const uint64_t m8  = (uint64_t) 0x00FF00FF00FF00FFULL;
-  const uint64_t m16 = (uint64_t) 0x0000FFFF0000FFFFULL;
-  const uint64_t m32 = (uint64_t) 0x00000000FFFFFFFFULL;
-
-
-  u = (( u >> 8U ) & m8)   | ((u & m8) << 8U);
-  u = (( u >> 16U ) & m16) | ((u & m16) << 16U);
-  u = (( u >> 32U ) & m32) | ((u & m32) << 32U);
-  return u;
-}
-
-
-static uint64_t util_endian_convert32_64( uint64_t u ) {
-  const uint64_t m8  = (uint64_t) 0x00FF00FF00FF00FFULL;
-  const uint64_t m16 = (uint64_t) 0x0000FFFF0000FFFFULL;
-
-
-  u = (( u >> 8U ) & m8)   | ((u & m8) << 8U);
-  u = (( u >> 16U ) & m16) | ((u & m16) << 16U);
-  return u;
-}
-
-
-
 void util_endian_flip_vector(void *data, int element_size , int elements) {
   int i;
   switch (element_size) {
@@ -193,43 +163,16 @@ void util_endian_flip_vector(void *data, int element_size , int elements) {
       break;
     }
   case(4):
-    {
-#ifdef ARCH64
-      /*
-        In the case of a 64 bit CPU the fastest way to swap 32 bit
-        variables will be by swapping two elements in one operation;
-        this is provided by the util_endian_convert32_64() function. In the case
-        of binary ECLIPSE files this case is quite common, and
-        therefor worth supporting as a special case.
-      */
-      uint64_t *tmp64 = (uint64_t *) data;
-
-      for (i = 0; i <elements/2; i++)
-        tmp64[i] = util_endian_convert32_64(tmp64[i]);
-
-      if ( elements & 1 ) {
-        // Odd number of elements - flip the last element as an ordinary 32 bit swap.
-        uint32_t *tmp32 = (uint32_t *) data;
-        tmp32[ elements - 1] = util_endian_convert32( tmp32[elements - 1] );
-      }
-      break;
-#else
-      uint32_t *tmp32 = (uint32_t *) data;
-
-      for (i = 0; i <elements; i++)
-        tmp32[i] = util_endian_convert32(tmp32[i]);
-
-      break;
-#endif
-    }
+    /*
+      The 4 and 8 byte cases are the common ones for binary ECLIPSE
+      files; they are handled by the (possibly vectorized) kernels in
+      util_kernels.c.
+    */
+    util_kernel_bswap32_copy( data , data , elements );
+    break;
   case(8):
-    {
-      uint64_t *tmp64 = (uint64_t *) data;
-
-      for (i = 0; i <elements; i++)
-        tmp64[i] = util_endian_convert64(tmp64[i]);
-      break;
-    }
+    util_kernel_bswap64_copy( data , data , elements );
+    break;
   default:
     fprintf(stderr,"%s: current element size: %d \n",__func__ , element_size);
     util_abort("%s: can only endian flip 1/2/4/8 byte variables - aborting \n",__func__);
@@ -748,6 +691,29 @@ void util_usleep( unsigned long micro_seconds ) {
 #endif
 }
 
+/**
+   Returns the number of online processors; if that can not be
+   determined the function returns 1.
+*/
+
+int util_get_num_cpu( ) {
+  int num_cpu = 1;
+#if defined(HAVE_SYSCONF) && defined(_SC_NPROCESSORS_ONLN)
+  num_cpu = sysconf( _SC_NPROCESSORS_ONLN );
+#else
+  #ifdef ERT_WINDOWS
+  {
+    SYSTEM_INFO system_info;
+    GetSystemInfo( &system_info );
+    num_cpu = system_info.dwNumberOfProcessors;
+  }
+  #endif
+#endif
+  if (num_cpu < 1)
+    num_cpu = 1;
+  return num_cpu;
+}
+
 void util_yield() {
 #if defined(WITH_PTHREAD) && (defined(HAVE_YIELD_NP) || defined(HAVE_YIELD))
   #ifdef HAVE_YIELD_NP
@@ -4210,9 +4176,7 @@ char * util_string_strip_chars_alloc(const char * buff_org, const char * chars)
 
 
 void util_float_to_double(double *double_ptr , const float *float_ptr , int size) {
-  int i;
-  for (i=0; i < size; i++)
-    double_ptr[i] = float_ptr[i];
+  util_kernel_float_to_double( double_ptr , float_ptr , size );
 }
 
 
@@ -4656,8 +4620,22 @@ void * util_malloc(size_t size) {
 }
 
 
+/**
+   Allocates storage for elements * element_size bytes which is
+   initialized to zero, like calloc(); will abort() on failure, and
+   return NULL if the size is zero - just like util_malloc().
+*/
+
 void * util_calloc( size_t elements , size_t element_size ) {
-  return util_malloc( elements * element_size );
+  void * data;
+  if ((elements == 0) || (element_size == 0))
+    data = NULL;
+  else {
+    data = calloc( elements , element_size );
+    if (data == NULL)
+      util_abort("%s: failed to allocate %zu x %zu bytes - aborting \n",__func__ , elements , element_size);
+  }
+  return data;
 }
 
 
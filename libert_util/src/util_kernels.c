@@ -0,0 +1,500 @@
+/*
+   Copyright (C) 2016  Statoil ASA, Norway.
+
+   The file 'util_kernels.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ert/util/build_config.h"
+
+#ifdef HAVE_X86_SIMD
+#include <immintrin.h>
+#endif
+
+#include <ert/util/util_kernels.h>
+
+/*
+  This file implements a small set of kernels for the inner loops
+  which are applied to complete keywords of eclipse data: byte
+  swapping, float -> double conversion and a fused scale/shift; and
+  for moving data between the enkf nodes and the columns of the
+  ensemble matrix: double -> float conversion and indexed gather /
+  scatter.
+
+  Each kernel has a plain C implementation, and when compiled for
+  x86_64 with a compiler supporting target specific functions
+  (HAVE_X86_SIMD) also SSE2 and AVX2 implementations. The
+  implementation is selected at runtime based on the capabilities of
+  the CPU; util_kernel_set_level() can be used to force a lower
+  level, e.g. for testing and benchmarking.
+
+  All kernels accept unaligned pointers. The byte swap kernels can be
+  called with target == src to swap in place; the remaining kernels
+  require that the input and output do not overlap.
+*/
+
+
+static int kernel_level = -1;
+
+
+static util_kernel_level_enum util_kernel_detect_level( void ) {
+#ifdef HAVE_X86_SIMD
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return UTIL_KERNEL_AVX2;
+
+  if (__builtin_cpu_supports("sse2"))
+    return UTIL_KERNEL_SSE2;
+#endif
+  return UTIL_KERNEL_SCALAR;
+}
+
+
+util_kernel_level_enum util_kernel_get_level( void ) {
+  if (kernel_level < 0)
+    kernel_level = util_kernel_detect_level();
+
+  return kernel_level;
+}
+
+
+/*
+  Will set the kernel level; if the requested level is not supported
+  by the current CPU the highest supported level is used
+  instead. Returns the level which is actually used.
+*/
+
+util_kernel_level_enum util_kernel_set_level( util_kernel_level_enum level ) {
+  util_kernel_level_enum max_level = util_kernel_detect_level();
+  if (level > max_level)
+    level = max_level;
+
+  kernel_level = level;
+  return level;
+}
+
+
+const char * util_kernel_level_name( util_kernel_level_enum level ) {
+  switch (level) {
+  case(UTIL_KERNEL_AVX2):
+    return "AVX2";
+  case(UTIL_KERNEL_SSE2):
+    return "SSE2";
+  default:
+    return "scalar";
+  }
+}
+
+
+/*****************************************************************/
+/* Scalar implementations; also used for the tail elements by the
+   vectorized implementations. */
+
+static uint32_t util_kernel_bswap32( uint32_t u ) {
+#ifdef __GNUC__
+  return __builtin_bswap32( u );
+#else
+  return ((u >> 24) & 0x000000ffU) | ((u >> 8) & 0x0000ff00U) | ((u << 8) & 0x00ff0000U) | ((u << 24) & 0xff000000U);
+#endif
+}
+
+
+static uint64_t util_kernel_bswap64( uint64_t u ) {
+#ifdef __GNUC__
+  return __builtin_bswap64( u );
+#else
+  return ((uint64_t) util_kernel_bswap32( (uint32_t) u ) << 32) | util_kernel_bswap32( (uint32_t) (u >> 32) );
+#endif
+}
+
+
+static void util_kernel_bswap32_copy_scalar( char * target , const char * src , size_t count ) {
+  size_t i;
+  for (i=0; i < count; i++) {
+    uint32_t u;
+    memcpy( &u , &src[4*i] , 4 );
+    u = util_kernel_bswap32( u );
+    memcpy( &target[4*i] , &u , 4 );
+  }
+}
+
+
+static void util_kernel_bswap64_copy_scalar( char * target , const char * src , size_t count ) {
+  size_t i;
+  for (i=0; i < count; i++) {
+    uint64_t u;
+    memcpy( &u , &src[8*i] , 8 );
+    u = util_kernel_bswap64( u );
+    memcpy( &target[8*i] , &u , 8 );
+  }
+}
+
+
+static void util_kernel_float_to_double_scalar( double * target , const float * src , size_t count ) {
+  size_t i;
+  for (i=0; i < count; i++)
+    target[i] = src[i];
+}
+
+
+static void util_kernel_scale_shift_float_scalar( float * data , size_t count , float scale , float shift ) {
+  size_t i;
+  for (i=0; i < count; i++)
+    data[i] = data[i] * scale + shift;
+}
+
+
+static void util_kernel_scale_shift_double_scalar( double * data , size_t count , double scale , double shift ) {
+  size_t i;
+  for (i=0; i < count; i++)
+    data[i] = data[i] * scale + shift;
+}
+
+
+static void util_kernel_double_to_float_scalar( float * target , const double * src , size_t count ) {
+  size_t i;
+  for (i=0; i < count; i++)
+    target[i] = src[i];
+}
+
+
+static void util_kernel_gather_double_scalar( double * target , const double * src , const int * index , size_t count ) {
+  size_t i;
+  for (i=0; i < count; i++)
+    target[i] = src[ index[i] ];
+}
+
+
+static void util_kernel_gather_float_to_double_scalar( double * target , const float * src , const int * index , size_t count ) {
+  size_t i;
+  for (i=0; i < count; i++)
+    target[i] = src[ index[i] ];
+}
+
+
+/*****************************************************************/
+
+#ifdef HAVE_X86_SIMD
+
+/*
+  SSE2 has no byte shuffle; the bytes are swapped within 16 bit words
+  with shifts, and then the 16 bit words are reordered.
+*/
+
+__attribute__((target("sse2")))
+static inline __m128i util_kernel_sse2_bswap32( __m128i v ) {
+  v = _mm_or_si128( _mm_slli_epi16( v , 8 ) , _mm_srli_epi16( v , 8 ));
+  v = _mm_shufflelo_epi16( v , _MM_SHUFFLE( 2 , 3 , 0 , 1 ));
+  return _mm_shufflehi_epi16( v , _MM_SHUFFLE( 2 , 3 , 0 , 1 ));
+}
+
+
+__attribute__((target("sse2")))
+static inline __m128i util_kernel_sse2_bswap64( __m128i v ) {
+  v = _mm_or_si128( _mm_slli_epi16( v , 8 ) , _mm_srli_epi16( v , 8 ));
+  v = _mm_shufflelo_epi16( v , _MM_SHUFFLE( 0 , 1 , 2 , 3 ));
+  return _mm_shufflehi_epi16( v , _MM_SHUFFLE( 0 , 1 , 2 , 3 ));
+}
+
+
+__attribute__((target("sse2")))
+static void util_kernel_bswap32_copy_sse2( char * target , const char * src , size_t count ) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i v = _mm_loadu_si128( (const __m128i *) &src[4*i] );
+    _mm_storeu_si128( (__m128i *) &target[4*i] , util_kernel_sse2_bswap32( v ));
+  }
+  util_kernel_bswap32_copy_scalar( &target[4*i] , &src[4*i] , count - i );
+}
+
+
+__attribute__((target("sse2")))
+static void util_kernel_bswap64_copy_sse2( char * target , const char * src , size_t count ) {
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    __m128i v = _mm_loadu_si128( (const __m128i *) &src[8*i] );
+    _mm_storeu_si128( (__m128i *) &target[8*i] , util_kernel_sse2_bswap64( v ));
+  }
+  util_kernel_bswap64_copy_scalar( &target[8*i] , &src[8*i] , count - i );
+}
+
+
+__attribute__((target("sse2")))
+static void util_kernel_float_to_double_sse2( double * target , const float * src , size_t count ) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 f = _mm_loadu_ps( &src[i] );
+    _mm_storeu_pd( &target[i]     , _mm_cvtps_pd( f ));
+    _mm_storeu_pd( &target[i + 2] , _mm_cvtps_pd( _mm_movehl_ps( f , f )));
+  }
+  util_kernel_float_to_double_scalar( &target[i] , &src[i] , count - i );
+}
+
+
+__attribute__((target("sse2")))
+static void util_kernel_double_to_float_sse2( float * target , const double * src , size_t count ) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 lo = _mm_cvtpd_ps( _mm_loadu_pd( &src[i] ));
+    __m128 hi = _mm_cvtpd_ps( _mm_loadu_pd( &src[i + 2] ));
+    _mm_storeu_ps( &target[i] , _mm_movelh_ps( lo , hi ));
+  }
+  util_kernel_double_to_float_scalar( &target[i] , &src[i] , count - i );
+}
+
+
+__attribute__((target("sse2")))
+static void util_kernel_scale_shift_float_sse2( float * data , size_t count , float scale , float shift ) {
+  const __m128 vscale = _mm_set1_ps( scale );
+  const __m128 vshift = _mm_set1_ps( shift );
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps( &data[i] , _mm_add_ps( _mm_mul_ps( _mm_loadu_ps( &data[i] ) , vscale ) , vshift ));
+  util_kernel_scale_shift_float_scalar( &data[i] , count - i , scale , shift );
+}
+
+
+__attribute__((target("sse2")))
+static void util_kernel_scale_shift_double_sse2( double * data , size_t count , double scale , double shift ) {
+  const __m128d vscale = _mm_set1_pd( scale );
+  const __m128d vshift = _mm_set1_pd( shift );
+  size_t i = 0;
+  for (; i + 2 <= count; i += 2)
+    _mm_storeu_pd( &data[i] , _mm_add_pd( _mm_mul_pd( _mm_loadu_pd( &data[i] ) , vscale ) , vshift ));
+  util_kernel_scale_shift_double_scalar( &data[i] , count - i , scale , shift );
+}
+
+
+/*****************************************************************/
+/*
+  The AVX2 kernels; observe that the multiply and add in the scale
+  shift kernels are deliberately not fused to FMA instructions, so
+  that the result is bitwise identical to the scalar implementation.
+*/
+
+__attribute__((target("avx2")))
+static inline __m256i util_kernel_avx2_bswap32( __m256i v ) {
+  const __m256i mask = _mm256_setr_epi8( 3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12,
+                                         3,2,1,0, 7,6,5,4, 11,10,9,8, 15,14,13,12 );
+  return _mm256_shuffle_epi8( v , mask );
+}
+
+
+__attribute__((target("avx2")))
+static void util_kernel_bswap32_copy_avx2( char * target , const char * src , size_t count ) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i v = _mm256_loadu_si256( (const __m256i *) &src[4*i] );
+    _mm256_storeu_si256( (__m256i *) &target[4*i] , util_kernel_avx2_bswap32( v ));
+  }
+  util_kernel_bswap32_copy_scalar( &target[4*i] , &src[4*i] , count - i );
+}
+
+
+__attribute__((target("avx2")))
+static void util_kernel_bswap64_copy_avx2( char * target , const char * src , size_t count ) {
+  const __m256i mask = _mm256_setr_epi8( 7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8,
+                                         7,6,5,4,3,2,1,0, 15,14,13,12,11,10,9,8 );
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m256i v = _mm256_loadu_si256( (const __m256i *) &src[8*i] );
+    _mm256_storeu_si256( (__m256i *) &target[8*i] , _mm256_shuffle_epi8( v , mask ));
+  }
+  util_kernel_bswap64_copy_scalar( &target[8*i] , &src[8*i] , count - i );
+}
+
+
+__attribute__((target("avx2")))
+static void util_kernel_float_to_double_avx2( double * target , const float * src , size_t count ) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm256_storeu_pd( &target[i]     , _mm256_cvtps_pd( _mm_loadu_ps( &src[i] )));
+    _mm256_storeu_pd( &target[i + 4] , _mm256_cvtps_pd( _mm_loadu_ps( &src[i + 4] )));
+  }
+  util_kernel_float_to_double_scalar( &target[i] , &src[i] , count - i );
+}
+
+
+__attribute__((target("avx2")))
+static void util_kernel_double_to_float_avx2( float * target , const double * src , size_t count ) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm_storeu_ps( &target[i]     , _mm256_cvtpd_ps( _mm256_loadu_pd( &src[i] )));
+    _mm_storeu_ps( &target[i + 4] , _mm256_cvtpd_ps( _mm256_loadu_pd( &src[i + 4] )));
+  }
+  util_kernel_double_to_float_scalar( &target[i] , &src[i] , count - i );
+}
+
+
+/*
+  The gather kernels only have a scalar and an AVX2 implementation;
+  SSE2 has no gather instructions.
+*/
+
+__attribute__((target("avx2")))
+static void util_kernel_gather_double_avx2( double * target , const double * src , const int * index , size_t count ) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m128i index0 = _mm_loadu_si128( (const __m128i *) &index[i] );
+    __m128i index1 = _mm_loadu_si128( (const __m128i *) &index[i + 4] );
+    _mm256_storeu_pd( &target[i]     , _mm256_i32gather_pd( src , index0 , 8 ));
+    _mm256_storeu_pd( &target[i + 4] , _mm256_i32gather_pd( src , index1 , 8 ));
+  }
+  util_kernel_gather_double_scalar( &target[i] , src , &index[i] , count - i );
+}
+
+
+__attribute__((target("avx2")))
+static void util_kernel_gather_float_to_double_avx2( double * target , const float * src , const int * index , size_t count ) {
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 f = _mm256_i32gather_ps( src , _mm256_loadu_si256( (const __m256i *) &index[i] ) , 4 );
+    _mm256_storeu_pd( &target[i]     , _mm256_cvtps_pd( _mm256_castps256_ps128( f )));
+    _mm256_storeu_pd( &target[i + 4] , _mm256_cvtps_pd( _mm256_extractf128_ps( f , 1 )));
+  }
+  util_kernel_gather_float_to_double_scalar( &target[i] , src , &index[i] , count - i );
+}
+
+
+__attribute__((target("avx2")))
+static void util_kernel_scale_shift_float_avx2( float * data , size_t count , float scale , float shift ) {
+  const __m256 vscale = _mm256_set1_ps( scale );
+  const __m256 vshift = _mm256_set1_ps( shift );
+  size_t i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps( &data[i] , _mm256_add_ps( _mm256_mul_ps( _mm256_loadu_ps( &data[i] ) , vscale ) , vshift ));
+  util_kernel_scale_shift_float_scalar( &data[i] , count - i , scale , shift );
+}
+
+
+__attribute__((target("avx2")))
+static void util_kernel_scale_shift_double_avx2( double * data , size_t count , double scale , double shift ) {
+  const __m256d vscale = _mm256_set1_pd( scale );
+  const __m256d vshift = _mm256_set1_pd( shift );
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm256_storeu_pd( &data[i] , _mm256_add_pd( _mm256_mul_pd( _mm256_loadu_pd( &data[i] ) , vscale ) , vshift ));
+  util_kernel_scale_shift_double_scalar( &data[i] , count - i , scale , shift );
+}
+
+#endif
+
+
+/*****************************************************************/
+/* The public dispatch functions. */
+
+#ifdef HAVE_X86_SIMD
+#define UTIL_KERNEL_DISPATCH( name , ... )                  \
+  switch (util_kernel_get_level()) {                        \
+  case(UTIL_KERNEL_AVX2):                                   \
+    name ## _avx2( __VA_ARGS__ );                           \
+    break;                                                  \
+  case(UTIL_KERNEL_SSE2):                                   \
+    name ## _sse2( __VA_ARGS__ );                           \
+    break;                                                  \
+  default:                                                  \
+    name ## _scalar( __VA_ARGS__ );                         \
+  }
+#else
+#define UTIL_KERNEL_DISPATCH( name , ... ) name ## _scalar( __VA_ARGS__ );
+#endif
+
+
+void util_kernel_bswap32_copy( void * target , const void * src , size_t count ) {
+  UTIL_KERNEL_DISPATCH( util_kernel_bswap32_copy , target , src , count );
+}
+
+
+void util_kernel_bswap64_copy( void * target , const void * src , size_t count ) {
+  UTIL_KERNEL_DISPATCH( util_kernel_bswap64_copy , target , src , count );
+}
+
+
+void util_kernel_float_to_double( double * target , const float * src , size_t count ) {
+  UTIL_KERNEL_DISPATCH( util_kernel_float_to_double , target , src , count );
+}
+
+
+void util_kernel_double_to_float( float * target , const double * src , size_t count ) {
+  UTIL_KERNEL_DISPATCH( util_kernel_double_to_float , target , src , count );
+}
+
+
+/*
+  Will set target[i] = src[ index[i] ] for i in [0,count); the
+  indices must be non-negative.
+*/
+
+void util_kernel_gather_double( double * target , const double * src , const int * index , size_t count ) {
+#ifdef HAVE_X86_SIMD
+  if (util_kernel_get_level() == UTIL_KERNEL_AVX2) {
+    util_kernel_gather_double_avx2( target , src , index , count );
+    return;
+  }
+#endif
+  util_kernel_gather_double_scalar( target , src , index , count );
+}
+
+
+void util_kernel_gather_float_to_double( double * target , const float * src , const int * index , size_t count ) {
+#ifdef HAVE_X86_SIMD
+  if (util_kernel_get_level() == UTIL_KERNEL_AVX2) {
+    util_kernel_gather_float_to_double_avx2( target , src , index , count );
+    return;
+  }
+#endif
+  util_kernel_gather_float_to_double_scalar( target , src , index , count );
+}
+
+
+/*
+  Will set target[ index[i] ] = src[i] for i in [0,count). There are
+  no scatter instructions before AVX-512, so the scatter kernels are
+  plain C for all levels.
+*/
+
+void util_kernel_scatter_double( double * target , const int * index , const double * src , size_t count ) {
+  size_t i;
+  for (i=0; i < count; i++)
+    target[ index[i] ] = src[i];
+}
+
+
+void util_kernel_scatter_double_to_float( float * target , const int * index , const double * src , size_t count ) {
+  size_t i;
+  for (i=0; i < count; i++)
+    target[ index[i] ] = src[i];
+}
+
+
+/*
+  Will update data[i] = data[i] * scale + shift. Observe that with
+  shift == -0.0 the result is identical to a pure scaling, also for
+  negative zero.
+*/
+
+void util_kernel_scale_shift_float( float * data , size_t count , float scale , float shift ) {
+  UTIL_KERNEL_DISPATCH( util_kernel_scale_shift_float , data , count , scale , shift );
+}
+
+
+void util_kernel_scale_shift_double( double * data , size_t count , double scale , double shift ) {
+  UTIL_KERNEL_DISPATCH( util_kernel_scale_shift_double , data , count , scale , shift );
+}
+
+#undef UTIL_KERNEL_DISPATCH
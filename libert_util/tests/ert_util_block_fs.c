@@ -17,11 +17,15 @@
 */
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include <sys/types.h>
 #include <unistd.h>
 
 
 #include <ert/util/block_fs.h>
+#include <ert/util/buffer.h>
+#include <ert/util/stringlist.h>
+#include <ert/util/vector.h>
 #include <ert/util/test_util.h>
 #include <ert/util/test_work_area.h>
 
@@ -102,8 +106,501 @@ void test_lock_conflict() {
 
 
 
+static void fwrite_test_file( block_fs_type * bfs , int index ) {
+  char * filename = util_alloc_sprintf("FILE.%d" , index);
+  int size = 10 + 37 * index;
+  int * data = util_malloc( size * sizeof * data );
+  for (int i=0; i < size; i++)
+    data[i] = index + i;
+
+  block_fs_fwrite_file( bfs , filename , data , size * sizeof * data );
+  free( data );
+  free( filename );
+}
+
+
+static void assert_test_file( block_fs_type * bfs , int index ) {
+  char * filename = util_alloc_sprintf("FILE.%d" , index);
+  int size = 10 + 37 * index;
+  test_assert_int_equal( block_fs_get_filesize( bfs , filename ) , size * sizeof(int));
+  {
+    int * data = util_malloc( size * sizeof * data );
+    buffer_type * buffer = buffer_alloc( 100 );
+
+    block_fs_fread_file( bfs , filename , data );
+    block_fs_fread_realloc_buffer( bfs , filename , buffer );
+    test_assert_int_equal( buffer_get_size( buffer ) , size * sizeof(int));
+    for (int i=0; i < size; i++) {
+      test_assert_int_equal( data[i] , index + i );
+      test_assert_int_equal( buffer_fread_int( buffer ) , index + i );
+    }
+
+    buffer_free( buffer );
+    free( data );
+  }
+  free( filename );
+}
+
+
+void test_mmap_read() {
+  test_work_area_type * work_area = test_work_area_alloc("block_fs/mmap_read");
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 10 , false , false , false );
+    for (int i=0; i < 100; i++)
+      fwrite_test_file( bfs , i );
+
+    block_fs_set_mmap_read( bfs , true );
+    test_assert_true( block_fs_has_mmap_read( bfs ));
+    for (int i=0; i < 100; i++)
+      assert_test_file( bfs , i );
+
+    /* Grow the file, and overwrite some of the existing nodes. */
+    for (int i=50; i < 200; i++)
+      fwrite_test_file( bfs , i );
+    for (int i=0; i < 200; i++)
+      assert_test_file( bfs , i );
+
+    block_fs_unlink_file( bfs , "FILE.0");
+    block_fs_defrag( bfs );
+    test_assert_true( block_fs_has_mmap_read( bfs ));
+    for (int i=1; i < 200; i++)
+      assert_test_file( bfs , i );
+
+    block_fs_set_mmap_read( bfs , false );
+    test_assert_false( block_fs_has_mmap_read( bfs ));
+    assert_test_file( bfs , 10 );
+    block_fs_close( bfs , false );
+  }
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 10 , false , true , false );
+    block_fs_set_mmap_read( bfs , true );
+    test_assert_true( block_fs_has_mmap_read( bfs ));
+    for (int i=1; i < 200; i++)
+      assert_test_file( bfs , i );
+    block_fs_close( bfs , false );
+  }
+  test_work_area_free( work_area );
+}
+
+
+void test_hash_index() {
+  test_work_area_type * work_area = test_work_area_alloc("block_fs/hash_index");
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 10 , false , false , false );
+    for (int i=0; i < 500; i++)
+      fwrite_test_file( bfs , i );
+    block_fs_close( bfs , false );
+  }
+  test_assert_true( util_file_exists( "test.index" ));
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 10 , false , false , false );
+    assert_test_file( bfs , 77 );
+    test_assert_false( block_fs_has_file( bfs , "FILE.500" ));
+    block_fs_unlink_file( bfs , "FILE.10" );
+    block_fs_unlink_file( bfs , "FILE.20" );
+    test_assert_false( block_fs_has_file( bfs , "FILE.10" ));
+    fwrite_test_file( bfs , 600 );
+    fwrite_test_file( bfs , 30 );
+    block_fs_close( bfs , false );
+  }
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 10 , false , true , false );
+    for (int i=0; i < 500; i++) {
+      if ((i == 10) || (i == 20)) {
+        char * filename = util_alloc_sprintf("FILE.%d" , i);
+        test_assert_false( block_fs_has_file( bfs , filename ));
+        free( filename );
+      } else
+        assert_test_file( bfs , i );
+    }
+    assert_test_file( bfs , 600 );
+    block_fs_close( bfs , false );
+  }
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 10 , false , false , false );
+    vector_type * files = block_fs_alloc_filelist( bfs , NULL , NO_SORT , false );
+    test_assert_int_equal( vector_get_size( files ) , 499 );
+    vector_free( files );
+    assert_test_file( bfs , 600 );
+    block_fs_close( bfs , false );
+  }
+  test_work_area_free( work_area );
+}
+
+
+/*
+  Overwrites size bytes of the index file at offset with the byte
+  value; a negative offset is relative to the end of the file, and a
+  negative size extends to the end of the file.
+*/
+
+static void corrupt_index( const char * index_file , long offset , int size , int value) {
+  FILE * stream = util_fopen( index_file , "r+");
+  char * data;
+
+  if (size < 0)
+    size = util_file_size( index_file ) - offset;
+  data = util_malloc( size );
+
+  memset( data , value , size );
+  if (offset < 0)
+    fseek( stream , offset , SEEK_END );
+  else
+    fseek( stream , offset , SEEK_SET );
+  util_fwrite( data , 1 , size , stream , __func__ );
+
+  free( data );
+  fclose( stream );
+}
+
+
+static void test_corrupt_index__( long offset , int size , int value ) {
+  test_work_area_type * work_area = test_work_area_alloc("block_fs/corrupt_index");
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 10 , false , false , false );
+    for (int i=0; i < 100; i++)
+      fwrite_test_file( bfs , i );
+    block_fs_unlink_file( bfs , "FILE.50" );
+    block_fs_close( bfs , false );
+  }
+  corrupt_index( "test.index" , offset , size , value );
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 10 , false , false , false );
+    test_assert_false( block_fs_has_file( bfs , "FILE.50" ));
+    test_assert_false( block_fs_has_file( bfs , "FILE.100" ));
+    for (int i=0; i < 100; i++)
+      if (i != 50)
+        assert_test_file( bfs , i );
+    fwrite_test_file( bfs , 50 );
+    block_fs_close( bfs , false );
+  }
+  test_work_area_free( work_area );
+}
+
+
+/*
+  The header of the index is left intact; the slots and the key table
+  are corrupted, and the index must be rebuilt from the data file.
+*/
+
+void test_corrupt_index() {
+  /* All the slots: invalid key offsets, no empty slot, free nodes outside the data file. */
+  test_corrupt_index__( 40 , -1 , 0xFF );
+
+  /* The last key in the key table is not NUL terminated. */
+  test_corrupt_index__( -4 , 4 , 'x' );
+}
+
+
+static void free_buffer( void * arg ) {
+  buffer_free( (buffer_type *) arg );
+}
+
+
+static void fwrite_test_batch( block_fs_type * bfs , int first , int last) {
+  stringlist_type * filenames = stringlist_alloc_new( );
+  vector_type * buffers = vector_alloc_new( );
+  for (int index = first; index < last; index++) {
+    int size = 10 + 37 * index;
+    buffer_type * buffer = buffer_alloc( size * sizeof(int) );
+    for (int i=0; i < size; i++)
+      buffer_fwrite_int( buffer , index + i );
+
+    stringlist_append_owned_ref( filenames , util_alloc_sprintf("FILE.%d" , index));
+    vector_append_owned_ref( buffers , buffer , free_buffer );
+  }
+  block_fs_fwrite_batch( bfs , filenames , buffers );
+  vector_free( buffers );
+  stringlist_free( filenames );
+}
+
+
+void test_fwrite_batch() {
+  test_work_area_type * work_area = test_work_area_alloc("block_fs/fwrite_batch");
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 10 , false , false , false );
+    for (int i=0; i < 50; i++)
+      fwrite_test_file( bfs , i );
+    block_fs_unlink_file( bfs , "FILE.5");
+
+    /* Mix of new nodes, reused nodes, grown nodes and free nodes. */
+    fwrite_test_batch( bfs , 40 , 300 );
+    for (int i=0; i < 300; i++)
+      if (i != 5)
+        assert_test_file( bfs , i );
+
+    block_fs_set_mmap_read( bfs , true );
+    fwrite_test_batch( bfs , 300 , 310 );
+    for (int i=300; i < 310; i++)
+      assert_test_file( bfs , i );
+    block_fs_close( bfs , false );
+  }
+  /* Remove the index to force a scan of the data file on the next mount. */
+  unlink( "test.index" );
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 10 , false , true , false );
+    test_assert_false( block_fs_has_file( bfs , "FILE.5" ));
+    for (int i=0; i < 310; i++)
+      if (i != 5)
+        assert_test_file( bfs , i );
+    block_fs_close( bfs , false );
+  }
+  test_work_area_free( work_area );
+}
+
+
+void violating_fwrite_batch( void * arg ) {
+  block_fs_type * bfs = block_fs_safe_cast( arg );
+  stringlist_type * filenames = stringlist_alloc_new( );
+  vector_type * buffers = vector_alloc_new( );
+
+  /* The second occurrence of FILE.1 needs a larger node than the first. */
+  for (int i=0; i < 2; i++) {
+    buffer_type * buffer = buffer_alloc( 100 );
+    for (int j=0; j < 10 + 1000 * i; j++)
+      buffer_fwrite_int( buffer , j );
+
+    stringlist_append_ref( filenames , "FILE.1" );
+    vector_append_owned_ref( buffers , buffer , free_buffer );
+  }
+  block_fs_fwrite_batch( bfs , filenames , buffers );
+  vector_free( buffers );
+  stringlist_free( filenames );
+}
+
+
+void test_fwrite_batch_duplicate() {
+  test_work_area_type * work_area = test_work_area_alloc("block_fs/fwrite_batch_duplicate");
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 10 , false , false , false );
+    fwrite_test_file( bfs , 1 );
+    test_assert_util_abort("block_fs_fwrite_batch" , violating_fwrite_batch , bfs );
+    assert_test_file( bfs , 1 );
+    test_assert_int_equal( 0 , block_fs_get_num_free_nodes( bfs ));
+    block_fs_close( bfs , false );
+  }
+  test_work_area_free( work_area );
+}
+
+
+void test_free_lists() {
+  test_work_area_type * work_area = test_work_area_alloc("block_fs/free_lists");
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 0 , false , false , false );
+    for (int i=0; i < 100; i++)
+      fwrite_test_file( bfs , i );
+    test_assert_int_equal( 100 , block_fs_get_num_new_nodes( bfs ));
+    test_assert_int_equal( 0 , block_fs_get_num_reused_nodes( bfs ));
+    test_assert_int_equal( 0 , block_fs_get_num_free_nodes( bfs ));
+
+    for (int i=10; i < 20; i++) {
+      char * filename = util_alloc_sprintf("FILE.%d" , i);
+      block_fs_unlink_file( bfs , filename );
+      free( filename );
+    }
+    test_assert_int_equal( 10 , block_fs_get_num_free_nodes( bfs ));
+    test_assert_true( block_fs_get_free_size( bfs ) > 0 );
+
+    /* Largest first; every file should fit exactly in its old hole. */
+    for (int i=19; i >= 10; i--)
+      fwrite_test_file( bfs , i );
+    test_assert_int_equal( 100 , block_fs_get_num_new_nodes( bfs ));
+    test_assert_int_equal( 10 , block_fs_get_num_reused_nodes( bfs ));
+    test_assert_int_equal( 0 , block_fs_get_num_free_nodes( bfs ));
+    test_assert_true( block_fs_get_free_size( bfs ) == 0 );
+
+    /* Small files are served from the holes left by large files. */
+    for (int i=90; i < 100; i++) {
+      char * filename = util_alloc_sprintf("FILE.%d" , i);
+      block_fs_unlink_file( bfs , filename );
+      free( filename );
+    }
+    for (int i=100; i < 110; i++)
+      fwrite_test_file( bfs , i );
+    test_assert_int_equal( 110 , block_fs_get_num_new_nodes( bfs ));
+    for (int i=0; i < 10; i++) {
+      char * filename = util_alloc_sprintf("SMALL.%d" , i);
+      int data[4] = {i , i , i , i};
+      block_fs_fwrite_file( bfs , filename , data , sizeof data );
+      free( filename );
+    }
+    test_assert_int_equal( 110 , block_fs_get_num_new_nodes( bfs ));
+    test_assert_int_equal( 20 , block_fs_get_num_reused_nodes( bfs ));
+    test_assert_int_equal( 0 , block_fs_get_num_free_nodes( bfs ));
+
+    for (int i=0; i < 90; i++)
+      assert_test_file( bfs , i );
+    block_fs_unlink_file( bfs , "FILE.50");
+    block_fs_unlink_file( bfs , "FILE.60");
+    block_fs_close( bfs , false );
+  }
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 0 , false , false , false );
+    test_assert_int_equal( 2 , block_fs_get_num_free_nodes( bfs ));
+    {
+      int data[4] = {1 , 2 , 3 , 4};
+      block_fs_fwrite_file( bfs , "SMALL.10" , data , sizeof data );
+    }
+    test_assert_int_equal( 1 , block_fs_get_num_reused_nodes( bfs ));
+    test_assert_int_equal( 1 , block_fs_get_num_free_nodes( bfs ));
+    for (int i=0; i < 50; i++)
+      assert_test_file( bfs , i );
+    block_fs_close( bfs , false );
+  }
+  test_work_area_free( work_area );
+}
+
+
+static void fwrite_sized_file( block_fs_type * bfs , const char * filename , int data_size ) {
+  char * data = util_calloc( data_size , sizeof * data );
+  memset( data , 1 , data_size );
+  block_fs_fwrite_file( bfs , filename , data , data_size );
+  free( data );
+}
+
+
+/*
+  Many free nodes of 4096 bytes share the size class [4096,4352) with
+  requests which are too large for them; finding a node must not scan
+  through them.
+*/
+
+void test_free_lists_bounded_scan() {
+  test_work_area_type * work_area = test_work_area_alloc("block_fs/free_lists_scan");
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 0 , false , false , false );
+    const int num_small = 200;
+    long int num_scanned;
+
+    for (int i=0; i < num_small; i++) {
+      char * filename = util_alloc_sprintf("SMALL.%d" , i);
+      char * keep = util_alloc_sprintf("KEEP.%d" , i);
+      fwrite_sized_file( bfs , filename , 4050 );
+      fwrite_sized_file( bfs , keep , 16 );
+      free( keep );
+      free( filename );
+    }
+    fwrite_sized_file( bfs , "LARGE" , 16000 );
+    fwrite_sized_file( bfs , "KEEP.LARGE" , 16 );
+    for (int i=0; i < num_small; i++) {
+      char * filename = util_alloc_sprintf("SMALL.%d" , i);
+      block_fs_unlink_file( bfs , filename );
+      free( filename );
+    }
+    block_fs_unlink_file( bfs , "LARGE" );
+    test_assert_int_equal( num_small + 1 , block_fs_get_num_free_nodes( bfs ));
+
+    /* Node size 4224: the 4096 byte nodes in the same class are too small. */
+    num_scanned = block_fs_get_num_free_scanned( bfs );
+    fwrite_sized_file( bfs , "MEDIUM.0" , 4150 );
+    test_assert_true( block_fs_get_num_free_scanned( bfs ) - num_scanned <= 2 );
+    test_assert_int_equal( 1 , block_fs_get_num_reused_nodes( bfs ));
+
+    /* Fits in the 4096 byte nodes, which are in the next class up. */
+    num_scanned = block_fs_get_num_free_scanned( bfs );
+    fwrite_sized_file( bfs , "SMALL.NEW" , 4050 );
+    test_assert_true( block_fs_get_num_free_scanned( bfs ) - num_scanned <= 2 );
+    test_assert_int_equal( 2 , block_fs_get_num_reused_nodes( bfs ));
+    test_assert_int_equal( num_small - 1 , block_fs_get_num_free_nodes( bfs ));
+
+    /* Only the small nodes are left; they are all too small. */
+    fwrite_sized_file( bfs , "MEDIUM.1" , 4150 );
+    test_assert_int_equal( 2 , block_fs_get_num_reused_nodes( bfs ));
+    test_assert_int_equal( num_small - 1 , block_fs_get_num_free_nodes( bfs ));
+
+    block_fs_close( bfs , false );
+  }
+  test_work_area_free( work_area );
+}
+
+
+static void unlink_test_file( block_fs_type * bfs , int index ) {
+  char * filename = util_alloc_sprintf("FILE.%d" , index);
+  block_fs_unlink_file( bfs , filename );
+  free( filename );
+}
+
+
+void test_compact() {
+  test_work_area_type * work_area = test_work_area_alloc("block_fs/compact");
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 0 , false , false , false );
+    for (int i=0; i < 100; i++)
+      fwrite_test_file( bfs , i );
+    for (int i=0; i < 100; i += 2)
+      unlink_test_file( bfs , i );
+    test_assert_true( block_fs_get_fragmentation( bfs ) > 0.25 );
+    test_assert_false( block_fs_compact( bfs , 0.90 , 4096 ));
+
+    /* Incremental compaction with reads and writes between the slices. */
+    test_assert_true( block_fs_compact_begin( bfs ));
+    test_assert_true( block_fs_is_compacting( bfs ));
+    test_assert_false( block_fs_compact_begin( bfs ));
+    test_assert_false( block_fs_compact_step( bfs , 4096 ));
+    assert_test_file( bfs , 1 );
+    fwrite_test_file( bfs , 150 );   /* New file. */
+    fwrite_test_file( bfs , 2 );     /* Unlinked file rewritten. */
+    unlink_test_file( bfs , 3 );
+    unlink_test_file( bfs , 99 );
+    {
+      /* Rewrite with different content and size. */
+      int data[4] = {5 , 5 , 5 , 5};
+      block_fs_fwrite_file( bfs , "FILE.97" , data , sizeof data );
+    }
+    while (!block_fs_compact_step( bfs , 4096 ))
+      assert_test_file( bfs , 1 );
+    fwrite_test_file( bfs , 151 );
+    block_fs_compact_finish( bfs );
+    test_assert_false( block_fs_is_compacting( bfs ));
+
+    test_assert_true( block_fs_get_fragmentation( bfs ) < 0.10 );
+    test_assert_false( util_file_exists( "test.data_0" ));
+    test_assert_true( util_file_exists( "test.data_1" ));
+    test_assert_false( block_fs_has_file( bfs , "FILE.3" ));
+    test_assert_false( block_fs_has_file( bfs , "FILE.99" ));
+    test_assert_int_equal( 4 * sizeof(int) , block_fs_get_filesize( bfs , "FILE.97" ));
+    assert_test_file( bfs , 2 );
+    assert_test_file( bfs , 150 );
+    assert_test_file( bfs , 151 );
+    for (int i=1; i < 97; i += 2)
+      if (i != 3)
+        assert_test_file( bfs , i );
+
+    fwrite_test_file( bfs , 152 );
+    block_fs_close( bfs , false );
+  }
+  /* Remount from the data file of the new version, without the index. */
+  unlink( "test.index" );
+  {
+    block_fs_type * bfs = block_fs_mount( "test.mnt" , 64 , 0 , 1.0 , 0 , false , false , false );
+    {
+      vector_type * files = block_fs_alloc_filelist( bfs , NULL , NO_SORT , false );
+      test_assert_int_equal( 52 , vector_get_size( files ));
+      vector_free( files );
+    }
+    for (int i=1; i < 97; i += 2)
+      if (i != 3)
+        assert_test_file( bfs , i );
+    assert_test_file( bfs , 2 );
+    assert_test_file( bfs , 152 );
+
+    test_assert_true( block_fs_compact( bfs , 0.0 , 1024*1024 ) || (block_fs_get_fragmentation( bfs ) == 0));
+    block_fs_close( bfs , false );
+  }
+  test_work_area_free( work_area );
+}
+
+
 int main(int argc , char ** argv) {
   test_readonly();
   test_lock_conflict();
+  test_mmap_read();
+  test_hash_index();
+  test_corrupt_index();
+  test_fwrite_batch();
+  test_fwrite_batch_duplicate();
+  test_free_lists();
+  test_free_lists_bounded_scan();
+  test_compact();
   exit(0);
 }
@@ -0,0 +1,182 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ert_util_kernels.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <ert/util/util.h>
+#include <ert/util/test_util.h>
+#include <ert/util/util_kernels.h>
+
+#define MAX_COUNT 77
+
+/*
+  The kernels are compared element by element with straightforward
+  reference implementations; all counts up to MAX_COUNT are tested to
+  exercise the scalar tail handling of the vectorized versions, and
+  the input is offset by one element to test unaligned access.
+*/
+
+
+static void reverse_bytes( char * target , const char * src , int size ) {
+  int i;
+  for (i=0; i < size; i++)
+    target[i] = src[size - 1 - i];
+}
+
+
+void test_bswap( ) {
+  char src[8 * (MAX_COUNT + 1)];
+  char target[8 * (MAX_COUNT + 1)];
+  char expected[8 * MAX_COUNT];
+  int count , i;
+
+  for (i=0; i < sizeof src; i++)
+    src[i] = (char) (i * 7 + 3);
+
+  for (count = 0; count <= MAX_COUNT; count++) {
+    for (i=0; i < count; i++)
+      reverse_bytes( &expected[4*i] , &src[4 + 4*i] , 4 );
+    util_kernel_bswap32_copy( &target[4] , &src[4] , count );
+    test_assert_int_equal( memcmp( &target[4] , expected , 4 * count ) , 0 );
+
+    for (i=0; i < count; i++)
+      reverse_bytes( &expected[8*i] , &src[8 + 8*i] , 8 );
+    util_kernel_bswap64_copy( &target[8] , &src[8] , count );
+    test_assert_int_equal( memcmp( &target[8] , expected , 8 * count ) , 0 );
+
+    /* In place */
+    memcpy( target , src , sizeof src );
+    util_kernel_bswap64_copy( &target[8] , &target[8] , count );
+    test_assert_int_equal( memcmp( &target[8] , expected , 8 * count ) , 0 );
+  }
+}
+
+
+void test_float_to_double( ) {
+  float src[MAX_COUNT + 1];
+  double target[MAX_COUNT + 1];
+  int count , i;
+
+  for (i=0; i <= MAX_COUNT; i++)
+    src[i] = (i - 20) * 0.37f;
+
+  for (count = 0; count <= MAX_COUNT; count++) {
+    util_kernel_float_to_double( &target[1] , &src[1] , count );
+    for (i=0; i < count; i++)
+      test_assert_true( target[1 + i] == (double) src[1 + i] );
+  }
+}
+
+
+void test_double_to_float( ) {
+  double src[MAX_COUNT + 1];
+  float target[MAX_COUNT + 1];
+  int count , i;
+
+  for (i=0; i <= MAX_COUNT; i++)
+    src[i] = (i - 20) * 0.1234567891;
+
+  for (count = 0; count <= MAX_COUNT; count++) {
+    util_kernel_double_to_float( &target[1] , &src[1] , count );
+    for (i=0; i < count; i++)
+      test_assert_true( target[1 + i] == (float) src[1 + i] );
+  }
+}
+
+
+void test_gather_scatter( ) {
+  double double_src[3 * MAX_COUNT];
+  float  float_src[3 * MAX_COUNT];
+  int    index[MAX_COUNT + 1];
+  double target[MAX_COUNT + 1];
+  int count , i;
+
+  for (i=0; i < 3 * MAX_COUNT; i++) {
+    double_src[i] = i * 0.5 - 7;
+    float_src[i]  = i * 0.25f - 3;
+  }
+  for (i=0; i <= MAX_COUNT; i++)
+    index[i] = (i * 37) % (3 * MAX_COUNT);
+
+  for (count = 0; count <= MAX_COUNT; count++) {
+    util_kernel_gather_double( &target[1] , double_src , &index[1] , count );
+    for (i=0; i < count; i++)
+      test_assert_true( target[1 + i] == double_src[ index[1 + i] ] );
+
+    util_kernel_gather_float_to_double( &target[1] , float_src , &index[1] , count );
+    for (i=0; i < count; i++)
+      test_assert_true( target[1 + i] == (double) float_src[ index[1 + i] ] );
+
+    {
+      double double_target[3 * MAX_COUNT];
+      float  float_target[3 * MAX_COUNT];
+
+      memset( double_target , 0 , sizeof double_target );
+      memset( float_target , 0 , sizeof float_target );
+      util_kernel_scatter_double( double_target , &index[1] , &double_src[1] , count );
+      util_kernel_scatter_double_to_float( float_target , &index[1] , &double_src[1] , count );
+      for (i=0; i < count; i++) {
+        test_assert_true( double_target[ index[1 + i] ] == double_src[1 + i] );
+        test_assert_true( float_target[ index[1 + i] ] == (float) double_src[1 + i] );
+      }
+    }
+  }
+}
+
+
+void test_scale_shift( ) {
+  float  float_data[MAX_COUNT + 1];
+  double double_data[MAX_COUNT + 1];
+  int count , i;
+
+  for (count = 0; count <= MAX_COUNT; count++) {
+    for (i=0; i <= MAX_COUNT; i++) {
+      float_data[i]  = i * 0.5f - 3;
+      double_data[i] = i * 0.25 - 3;
+    }
+
+    util_kernel_scale_shift_float( &float_data[1] , count , 3.0f , -0.5f );
+    util_kernel_scale_shift_double( &double_data[1] , count , 7.0 , 0.125 );
+    for (i=1; i <= MAX_COUNT; i++) {
+      if (i <= count) {
+        test_assert_true( float_data[i]  == (i * 0.5f - 3) * 3.0f - 0.5f );
+        test_assert_true( double_data[i] == (i * 0.25 - 3) * 7.0 + 0.125 );
+      } else {
+        test_assert_true( float_data[i]  == i * 0.5f - 3 );
+        test_assert_true( double_data[i] == i * 0.25 - 3 );
+      }
+    }
+  }
+}
+
+
+int main( int argc , char ** argv) {
+  util_kernel_level_enum max_level = util_kernel_get_level( );
+  int level;
+
+  for (level = UTIL_KERNEL_SCALAR; level <= max_level; level++) {
+    test_assert_int_equal( util_kernel_set_level( level ) , level );
+    test_bswap( );
+    test_float_to_double( );
+    test_double_to_float( );
+    test_gather_scatter( );
+    test_scale_shift( );
+  }
+  exit(0);
+}
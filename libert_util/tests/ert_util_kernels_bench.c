@@ -0,0 +1,106 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ert_util_kernels_bench.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <ert/util/util.h>
+#include <ert/util/util_kernels.h>
+
+/*
+  Microbenchmark for the kernels in util_kernels.c, comparable to
+  converting a keyword with 10M cells:
+
+     ert_util_kernels_bench [num_elements] [repeat]
+
+  For each kernel and each kernel level supported by the CPU the
+  throughput is reported in GB/s, counting the bytes read and written
+  by the kernel.
+*/
+
+
+static double now( ) {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC , &ts );
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+
+static void report( const char * kernel , util_kernel_level_enum level , double elapsed , double bytes ) {
+  printf("%-28s %-7s : %8.2f GB/s\n" , kernel , util_kernel_level_name( level ) , bytes / elapsed * 1e-9);
+}
+
+
+int main( int argc , char ** argv) {
+  int num_elements = 10000000;
+  int repeat       = 20;
+  util_kernel_level_enum max_level = util_kernel_get_level( );
+
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &num_elements );
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &repeat );
+
+  {
+    float  * float_data  = util_calloc( num_elements , sizeof * float_data );
+    double * double_data = util_calloc( num_elements , sizeof * double_data );
+    int level , i , r;
+
+    for (i=0; i < num_elements; i++) {
+      float_data[i]  = i * 0.001f;
+      double_data[i] = i * 0.001;
+    }
+
+    for (level = UTIL_KERNEL_SCALAR; level <= max_level; level++) {
+      double start;
+      util_kernel_set_level( level );
+
+      start = now( );
+      for (r=0; r < repeat; r++)
+        util_kernel_bswap32_copy( float_data , float_data , num_elements );
+      report( "bswap32 (in place)" , level , now( ) - start , 2.0 * repeat * num_elements * sizeof * float_data );
+
+      start = now( );
+      for (r=0; r < repeat; r++)
+        util_kernel_bswap64_copy( double_data , double_data , num_elements );
+      report( "bswap64 (in place)" , level , now( ) - start , 2.0 * repeat * num_elements * sizeof * double_data );
+
+      start = now( );
+      for (r=0; r < repeat; r++)
+        util_kernel_float_to_double( double_data , float_data , num_elements );
+      report( "float -> double" , level , now( ) - start , 1.0 * repeat * num_elements * (sizeof * float_data + sizeof * double_data));
+
+      start = now( );
+      for (r=0; r < repeat; r++)
+        util_kernel_scale_shift_float( float_data , num_elements , 1.0f , 0.0f );
+      report( "scale/shift float" , level , now( ) - start , 2.0 * repeat * num_elements * sizeof * float_data );
+
+      start = now( );
+      for (r=0; r < repeat; r++)
+        util_kernel_scale_shift_double( double_data , num_elements , 1.0 , 0.0 );
+      report( "scale/shift double" , level , now( ) - start , 2.0 * repeat * num_elements * sizeof * double_data );
+
+      printf("\n");
+    }
+
+    free( float_data );
+    free( double_data );
+  }
+  exit(0);
+}
@@ -0,0 +1,132 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ert_util_parallel_for.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <ert/util/util.h>
+#include <ert/util/test_util.h>
+#include <ert/util/thread_pool.h>
+#include <ert/util/parallel_for.h>
+
+
+typedef struct {
+  int * count;
+  int   grain;
+  int   slow_limit;   /* Indices below slow_limit sleep a little. */
+} visit_arg_type;
+
+
+static void visit( int begin , int end , void * arg ) {
+  visit_arg_type * visit_arg = arg;
+  test_assert_true( end > begin );
+  test_assert_true( end - begin <= visit_arg->grain );
+  for (int i = begin; i < end; i++) {
+    if (i < visit_arg->slow_limit)
+      usleep( 1000 );
+    __sync_fetch_and_add( &visit_arg->count[i] , 1 );
+  }
+}
+
+
+static void test_visit_all( int max_running , int size , int grain , int slow_limit) {
+  thread_pool_type * tp = thread_pool_alloc( max_running , false );
+  parallel_for_stats_type * stats = parallel_for_stats_alloc( );
+  visit_arg_type visit_arg = { .count = util_calloc( size , sizeof(int) ) , .grain = grain , .slow_limit = slow_limit };
+
+  for (int i=0; i < size; i++)
+    visit_arg.count[i] = 0;
+
+  parallel_for_timed( tp , 0 , size , grain , visit , &visit_arg , stats );
+  for (int i=0; i < size; i++)
+    test_assert_int_equal( visit_arg.count[i] , 1 );
+
+  {
+    int num_tasks = 0;
+    test_assert_int_equal( parallel_for_stats_get_num_threads( stats ) , util_int_max( 1 , max_running ));
+    for (int i=0; i < parallel_for_stats_get_num_threads( stats ); i++) {
+      num_tasks += parallel_for_stats_iget_num_tasks( stats , i );
+      test_assert_true( parallel_for_stats_iget_max_task_time( stats , i ) <= parallel_for_stats_iget_busy_time( stats , i ));
+    }
+    test_assert_true( num_tasks >= (size + grain - 1) / grain );
+    test_assert_true( parallel_for_stats_get_imbalance( stats ) >= 1.0 );
+  }
+
+  /* The thread pool can be reused. */
+  parallel_for( tp , 0 , size , grain , visit , &visit_arg );
+  for (int i=0; i < size; i++)
+    test_assert_int_equal( visit_arg.count[i] , 2 );
+
+  free( visit_arg.count );
+  parallel_for_stats_free( stats );
+  thread_pool_free( tp );
+}
+
+
+/*
+  All the slow elements are in the range initially given to thread 0,
+  the other threads must steal from it.
+*/
+
+static void test_steal( ) {
+  const int max_running = 4;
+  const int size = 400;
+  thread_pool_type * tp = thread_pool_alloc( max_running , false );
+  parallel_for_stats_type * stats = parallel_for_stats_alloc( );
+  visit_arg_type visit_arg = { .count = util_calloc( size , sizeof(int) ) , .grain = 1 , .slow_limit = size / max_running };
+
+  for (int i=0; i < size; i++)
+    visit_arg.count[i] = 0;
+
+  parallel_for_timed( tp , 0 , size , 1 , visit , &visit_arg , stats );
+  {
+    int num_steals = 0;
+    for (int i=0; i < max_running; i++)
+      num_steals += parallel_for_stats_iget_num_steals( stats , i );
+    test_assert_true( num_steals > 0 );
+  }
+
+  parallel_for_stats_reset( stats );
+  test_assert_double_equal( parallel_for_stats_get_wall_time( stats ) , 0 );
+  test_assert_int_equal( parallel_for_stats_iget_num_tasks( stats , 0 ) , 0 );
+
+  free( visit_arg.count );
+  parallel_for_stats_free( stats );
+  thread_pool_free( tp );
+}
+
+
+static void test_empty_range( ) {
+  thread_pool_type * tp = thread_pool_alloc( 4 , false );
+  visit_arg_type visit_arg = { .count = NULL , .grain = 1 , .slow_limit = 0 };
+  parallel_for( tp , 10 , 10 , 1 , visit , &visit_arg );
+  parallel_for( tp , 10 , 5 , 1 , visit , &visit_arg );
+  thread_pool_free( tp );
+}
+
+
+int main(int argc , char ** argv) {
+  test_visit_all( 0 , 100 , 7 , 0 );
+  test_visit_all( 1 , 100 , 7 , 0 );
+  test_visit_all( 4 , 1000 , 1 , 20 );
+  test_visit_all( 4 , 1003 , 17 , 0 );
+  test_visit_all( 8 , 3 , 1 , 0 );
+  test_steal( );
+  test_empty_range( );
+  exit(0);
+}
@@ -0,0 +1,103 @@
+/*
+   Copyright (C) 2017  Statoil ASA, Norway.
+
+   The file 'ert_util_thread_pool_bench.c' is part of ERT - Ensemble based Reservoir Tool.
+
+   ERT is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   ERT is distributed in the hope that it will be useful, but WITHOUT ANY
+   WARRANTY; without even the implied warranty of MERCHANTABILITY or
+   FITNESS FOR A PARTICULAR PURPOSE.
+
+   See the GNU General Public License at <http://www.gnu.org/licenses/gpl.html>
+   for more details.
+*/
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <semaphore.h>
+
+#include <ert/util/util.h>
+#include <ert/util/thread_pool.h>
+
+/*
+  Microbenchmark for the dispatch overhead of the thread_pool; the
+  jobs are (nearly) empty, so the timing is dominated by the time it
+  takes to get a job from thread_pool_add_job() to a running thread.
+
+     ert_util_thread_pool_bench [num_threads] [num_jobs]
+
+  Two numbers are reported:
+
+    latency   : The average time from a single job is added to an
+                idle pool until it has started running.
+
+    throughput: The average time per job when num_jobs small jobs
+                are added in one go.
+*/
+
+
+static double now( ) {
+  struct timespec ts;
+  clock_gettime( CLOCK_MONOTONIC , &ts );
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+
+static void * small_job( void * arg ) {
+  double * sum = arg;
+  for (int i=0; i < 100; i++)
+    sum[0] += i;
+  return NULL;
+}
+
+
+static void * post_job( void * arg ) {
+  sem_post( (sem_t *) arg );
+  return NULL;
+}
+
+
+int main( int argc , char ** argv) {
+  int num_threads = 4;
+  int num_jobs    = 100000;
+  int num_cycles  = 200;
+
+  if (argc > 1)
+    util_sscanf_int( argv[1] , &num_threads );
+  if (argc > 2)
+    util_sscanf_int( argv[2] , &num_jobs );
+
+  {
+    thread_pool_type * tp = thread_pool_alloc( num_threads , true );
+    sem_t started;
+    double start;
+
+    sem_init( &started , 0 , 0 );
+    start = now( );
+    for (int i=0; i < num_cycles; i++) {
+      thread_pool_add_job( tp , post_job , &started );
+      sem_wait( &started );
+    }
+    printf("latency    : %8.2f us/job  (%d jobs added to an idle pool)\n" , 1e6 * (now( ) - start) / num_cycles , num_cycles);
+    thread_pool_join( tp );
+    thread_pool_free( tp );
+    sem_destroy( &started );
+  }
+
+  {
+    double * sums = util_calloc( num_jobs , sizeof * sums );
+    thread_pool_type * tp = thread_pool_alloc( num_threads , true );
+    double start = now( );
+    for (int i=0; i < num_jobs; i++)
+      thread_pool_add_job( tp , small_job , &sums[i] );
+    thread_pool_join( tp );
+    printf("throughput : %8.2f us/job  (%d jobs on %d threads)\n" , 1e6 * (now( ) - start) / num_jobs , num_jobs , num_threads);
+    thread_pool_free( tp );
+    free( sums );
+  }
+  exit(0);
+}
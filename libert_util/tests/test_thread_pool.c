@@ -64,7 +64,77 @@ void run() {
 
 
 
+void * square(void * arg) {
+  long value = (long) arg;
+  return (void *) (value * value);
+}
+
+
+void return_values() {
+  int job_size = 100;
+  thread_pool_type * tp = thread_pool_alloc( 4 , false );
+
+  for (int restart = 0; restart < 3; restart++) {
+    thread_pool_restart( tp );
+    for (long i=0; i < job_size; i++)
+      thread_pool_add_job( tp , square , (void *) (i + restart));
+    thread_pool_join( tp );
+
+    for (long i=0; i < job_size; i++)
+      test_assert_long_equal( (i + restart) * (i + restart) , (long) thread_pool_iget_return_value( tp , i ));
+  }
+  thread_pool_free( tp );
+}
+
+
+void * wait_for_unlock(void * arg) {
+  pthread_mutex_t * mutex = (pthread_mutex_t *) arg;
+  pthread_mutex_lock( mutex );
+  pthread_mutex_unlock( mutex );
+  return NULL;
+}
+
+
+void try_join() {
+  pthread_mutex_t mutex;
+  thread_pool_type * tp = thread_pool_alloc( 2 , true );
+
+  pthread_mutex_init( &mutex , NULL );
+  pthread_mutex_lock( &mutex );
+  thread_pool_add_job( tp , wait_for_unlock , &mutex );
+  test_assert_false( thread_pool_try_join( tp , 1 ));
+
+  /* The pool is still running after a failed join. */
+  thread_pool_add_job( tp , square , (void *) 3 );
+  pthread_mutex_unlock( &mutex );
+  test_assert_true( thread_pool_try_join( tp , 10 ));
+  test_assert_long_equal( 9 , (long) thread_pool_iget_return_value( tp , 1 ));
+
+  thread_pool_free( tp );
+  pthread_mutex_destroy( &mutex );
+}
+
+
+void free_running() {
+  int job_size = 100;
+  int value = 0;
+  thread_pool_type * tp = thread_pool_alloc( 4 , true );
+
+  pthread_mutex_init(&lock , NULL);
+  for (int i=0; i < job_size; i++)
+    thread_pool_add_job( tp , inc , &value );
+
+  /* thread_pool_free() joins the workers of a pool which is still running. */
+  thread_pool_free( tp );
+  test_assert_int_equal( job_size , value );
+  pthread_mutex_destroy( &lock );
+}
+
+
 int main( int argc , char ** argv) {
   create_and_destroy();
   run();
+  return_values();
+  try_join();
+  free_running();
 }
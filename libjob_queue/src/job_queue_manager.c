@@ -73,22 +73,10 @@ void job_queue_manager_wait( job_queue_manager_type * manager) {
 
 
 bool job_queue_manager_try_wait( job_queue_manager_type * manager , int timeout_seconds) {
-  struct timespec ts;
   time_t timeout_time = time( NULL );
 
   util_inplace_forward_seconds_utc(&timeout_time , timeout_seconds );
-  ts.tv_sec = timeout_time;
-  ts.tv_nsec = 0;
 
-#ifdef HAVE_TIMEDJOIN
-  {
-    int join_return = pthread_timedjoin_np( manager->queue_thread , NULL , &ts);  /* Wait for the main thread to complete. */
-    if (join_return == 0)
-      return true;
-    else
-      return false;
-  }
-#else
     while(true) {
         if (pthread_kill(manager->queue_thread, 0) == 0){
             util_yield();
@@ -102,8 +90,6 @@ bool job_queue_manager_try_wait( job_queue_manager_type * manager , int timeout_
             return false;
         }
     }
-
-#endif
 }
 
 
@@ -120,6 +120,13 @@ class SiteConfig(BaseCClass):
     def set_max_submit(self, max_value):
         SiteConfig.cNamespace().set_max_submit( self , max_value)
 
+    def get_load_threads(self):
+        """ @rtype: int """
+        return SiteConfig.cNamespace().get_load_threads( self )
+
+    def set_load_threads(self, load_threads):
+        SiteConfig.cNamespace().set_load_threads( self , load_threads)
+
     def get_license_root_path(self):
         """ @rtype: str """
         return SiteConfig.cNamespace().get_license_root_path( self )
@@ -179,6 +186,8 @@ SiteConfig.cNamespace().set_max_running_local = cwrapper.prototype("void site_co
 SiteConfig.cNamespace().get_installed_jobs    = cwrapper.prototype("ext_joblist_ref site_config_get_installed_jobs(site_config)")
 SiteConfig.cNamespace().get_max_submit        = cwrapper.prototype("int site_config_get_max_submit(site_config)")
 SiteConfig.cNamespace().set_max_submit        = cwrapper.prototype("void site_config_set_max_submit(site_config, int)")
+SiteConfig.cNamespace().get_load_threads      = cwrapper.prototype("int site_config_get_load_threads(site_config)")
+SiteConfig.cNamespace().set_load_threads      = cwrapper.prototype("void site_config_set_load_threads(site_config, int)")
 SiteConfig.cNamespace().get_license_root_path = cwrapper.prototype("char* site_config_get_license_root_path(site_config)")
 SiteConfig.cNamespace().set_license_root_path = cwrapper.prototype("void site_config_set_license_root_path(site_config, char*)")
 SiteConfig.cNamespace().get_job_script        = cwrapper.prototype("char* site_config_get_job_script(site_config)")
@@ -15,6 +15,8 @@ class AnalysisModuleKeywords(object):
         ert_keywords.addKeyword(self.addIterCount())
         ert_keywords.addKeyword(self.addStdCutoff())
         ert_keywords.addKeyword(self.addSingleNodeUpdate())
+        ert_keywords.addKeyword(self.addUpdateThreads())
+        ert_keywords.addKeyword(self.addUpdateBlockSize())
         ert_keywords.addKeyword(self.addIterRetryCount())
 
 
@@ -103,4 +105,22 @@ class AnalysisModuleKeywords(object):
                                                  documentation_link="keywords/single_node_update",
                                                  required=False,
                                                  group=self.group)
-        return single_node_update
\ No newline at end of file
+        return single_node_update
+
+
+    def addUpdateThreads(self):
+        update_threads = ConfigurationLineDefinition(keyword=KeywordDefinition("UPDATE_THREADS"),
+                                                     arguments=[IntegerArgument(from_value=0)],
+                                                     documentation_link="keywords/update_threads",
+                                                     required=False,
+                                                     group=self.group)
+        return update_threads
+
+
+    def addUpdateBlockSize(self):
+        update_block_size = ConfigurationLineDefinition(keyword=KeywordDefinition("UPDATE_BLOCK_SIZE"),
+                                                        arguments=[IntegerArgument(from_value=0)],
+                                                        documentation_link="keywords/update_block_size",
+                                                        required=False,
+                                                        group=self.group)
+        return update_block_size
\ No newline at end of file
@@ -17,6 +17,7 @@ class RunKeywords(object):
         ert_keywords.addKeyword(self.addLogLevel())
         ert_keywords.addKeyword(self.addLogFile())
         ert_keywords.addKeyword(self.addMaxSubmit())
+        ert_keywords.addKeyword(self.addLoadThreads())
         ert_keywords.addKeyword(self.addMaxResample())
         ert_keywords.addKeyword(self.addPreClearRunpath())
 
@@ -126,6 +127,15 @@ class RunKeywords(object):
         return max_submit
 
 
+    def addLoadThreads(self):
+        load_threads = ConfigurationLineDefinition(keyword=KeywordDefinition("LOAD_THREADS"),
+                                                   arguments=[IntegerArgument(from_value=0)],
+                                                   documentation_link="keywords/load_threads",
+                                                   required=False,
+                                                   group=self.group)
+        return load_threads
+
+
     def addMaxResample(self):
         max_resample = ConfigurationLineDefinition(keyword=KeywordDefinition("MAX_RESAMPLE"),
                                                   arguments=[IntegerArgument()],
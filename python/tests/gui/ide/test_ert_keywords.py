@@ -66,6 +66,7 @@ class ErtKeywordTest(ExtendedTestCase):
         self.keywordTest("LOG_LEVEL", [IntegerArgument], "keywords/log_level", "Run")
         self.keywordTest("LOG_FILE", [PathArgument], "keywords/log_file", "Run")
         self.keywordTest("MAX_SUBMIT", [IntegerArgument], "keywords/max_submit", "Run")
+        self.keywordTest("LOAD_THREADS", [IntegerArgument], "keywords/load_threads", "Run")
         self.keywordTest("MAX_RESAMPLE", [IntegerArgument], "keywords/max_resample", "Run")
         self.keywordTest("PRE_CLEAR_RUNPATH", [BoolArgument], "keywords/pre_clear_runpath", "Run")
 
@@ -124,6 +125,8 @@ class ErtKeywordTest(ExtendedTestCase):
         self.keywordTest("ITER_COUNT", [IntegerArgument], "keywords/iter_count", "Analysis Module")
         self.keywordTest("STD_CUTOFF", [FloatArgument], "keywords/std_cutoff", "Analysis Module")
         self.keywordTest("SINGLE_NODE_UPDATE", [BoolArgument], "keywords/single_node_update", "Analysis Module")
+        self.keywordTest("UPDATE_THREADS", [IntegerArgument], "keywords/update_threads", "Analysis Module")
+        self.keywordTest("UPDATE_BLOCK_SIZE", [IntegerArgument], "keywords/update_block_size", "Analysis Module")
 
 
     def test_advanced_keywords(self):